@@ -0,0 +1,150 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ostream>
+#include <vector>
+
+#include "ModernInventory/ModernInventory.h"
+
+namespace MI::Bench
+{
+    namespace
+    {
+        struct Case
+        {
+            std::string name;
+            Body        body;
+            double      itemsPerIter;
+        };
+
+        std::vector<Case>& Registry()
+        {
+            static std::vector<Case> cases;
+            return cases;
+        }
+
+        // Case whose body is running, for Expect's message
+        const Case* g_Running = nullptr;
+
+        double TimeSeconds(const Case& c, std::uint64_t iters)
+        {
+            g_Running = &c;
+            const auto t0 = std::chrono::steady_clock::now();
+            c.body(iters);
+            const auto t1 = std::chrono::steady_clock::now();
+            return std::chrono::duration<double>(t1 - t0).count();
+        }
+
+        const char* CompilerId()
+        {
+#if defined(__clang__)
+            return "clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc";
+#else
+            return "unknown";
+#endif
+        }
+
+        // Names are plain ASCII identifiers; escape the two characters that could break JSON.
+        void WriteString(std::ostream& out, std::string_view s)
+        {
+            out << '"';
+            for (char c : s) {
+                if (c == '"' || c == '\\') out << '\\';
+                out << c;
+            }
+            out << '"';
+        }
+    }
+
+    void Register(std::string name, Body body, double itemsPerIter)
+    {
+        Registry().push_back(Case{ std::move(name), std::move(body), itemsPerIter });
+    }
+
+    void Expect(bool ok, const char* what)
+    {
+        if (!ok) {
+            std::fprintf(stderr, "%s: %s\n", g_Running ? g_Running->name.c_str() : "MI_bench", what);
+            std::abort();
+        }
+    }
+
+    void List(std::ostream& out)
+    {
+        for (const auto& c : Registry()) {
+            out << c.name << '\n';
+        }
+    }
+
+    int RunAll(std::string_view filter, double minSeconds, std::ostream& json)
+    {
+        constexpr int kSamples = 5;
+
+        json << "{\n  \"schema\": 1,\n  \"suite\": ";
+        WriteString(json, kName);
+        json << ",\n  \"version\": ";
+        WriteString(json, kVersion);
+        json << ",\n  \"compiler\": ";
+        WriteString(json, CompilerId());
+        json << ",\n  \"results\": [";
+
+        int ran = 0;
+        for (const auto& c : Registry()) {
+            if (!filter.empty() && c.name.find(filter) == std::string::npos) {
+                continue;
+            }
+
+            // Calibrate: grow the batch until one sample takes a fair share of minSeconds.
+            const double perSample = minSeconds / kSamples;
+            std::uint64_t iters = 1;
+            double elapsed = TimeSeconds(c, iters);
+            while (elapsed < perSample && iters < (1ull << 40)) {
+                const double grow = elapsed > 0.0 ? (std::min)(perSample / elapsed * 1.2, 10.0) : 10.0;
+                iters = (std::max)(iters + 1, static_cast<std::uint64_t>(iters * grow));
+                elapsed = TimeSeconds(c, iters);
+            }
+
+            std::vector<double> ns;
+            ns.reserve(kSamples);
+            for (int s = 0; s < kSamples; ++s) {
+                ns.push_back(TimeSeconds(c, iters) * 1e9 / static_cast<double>(iters));
+            }
+            std::sort(ns.begin(), ns.end());
+            const double median = ns[kSamples / 2];
+
+            json << (ran ? ",\n" : "\n") << "    { \"name\": ";
+            WriteString(json, c.name);
+            json << ", \"iterations\": " << iters
+                 << ", \"samples\": " << kSamples
+                 << ", \"ns_per_iter_min\": " << ns.front()
+                 << ", \"ns_per_iter_median\": " << median
+                 << ", \"items_per_second\": " << (median > 0.0 ? c.itemsPerIter * 1e9 / median : 0.0)
+                 << " }";
+            ++ran;
+        }
+        json << "\n  ]\n}\n";
+        return ran;
+    }
+
+    int CheckAll(std::string_view filter, std::ostream& out)
+    {
+        int ran = 0;
+        for (const auto& c : Registry()) {
+            if (!filter.empty() && c.name.find(filter) == std::string::npos) {
+                continue;
+            }
+            out << c.name << " ... " << std::flush;
+            const double seconds = TimeSeconds(c, 1);
+            out << "ok (" << seconds * 1e3 << " ms)\n";
+            ++ran;
+        }
+        return ran;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+// Minimal self-registering microbenchmark harness for the portable core.
+// Results are written as JSON so runs can be diffed between releases.
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace MI::Bench
+{
+    // Runs the measured operation `iters` times.
+    using Body = std::function<void(std::uint64_t iters)>;
+
+    // itemsPerIter scales the reported items/s (e.g. bones per call).
+    void Register(std::string name, Body body, double itemsPerIter = 1.0);
+
+    void List(std::ostream& out);
+
+    // Run every case whose name contains `filter`; returns the number of cases run.
+    int RunAll(std::string_view filter, double minSeconds, std::ostream& json);
+
+    // Run each matching case once (one iteration, no timing) so its Expect checks fire;
+    // a failed check aborts. Prints one line per case; returns the number run (ctest).
+    int CheckAll(std::string_view filter, std::ostream& out);
+
+    // Check made by a case body: unless ok, print "<running case>: <what>" and abort.
+    void Expect(bool ok, const char* what);
+
+    // Keep a value observable so the optimizer can't drop the work producing it.
+    template <class T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        const volatile char* p = reinterpret_cast<const volatile char*>(&value);
+        (void)*p;
+#endif
+    }
+
+    // Cheap deterministic PRNG for synthetic inputs (xorshift32).
+    struct Rng
+    {
+        std::uint32_t state{ 0x9E3779B9u };
+
+        std::uint32_t Next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+        float Uniform(float lo, float hi) { return lo + (hi - lo) * (Next() >> 8) * (1.0f / 16777216.0f); }
+    };
+}
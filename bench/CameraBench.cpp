@@ -0,0 +1,22 @@
+#include "Bench.h"
+
+#include "ModernInventory/PreviewCamera.h"
+#include "ModernInventory/XformMath.h"
+
+namespace
+{
+    const bool kRegistered = [] {
+        MI::Bench::Register("Camera/ComputeFullBody", [](std::uint64_t iters) {
+            MI::Math::Sphere bound{ {}, 90.0f };
+            float acc = 0.0f;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                bound.radius = 60.0f + static_cast<float>(i & 63);
+                const auto cam = MI::Camera::ComputeFullBody(bound, 512u + static_cast<unsigned>(i & 255), 1024u,
+                                                             50.0f, 1.10f, 180.0f, 0.0f);
+                acc += cam.distance;
+            }
+            MI::Bench::DoNotOptimize(acc);
+        });
+        return true;
+    }();
+}
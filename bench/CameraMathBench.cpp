@@ -0,0 +1,217 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ModernInventory/CameraMath.h"
+#include "ModernInventory/PreviewCamera.h"
+
+// Preview camera math against a scalar std::sin / std::cos reference: batched sin/cos, orbit
+// cameras for a sheet of thumbnails (eye + look-at basis each), and the frustum / full-body
+// fit. Cases abort if a result is further from the double-precision reference than the
+// tolerances below, or a basis is not orthonormal.
+
+namespace
+{
+    constexpr std::size_t kAngles = 4096;
+    constexpr std::size_t kCameras = 64;  // a thumbnail grid
+    constexpr float       kPi = 3.14159265358979f;
+
+    constexpr double kSinCosTol = 3e-7;  // absolute, |angle| <= 8 pi (preview yaw accumulates turns)
+    constexpr double kWideTol = 2e-6;    // |angle| <= 1000
+    constexpr double kBasisTol = 2e-6;
+
+    using MI::Bench::Expect;
+
+    std::vector<float> Angles(float range)
+    {
+        MI::Bench::Rng     rng;
+        std::vector<float> angles(kAngles);
+        for (auto& a : angles) {
+            a = rng.Uniform(-range, range);
+        }
+        angles[0] = 0.0f;
+        angles[1] = -0.0f;
+        angles[2] = kPi * 0.25f;
+        angles[3] = -kPi * 0.5f;
+        return angles;
+    }
+
+    double MaxSinCosError(const std::vector<float>& angles, const std::vector<float>& s, const std::vector<float>& c)
+    {
+        double worst = 0.0;
+        for (std::size_t i = 0; i < angles.size(); ++i) {
+            const double a = angles[i];
+            worst = (std::max)({ worst, std::fabs(s[i] - std::sin(a)), std::fabs(c[i] - std::cos(a)) });
+        }
+        return worst;
+    }
+
+    std::vector<MI::Math::Orbit> Orbits()
+    {
+        MI::Bench::Rng               rng;
+        std::vector<MI::Math::Orbit> orbits(kCameras + 3);  // plus a scalar tail
+        for (auto& o : orbits) {
+            o.target = { rng.Uniform(-50.0f, 50.0f), rng.Uniform(-50.0f, 50.0f), rng.Uniform(0.0f, 120.0f) };
+            o.yawRad = rng.Uniform(-2.0f * kPi, 4.0f * kPi);
+            o.pitchRad = rng.Uniform(-1.4f, 1.4f);
+            o.distance = rng.Uniform(60.0f, 220.0f);
+        }
+        orbits[5].pitchRad = 2.0f;  // past straight up: the basis flips with cos(pitch)
+        return orbits;
+    }
+
+    // What Preview3D did per camera: std::sin / std::cos for the eye, then a look-at basis
+    MI::Math::Xform ScalarOrbit(const MI::Math::Orbit& o)
+    {
+        const float     cp = std::cos(o.pitchRad), sp = std::sin(o.pitchRad);
+        const float     sy = std::sin(o.yawRad), cy = std::cos(o.yawRad);
+        MI::Math::Xform x;
+        x.pos = { o.target.x - sy * cp * o.distance, o.target.y - cy * cp * o.distance, o.target.z - sp * o.distance };
+        MI::Math::LookAt(x.pos, o.target, x.rot);
+        return x;
+    }
+
+    void ExpectOrthonormal(const float (&m)[3][3])
+    {
+        for (int a = 0; a < 3; ++a) {
+            for (int b = 0; b < 3; ++b) {
+                const double dot = m[0][a] * m[0][b] + m[1][a] * m[1][b] + m[2][a] * m[2][b];
+                Expect(std::fabs(dot - (a == b ? 1.0 : 0.0)) < kBasisTol, "basis is not orthonormal");
+            }
+        }
+    }
+
+    void CheckOrbits(const std::vector<MI::Math::Orbit>& orbits, const std::vector<MI::Math::Xform>& cams)
+    {
+        for (std::size_t i = 0; i < orbits.size(); ++i) {
+            const auto ref = ScalarOrbit(orbits[i]);
+            const auto& cam = cams[i];
+            Expect(MI::Math::Distance(cam.pos, ref.pos) < 1e-5 * orbits[i].distance, "orbit eye differs from the scalar reference");
+            for (int r = 0; r < 3; ++r) {
+                for (int c = 0; c < 3; ++c) {
+                    Expect(std::fabs(cam.rot[r][c] - ref.rot[r][c]) < kBasisTol, "orbit basis differs from LookAt");
+                }
+            }
+            ExpectOrthonormal(cam.rot);
+            Expect(cam.scale == 1.0f, "orbit camera is scaled");
+            const auto single = MI::Math::OrbitCamera(orbits[i]);
+            Expect(MI::Math::Distance(single.pos, cam.pos) < 1e-4f, "batched and single orbit cameras disagree");
+        }
+    }
+
+    const bool kRegistered = [] {
+        // Batched (SSE2) against the std:: pair per angle
+        auto checked = std::make_shared<bool>(false);
+        MI::Bench::Register("CameraMath/SinCos4096", [checked](std::uint64_t iters) {
+            static const auto angles = Angles(8.0f * kPi);
+            std::vector<float> s(kAngles), c(kAngles);
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                MI::Math::SinCos(angles, s, c);
+                MI::Bench::DoNotOptimize(s.data());
+                MI::Bench::DoNotOptimize(c.data());
+            }
+            if (!std::exchange(*checked, true)) {
+                Expect(MaxSinCosError(angles, s, c) < kSinCosTol, "batched sin/cos off the reference");
+                Expect(!std::signbit(c[1]) && s[1] == 0.0f && std::signbit(s[1]), "sin(-0) is not -0");
+                for (std::size_t i = 0; i < kAngles; ++i) {
+                    float ss, cc;
+                    MI::Math::SinCos(angles[i], ss, cc);
+                    Expect(std::fabs(ss - s[i]) <= 1e-7f && std::fabs(cc - c[i]) <= 1e-7f, "scalar and SSE2 sin/cos disagree");
+                }
+
+                const auto wide = Angles(1000.0f);
+                MI::Math::SinCos(wide, s, c);
+                Expect(MaxSinCosError(wide, s, c) < kWideTol, "batched sin/cos off the reference on wide angles");
+            }
+        }, static_cast<double>(kAngles));
+
+        MI::Bench::Register("CameraMath/StdSinCos4096", [](std::uint64_t iters) {
+            static const auto angles = Angles(8.0f * kPi);
+            std::vector<float> s(kAngles), c(kAngles);
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                for (std::size_t k = 0; k < kAngles; ++k) {
+                    s[k] = std::sin(angles[k]);
+                    c[k] = std::cos(angles[k]);
+                }
+                MI::Bench::DoNotOptimize(s.data());
+                MI::Bench::DoNotOptimize(c.data());
+            }
+        }, static_cast<double>(kAngles));
+
+        // One frame of thumbnail cameras: eye and NiCamera basis for each
+        auto orbitsChecked = std::make_shared<bool>(false);
+        MI::Bench::Register("CameraMath/OrbitCameras64", [orbitsChecked](std::uint64_t iters) {
+            static const auto orbits = Orbits();
+            std::vector<MI::Math::Xform> cams(orbits.size());
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                MI::Math::OrbitCameras(orbits, cams);
+                MI::Bench::DoNotOptimize(cams.data());
+            }
+            if (!std::exchange(*orbitsChecked, true)) {
+                CheckOrbits(orbits, cams);
+            }
+        }, static_cast<double>(kCameras + 3));
+
+        MI::Bench::Register("CameraMath/ScalarOrbitLookAt64", [](std::uint64_t iters) {
+            static const auto orbits = Orbits();
+            std::vector<MI::Math::Xform> cams(orbits.size());
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                for (std::size_t k = 0; k < orbits.size(); ++k) {
+                    cams[k] = ScalarOrbit(orbits[k]);
+                }
+                MI::Bench::DoNotOptimize(cams.data());
+            }
+        }, static_cast<double>(kCameras + 3));
+
+        // Degenerate look-ats and the frustum / full-body fit against their std:: forms
+        MI::Bench::Register("CameraMath/LookAt", [](std::uint64_t iters) {
+            MI::Math::Xform x;
+            float           acc = 0.0f;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                const MI::Math::Vec3 eye{ static_cast<float>(i & 127) - 64.0f, -150.0f, 10.0f };
+                MI::Math::LookAt(eye, MI::Math::Vec3{ 0.0f, 0.0f, 90.0f }, x.rot);
+                acc += x.rot[0][2];
+            }
+            MI::Bench::DoNotOptimize(acc);
+
+            MI::Math::LookAt({ 0.0f, 0.0f, -100.0f }, { 0.0f, 0.0f, 0.0f }, x.rot);  // straight up
+            ExpectOrthonormal(x.rot);
+            Expect(x.rot[2][0] == 1.0f && x.rot[0][2] == 1.0f, "looking straight up should use +X as right");
+            MI::Math::LookAt({ 0.0f, -150.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, x.rot);
+            Expect(x.rot[1][0] == 1.0f && x.rot[2][1] == 1.0f && x.rot[0][2] == 1.0f,
+                   "looking down +Y should be forward +Y, up +Z, right +X");
+        });
+
+        MI::Bench::Register("CameraMath/FullBodyFit", [](std::uint64_t iters) {
+            float acc = 0.0f;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                const auto f = MI::Math::Perspective(0.35f + static_cast<float>(i & 63) * 0.02f, 0.5f, 5.0f, 5000.0f);
+                acc += f.top + f.right;
+            }
+            MI::Bench::DoNotOptimize(acc);
+
+            for (float fovDeg = 20.0f; fovDeg <= 90.0f; fovDeg += 5.0f) {
+                const float fov = fovDeg * kPi / 180.0f;
+                const auto  f = MI::Math::Perspective(fov, 0.5f, 5.0f, 5000.0f);
+                const double t = std::tan(fov * 0.5);
+                Expect(std::fabs(f.top - t) < 1e-6 * t && f.bottom == -f.top && std::fabs(f.right - 0.5 * t) < 1e-6 * t &&
+                           f.left == -f.right && f.nearZ == 5.0f && f.farZ == 5000.0f,
+                       "perspective frustum off tan(fov / 2)");
+
+                for (const unsigned width : { 64u, 512u, 1024u, 4096u }) {
+                    const auto cam = MI::Camera::ComputeFullBodyFromRadius(90.0f, width, 1024u, fovDeg, 1.1f, 180.0f, 0.0f);
+                    // The sin / atan form it replaced
+                    const double r = 90.0 * 1.1, halfF = (std::max)(fov * 0.5, 0.1);
+                    const double halfX = std::atan(std::tan(halfF) * width / 1024.0);
+                    const double ref = (std::max)(r / std::sin(halfF), r / std::sin((std::max)(halfX, 0.1)));
+                    Expect(std::fabs(cam.distance - ref) < 1e-5 * ref, "full-body distance differs from the sin / atan fit");
+                }
+            }
+        });
+        return true;
+    }();
+}
@@ -0,0 +1,198 @@
+#include "Bench.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ModernInventory/GameWorld.h"
+#include "ModernInventory/MpscQueue.h"
+#include "ModernInventory/PreviewController.h"
+
+// Throughput of the sink -> render thread command queue, plus stress cases that abort on
+// lost, duplicated or reordered commands. Build with -DMI_SANITIZE=thread and run
+// `MI_bench --filter CommandQueue` to have ThreadSanitizer check the same paths.
+
+namespace
+{
+    struct Message
+    {
+        std::uint32_t producer;
+        std::uint32_t seq;
+    };
+
+    using Queue = MI::MpscQueue<Message, 1024>;
+
+    // `producers` threads push `perProducer` messages each (spinning while full); this thread
+    // drains. Every message must arrive exactly once and in push order per producer.
+    void RunProducers(Queue& queue, unsigned producers, std::uint64_t perProducer)
+    {
+        std::atomic<bool>        go{ false };
+        std::vector<std::thread> threads;
+        for (unsigned p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (std::uint32_t s = 0; s < perProducer; ++s) {
+                    while (!queue.TryPush(Message{ p, s })) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        std::vector<std::uint32_t> next(producers, 0);
+        const auto                 total = perProducer * producers;
+        std::uint64_t              received = 0;
+        go.store(true, std::memory_order_release);
+        while (received < total) {
+            const auto n = queue.Drain([&](const Message& m) {
+                if (m.producer >= producers || m.seq != next[m.producer]) {
+                    std::fprintf(stderr, "MpscQueue: producer %u sent seq %u, expected %u\n", m.producer, m.seq,
+                                 m.producer < producers ? next[m.producer] : 0u);
+                    std::abort();
+                }
+                ++next[m.producer];
+            });
+            received += n;
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        Message extra{};
+        if (queue.TryPop(extra)) {
+            std::fprintf(stderr, "MpscQueue: message left over after all producers finished\n");
+            std::abort();
+        }
+    }
+
+    // Render-side calls must all come from the thread driving OnFrame; counts let the
+    // stress case check that every posted command was applied or counted as dropped.
+    class CountingWorld final : public MI::IGameWorld
+    {
+    public:
+        std::thread::id            renderThread{};
+        std::uint64_t              opens{}, closes{}, rebuilds{}, exports{};
+        std::atomic<std::uint64_t> clock{ 0 };
+
+        bool HasPlayer3D() override { return Check(), true; }
+        void HideVanillaPreview() override { Check(); }
+        void SetPanelVisible(bool open) override
+        {
+            Check();
+            ++(open ? opens : closes);
+        }
+        bool RebuildPreview() override
+        {
+            Check();
+            ++rebuilds;
+            return true;
+        }
+        void DiscardPreview() override { Check(); }
+        std::uint64_t PreviewFingerprint() override { return Check(), 0; }
+        bool UnderMemoryPressure() override { return Check(), false; }
+        bool RenderPreview(unsigned, unsigned) override { return Check(), true; }
+        void Notify(const char*) override { Check(); }
+        std::uint64_t NowUs() override { return clock.fetch_add(1, std::memory_order_relaxed); }  // any thread
+        void TakeGpuCalls(MI::GpuCallFrame& out) override { out.fill(0); }
+        void RequestExport() override
+        {
+            Check();
+            ++exports;
+        }
+        std::uint32_t HoveredRow() override { return Check(), kNone; }
+        std::uint32_t ItemCount() override { return Check(), 0; }
+        std::uint32_t ItemForm(std::uint32_t) override { return Check(), 0; }
+        bool BuildVariant(std::uint32_t, std::uint32_t) override { return Check(), false; }
+        void ShowVariant(std::uint32_t) override { Check(); }
+        void DiscardVariants() override { Check(); }
+
+    private:
+        void Check() const
+        {
+            if (std::this_thread::get_id() != renderThread) {
+                std::fprintf(stderr, "PreviewController: world touched off the render thread\n");
+                std::abort();
+            }
+        }
+    };
+
+    // Menu, equip and input sinks firing from three threads while this thread renders.
+    void RunControllerSinks(std::uint64_t perSink)
+    {
+        CountingWorld world;
+        world.renderThread = std::this_thread::get_id();
+        MI::PreviewController controller{ world };
+
+        std::atomic<unsigned>    done{ 0 };
+        std::vector<std::thread> sinks;
+        sinks.emplace_back([&] {
+            for (std::uint64_t i = 0; i < perSink; ++i) {
+                controller.OnMenu((i & 1) == 0);
+            }
+            done.fetch_add(1, std::memory_order_release);
+        });
+        sinks.emplace_back([&] {
+            for (std::uint64_t i = 0; i < perSink; ++i) {
+                controller.OnEquip();
+            }
+            done.fetch_add(1, std::memory_order_release);
+        });
+        sinks.emplace_back([&] {
+            for (std::uint64_t i = 0; i < perSink; ++i) {
+                controller.OnExport();
+            }
+            done.fetch_add(1, std::memory_order_release);
+        });
+
+        while (done.load(std::memory_order_acquire) < sinks.size()) {
+            controller.OnFrame(320, 480);
+        }
+        for (auto& t : sinks) {
+            t.join();
+        }
+        controller.ProcessCommands();
+
+        const auto& stats = controller.GetStats();
+        const auto  applied = world.opens + world.closes + world.exports +
+                             stats.equips.load(std::memory_order_relaxed);
+        const auto  dropped = stats.commandsDropped.load(std::memory_order_relaxed);
+        if (applied + dropped != perSink * sinks.size() || world.opens != stats.menuOpens.load() ||
+            world.exports != stats.exports.load() || world.rebuilds > world.opens + stats.equips.load()) {
+            std::fprintf(stderr, "PreviewController: %llu applied + %llu dropped of %llu posted\n",
+                         static_cast<unsigned long long>(applied), static_cast<unsigned long long>(dropped),
+                         static_cast<unsigned long long>(perSink * sinks.size()));
+            std::abort();
+        }
+    }
+
+    const bool kRegistered = [] {
+        MI::Bench::Register("CommandQueue/PushPop/singleThread", [](std::uint64_t iters) {
+            static Queue queue;
+            Message      m{};
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                queue.TryPush(Message{ 0, static_cast<std::uint32_t>(i) });
+                queue.TryPop(m);
+            }
+            MI::Bench::DoNotOptimize(m);
+        });
+
+        for (const unsigned producers : { 1u, 4u }) {
+            MI::Bench::Register("CommandQueue/Drain/" + std::to_string(producers) + "producers", [producers](std::uint64_t iters) {
+                static Queue queue;  // shared by both cases; always empty between runs
+                RunProducers(queue, producers, (iters + producers - 1) / producers);
+            });
+        }
+
+        MI::Bench::Register("CommandQueue/PreviewController/concurrentSinks", [](std::uint64_t iters) {
+            RunControllerSinks((iters + 2) / 3);
+        });
+        return true;
+    }();
+}
@@ -0,0 +1,40 @@
+#include "Bench.h"
+
+#include <sstream>
+#include <string>
+
+#include "ModernInventory/Config.h"
+
+namespace
+{
+    // Representative ModernInventory.ini: every key plus comments and noise lines.
+    constexpr const char* kIni =
+        "; ModernInventory settings\n"
+        "DebugToasts=1\n"
+        "PanelWidthRatio = 0.75   # wide panel\n"
+        "PanelMinWidth=520\n"
+        "\n"
+        "[Preview]\n"
+        "PreviewFovDeg=45\n"
+        "PreviewYawDeg=170\n"
+        "PreviewPitchDeg=-5\n"
+        "PreviewFitMargin=1.2\n"
+        "TurntableFrames=36\n"
+        "TurntableBakesPerFrame=2\n"
+        "TurntableBlend=yes\n"
+        "UnknownKey=ignored\n"
+        "BadNumber=abc\n";
+
+    const bool kRegistered = [] {
+        MI::Bench::Register("Config/Parse", [](std::uint64_t iters) {
+            const std::string text = kIni;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                std::istringstream in(text);
+                MI::Config cfg{};
+                MI::ConfigSys::Parse(in, cfg);
+                MI::Bench::DoNotOptimize(cfg);
+            }
+        });
+        return true;
+    }();
+}
@@ -0,0 +1,123 @@
+#include "Bench.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ModernInventory/EventLog.h"
+
+// Cost of EventRecorder::Record on the recording thread (a queue push; the writer thread
+// encodes and writes). Cases abort if events from concurrent recorders are lost beyond the
+// counted drops, duplicated or reordered per thread in the written capture, or if Flush
+// does not get recorded events to disk without Stop.
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    using MI::Bench::Expect;
+
+    std::string TempCapture(const char* name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    // Threads record kGpuCalls events (a = thread, b = sequence) while the writer runs
+    void CheckConcurrent()
+    {
+        constexpr unsigned      kThreads = 4;
+        constexpr std::uint32_t kPerThread = 3000;  // more than the queue holds at once
+        const auto              path = TempCapture("mi_bench_events_mt.mievents");
+        MI::EventRecorder       recorder;
+        Expect(recorder.Start(path, 0), "could not start the recorder");
+
+        std::atomic<bool>        go{ false };
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (std::uint32_t s = 0; s < kPerThread; ++s) {
+                    recorder.Record(MI::EventType::kGpuCalls, s, t, s);
+                    if (s % 256 == 255) {
+                        std::this_thread::sleep_for(1ms);  // roughly a frame's worth per burst
+                    }
+                }
+            });
+        }
+        go.store(true, std::memory_order_release);
+        for (auto& t : threads) {
+            t.join();
+        }
+        recorder.Stop();
+
+        const auto& stats = recorder.GetStats();
+        Expect(stats.recorded + stats.dropped == kThreads * kPerThread, "Record calls not accounted for");
+        std::vector<MI::Event> events;
+        Expect(MI::EventLog::ReadFile(path, events), "capture does not decode");
+        Expect(events.size() == stats.recorded, "written events differ from the recorded count");
+        std::vector<std::int64_t> last(kThreads, -1);
+        for (const auto& e : events) {
+            Expect(e.type == MI::EventType::kGpuCalls && e.a < kThreads, "unexpected event in the capture");
+            Expect(static_cast<std::int64_t>(e.b) > last[e.a], "events of one thread duplicated or reordered");
+            last[e.a] = e.b;
+        }
+        std::filesystem::remove(path);
+    }
+
+    // Flush (menu close) gets what was recorded onto disk while recording goes on
+    void CheckFlush()
+    {
+        const auto        path = TempCapture("mi_bench_events_flush.mievents");
+        MI::EventRecorder recorder;
+        Expect(recorder.Start(path, 1000), "could not start the recorder");
+        recorder.Record(MI::EventType::kMenuOpen, 1000);
+        recorder.Record(MI::EventType::kPaneSize, 1500, 640, 1080);
+        recorder.Record(MI::EventType::kMenuClose, 2500);
+        recorder.Flush();
+
+        std::vector<MI::Event> events;
+        for (auto waited = 0ms; waited < 2s && events.size() < 3; waited += 5ms) {
+            std::this_thread::sleep_for(5ms);
+            events.clear();
+            MI::EventLog::ReadFile(path, events);
+        }
+        Expect(events.size() == 3, "Flush did not write the recorded events");
+        Expect(events[1].type == MI::EventType::kPaneSize && events[1].timeUs == 500 && events[1].a == 640 &&
+                   events[2].timeUs == 1500,
+               "flushed events decode wrong");
+        recorder.Stop();
+        Expect(!recorder.Active(), "recorder still active after Stop");
+        std::filesystem::remove(path);
+    }
+
+    const bool kRegistered = [] {
+        // One render-thread frame's worth of records: a few GPU call counts and the frame. The
+        // writer keeps up at bench rates only by dropping, so this is the push cost either way.
+        auto recorder = std::make_shared<MI::EventRecorder>();
+        auto checked = std::make_shared<bool>(false);
+        MI::Bench::Register("EventRecorder/Record/frame", [recorder, checked](std::uint64_t iters) {
+            if (!recorder->Active()) {
+                recorder->Start(TempCapture("mi_bench_events.mievents"), 0);
+            }
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                const auto now = i * 16667;
+                for (std::uint32_t call = 0; call < 4; ++call) {
+                    recorder->Record(MI::EventType::kGpuCalls, now, call, 2);
+                }
+                recorder->Record(MI::EventType::kFrame, now);
+            }
+            if (!std::exchange(*checked, true)) {
+                CheckConcurrent();
+                CheckFlush();
+            }
+        }, 5.0);
+        return true;
+    }();
+}
@@ -0,0 +1,227 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ModernInventory/FlatHierarchy.h"
+
+// Flat breadth-first update against the recursive pointer-chasing walk it replaced. Cases
+// abort if a flat world transform differs from TreeNode::world (also under a non-identity
+// parent world, as the preview clone hangs off its scene root), or an update after SetLocal
+// reports (or changes) anything outside the edited node's subtree.
+
+namespace
+{
+    using MI::Bench::Expect;
+
+    // Pointer-chasing baseline shaped like an NiNode tree: heap nodes, child pointer arrays,
+    // and padding so a node spans as many cache lines as an NiNode (~0x128 bytes).
+    struct TreeNode
+    {
+        MI::Math::Xform        local;
+        std::uint8_t           otherFields[0x60]{};
+        MI::Math::Xform        world;
+        std::vector<TreeNode*> children;
+        std::uint8_t           moreFields[0x40]{};
+    };
+
+    void UpdateRecursive(TreeNode* node, const MI::Math::Xform& parentWorld)
+    {
+        node->world = MI::Math::Compose(parentWorld, node->local);
+        for (auto* child : node->children) {
+            UpdateRecursive(child, node->world);
+        }
+    }
+
+    MI::Math::Xform RandomLocal(MI::Bench::Rng& rng)
+    {
+        MI::Math::Xform x;
+        const float a = rng.Uniform(-0.5f, 0.5f);
+        x.rot[0][0] = std::cos(a); x.rot[0][2] = std::sin(a);
+        x.rot[2][0] = -std::sin(a); x.rot[2][2] = std::cos(a);
+        x.pos = { rng.Uniform(-5.0f, 5.0f), rng.Uniform(-5.0f, 5.0f), rng.Uniform(1.0f, 10.0f) };
+        return x;
+    }
+
+    // Random tree of `count` nodes (parent chosen among recent nodes -> deep chains),
+    // allocated in shuffled order so siblings are not adjacent in memory.
+    struct Scene
+    {
+        std::vector<std::unique_ptr<TreeNode>> storage;
+        std::vector<std::uint32_t>             parent;
+        std::vector<TreeNode*>                 byFlat;  // flat index -> tree node
+        TreeNode*                              root{};
+        MI::FlatHierarchy                      flat;
+
+        explicit Scene(std::uint32_t count)
+        {
+            MI::Bench::Rng rng;
+            parent.resize(count, MI::FlatHierarchy::kNoParent);
+            std::vector<MI::Math::Xform> locals(count);
+            for (std::uint32_t i = 0; i < count; ++i) {
+                locals[i] = RandomLocal(rng);
+                if (i > 0) {
+                    const std::uint32_t window = (std::min)(i, 8u);
+                    parent[i] = i - 1 - rng.Next() % window;
+                }
+            }
+
+            std::vector<std::uint32_t> order(count);
+            for (std::uint32_t i = 0; i < count; ++i) order[i] = i;
+            for (std::uint32_t i = count; i > 1; --i) std::swap(order[i - 1], order[rng.Next() % i]);
+            std::vector<TreeNode*> byIndex(count);
+            for (auto idx : order) {
+                storage.push_back(std::make_unique<TreeNode>());
+                byIndex[idx] = storage.back().get();
+                byIndex[idx]->local = locals[idx];
+            }
+            for (std::uint32_t i = 1; i < count; ++i) {
+                byIndex[parent[i]]->children.push_back(byIndex[i]);
+            }
+            root = byIndex[0];
+
+            // Breadth-first flatten, as Preview3D::FlattenClone does
+            std::vector<TreeNode*> queue{ root };
+            std::vector<std::uint32_t> flatIndex{ flat.Add(MI::FlatHierarchy::kNoParent, root->local) };
+            for (std::size_t q = 0; q < queue.size(); ++q) {
+                for (auto* c : queue[q]->children) {
+                    queue.push_back(c);
+                    flatIndex.push_back(flat.Add(flatIndex[q], c->local));
+                }
+            }
+            byFlat.resize(count);
+            for (std::size_t q = 0; q < queue.size(); ++q) {
+                byFlat[flatIndex[q]] = queue[q];
+            }
+        }
+    };
+
+    bool Near(const MI::Math::Xform& a, const MI::Math::Xform& b)
+    {
+        // Same products in the same order; the slack only covers contraction into FMAs
+        const float tol = 1e-5f * (1.0f + std::fabs(b.pos.x) + std::fabs(b.pos.y) + std::fabs(b.pos.z));
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                if (std::fabs(a.rot[r][c] - b.rot[r][c]) > 1e-5f) {
+                    return false;
+                }
+            }
+        }
+        return std::fabs(a.pos.x - b.pos.x) <= tol && std::fabs(a.pos.y - b.pos.y) <= tol && std::fabs(a.pos.z - b.pos.z) <= tol &&
+               std::fabs(a.scale - b.scale) <= 1e-5f * b.scale;
+    }
+
+    void ExpectMatchesTree(const Scene& scene)
+    {
+        UpdateRecursive(scene.root, MI::Math::Xform{});
+        for (std::uint32_t i = 0; i < scene.flat.Size(); ++i) {
+            Expect(Near(scene.flat.World(i), scene.byFlat[i]->world), "flat world differs from the pointer-chasing walk");
+        }
+    }
+
+    bool InSubtree(const MI::FlatHierarchy& flat, std::uint32_t node, std::uint32_t root)
+    {
+        for (; node != MI::FlatHierarchy::kNoParent; node = flat.Parent(node)) {
+            if (node == root) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Edit one node's local: exactly its subtree is reported, and the result still matches the tree
+    void CheckDirtySubtree(Scene& scene, std::uint32_t edited)
+    {
+        auto&      flat = scene.flat;
+        const auto before = flat.Update();  // settle
+        Expect(before == 0 || flat.Update() == 0, "a clean hierarchy reported changes");
+
+        std::vector<MI::Math::Xform> worlds(flat.Size());
+        for (std::uint32_t i = 0; i < flat.Size(); ++i) {
+            worlds[i] = flat.World(i);
+        }
+        const auto oldLocal = flat.Local(edited);
+        auto       local = oldLocal;
+        local.pos.x += 3.0f;
+        flat.SetLocal(edited, local);
+        scene.byFlat[edited]->local = local;
+
+        std::size_t expected = 0;
+        for (std::uint32_t i = 0; i < flat.Size(); ++i) {
+            expected += InSubtree(flat, i, edited);
+        }
+        Expect(flat.Update() == expected, "update count is not the edited subtree's size");
+        std::size_t visited = 0;
+        flat.ForEachUpdated([&](std::uint32_t i, const MI::Math::Xform&) {
+            Expect(InSubtree(flat, i, edited), "a node outside the edited subtree was reported");
+            ++visited;
+        });
+        Expect(visited == expected, "ForEachUpdated missed part of the edited subtree");
+        for (std::uint32_t i = 0; i < flat.Size(); ++i) {
+            if (!InSubtree(flat, i, edited)) {
+                Expect(Near(flat.World(i), worlds[i]), "a node outside the edited subtree changed");
+            }
+        }
+        ExpectMatchesTree(scene);
+
+        flat.SetLocal(edited, oldLocal);
+        scene.byFlat[edited]->local = oldLocal;
+        flat.Update();
+    }
+
+    // Preview3D folds sceneRoot_'s world into the mirror's root: the result must match a walk
+    // that starts from that parent, and Inverse must undo the placement the root leaves
+    void CheckParentWorld(Scene& scene)
+    {
+        MI::Bench::Rng rng;
+        auto parent = RandomLocal(rng);
+        parent.scale = 1.5f;
+        auto& flat = scene.flat;
+        const auto rootLocal = flat.Local(0);
+        flat.SetLocal(0, MI::Math::Compose(parent, rootLocal));
+        flat.Update();
+        UpdateRecursive(scene.root, parent);
+        for (std::uint32_t i = 0; i < flat.Size(); ++i) {
+            Expect(Near(flat.World(i), scene.byFlat[i]->world), "the parent's world is not carried through the mirror");
+        }
+        Expect(Near(MI::Math::Compose(parent, MI::Math::Inverse(parent)), MI::Math::Xform{}), "Inverse does not undo the transform");
+        Expect(Near(MI::Math::Compose(MI::Math::Inverse(parent), parent), MI::Math::Xform{}), "Inverse is not a left inverse");
+
+        flat.SetLocal(0, rootLocal);
+        flat.Update();
+    }
+
+    const bool kRegistered = [] {
+        for (std::uint32_t nodes : { 300u, 1000u, 4000u }) {
+            const std::string n = std::to_string(nodes);
+            auto scene = std::make_shared<Scene>(nodes);
+            auto checked = std::make_shared<bool>(false);
+            MI::Bench::Register("FlatHierarchy/Update/" + n, [scene, checked](std::uint64_t iters) {
+                for (std::uint64_t i = 0; i < iters; ++i) {
+                    scene->flat.MarkAllDirty();
+                    MI::Bench::DoNotOptimize(scene->flat.Update());
+                }
+                if (!std::exchange(*checked, true)) {
+                    ExpectMatchesTree(*scene);
+                    const auto size = static_cast<std::uint32_t>(scene->flat.Size());
+                    for (const std::uint32_t edited : { 0u, 1u, size / 3, size / 2, size - 1 }) {
+                        CheckDirtySubtree(*scene, edited);
+                    }
+                    CheckParentWorld(*scene);
+                }
+            }, nodes);
+            MI::Bench::Register("FlatHierarchy/PointerChase/" + n, [scene](std::uint64_t iters) {
+                const MI::Math::Xform identity{};
+                for (std::uint64_t i = 0; i < iters; ++i) {
+                    UpdateRecursive(scene->root, identity);
+                    MI::Bench::DoNotOptimize(scene->root->world);
+                }
+            }, nodes);
+        }
+        return true;
+    }();
+}
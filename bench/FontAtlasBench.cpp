@@ -0,0 +1,178 @@
+#include "Bench.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "ModernInventory/FontAtlasCache.h"
+
+#if MI_BENCH_HAS_IMGUI
+#include <imgui.h>
+
+#include "ModernInventory/FontAtlasImGui.h"
+#endif
+
+// First-frame font cost: decoding a cached atlas vs. rasterizing it, and the per-string cost of
+// tracking which glyphs drawn text needs. With ImGui available the cold bake and the cache load
+// run through ImFontAtlas; MI_BENCH_FONT=<file.ttf> bakes that font with the CJK common range
+// (the case the cache is for) instead of ImGui's built-in Latin font.
+
+namespace
+{
+    std::string TempPath(const char* name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    // 1024x1024 atlas with ~7000 glyphs: the size of a CJK common-set bake at 16 px
+    MI::BakedAtlas SyntheticAtlas()
+    {
+        MI::Bench::Rng rng;
+        MI::BakedAtlas atlas;
+        atlas.width = atlas.height = 1024;
+        atlas.alpha.resize(static_cast<std::size_t>(atlas.width) * atlas.height);
+        for (auto& a : atlas.alpha) {
+            a = static_cast<std::uint8_t>(rng.Next());
+        }
+        atlas.lineUvs.resize(64);
+        atlas.ranges = { 0x0020, 0x00FF, 0x3000, 0x30FF, 0x4E00, 0x5C7F };
+        auto& font = atlas.fonts.emplace_back();
+        font.size = 16.0f;
+        font.ascent = 13.0f;
+        font.descent = -3.0f;
+        for (std::size_t i = 0; i + 1 < atlas.ranges.size(); i += 2) {
+            for (auto cp = atlas.ranges[i]; cp <= atlas.ranges[i + 1]; ++cp) {
+                font.glyphs.push_back({ cp, rng.Uniform(4, 16), 0, 0, 8, 16, rng.Uniform(0, 1), rng.Uniform(0, 1), 0, 0 });
+            }
+        }
+        return atlas;
+    }
+
+    // Item names as the panel would draw them: mostly Latin, some Cyrillic and CJK
+    const std::vector<std::string> kNames = {
+        "Iron Sword", "Steel Plate Armor", "Elven Bow of Frost", "Потион здоровья", "Daedric Helmet",
+        "\xE9\x89\x84\xE3\x81\xAE\xE5\x89\xA3", "Ebony Mail", "Glass Dagger", "Amulet of Mara", "Sweetroll",
+    };
+
+#if MI_BENCH_HAS_IMGUI
+    std::vector<MI::FontSource> BenchFonts(std::vector<std::uint32_t>& ranges)
+    {
+        if (const char* file = std::getenv("MI_BENCH_FONT")) {
+            ranges = { 0x0020, 0x00FF, 0x3000, 0x30FF, 0x31F0, 0x31FF, 0xFF00, 0xFFEF, 0x4E00, 0x9FAF };
+            return { { file, 16.0f } };
+        }
+        ranges = { 0x0020, 0x00FF };
+        return { { "", 13.0f } };
+    }
+
+    std::size_t GlyphCount(const ImFontAtlas& atlas)
+    {
+        std::size_t n = 0;
+        for (const ImFont* font : atlas.Fonts) {
+            n += static_cast<std::size_t>(font->Glyphs.Size);
+        }
+        return n;
+    }
+#endif
+
+    const bool kRegistered = [] {
+        MI::Bench::Register("FontAtlasCache/Decode", [](std::uint64_t iters) {
+            const auto atlas = SyntheticAtlas();
+            std::vector<std::uint8_t> bytes;
+            MI::FontAtlasCache::Encode(atlas, 42, bytes);
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                MI::BakedAtlas out;
+                if (!MI::FontAtlasCache::Decode(bytes.data(), bytes.size(), 42, out) ||
+                    out.fonts[0].glyphs.size() != atlas.fonts[0].glyphs.size() || out.alpha != atlas.alpha) {
+                    std::fprintf(stderr, "FontAtlasCache: round trip changed the atlas\n");
+                    std::abort();
+                }
+                MI::Bench::DoNotOptimize(out);
+            }
+        });
+
+        MI::Bench::Register("FontAtlasCache/ReadFile", [](std::uint64_t iters) {
+            const auto path = TempPath("mi_bench.fontcache");
+            if (!MI::FontAtlasCache::WriteFile(path, SyntheticAtlas(), 42)) {
+                std::abort();
+            }
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                MI::BakedAtlas out;
+                if (!MI::FontAtlasCache::ReadFile(path, 42, out)) {
+                    std::abort();
+                }
+                MI::Bench::DoNotOptimize(out);
+            }
+            MI::BakedAtlas stale;
+            if (MI::FontAtlasCache::ReadFile(path, 43, stale)) {
+                std::fprintf(stderr, "FontAtlasCache: accepted a cache with another key\n");
+                std::abort();
+            }
+            std::filesystem::remove(path);
+        });
+
+        // Steady state: every name already covered, so one bit test per codepoint
+        MI::Bench::Register("GlyphCoverage/NoteCovered", [](std::uint64_t iters) {
+            MI::GlyphCoverage coverage;
+            coverage.Reset({ 0x0020, 0x00FF });
+            for (const auto& name : kNames) {
+                coverage.Note(name);
+            }
+            std::vector<std::uint32_t> ranges = { 0x0020, 0x00FF };
+            coverage.TakePending(ranges);
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                for (const auto& name : kNames) {
+                    coverage.Note(name);
+                }
+            }
+            if (coverage.HasPending()) {
+                std::fprintf(stderr, "GlyphCoverage: taken blocks requested again\n");
+                std::abort();
+            }
+        }, static_cast<double>(kNames.size()));
+
+#if MI_BENCH_HAS_IMGUI
+        MI::Bench::Register("FontAtlas/ColdBake", [](std::uint64_t iters) {
+            std::vector<std::uint32_t> ranges;
+            const auto fonts = BenchFonts(ranges);
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                ImFontAtlas atlas;
+                if (!MI::FontAtlasImGui::Bake(atlas, fonts, ranges)) {
+                    std::abort();
+                }
+                MI::Bench::DoNotOptimize(atlas.TexPixelsAlpha8);
+            }
+        });
+
+        // What a warm start pays: read the cache file and rebuild the ImFontAtlas from it
+        MI::Bench::Register("FontAtlas/CacheLoad", [](std::uint64_t iters) {
+            std::vector<std::uint32_t> ranges;
+            const auto fonts = BenchFonts(ranges);
+            const auto key = MI::FontAtlasCache::Key(fonts, ranges, MI::FontAtlasImGui::BuilderVersion());
+            const auto path = TempPath("mi_bench_imgui.fontcache");
+            ImFontAtlas baked;
+            MI::BakedAtlas snapshot;
+            MI::FontAtlasImGui::Bake(baked, fonts, ranges);
+            MI::FontAtlasImGui::Capture(baked, ranges, snapshot);
+            if (!MI::FontAtlasCache::WriteFile(path, snapshot, key)) {
+                std::abort();
+            }
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                MI::BakedAtlas cached;
+                ImFontAtlas atlas;
+                if (!MI::FontAtlasCache::ReadFile(path, key, cached) || !MI::FontAtlasImGui::Restore(cached, atlas) ||
+                    GlyphCount(atlas) != GlyphCount(baked) || atlas.TexWidth != baked.TexWidth ||
+                    atlas.TexHeight != baked.TexHeight) {
+                    std::fprintf(stderr, "FontAtlas: restored atlas differs from the bake\n");
+                    std::abort();
+                }
+                MI::Bench::DoNotOptimize(atlas.TexPixelsAlpha8);
+            }
+            std::filesystem::remove(path);
+        });
+#endif
+        return true;
+    }();
+}
@@ -0,0 +1,458 @@
+#include "Bench.h"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "Mannequin.h"
+#include "ModernInventory/ImageEncode.h"
+#include "ModernInventory/ImageExporter.h"
+#include "ModernInventory/SoftRaster.h"
+
+#if MI_BENCH_HAS_FAKE_D3D11
+#    include "FakeDevice.h"
+#    include "ModernInventory/PreviewExporter.h"
+#endif
+
+// QOI / PNG encoding of a rendered frame and the render-thread side of an export. Cases abort
+// if a written image does not decode back to the source pixels, ImageExporter::Submit waits
+// on a writer that is stuck instead of dropping the job, or PreviewExporter::Poll maps a
+// readback whose copy is still in flight (or waits on the GPU or the encoder queue).
+
+#if MI_BENCH_HAS_FAKE_D3D11
+// PreviewExporter logs each export; the bench has no log file
+namespace MI::Log
+{
+    void Info(std::string_view) {}
+    void Warn(std::string_view) {}
+}
+#endif
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    using MI::Bench::Expect;
+
+    // A rendered 512x1024 mannequin frame: large flat background, shaded silhouette.
+    struct Frame
+    {
+        MI::SoftRaster::Image     image;
+        std::vector<std::uint8_t> out;
+
+        Frame()
+        {
+            std::vector<MI::Math::Sphere> spheres;
+            MI::Raster::BuildMannequin(spheres);
+            MI::SoftRaster::Mesh mesh;
+            for (const auto& s : spheres) {
+                mesh.AddSphere(s);
+            }
+            MI::SoftRaster::Rasterizer raster(0);
+            image.Resize(512, 1024);
+            image.Clear(MI::SoftRaster::Rgba(20, 20, 20, 230));
+            raster.Draw(mesh, MI::Raster::MannequinView(0.5f), 0xFFA0B4C8u, image);
+        }
+
+        const std::uint8_t* Pixels() const { return reinterpret_cast<const std::uint8_t*>(image.rgba.data()); }
+        std::size_t         Pitch() const { return static_cast<std::size_t>(image.stride) * 4u; }
+    };
+
+    // Decoded image, tightly packed RGBA
+    struct Decoded
+    {
+        std::uint32_t             width{}, height{};
+        std::vector<std::uint8_t> rgba;
+    };
+
+    std::uint32_t GetU32BE(const std::uint8_t* p)
+    {
+        return static_cast<std::uint32_t>(p[0]) << 24 | static_cast<std::uint32_t>(p[1]) << 16 |
+               static_cast<std::uint32_t>(p[2]) << 8 | p[3];
+    }
+
+    // Full QOI decoder (every op), independent of the encoder's tables
+    bool DecodeQoi(const std::vector<std::uint8_t>& in, Decoded& out)
+    {
+        if (in.size() < 22 || std::memcmp(in.data(), "qoif", 4) != 0 || in[12] != 4) {
+            return false;
+        }
+        out.width = GetU32BE(&in[4]);
+        out.height = GetU32BE(&in[8]);
+        const std::size_t total = static_cast<std::size_t>(out.width) * out.height;
+        const std::size_t end = in.size() - 8;
+        out.rgba.assign(total * 4, 0);
+
+        std::array<std::uint8_t, 4>                 px{ 0, 0, 0, 255 };
+        std::array<std::array<std::uint8_t, 4>, 64> index{};
+        std::size_t                                 p = 14;
+        std::uint32_t                               run = 0;
+        for (std::size_t n = 0; n < total; ++n) {
+            if (run > 0) {
+                --run;
+            } else {
+                if (p >= end) {
+                    return false;
+                }
+                const auto op = in[p++];
+                if (op == 0xFE || op == 0xFF) {
+                    const std::size_t channels = op == 0xFE ? 3 : 4;
+                    if (p + channels > end) {
+                        return false;
+                    }
+                    std::memcpy(px.data(), &in[p], channels);
+                    p += channels;
+                } else if ((op >> 6) == 0) {
+                    px = index[op];
+                } else if ((op >> 6) == 1) {
+                    px[0] = static_cast<std::uint8_t>(px[0] + ((op >> 4) & 3) - 2);
+                    px[1] = static_cast<std::uint8_t>(px[1] + ((op >> 2) & 3) - 2);
+                    px[2] = static_cast<std::uint8_t>(px[2] + (op & 3) - 2);
+                } else if ((op >> 6) == 2) {
+                    if (p >= end) {
+                        return false;
+                    }
+                    const int vg = (op & 0x3F) - 32;
+                    const auto b = in[p++];
+                    px[0] = static_cast<std::uint8_t>(px[0] + vg - 8 + (b >> 4));
+                    px[1] = static_cast<std::uint8_t>(px[1] + vg);
+                    px[2] = static_cast<std::uint8_t>(px[2] + vg - 8 + (b & 0x0F));
+                } else {
+                    run = op & 0x3F;
+                }
+            }
+            index[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64] = px;
+            std::memcpy(&out.rgba[n * 4], px.data(), 4);
+        }
+        static constexpr std::uint8_t kEnd[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+        return run == 0 && p == end && std::memcmp(&in[end], kEnd, 8) == 0;
+    }
+
+    std::uint32_t Crc32(const std::uint8_t* data, std::size_t size)
+    {
+        std::uint32_t crc = ~0u;
+        for (std::size_t i = 0; i < size; ++i) {
+            crc ^= data[i];
+            for (int k = 0; k < 8; ++k) {
+                crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+            }
+        }
+        return ~crc;
+    }
+
+    // PNG decoder for what ImageEncode::Png writes: 8-bit RGBA, stored deflate blocks, filter
+    // type 0 rows. Chunk CRCs, LEN / NLEN and the Adler-32 are all verified.
+    bool DecodePng(const std::vector<std::uint8_t>& in, Decoded& out)
+    {
+        static constexpr std::uint8_t kSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        if (in.size() < 8 || std::memcmp(in.data(), kSignature, 8) != 0) {
+            return false;
+        }
+        std::vector<std::uint8_t> zlib;
+        bool                      header = false, ended = false;
+        for (std::size_t p = 8; p + 12 <= in.size() && !ended;) {
+            const auto len = GetU32BE(&in[p]);
+            if (p + 12 + len > in.size() || GetU32BE(&in[p + 8 + len]) != Crc32(&in[p + 4], len + 4)) {
+                return false;
+            }
+            const auto* type = &in[p + 4];
+            const auto* data = &in[p + 8];
+            if (std::memcmp(type, "IHDR", 4) == 0) {
+                out.width = GetU32BE(data);
+                out.height = GetU32BE(data + 4);
+                header = len == 13 && data[8] == 8 && data[9] == 6 && data[10] == 0 && data[11] == 0 && data[12] == 0;
+            } else if (std::memcmp(type, "IDAT", 4) == 0) {
+                zlib.insert(zlib.end(), data, data + len);
+            } else if (std::memcmp(type, "IEND", 4) == 0) {
+                ended = true;
+            }
+            p += 12 + len;
+        }
+        if (!header || !ended || zlib.size() < 6 || (zlib[0] & 0x0F) != 8 || (zlib[0] * 256 + zlib[1]) % 31 != 0) {
+            return false;
+        }
+
+        std::vector<std::uint8_t> raw;
+        std::size_t               p = 2;
+        for (bool last = false; !last;) {
+            if (p + 5 > zlib.size() || (zlib[p] & 0x06) != 0) {
+                return false;  // truncated, or not a stored block
+            }
+            last = zlib[p] & 1;
+            const std::uint32_t len = zlib[p + 1] | zlib[p + 2] << 8;
+            const std::uint32_t nlen = zlib[p + 3] | zlib[p + 4] << 8;
+            p += 5;
+            if ((len ^ nlen) != 0xFFFF || p + len > zlib.size()) {
+                return false;
+            }
+            raw.insert(raw.end(), zlib.begin() + p, zlib.begin() + p + len);
+            p += len;
+        }
+        std::uint32_t a = 1, b = 0;
+        for (const auto byte : raw) {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        if (p + 4 != zlib.size() || GetU32BE(&zlib[p]) != (b << 16 | a)) {
+            return false;
+        }
+
+        const std::size_t rowBytes = static_cast<std::size_t>(out.width) * 4;
+        if (raw.size() != (rowBytes + 1) * out.height) {
+            return false;
+        }
+        out.rgba.clear();
+        for (std::uint32_t y = 0; y < out.height; ++y) {
+            const auto* row = &raw[y * (rowBytes + 1)];
+            if (row[0] != 0) {
+                return false;
+            }
+            out.rgba.insert(out.rgba.end(), row + 1, row + 1 + rowBytes);
+        }
+        return true;
+    }
+
+    bool Decode(MI::ImageFormat format, const std::vector<std::uint8_t>& in, Decoded& out)
+    {
+        return format == MI::ImageFormat::kPng ? DecodePng(in, out) : DecodeQoi(in, out);
+    }
+
+    bool SamePixels(const Decoded& image, const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height, std::size_t pitch)
+    {
+        if (image.width != width || image.height != height) {
+            return false;
+        }
+        for (std::uint32_t y = 0; y < height; ++y) {
+            if (std::memcmp(&image.rgba[static_cast<std::size_t>(y) * width * 4], rgba + y * pitch, width * 4u) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Encode, decode, compare: the rendered frame (pitch wider than a row if the raster pads),
+    // noise that exercises every QOI op and several PNG stored blocks, runs longer than one QOI
+    // run op and one ending on the last pixel, and the degenerate sizes
+    void CheckRoundTrip(MI::ImageFormat format, const Frame& frame)
+    {
+        const auto check = [format](const std::uint8_t* rgba, std::uint32_t w, std::uint32_t h, std::size_t pitch) {
+            std::vector<std::uint8_t> encoded;
+            MI::ImageEncode::Encode(format, rgba, w, h, pitch, encoded);
+            Decoded decoded;
+            Expect(Decode(format, encoded, decoded), "encoded image does not decode");
+            Expect(SamePixels(decoded, rgba, w, h, pitch), "decoded pixels differ from the source");
+        };
+        check(frame.Pixels(), 512, 1024, frame.Pitch());
+
+        MI::Bench::Rng              rng;
+        constexpr std::uint32_t     kW = 181, kH = 97;
+        std::vector<std::uint8_t>   noise(static_cast<std::size_t>(kW + 3) * 4 * kH);
+        std::array<std::uint8_t, 4> px{ 0, 0, 0, 255 };
+        for (std::size_t i = 0; i + 4 <= noise.size(); i += 4) {
+            const auto roll = rng.Next() % 8;
+            if (roll == 0) {
+                px = { static_cast<std::uint8_t>(rng.Next()), static_cast<std::uint8_t>(rng.Next()),
+                       static_cast<std::uint8_t>(rng.Next()), static_cast<std::uint8_t>(rng.Next()) };
+            } else if (roll < 4) {
+                px[rng.Next() % 3] += static_cast<std::uint8_t>(rng.Next() % 40) - 20;
+            } else if (roll == 4) {
+                px[3] = static_cast<std::uint8_t>(rng.Next());
+            }  // otherwise repeat: runs
+            std::memcpy(&noise[i], px.data(), 4);
+        }
+        check(noise.data(), kW, kH, (kW + 3) * 4);
+
+        std::vector<std::uint8_t> flat(static_cast<std::size_t>(200) * 4 * 3, 7);
+        check(flat.data(), 200, 3, 800);  // one colour to the last pixel: run ops only
+        check(noise.data(), 1, 1, 4);
+        check(noise.data(), 0, 0, 0);
+    }
+
+    // Runs f on another thread and aborts unless it finishes promptly: a call that waits on a
+    // stuck writer or GPU would otherwise hang the check
+    template <class F>
+    auto WithoutWaiting(F&& f, const char* what)
+    {
+        auto result = std::async(std::launch::async, std::forward<F>(f));
+        Expect(result.wait_for(2s) == std::future_status::ready, what);
+        return result.get();
+    }
+
+#if !defined(_WIN32)
+    // A writer thread saving to a FIFO blocks in open until someone reads it: a deterministic
+    // stuck encoder. Read() releases it and returns what it wrote.
+    struct StuckPath
+    {
+        std::filesystem::path path;
+
+        explicit StuckPath(const char* name) :
+            path(std::filesystem::temp_directory_path() / (name + std::to_string(::getpid()) + ".fifo"))
+        {
+            std::filesystem::remove(path);
+            Expect(::mkfifo(path.c_str(), 0600) == 0, "could not create a FIFO to stall the writer");
+        }
+        ~StuckPath() { std::filesystem::remove(path); }
+
+        std::vector<std::uint8_t> Read() const
+        {
+            std::ifstream in(path, std::ios::binary);
+            return { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+        }
+    };
+
+    // Submit against a writer stuck on its first job: it queues up to the bound, then drops at
+    // once. The stuck job still reaches disk intact once the writer is released.
+    void CheckSubmitNeverWaits(const Frame& frame)
+    {
+        constexpr std::size_t kQueued = 2;
+        const StuckPath       stuck("mi_bench_submit_");
+        const auto            other = (std::filesystem::temp_directory_path() / "mi_bench_submit.qoi").string();
+        MI::ImageExporter     exporter(1, kQueued);
+
+        const auto job = [&frame](std::string path) {
+            MI::ImageExporter::Job j;
+            j.width = 512;
+            j.height = 1024;
+            j.path = std::move(path);
+            for (std::uint32_t y = 0; y < 1024; ++y) {
+                j.rgba.insert(j.rgba.end(), frame.Pixels() + y * frame.Pitch(), frame.Pixels() + y * frame.Pitch() + 512 * 4);
+            }
+            return j;
+        };
+        Expect(WithoutWaiting([&] { return exporter.Submit(job(stuck.path.string())); }, "Submit waited on an idle writer"),
+               "first job was dropped");
+        // The worker may or may not have taken the stuck job off the queue yet
+        std::size_t submits = 1;
+        while (WithoutWaiting([&] { return exporter.Submit(job(other)); }, "Submit waited for the stuck writer")) {
+            Expect(++submits <= kQueued + 1, "queue grew past its bound");
+        }
+        Expect(submits >= kQueued, "Submit dropped with room in the queue");
+        Expect(exporter.GetStats().dropped == 1 && exporter.GetStats().submitted == submits, "drop not counted");
+
+        Decoded decoded;
+        Expect(DecodeQoi(stuck.Read(), decoded) && SamePixels(decoded, frame.Pixels(), 512, 1024, frame.Pitch()),
+               "exported file does not decode to the submitted frame");
+        exporter.Drain();
+        Expect(exporter.GetStats().written == submits && exporter.GetStats().failed == 0, "queued jobs were not all written");
+        std::filesystem::remove(other);
+    }
+#endif
+
+#if MI_BENCH_HAS_FAKE_D3D11
+    // PreviewExporter on the fake device. While the GPU holds the copy, Poll must leave the
+    // slot alone (no map, no stall). Once it lands, Poll must read back every slot in one go
+    // even though the encoder is stuck and its queue overflows: the overflow is dropped, not
+    // waited on. The first capture goes through the real readback + writer path to disk and
+    // must decode to the source texture's pixels.
+    void CheckPollNeverWaits(const Frame& frame)
+    {
+        constexpr std::uint32_t kSlots = 6;
+        MI::Replay::FakeDevice  device;
+        MI::GpuCallFrame        calls;
+
+        D3D11_TEXTURE2D_DESC td{};
+        td.Width = 512;
+        td.Height = 1024;
+        td.MipLevels = 1;
+        td.ArraySize = 1;
+        td.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        td.SampleDesc.Count = 1;
+        td.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+        ID3D11Texture2D* src = nullptr;
+        Expect(SUCCEEDED(device.Device()->CreateTexture2D(&td, nullptr, &src)), "fake source texture");
+        device.Context()->UpdateSubresource(src, 0, nullptr, frame.Pixels(), static_cast<UINT>(frame.Pitch()), 0);
+
+        const StuckPath     stuck("mi_bench_preview_");
+        const auto          other = (std::filesystem::temp_directory_path() / "mi_bench_preview.qoi").string();
+        MI::PreviewExporter exporter;
+        Expect(exporter.Init(device.Device(), device.Context(), kSlots), "PreviewExporter init");
+
+        device.HoldGpu(true);
+        Expect(exporter.Capture(src, { 0, 0, 0, 512, 1024, 1 }, stuck.path.string(), MI::ImageFormat::kQoi), "capture refused");
+        device.TakeFrame(calls);
+        WithoutWaiting([&] { exporter.Poll(); }, "Poll waited on a copy still in flight");
+        device.TakeFrame(calls);
+        Expect(calls[static_cast<std::size_t>(MI::GpuCall::kMap)] == 0, "Poll mapped a readback whose copy is still in flight");
+        Expect(exporter.HasPending() && exporter.GetStats() == nullptr, "Poll handed off a frame the GPU had not finished");
+
+        for (std::uint32_t i = 1; i < kSlots; ++i) {
+            const D3D11_BOX box{ 48 * i, 128 * i, 0, 48 * i + 256, 128 * i + 256, 1 };
+            Expect(exporter.Capture(src, box, other, MI::ImageFormat::kQoi), "capture refused with a slot free");
+        }
+        Expect(!exporter.Capture(src, { 0, 0, 0, 16, 16, 1 }, other, MI::ImageFormat::kQoi), "capture overwrote a busy slot");
+
+        device.HoldGpu(false);
+        WithoutWaiting([&] { exporter.Poll(); }, "Poll waited on the encoder queue");
+        const auto* stats = exporter.GetStats();
+        Expect(!exporter.HasPending() && stats, "Poll left finished readbacks behind");
+        Expect(stats->submitted + stats->dropped == kSlots && stats->dropped >= 1, "overflowing encoder queue was not dropped");
+        Expect(device.GetStats().stalls == 0 && device.GetStats().errors == 0, "readback waited on the GPU or misused the device");
+
+        Decoded decoded;
+        Expect(DecodeQoi(stuck.Read(), decoded) && SamePixels(decoded, frame.Pixels(), 512, 1024, frame.Pitch()),
+               "exported preview does not decode to the source texture");
+        exporter.Shutdown();
+        src->Release();
+        Expect(device.Live() == 0, "PreviewExporter leaked a staging texture or query");
+        std::filesystem::remove(other);
+    }
+#endif
+
+    const bool kRegistered = [] {
+        auto frame = std::make_shared<Frame>();
+        const double pixels = 512.0 * 1024.0;
+        for (const auto format : { MI::ImageFormat::kQoi, MI::ImageFormat::kPng }) {
+            const std::string name = std::string("ImageEncode/") + (format == MI::ImageFormat::kPng ? "Png" : "Qoi") +
+                                     "/512x1024";
+            auto checked = std::make_shared<bool>(false);
+            MI::Bench::Register(name, [frame, format, checked](std::uint64_t iters) {
+                for (std::uint64_t i = 0; i < iters; ++i) {
+                    frame->out.clear();
+                    MI::ImageEncode::Encode(format, frame->Pixels(), 512, 1024, frame->Pitch(), frame->out);
+                    MI::Bench::DoNotOptimize(frame->out.data());
+                }
+                if (!std::exchange(*checked, true)) {
+                    CheckRoundTrip(format, *frame);
+                }
+            }, pixels);
+        }
+
+        // Render-thread side of an export: copy the readback and queue it. The single worker
+        // is kept busy, so this also shows Submit drops rather than waits when it falls behind.
+        auto exporter = std::make_shared<MI::ImageExporter>(1, 4);
+        const auto path = (std::filesystem::temp_directory_path() / "mi_bench_export.qoi").string();
+        auto checked = std::make_shared<bool>(false);
+        MI::Bench::Register("ImageExporter/Submit/512x1024", [frame, exporter, path, checked](std::uint64_t iters) {
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                MI::ImageExporter::Job job;
+                job.width = 512;
+                job.height = 1024;
+                job.path = path;
+                job.rgba.assign(frame->Pixels(), frame->Pixels() + frame->Pitch() * 1024);
+                MI::Bench::DoNotOptimize(exporter->Submit(std::move(job)));
+            }
+            if (!std::exchange(*checked, true)) {
+#if !defined(_WIN32)
+                CheckSubmitNeverWaits(*frame);
+#endif
+#if MI_BENCH_HAS_FAKE_D3D11
+                CheckPollNeverWaits(*frame);
+#endif
+            }
+        }, pixels);
+        return true;
+    }();
+}
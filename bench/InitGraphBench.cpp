@@ -0,0 +1,95 @@
+#include "Bench.h"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "ModernInventory/InitGraph.h"
+
+// Cost of InitGraph::Require on a finished step (every Log:: / ConfigSys::Get call pays it)
+// and a stress case that aborts when a step runs twice or before one of its dependencies.
+
+namespace
+{
+    constexpr std::size_t kSteps = 16;
+
+    struct Counters
+    {
+        std::array<std::atomic<int>, kSteps> runs{};
+    };
+
+    // Steps alternate sync / background / lazy; each depends on up to two earlier steps.
+    void RunGraph(unsigned requesters)
+    {
+        Counters counters;
+        MI::InitGraph graph;
+        std::array<std::vector<MI::InitGraph::StepId>, kSteps> deps;
+        for (std::uint32_t i = 0; i < kSteps; ++i) {
+            if (i >= 1) deps[i].push_back((i * 7 + 3) % i);
+            if (i >= 3) deps[i].push_back(i - 3);
+            const auto mode = static_cast<MI::InitGraph::Mode>(i % 3);
+            const auto check = [&counters, &deps, i] {
+                for (const auto d : deps[i]) {
+                    if (counters.runs[d].load(std::memory_order_acquire) != 1) {
+                        std::fprintf(stderr, "InitGraph: step %u ran before dependency %u\n", i, d);
+                        std::abort();
+                    }
+                }
+                counters.runs[i].fetch_add(1, std::memory_order_acq_rel);
+                return true;
+            };
+            const auto id = deps[i].size() == 2 ? graph.Add("step", mode, check, { deps[i][0], deps[i][1] })
+                          : deps[i].size() == 1 ? graph.Add("step", mode, check, { deps[i][0] })
+                                                : graph.Add("step", mode, check);
+            if (id != i) {
+                std::abort();
+            }
+        }
+
+        graph.Run();
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < requesters; ++t) {
+            threads.emplace_back([&graph, t] {
+                for (std::uint32_t i = 0; i < kSteps; ++i) {
+                    graph.Require((i * 5 + t * 3) % kSteps);
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        graph.WaitBackground();
+        for (std::uint32_t i = 0; i < kSteps; ++i) {
+            if (counters.runs[i].load() != 1 || !graph.Done(i)) {
+                std::fprintf(stderr, "InitGraph: step %u ran %d times\n", i, counters.runs[i].load());
+                std::abort();
+            }
+        }
+    }
+
+    const bool kRegistered = [] {
+        MI::Bench::Register("InitGraph/Require/done", [](std::uint64_t iters) {
+            static MI::InitGraph graph;
+            static const bool ran = [] {
+                graph.Add("done", MI::InitGraph::Mode::kSync, [] { return true; });
+                graph.Run();
+                return true;
+            }();
+            bool ok = ran;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                ok &= graph.Require(0);
+            }
+            MI::Bench::DoNotOptimize(ok);
+        });
+
+        MI::Bench::Register("InitGraph/RunWithConcurrentRequire", [](std::uint64_t iters) {
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                RunGraph(3);
+            }
+        }, kSteps);
+        return true;
+    }();
+}
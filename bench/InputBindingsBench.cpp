@@ -0,0 +1,238 @@
+#include "Bench.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ModernInventory/InitGraph.h"
+#include "ModernInventory/InputBindings.h"
+#include "ModernInventory/SinkRegistry.h"
+
+// The input sink's filter over a synthetic event stream shaped like gameplay (mouse look,
+// thumbsticks, held movement keys, the odd key press): the scancode bitset against reading
+// both keys from the settings per button event (ConfigSys::Get, an InitGraph::Require each)
+// and comparing. items/s is events filtered per second. Cases abort if the two filters fire
+// different actions, or the sink registry attaches a sink twice or keeps one it no longer needs.
+
+namespace
+{
+    constexpr std::size_t   kEvents = 4096;
+    constexpr std::uint32_t kExportKey = 0x58;  // F12
+    constexpr std::uint32_t kToggleKey = 0x17;  // I
+
+    // Just enough of RE::InputEvent / ButtonEvent: a virtual chain walked per event
+    enum class EventType : std::uint8_t { kButton, kMouseMove, kThumbstick, kChar };
+    enum class Device : std::uint8_t { kKeyboard, kMouse, kGamepad };
+
+    struct InputEvent
+    {
+        virtual ~InputEvent() = default;
+        EventType   eventType{};
+        Device      device{};
+        InputEvent* next{};
+    };
+
+    struct ButtonEvent final : InputEvent
+    {
+        std::uint32_t idCode{};
+        float         value{}, heldDuration{};
+
+        bool IsDown() const { return value > 0.0f && heldDuration == 0.0f; }
+    };
+
+    struct Stream
+    {
+        std::vector<std::unique_ptr<InputEvent>> events;
+        InputEvent*                              head{};
+    };
+
+    std::unique_ptr<Stream> MakeStream()
+    {
+        static constexpr std::uint32_t kMovement[] = { 0x11, 0x1E, 0x1F, 0x20, 0x2A, 0x39 };  // W A S D shift space
+        auto           s = std::make_unique<Stream>();
+        MI::Bench::Rng rng;
+        for (std::size_t i = 0; i < kEvents; ++i) {
+            const auto roll = rng.Next() % 100;
+            if (roll < 40) {
+                auto e = std::make_unique<InputEvent>();
+                e->eventType = EventType::kMouseMove;
+                e->device = Device::kMouse;
+                s->events.push_back(std::move(e));
+            } else if (roll < 55) {
+                auto e = std::make_unique<InputEvent>();
+                e->eventType = EventType::kThumbstick;
+                e->device = Device::kGamepad;
+                s->events.push_back(std::move(e));
+            } else if (roll < 60) {
+                auto e = std::make_unique<InputEvent>();
+                e->eventType = EventType::kChar;
+                s->events.push_back(std::move(e));
+            } else {
+                auto e = std::make_unique<ButtonEvent>();
+                e->eventType = EventType::kButton;
+                e->device = roll < 65 ? Device::kMouse : Device::kKeyboard;
+                const auto k = rng.Next() % 100;
+                e->idCode = k < 2 ? kToggleKey : k < 4 ? kExportKey : k < 80 ? kMovement[rng.Next() % std::size(kMovement)] : rng.Next() % 256;
+                e->value = 1.0f;
+                e->heldDuration = rng.Next() % 4 == 0 ? 0.0f : 0.25f;  // mostly held
+                s->events.push_back(std::move(e));
+            }
+        }
+        for (std::size_t i = 0; i + 1 < s->events.size(); ++i) {
+            s->events[i]->next = s->events[i + 1].get();
+        }
+        s->head = s->events.front().get();
+        return s;
+    }
+
+    const Stream& SharedStream()
+    {
+        static const auto stream = MakeStream();
+        return *stream;
+    }
+
+    // The settings as the old sink read them: a finished lazy startup step per access
+    struct Settings
+    {
+        MI::InitGraph         graph;
+        MI::InitGraph::StepId config{};
+        int                   exportKey = kExportKey;
+        int                   toggleKey = kToggleKey;
+
+        Settings()
+        {
+            config = graph.Add("config", MI::InitGraph::Mode::kLazy, [] { return true; });
+            graph.Run();
+            graph.Require(config);
+        }
+
+        const Settings& Get()
+        {
+            graph.Require(config);
+            return *this;
+        }
+    };
+
+    struct Fired
+    {
+        std::uint32_t exports{}, prebuilds{};
+        bool operator==(const Fired&) const = default;
+    };
+
+    Fired FilterCompare(const InputEvent* head, Settings& settings)
+    {
+        Fired fired;
+        for (auto e = head; e; e = e->next) {
+            if (e->eventType != EventType::kButton) {
+                continue;
+            }
+            const auto* be = static_cast<const ButtonEvent*>(e);
+            if (be->device != Device::kKeyboard) {
+                continue;
+            }
+            const auto exportKey = settings.Get().exportKey;
+            if (exportKey != 0 && be->idCode == static_cast<std::uint32_t>(exportKey) && be->IsDown()) {
+                ++fired.exports;
+            }
+            if (be->idCode == static_cast<std::uint32_t>(settings.Get().toggleKey) && be->IsDown()) {
+                ++fired.prebuilds;
+            }
+        }
+        return fired;
+    }
+
+    Fired FilterBitset(const InputEvent* head, const MI::InputBindings& bindings)
+    {
+        Fired fired;
+        for (auto e = head; e; e = e->next) {
+            if (e->eventType != EventType::kButton) {
+                continue;
+            }
+            const auto* be = static_cast<const ButtonEvent*>(e);
+            if (be->device != Device::kKeyboard) {
+                continue;
+            }
+            const auto actions = bindings.Match(be->idCode);
+            if (actions == 0 || !be->IsDown()) {
+                continue;
+            }
+            fired.exports += (actions & MI::InputBindings::Bit(MI::InputAction::kExport)) != 0;
+            fired.prebuilds += (actions & MI::InputBindings::Bit(MI::InputAction::kPrebuild)) != 0;
+        }
+        return fired;
+    }
+
+    using MI::Bench::Expect;
+
+    const bool kRegistered = [] {
+        MI::Bench::Register("InputBindings/CompareSettings4096", [](std::uint64_t iters) {
+            static Settings settings;
+            const auto&     stream = SharedStream();
+            Fired           fired;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                fired = FilterCompare(stream.head, settings);
+                MI::Bench::DoNotOptimize(fired.exports);
+            }
+        }, static_cast<double>(kEvents));
+
+        auto checked = std::make_shared<bool>(false);
+        MI::Bench::Register("InputBindings/Bitset4096", [checked](std::uint64_t iters) {
+            const auto&       stream = SharedStream();
+            MI::InputBindings bindings;
+            bindings.Bind(MI::InputAction::kExport, kExportKey);
+            bindings.Bind(MI::InputAction::kPrebuild, kToggleKey);
+            Fired fired;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                fired = FilterBitset(stream.head, bindings);
+                MI::Bench::DoNotOptimize(fired.exports);
+            }
+            if (!std::exchange(*checked, true)) {
+                Settings settings;
+                Expect(fired == FilterCompare(stream.head, settings), "bitset fired different actions than the comparisons");
+                Expect(fired.exports > 0 && fired.prebuilds > 0, "stream has no bound key presses");
+
+                // Context: in the inventory only the export key passes
+                bindings.SetEnabled(MI::InputBindings::Bit(MI::InputAction::kExport));
+                const auto open = FilterBitset(stream.head, bindings);
+                Expect(open.exports == fired.exports && open.prebuilds == 0, "a disabled action still fired");
+
+                // Remapped: the old key is gone, the new one fires
+                bindings.SetEnabled(MI::InputBindings::kAll);
+                bindings.Rebind(MI::InputAction::kExport, 0x11);  // W, pressed far more often
+                const auto remapped = FilterBitset(stream.head, bindings);
+                Expect(remapped.exports > fired.exports && remapped.prebuilds == fired.prebuilds, "rebinding did not move the action");
+                Expect(bindings.Match(kExportKey) == 0 && bindings.KeyOf(MI::InputAction::kExport) == 0x11, "old binding left behind");
+
+                bindings.Rebind(MI::InputAction::kExport, 0);
+                bindings.SetEnabled(MI::InputBindings::Bit(MI::InputAction::kExport));
+                Expect(!bindings.Any(), "unbound context still wants the input sink");
+            }
+        }, static_cast<double>(kEvents));
+
+        // Menu open / close with the registry deciding whether the input sink is attached, plus
+        // the load messages re-asserting the always-on sinks
+        MI::Bench::Register("SinkRegistry/MenuCycle", [](std::uint64_t iters) {
+            constexpr MI::SinkRegistry::Reasons kKeysBound = 1;
+            int               attached[2] = {};
+            MI::SinkRegistry  sinks;
+            MI::InputBindings bindings;
+            const auto        hooks = [&attached](int i) {
+                return MI::SinkRegistry::Hooks{ [&attached, i] { return ++attached[i] == 1; }, [&attached, i] { --attached[i]; } };
+            };
+            const auto menu = sinks.Add("menu", hooks(0));
+            const auto input = sinks.Add("input", hooks(1));
+            bindings.Bind(MI::InputAction::kExport, kExportKey);  // no prebuild hotkey
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                sinks.Attach(menu);  // kPostLoadGame after kDataLoaded: already there
+                const bool open = i % 2 == 0;
+                bindings.SetEnabled(MI::InputBindings::Bit(open ? MI::InputAction::kExport : MI::InputAction::kPrebuild));
+                sinks.Need(input, kKeysBound, bindings.Any());
+                Expect(sinks.Attached(input) == open, "input sink attached without a usable key");
+            }
+            Expect(attached[0] == 1 && attached[1] == (iters % 2 ? 1 : 0), "a sink was added to its source twice");
+            const auto stats = sinks.GetStats();
+            Expect(stats.attaches == 1 + (iters + 1) / 2 && stats.failures == 0, "unexpected attach count");
+        });
+        return true;
+    }();
+}
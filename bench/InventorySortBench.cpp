@@ -0,0 +1,216 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ModernInventory/InventorySort.h"
+
+// Re-sorting a synthetic inventory of 1k / 10k / 100k items: std::stable_sort with comparators
+// that ask each item (a virtual call, like reading TESForm) and compare names as strings,
+// against packed 64-bit keys and the radix sorter. Patch re-keys 16 rows of 100k after an
+// equip / temper. Cases abort if the radix order differs from std::stable_sort's.
+
+namespace
+{
+    struct IForm
+    {
+        virtual ~IForm() = default;
+        virtual std::string_view Name() const = 0;
+        virtual float            Weight() const = 0;
+        virtual float            Value() const = 0;
+    };
+
+    struct Form final : IForm
+    {
+        std::string name;
+        float       weight{}, value{};
+        std::string_view Name() const override { return name; }
+        float            Weight() const override { return weight; }
+        float            Value() const override { return value; }
+    };
+
+    struct Inventory
+    {
+        std::vector<std::unique_ptr<Form>> forms;
+        std::vector<const IForm*>          items;  // what the comparators see
+        MI::SortColumns                    columns;
+        MI::NameCollation                  collation;
+    };
+
+    std::unique_ptr<Inventory> MakeInventory(std::size_t n)
+    {
+        static constexpr const char* kMaterial[] = { "Iron", "steel", "Elven", "Glass", "ebony", "Daedric", "Leather", "Hide" };
+        static constexpr const char* kPiece[] = { " Sword", " Dagger", " Bow", " Helmet", " Boots", " Gauntlets", " Armor", " shield" };
+        static constexpr const char* kSuffix[] = { "", " of Frost", " of Fire", " of Absorption", " of Binding" };
+        MI::Bench::Rng rng;
+        auto inv = std::make_unique<Inventory>();
+        std::vector<std::string> names;
+        for (std::size_t i = 0; i < n; ++i) {
+            auto form = std::make_unique<Form>();
+            form->name = std::string(kMaterial[rng.Next() % std::size(kMaterial)]) + kPiece[rng.Next() % std::size(kPiece)] +
+                         kSuffix[rng.Next() % std::size(kSuffix)];
+            if (rng.Next() % 4 == 0) {
+                form->name += " (" + std::to_string(rng.Next() % 50) + ")";  // enchanted / renamed copies
+            }
+            form->weight = rng.Next() % 10 == 0 ? 0.0f : rng.Uniform(0.1f, 50.0f);
+            form->value = static_cast<float>(rng.Next() % 5000);
+            names.push_back(form->name);
+            inv->items.push_back(form.get());
+            inv->forms.push_back(std::move(form));
+        }
+        inv->collation.Build(names);
+        for (const auto& form : inv->forms) {
+            inv->columns.nameRank.push_back(inv->collation.Rank(form->name));
+            inv->columns.weight.push_back(form->weight);
+            inv->columns.value.push_back(form->value);
+            inv->columns.category.push_back(0);
+        }
+        return inv;
+    }
+
+    // Built on a case's first call (calibration), so listing or filtering stays instant
+    Inventory& SharedInventory(std::size_t n)
+    {
+        static std::map<std::size_t, std::unique_ptr<Inventory>> cache;
+        auto& inv = cache[n];
+        if (!inv) {
+            inv = MakeInventory(n);
+        }
+        return *inv;
+    }
+
+    // Sorter, keys and the one-time order check kept across a case's calls
+    struct RadixState
+    {
+        std::unique_ptr<Inventory>           own;  // Patch mutates its items
+        std::unique_ptr<MI::InventorySorter> sorter;
+        std::vector<std::uint64_t>           keys;
+        bool                                 checked = false;
+    };
+
+    float ValuePerWeight(const IForm& f)
+    {
+        return f.Weight() > 0.0f ? f.Value() / f.Weight() : std::numeric_limits<float>::infinity();
+    }
+
+    // The comparator-per-sort baseline for each ordering
+    void StableSort(const Inventory& inv, bool byName, std::vector<std::uint32_t>& order)
+    {
+        order.resize(inv.items.size());
+        std::iota(order.begin(), order.end(), 0u);
+        const auto& forms = inv.items;
+        if (byName) {
+            std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+                return MI::NameCollation::Less(forms[a]->Name(), forms[b]->Name());
+            });
+        } else {
+            std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+                const auto va = ValuePerWeight(*forms[a]);
+                const auto vb = ValuePerWeight(*forms[b]);
+                if (va != vb) {
+                    return va > vb;
+                }
+                return MI::NameCollation::Less(forms[a]->Name(), forms[b]->Name());
+            });
+        }
+    }
+
+    MI::SortOrder OrderFor(bool byName)
+    {
+        return byName ? MI::SortOrder{ MI::SortField::kName, MI::SortField::kName, false }
+                      : MI::SortOrder{ MI::SortField::kValuePerWeight, MI::SortField::kName, true };
+    }
+
+    using MI::Bench::Expect;
+
+    const bool kRegistered = [] {
+        for (const std::size_t n : { 1'000u, 10'000u, 100'000u }) {
+            for (const bool byName : { true, false }) {
+                const std::string suffix = std::string(byName ? "/Name/" : "/ValuePerWeight/") + std::to_string(n);
+
+                MI::Bench::Register("InventorySort/StableSort" + suffix, [n, byName](std::uint64_t iters) {
+                    const auto& inv = SharedInventory(n);
+                    std::vector<std::uint32_t> order;
+                    for (std::uint64_t i = 0; i < iters; ++i) {
+                        StableSort(inv, byName, order);
+                        MI::Bench::DoNotOptimize(order.data());
+                    }
+                }, static_cast<double>(n));
+
+                // Keys packed on every sort: what a header click pays
+                auto state = std::make_shared<RadixState>();
+                MI::Bench::Register("InventorySort/Radix" + suffix, [n, byName, state](std::uint64_t iters) {
+                    const auto& inv = SharedInventory(n);
+                    if (!state->sorter) {
+                        state->sorter = std::make_unique<MI::InventorySorter>();
+                    }
+                    for (std::uint64_t i = 0; i < iters; ++i) {
+                        MI::PackSortKeys(inv.columns, OrderFor(byName), state->keys);
+                        MI::Bench::DoNotOptimize(state->sorter->Sort(state->keys).data());
+                    }
+                    if (!std::exchange(state->checked, true)) {
+                        std::vector<std::uint32_t> expected;
+                        StableSort(inv, byName, expected);
+                        Expect(state->sorter->Order() == expected, "radix order differs from std::stable_sort");
+                        if (n >= MI::InventorySorter::kParallelMin) {  // the pooled path, whatever the core count
+                            MI::InventorySorter pooled(3);
+                            Expect(pooled.Sort(state->keys) == expected, "pooled radix order differs from std::stable_sort");
+                        }
+                    }
+                }, static_cast<double>(n));
+            }
+        }
+
+        // Items change value (temper, enchant) between calls; the previous order is patched
+        auto patch = std::make_shared<RadixState>();
+        MI::Bench::Register("InventorySort/Patch16of100k", [patch](std::uint64_t iters) {
+            const auto order = OrderFor(false);
+            if (!patch->sorter) {
+                patch->own = MakeInventory(100'000);
+                patch->sorter = std::make_unique<MI::InventorySorter>();
+                MI::PackSortKeys(patch->own->columns, order, patch->keys);
+                patch->sorter->Sort(patch->keys);
+            }
+            auto& inv = *patch->own;
+            MI::Bench::Rng rng;
+            std::vector<std::uint32_t> changed(16);
+            const auto fallbacks = patch->sorter->GetStats().patchFallbacks;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                for (auto& row : changed) {
+                    row = rng.Next() % 100'000;
+                    inv.forms[row]->value = inv.columns.value[row] = static_cast<float>(rng.Next() % 5000);
+                }
+                MI::PackSortKeys(inv.columns, order, patch->keys);  // the caller re-packs: a linear pass
+                MI::Bench::DoNotOptimize(patch->sorter->Patch(patch->keys, changed).data());
+            }
+            Expect(patch->sorter->GetStats().patchFallbacks == fallbacks, "patch fell back to a full sort");
+            if (!std::exchange(patch->checked, true)) {
+                std::vector<std::uint32_t> expected;
+                StableSort(inv, false, expected);
+                Expect(patch->sorter->Order() == expected, "patched order differs from a full sort");
+            }
+        }, 100'000.0);
+
+        // The pool's share: the same sort on the calling thread only
+        auto single = std::make_shared<RadixState>();
+        MI::Bench::Register("InventorySort/Radix/ValuePerWeight/100000/1thread", [single](std::uint64_t iters) {
+            const auto& inv = SharedInventory(100'000);
+            if (!single->sorter) {
+                single->sorter = std::make_unique<MI::InventorySorter>(0);
+                MI::PackSortKeys(inv.columns, OrderFor(false), single->keys);
+            }
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                MI::Bench::DoNotOptimize(single->sorter->Sort(single->keys).data());
+            }
+            Expect(single->sorter->GetStats().passesSkipped > 0, "no digit pass was skipped");
+        }, 100'000.0);
+        return true;
+    }();
+}
@@ -0,0 +1,287 @@
+#include "Bench.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ModernInventory/ItemFilter.h"
+
+// Filter chips over a 100k-row synthetic inventory: the compiled bitset program (SSE2 AND /
+// OR / ANDNOT over per-term bitsets) against evaluating the same expression per item through
+// virtual calls and keyword scans, like asking each TESForm every frame. Cases abort if the
+// two disagree or an incremental update re-evaluates more blocks than the rows it touched.
+
+namespace
+{
+    constexpr std::size_t kItems = 100'000;
+
+    constexpr const char* kCategories[] = { "light armor", "heavy armor", "clothing", "one-handed",
+                                            "two-handed",  "bow",         "potion",   "misc" };
+    constexpr const char* kKeywords[] = { "ArmorHelmet",   "ArmorCuirass",   "ArmorBoots",    "ArmorGauntlets", "ArmorShield",
+                                          "MaterialIron",  "MaterialSteel",  "MaterialElven", "MaterialGlass",  "MaterialEbony",
+                                          "MaterialDaedric", "WeapTypeSword", "WeapTypeAxe",  "WeapTypeMace",   "WeapTypeDagger",
+                                          "VendorItemArmor", "VendorItemWeapon", "MagicDisallowEnchanting", "ClothingRich",
+                                          "ClothingPoor",  "JewelryExpensive", "ArmorJewelry", "Daedric Artifact", "Unique" };
+    constexpr const char* kFlags[] = { "enchanted", "stolen", "favorite", "equipped", "quest", "tempered" };
+    constexpr std::uint32_t kCategoryCount = static_cast<std::uint32_t>(std::size(kCategories));
+    constexpr std::uint32_t kKeywordCount = static_cast<std::uint32_t>(std::size(kKeywords));
+
+    constexpr const char* kChip = "light armor AND enchanted AND NOT stolen";
+    constexpr const char* kDeep =
+        "((light armor OR heavy armor) AND (ArmorHelmet OR ArmorCuirass OR ArmorBoots OR ArmorGauntlets) AND NOT (stolen OR quest))"
+        " OR (one-handed AND enchanted AND NOT (favorite AND equipped) AND (MaterialGlass OR MaterialEbony OR MaterialDaedric))"
+        " OR (bow AND tempered AND NOT MaterialIron) OR (clothing AND (ClothingRich OR JewelryExpensive) AND NOT ClothingPoor)"
+        " OR (NOT (potion OR misc) AND Unique AND NOT (Daedric Artifact AND stolen))";
+
+    // What a per-item predicate asks the form for
+    struct IItem
+    {
+        virtual ~IItem() = default;
+        virtual std::uint32_t Category() const = 0;
+        virtual bool          HasKeyword(std::uint32_t keyword) const = 0;
+        virtual bool          HasFlag(std::uint32_t flag) const = 0;
+    };
+
+    struct Item final : IItem
+    {
+        std::uint32_t              category{};
+        std::vector<std::uint32_t> keywords;
+        std::uint32_t              flags{};
+
+        std::uint32_t Category() const override { return category; }
+        bool HasKeyword(std::uint32_t keyword) const override
+        {
+            for (const auto k : keywords) {
+                if (k == keyword) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        bool HasFlag(std::uint32_t flag) const override { return (flags >> flag) & 1; }
+    };
+
+    // Term ids are registered categories, then keywords, then flags
+    struct Inventory
+    {
+        std::vector<std::unique_ptr<Item>> items;
+        MI::ItemBitsets                    bitsets;
+        std::vector<std::uint32_t>         scratch;
+
+        bool Has(const IItem& item, std::uint32_t term) const
+        {
+            if (term < kCategoryCount) {
+                return item.Category() == term;
+            }
+            if (term < kCategoryCount + kKeywordCount) {
+                return item.HasKeyword(term - kCategoryCount);
+            }
+            return item.HasFlag(term - kCategoryCount - kKeywordCount);
+        }
+
+        void Tag(std::size_t row)
+        {
+            const auto& item = *items[row];
+            scratch.assign({ item.category });
+            for (const auto k : item.keywords) {
+                scratch.push_back(kCategoryCount + k);
+            }
+            for (std::uint32_t f = 0; f < std::size(kFlags); ++f) {
+                if (item.HasFlag(f)) {
+                    scratch.push_back(kCategoryCount + kKeywordCount + f);
+                }
+            }
+            bitsets.SetRow(row, scratch);
+        }
+    };
+
+    std::unique_ptr<Item> RandomItem(MI::Bench::Rng& rng)
+    {
+        auto item = std::make_unique<Item>();
+        item->category = rng.Next() % kCategoryCount;
+        for (auto n = rng.Next() % 4; n > 0; --n) {
+            item->keywords.push_back(rng.Next() % kKeywordCount);
+        }
+        for (std::uint32_t f = 0; f < std::size(kFlags); ++f) {
+            item->flags |= (rng.Next() % 4 == 0 ? 1u : 0u) << f;
+        }
+        return item;
+    }
+
+    std::unique_ptr<Inventory> MakeInventory()
+    {
+        auto inv = std::make_unique<Inventory>();
+        for (const auto* name : kCategories) {
+            inv->bitsets.AddTerm(name);
+        }
+        for (const auto* name : kKeywords) {
+            inv->bitsets.AddTerm(name);
+        }
+        for (const auto* name : kFlags) {
+            inv->bitsets.AddTerm(name);
+        }
+        MI::Bench::Rng rng;
+        inv->bitsets.Resize(kItems);
+        for (std::size_t i = 0; i < kItems; ++i) {
+            inv->items.push_back(RandomItem(rng));
+            inv->Tag(i);
+        }
+        return inv;
+    }
+
+    // Built on first use so listing and filtering the benchmarks stays instant
+    Inventory& SharedInventory()
+    {
+        static auto inv = MakeInventory();
+        return *inv;
+    }
+
+    // The same postfix program, one item at a time
+    std::size_t PerItem(const Inventory& inv, const MI::FilterProgram& program, std::vector<std::uint8_t>& out)
+    {
+        using Op = MI::FilterProgram::Op;
+        out.resize(inv.items.size());
+        std::size_t count = 0;
+        bool        stack[32];
+        for (std::size_t r = 0; r < inv.items.size(); ++r) {
+            const auto& item = *inv.items[r];
+            std::size_t sp = 0;
+            for (const auto& step : program.steps) {
+                switch (step.op) {
+                case Op::kTerm: stack[sp++] = inv.Has(item, step.term); break;
+                case Op::kAll: stack[sp++] = true; break;
+                case Op::kAnd: --sp; stack[sp - 1] = stack[sp - 1] && stack[sp]; break;
+                case Op::kOr: --sp; stack[sp - 1] = stack[sp - 1] || stack[sp]; break;
+                case Op::kAndNot: --sp; stack[sp - 1] = stack[sp - 1] && !stack[sp]; break;
+                case Op::kNot: stack[sp - 1] = !stack[sp - 1]; break;
+                case Op::kAndTerm: stack[sp - 1] = stack[sp - 1] && inv.Has(item, step.term); break;
+                case Op::kOrTerm: stack[sp - 1] = stack[sp - 1] || inv.Has(item, step.term); break;
+                case Op::kAndNotTerm: stack[sp - 1] = stack[sp - 1] && !inv.Has(item, step.term); break;
+                }
+            }
+            out[r] = stack[0];
+            count += stack[0];
+        }
+        return count;
+    }
+
+    using MI::Bench::Expect;
+
+    MI::FilterProgram CompileOrDie(const char* text, const MI::ItemBitsets& bitsets)
+    {
+        MI::FilterProgram program;
+        std::string       error;
+        if (!MI::FilterProgram::Compile(text, bitsets, program, &error)) {
+            std::fprintf(stderr, "ItemFilter: '%s': %s\n", text, error.c_str());
+            std::abort();
+        }
+        return program;
+    }
+
+    const bool kRegistered = [] {
+        for (const auto& [label, text] : { std::pair{ "Chip", kChip }, std::pair{ "Deep", kDeep } }) {
+            const char* expr = text;
+
+            // A chip toggled: the whole list re-filtered from the bitsets
+            auto checked = std::make_shared<bool>(false);
+            MI::Bench::Register(std::string("ItemFilter/Bitset/") + label + "100k", [expr, checked](std::uint64_t iters) {
+                const auto& inv = SharedInventory();
+                const auto program = CompileOrDie(expr, inv.bitsets);
+                MI::FilterView view;
+                for (std::uint64_t i = 0; i < iters; ++i) {
+                    view.Set(program);
+                    view.Update(inv.bitsets);
+                    MI::Bench::DoNotOptimize(view.Count());
+                }
+                if (!std::exchange(*checked, true)) {
+                    std::vector<std::uint8_t> expected;
+                    Expect(PerItem(inv, program, expected) == view.Count(), "bitset count differs from the per-item filter");
+                    for (std::size_t r = 0; r < kItems; ++r) {
+                        Expect(view.Matches(r) == (expected[r] != 0), "bitset rows differ from the per-item filter");
+                    }
+                }
+            }, static_cast<double>(kItems));
+
+            MI::Bench::Register(std::string("ItemFilter/PerItem/") + label + "100k", [expr](std::uint64_t iters) {
+                const auto& inv = SharedInventory();
+                const auto program = CompileOrDie(expr, inv.bitsets);
+                std::vector<std::uint8_t> out;
+                for (std::uint64_t i = 0; i < iters; ++i) {
+                    MI::Bench::DoNotOptimize(PerItem(inv, program, out));
+                }
+            }, static_cast<double>(kItems));
+        }
+
+        // Counts on every chip for the current filter
+        MI::Bench::Register("ItemFilter/Badges16of100k", [](std::uint64_t iters) {
+            const auto& inv = SharedInventory();
+            MI::FilterView view;
+            view.Set(CompileOrDie(kDeep, inv.bitsets));
+            view.Update(inv.bitsets);
+            std::vector<std::uint32_t> chips;
+            for (std::uint32_t t = 0; t < 16; ++t) {
+                chips.push_back(t * 2);
+            }
+            std::vector<std::size_t> counts(chips.size());
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                view.Badges(inv.bitsets, chips, counts);
+                MI::Bench::DoNotOptimize(counts.data());
+            }
+            std::size_t sum = 0;
+            for (std::uint32_t c = 0; c < kCategoryCount; ++c) {
+                std::size_t n = 0;
+                view.Badges(inv.bitsets, std::span(&c, 1), std::span(&n, 1));
+                sum += n;
+            }
+            Expect(sum == view.Count(), "category badges do not add up to the filter count");
+        }, 16.0 * kItems);
+
+        // A few items change (picked up, enchanted) between frames: only their blocks re-run
+        struct Retag
+        {
+            std::unique_ptr<Inventory> inv;  // its own: items are replaced
+            MI::FilterProgram          program;
+            MI::FilterView             view;
+            MI::Bench::Rng             rng;
+            bool                       checked = false;
+        };
+        auto retag = std::make_shared<Retag>();
+        MI::Bench::Register("ItemFilter/Retag8Update100k", [retag](std::uint64_t iters) {
+            if (!retag->inv) {
+                retag->inv = MakeInventory();
+                retag->program = CompileOrDie(kDeep, retag->inv->bitsets);
+                retag->view.Set(retag->program);
+                retag->view.Update(retag->inv->bitsets);
+            }
+            auto&       inv = *retag->inv;
+            std::size_t blocks = 0;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                for (int k = 0; k < 8; ++k) {
+                    const auto row = retag->rng.Next() % kItems;
+                    inv.items[row] = RandomItem(retag->rng);
+                    inv.Tag(row);
+                }
+                blocks += retag->view.Update(inv.bitsets);
+            }
+            Expect(blocks <= iters * 8, "an update re-evaluated blocks nothing changed in");
+            if (!std::exchange(retag->checked, true)) {
+                std::vector<std::uint8_t> expected;
+                Expect(PerItem(inv, retag->program, expected) == retag->view.Count(), "incremental count drifted from a full filter");
+            }
+        }, 8.0);
+
+        MI::Bench::Register("ItemFilter/CompileDeep", [](std::uint64_t iters) {
+            const auto& inv = SharedInventory();
+            MI::FilterProgram program;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                MI::FilterProgram::Compile(kDeep, inv.bitsets, program);
+                MI::Bench::DoNotOptimize(program.steps.data());
+            }
+            Expect(program.depth <= 4, "term operands were pushed instead of read in place");
+        });
+        return true;
+    }();
+}
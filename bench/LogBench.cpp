@@ -0,0 +1,58 @@
+#include "Bench.h"
+
+#if MI_BENCH_HAS_SPDLOG
+
+#include <memory>
+#include <string>
+
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+
+namespace
+{
+    // Same logger shape as Log::Init, but with a null sink so only the logging path is timed.
+    void UseNullLogger()
+    {
+        static const bool installed = [] {
+            auto logger = std::make_shared<spdlog::logger>("ModernInventory", std::make_shared<spdlog::sinks::null_sink_mt>());
+            spdlog::set_default_logger(logger);
+            spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
+            return true;
+        }();
+        (void)installed;
+    }
+
+    const bool kRegistered = [] {
+        // Log::Info / Log::Warn forward a string_view through "{}"
+        MI::Bench::Register("Log/Info", [](std::uint64_t iters) {
+            UseNullLogger();
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                spdlog::info("{}", std::string_view{ "PreviewGraph clone failed; falling back." });
+            }
+        });
+
+        // The per-frame camera line built by PreviewRenderer::RenderTo
+        MI::Bench::Register("Log/CameraLine", [](std::uint64_t iters) {
+            UseNullLogger();
+            const float fov = 50.0f, yaw = 180.0f, pitch = 0.0f;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                const float dist = 250.0f + static_cast<float>(i & 15);
+                spdlog::info("{}", std::string("Preview cam fov=") + std::to_string(fov) +
+                                       std::string(" dist=") + std::to_string(dist) +
+                                       std::string(" yaw=") + std::to_string(yaw) +
+                                       std::string(" pitch=") + std::to_string(pitch));
+            }
+        });
+
+        // Below the logger level: cost of a filtered-out call
+        MI::Bench::Register("Log/Filtered", [](std::uint64_t iters) {
+            UseNullLogger();
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                spdlog::debug("{}", std::string_view{ "not emitted" });
+            }
+        });
+        return true;
+    }();
+}
+
+#endif
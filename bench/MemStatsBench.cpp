@@ -0,0 +1,64 @@
+#include "Bench.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ModernInventory/MemStats.h"
+
+namespace
+{
+    // Every thread allocates and releases on the same counter (the render thread, the
+    // exporter workers and the SoftRaster pool all report); afterwards current must be back
+    // to zero and the peak within what the threads could have held together.
+    void Contend(MI::MemCounter& counter, unsigned threads, std::uint64_t iters)
+    {
+        constexpr std::int64_t kBytes = 4096;
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&counter, iters] {
+                for (std::uint64_t i = 0; i < iters; ++i) {
+                    counter.Add(kBytes);
+                    counter.Add(-kBytes);
+                }
+            });
+        }
+        for (auto& t : pool) {
+            t.join();
+        }
+        if (counter.Current() != 0 || counter.Peak() > kBytes * threads) {
+            std::fprintf(stderr, "MemStats: inconsistent after contention (current %lld, peak %lld)\n",
+                         static_cast<long long>(counter.Current()), static_cast<long long>(counter.Peak()));
+            std::abort();
+        }
+    }
+
+    const bool kRegistered = [] {
+        auto& single = MI::MemStats::Register("bench/single", MI::MemKind::kCpu);
+        MI::Bench::Register("MemStats/AddRelease/1thread", [&single](std::uint64_t iters) {
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                single.Add(1024);
+                single.Add(-1024);
+            }
+            MI::Bench::DoNotOptimize(single.Current());
+        });
+
+        for (const unsigned threads : { 4u, 16u }) {
+            auto& counter = MI::MemStats::Register(threads == 4 ? "bench/contended4" : "bench/contended16", MI::MemKind::kCpu);
+            MI::Bench::Register("MemStats/AddRelease/" + std::to_string(threads) + "threads", [&counter, threads](std::uint64_t iters) {
+                Contend(counter, threads, iters);
+            }, threads);
+        }
+
+        MI::Bench::Register("MemStats/Snapshot", [](std::uint64_t iters) {
+            std::vector<MI::MemStats::Entry> entries;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                MI::MemStats::Snapshot(entries);
+                MI::Bench::DoNotOptimize(entries.data());
+            }
+        });
+        return true;
+    }();
+}
@@ -0,0 +1,127 @@
+#include "Bench.h"
+
+#include <vector>
+
+#include "ModernInventory/MultiView.h"
+
+// Scheduling cost of a four-view preview pass against a fake backend that counts target binds,
+// clears and draws. Each case aborts when the pass does more GPU work than it should: more than
+// one bind per frame, redrawing clean views, or clearing outside the changed tiles.
+
+namespace
+{
+    constexpr float kPi = 3.14159265f;
+
+    struct CountingBackend final : MI::IMultiViewBackend
+    {
+        bool          partialClears = true;
+        std::uint64_t binds = 0, fullClears = 0, rectClears = 0, draws = 0;
+
+        bool BeginPass() override { ++binds; return true; }
+        void ClearTarget() override { ++fullClears; }
+        bool ClearRect(const MI::ViewRect&) override
+        {
+            rectClears += partialClears;
+            return partialClears;
+        }
+        bool DrawView(const MI::ViewRect& rect, const MI::PreviewView& view) override
+        {
+            ++draws;
+            MI::Bench::DoNotOptimize(rect);
+            MI::Bench::DoNotOptimize(view);
+            return true;
+        }
+    };
+
+    std::vector<MI::PreviewView> FourViews(float yaw)
+    {
+        std::vector<MI::PreviewView> views;
+        for (std::uint32_t i = 0; i < 4; ++i) {
+            views.push_back({ 0, yaw + i * kPi * 0.5f, 0.1f, 140.0f });
+        }
+        return views;
+    }
+
+    using MI::Bench::Expect;
+
+    const bool kRegistered = [] {
+        // Nothing changed: no bind, no draw
+        MI::Bench::Register("MultiView/IdleFrame", [](std::uint64_t iters) {
+            CountingBackend gpu;
+            MI::MultiViewPass pass;
+            pass.SetTargetSize(1024, 768);
+            pass.SetVariantGeneration(0, 1);
+            const auto views = FourViews(0.0f);
+            pass.SetViews(views);
+            pass.Render(gpu);
+            Expect(gpu.binds == 1 && gpu.fullClears == 1 && gpu.draws == 4, "first frame must clear once and draw all");
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                pass.SetViews(views);
+                pass.Render(gpu);
+            }
+            Expect(gpu.binds == 1 && gpu.draws == 4, "idle frames touched the target");
+        });
+
+        // Dragging the camera: every view changes, still one bind per frame
+        MI::Bench::Register("MultiView/DragFrame", [](std::uint64_t iters) {
+            CountingBackend gpu;
+            MI::MultiViewPass pass;
+            pass.SetTargetSize(1024, 768);
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                pass.SetViews(FourViews(static_cast<float>(i) * 0.01f));
+                pass.Render(gpu);
+            }
+            Expect(gpu.binds == iters && gpu.draws == iters * 4, "drag frame is not one bind + four draws");
+            Expect(gpu.fullClears == 1 && gpu.rectClears == (iters - 1) * 4, "drag frame cleared outside its tiles");
+        }, 4.0);
+
+        // One candidate view changes: one bind, one tile cleared and drawn
+        MI::Bench::Register("MultiView/OneViewChanged", [](std::uint64_t iters) {
+            CountingBackend gpu;
+            MI::MultiViewPass pass;
+            pass.SetTargetSize(1024, 768);
+            auto views = FourViews(0.0f);
+            pass.SetViews(views);
+            pass.Render(gpu);
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                views[2].pitchRad = static_cast<float>(i % 7) * 0.05f + 0.2f;
+                pass.SetViews(views);
+                pass.Render(gpu);
+            }
+            Expect(gpu.binds == iters + 1 && gpu.draws == iters + 4 && gpu.rectClears == iters,
+                   "a single changed view redrew others");
+        });
+
+        // Variant rebuilt (equip) on a backend without partial clears: whole target, all views
+        MI::Bench::Register("MultiView/VariantRebuildNoPartialClear", [](std::uint64_t iters) {
+            CountingBackend gpu;
+            gpu.partialClears = false;
+            MI::MultiViewPass pass;
+            pass.SetTargetSize(1024, 768);
+            auto views = FourViews(0.0f);
+            views[1].variant = views[3].variant = 1;
+            pass.SetViews(views);
+            pass.Render(gpu);
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                pass.SetVariantGeneration(1, i + 1);
+                pass.Render(gpu);
+            }
+            Expect(gpu.binds == iters + 1 && gpu.fullClears == iters + 1 && gpu.draws == (iters + 1) * 4,
+                   "fallback without partial clears must redraw every view");
+        });
+
+        MI::Bench::Register("MultiView/Layout", [](std::uint64_t iters) {
+            std::vector<MI::ViewRect> rects;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                MI::MultiViewPass::Layout(1 + i % 6, 1024, 768, rects);
+                MI::Bench::DoNotOptimize(rects.data());
+            }
+            MI::MultiViewPass::Layout(2, 1004, 768, rects);
+            Expect(rects[0] == MI::ViewRect{ 0, 0, 500, 768 } && rects[1] == MI::ViewRect{ 504, 0, 500, 768 },
+                   "two views are not side by side");
+            MI::MultiViewPass::Layout(4, 1004, 768, rects);
+            Expect(rects[3] == MI::ViewRect{ 504, 386, 500, 382 }, "four views are not a 2x2 grid");
+        });
+        return true;
+    }();
+}
@@ -0,0 +1,127 @@
+#include "Bench.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ModernInventory/OverlayRegistry.h"
+
+namespace
+{
+    // Callbacks log their priority; the dispatch order must never go backwards.
+    struct Probe
+    {
+        std::int32_t         priority{};
+        std::vector<std::int32_t>* trace{};
+    };
+
+    void Record(void* user)
+    {
+        auto* p = static_cast<Probe*>(user);
+        p->trace->push_back(p->priority);
+    }
+
+    void Count(void* user)
+    {
+        ++*static_cast<std::uint64_t*>(user);
+    }
+
+    void CheckOrder(const std::vector<std::int32_t>& trace)
+    {
+        for (std::size_t i = 1; i < trace.size(); ++i) {
+            if (trace[i] < trace[i - 1]) {
+                std::fprintf(stderr, "OverlayRegistry: priority %d dispatched after %d\n", trace[i], trace[i - 1]);
+                std::abort();
+            }
+        }
+    }
+
+    // Frame-by-frame dispatch while another thread keeps registering / unregistering
+    // overlays with random priorities (plugins loading late, menus opening).
+    struct Churn
+    {
+        MI::OverlayRegistry       registry;
+        std::vector<Probe>        probes;
+        std::vector<std::int32_t> trace;
+        std::atomic<bool>         stop{ false };
+        std::thread               writer;
+
+        Churn() : probes(48)
+        {
+            trace.reserve(MI::OverlayRegistry::kCapacity);
+            for (std::size_t i = 0; i < probes.size(); ++i) {
+                probes[i] = { static_cast<std::int32_t>(i % 7) - 3, &trace };
+                if (i < 16) {
+                    registry.Register("static", probes[i].priority, &Record, &probes[i]);
+                }
+            }
+            writer = std::thread([this] {
+                MI::Bench::Rng rng;
+                std::vector<MI::OverlayRegistry::Handle> live;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    if (live.size() < 24 && (live.empty() || rng.Next() % 2)) {
+                        auto& p = probes[16 + rng.Next() % 32];
+                        if (const auto h = registry.Register("churn", p.priority, &Record, &p)) {
+                            live.push_back(h);
+                        }
+                    } else {
+                        const auto i = rng.Next() % live.size();
+                        if (!registry.Unregister(live[i])) {
+                            std::fprintf(stderr, "OverlayRegistry: live handle rejected\n");
+                            std::abort();
+                        }
+                        live[i] = live.back();
+                        live.pop_back();
+                    }
+                }
+            });
+        }
+
+        ~Churn()
+        {
+            stop = true;
+            writer.join();
+        }
+    };
+
+    const bool kRegistered = [] {
+        for (const std::uint32_t n : { 1u, 8u, 32u }) {
+            auto registry = std::make_shared<MI::OverlayRegistry>();
+            auto counter = std::make_shared<std::uint64_t>(0);
+            for (std::uint32_t i = 0; i < n; ++i) {
+                registry->Register("bench", static_cast<std::int32_t>(i % 5), &Count, counter.get());
+            }
+            MI::Bench::Register("OverlayRegistry/Dispatch/" + std::to_string(n) + "callbacks", [registry, counter](std::uint64_t iters) {
+                for (std::uint64_t i = 0; i < iters; ++i) {
+                    MI::Bench::DoNotOptimize(registry->Dispatch());
+                }
+                MI::Bench::DoNotOptimize(*counter);
+            }, n);
+        }
+
+        auto registry = std::make_shared<MI::OverlayRegistry>();
+        MI::Bench::Register("OverlayRegistry/RegisterUnregister", [registry](std::uint64_t iters) {
+            std::uint64_t sink = 0;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                const auto h = registry->Register("bench", static_cast<std::int32_t>(i & 7), &Count, &sink);
+                registry->Unregister(h);
+            }
+            MI::Bench::DoNotOptimize(sink);
+        });
+
+        // Created on first use so the writer thread only runs while this case does
+        MI::Bench::Register("OverlayRegistry/Dispatch/withConcurrentRegistration", [](std::uint64_t iters) {
+            static Churn churn;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                churn.trace.clear();
+                churn.registry.Dispatch();
+                CheckOrder(churn.trace);
+            }
+        });
+        return true;
+    }();
+}
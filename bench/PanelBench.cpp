@@ -0,0 +1,19 @@
+#include "Bench.h"
+
+#include "ModernInventory/PanelLayout.h"
+
+namespace
+{
+    const bool kRegistered = [] {
+        MI::Bench::Register("Panel/ComputeRightPanel", [](std::uint64_t iters) {
+            float acc = 0.0f;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                const float w = 1280.0f + static_cast<float>(i & 2047);
+                const auto r = MI::Panel::ComputeRightPanel(w, 1440.0f, 0.56f, 520.0f);
+                acc += r.x + r.w;
+            }
+            MI::Bench::DoNotOptimize(acc);
+        });
+        return true;
+    }();
+}
@@ -0,0 +1,46 @@
+#include "Bench.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ModernInventory/PoseBounds.h"
+
+namespace
+{
+    // Synthetic skeleton: random rotations/offsets and small per-bone spheres,
+    // roughly human-sized (bones spread over ~130 units).
+    void MakeSkeleton(std::size_t bones, std::vector<MI::Math::Xform>& world, std::vector<MI::Math::Sphere>& local)
+    {
+        MI::Bench::Rng rng;
+        world.resize(bones);
+        local.resize(bones);
+        for (std::size_t i = 0; i < bones; ++i) {
+            const float a = rng.Uniform(-3.14159f, 3.14159f);
+            auto& w = world[i];
+            w.rot[0][0] = std::cos(a); w.rot[0][1] = -std::sin(a);
+            w.rot[1][0] = std::sin(a); w.rot[1][1] = std::cos(a);
+            w.pos = { rng.Uniform(-40.0f, 40.0f), rng.Uniform(-20.0f, 20.0f), rng.Uniform(0.0f, 130.0f) };
+            w.scale = 1.0f;
+            local[i] = { { rng.Uniform(-3.0f, 3.0f), rng.Uniform(-3.0f, 3.0f), rng.Uniform(-3.0f, 3.0f) },
+                         (i % 7 == 0) ? 0.0f : rng.Uniform(2.0f, 15.0f) };
+        }
+    }
+
+    const bool kRegistered = [] {
+        for (std::size_t bones : { 100u, 200u, 300u }) {
+            auto world = std::make_shared<std::vector<MI::Math::Xform>>();
+            auto local = std::make_shared<std::vector<MI::Math::Sphere>>();
+            MakeSkeleton(bones, *world, *local);
+            MI::Bench::Register("PoseBounds/Compute/" + std::to_string(bones), [world, local](std::uint64_t iters) {
+                MI::Math::Sphere s{};
+                for (std::uint64_t i = 0; i < iters; ++i) {
+                    MI::PoseBounds::Compute(*world, *local, s);
+                    MI::Bench::DoNotOptimize(s);
+                }
+            }, static_cast<double>(bones));
+        }
+        return true;
+    }();
+}
@@ -0,0 +1,49 @@
+#include "Bench.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Mannequin.h"
+#include "ModernInventory/SoftRaster.h"
+
+namespace
+{
+    // Reference mannequin at preview sizes; single-threaded vs the default worker pool.
+    struct Scene
+    {
+        MI::SoftRaster::Mesh       mesh;
+        MI::SoftRaster::View       view;
+        MI::SoftRaster::Image      image;
+        MI::SoftRaster::Rasterizer raster;
+
+        Scene(unsigned w, unsigned h, unsigned workers) : raster(workers)
+        {
+            std::vector<MI::Math::Sphere> spheres;
+            MI::Raster::BuildMannequin(spheres);
+            for (const auto& s : spheres) {
+                mesh.AddSphere(s);
+            }
+            view = MI::Raster::MannequinView(static_cast<float>(w) / static_cast<float>(h));
+            image.Resize(w, h);
+        }
+    };
+
+    const bool kRegistered = [] {
+        struct Size { unsigned w, h; };
+        for (const Size size : { Size{ 256, 512 }, Size{ 512, 1024 } }) {
+            for (const unsigned workers : { 0u, MI::SoftRaster::Rasterizer::kAuto }) {
+                auto scene = std::make_shared<Scene>(size.w, size.h, workers);
+                const std::string name = "SoftRaster/Mannequin/" + std::to_string(size.w) + "x" + std::to_string(size.h) +
+                                         (workers == 0 ? "/1thread" : "/pool");
+                MI::Bench::Register(name, [scene](std::uint64_t iters) {
+                    for (std::uint64_t i = 0; i < iters; ++i) {
+                        scene->image.Clear(0);
+                        MI::Bench::DoNotOptimize(scene->raster.Draw(scene->mesh, scene->view, 0xFFA0B4C8u, scene->image));
+                    }
+                }, static_cast<double>(size.w) * size.h);
+            }
+        }
+        return true;
+    }();
+}
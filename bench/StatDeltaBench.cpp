@@ -0,0 +1,199 @@
+#include "Bench.h"
+
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "ModernInventory/StatDelta.h"
+
+// Equip comparison deltas for a 100k-row synthetic inventory: the SSE2 pass over the columns,
+// the same loop scalar, and a per-row virtual-call walk like reading each TESForm every frame.
+// The cached frame is what the panel pays between equips. Cases abort if the SIMD pass and the
+// scalar loop disagree.
+
+namespace
+{
+    constexpr std::size_t kItems = 100'000;
+
+    MI::ItemStats RandomItem(MI::Bench::Rng& rng)
+    {
+        MI::ItemStats item;
+        const auto pick = rng.Next() % 8;
+        if (pick < 5) {  // armor piece in one of the common slots
+            static constexpr std::uint32_t kSlots[] = { 1u << 0, 1u << 2, 1u << 3, 1u << 7, 1u << 9, 1u << 5, 1u << 6 };
+            item.slots = kSlots[rng.Next() % std::size(kSlots)];
+            item.kind = static_cast<MI::ItemKind>(1 + rng.Next() % 3);
+            item.base = rng.Uniform(0.0f, 60.0f);
+        } else if (pick < 7) {
+            item.slots = MI::StatDeltaEngine::kWeaponSlot;
+            item.kind = static_cast<MI::ItemKind>(4 + rng.Next() % 3);
+            item.base = rng.Uniform(4.0f, 30.0f);
+        }
+        item.bonus = rng.Next() % 4 == 0 ? rng.Uniform(1.0f, 8.0f) : 0.0f;
+        item.weight = rng.Uniform(0.1f, 50.0f);
+        item.value = rng.Uniform(1.0f, 3000.0f);
+        return item;
+    }
+
+    struct Inventory
+    {
+        std::vector<MI::ItemStats>             rows;
+        std::vector<MI::ItemStats>             worn;
+        std::array<float, MI::kItemKindCount> multipliers{ 0.0f, 1.25f, 1.4f, 1.0f, 1.6f, 1.5f, 1.3f };
+    };
+
+    Inventory MakeInventory()
+    {
+        MI::Bench::Rng rng;
+        Inventory inv;
+        for (std::size_t i = 0; i < kItems; ++i) {
+            inv.rows.push_back(RandomItem(rng));
+        }
+        for (const std::uint32_t slot : { 1u << 0, 1u << 2, 1u << 3, 1u << 7, 1u << 9 }) {  // helmet, cuirass, gauntlets, boots, shield
+            auto piece = RandomItem(rng);
+            piece.slots = slot;
+            piece.kind = MI::ItemKind::kHeavyArmor;
+            inv.worn.push_back(piece);
+        }
+        auto sword = RandomItem(rng);
+        sword.slots = MI::StatDeltaEngine::kWeaponSlot;
+        sword.kind = MI::ItemKind::kOneHanded;
+        inv.worn.push_back(sword);
+        return inv;
+    }
+
+    void Load(const Inventory& inv, MI::StatDeltaEngine& engine, std::uint64_t version)
+    {
+        auto& items = engine.EditItems();
+        items.Clear();
+        items.Reserve(inv.rows.size());
+        for (const auto& row : inv.rows) {
+            items.Add(row);
+        }
+        engine.SetEquipped(inv.worn, inv.multipliers, version);
+    }
+
+    // Per-row object walk: the cost of asking every form for its stats each frame
+    struct IItem
+    {
+        virtual ~IItem() = default;
+        virtual float         Rating(const std::array<float, MI::kItemKindCount>& m) const = 0;
+        virtual float         Weight() const = 0;
+        virtual float         Value() const = 0;
+        virtual std::uint32_t Slots() const = 0;
+    };
+
+    struct FormItem final : IItem
+    {
+        MI::ItemStats s;
+        explicit FormItem(const MI::ItemStats& stats) : s(stats) {}
+        float Rating(const std::array<float, MI::kItemKindCount>& m) const override
+        {
+            return s.base * m[static_cast<std::size_t>(s.kind)] + s.bonus;
+        }
+        float         Weight() const override { return s.weight; }
+        float         Value() const override { return s.value; }
+        std::uint32_t Slots() const override { return s.slots; }
+    };
+
+    using MI::Bench::Expect;
+
+    const bool kRegistered = [] {
+        // Full pass after an equip: every row re-evaluated with SSE2
+        MI::Bench::Register("StatDelta/Compute100k", [](std::uint64_t iters) {
+            const auto inv = MakeInventory();
+            MI::StatDeltaEngine engine;
+            Load(inv, engine, 1);
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                engine.SetEquipped(inv.worn, inv.multipliers, i + 2);
+                MI::Bench::DoNotOptimize(engine.Evaluate().rating.data());
+            }
+            Expect(engine.GetStats().evaluations == iters, "an equip change did not re-evaluate");
+
+            // Same columns through the scalar loop: lanes must match row for row
+            MI::StatDeltaColumns scalar;
+            MI::StatDeltaEngine::Equipped equipped;
+            equipped.multipliers = inv.multipliers;
+            equipped.count = inv.worn.size();
+            for (std::size_t j = 0; j < inv.worn.size(); ++j) {
+                const auto& w = inv.worn[j];
+                equipped.slots[j] = w.slots;
+                equipped.rating[j] = w.base * inv.multipliers[static_cast<std::size_t>(w.kind)] + w.bonus;
+                equipped.weight[j] = w.weight;
+                equipped.value[j] = w.value;
+            }
+            MI::StatDeltaEngine::Compute(engine.Items(), equipped, scalar, false);
+            const auto& simd = engine.Evaluate();
+            for (std::size_t r = 0; r < kItems; ++r) {
+                Expect(std::fabs(simd.rating[r] - scalar.rating[r]) < 1e-3f && std::fabs(simd.weight[r] - scalar.weight[r]) < 1e-3f &&
+                           std::fabs(simd.value[r] - scalar.value[r]) < 1e-2f,
+                       "SIMD and scalar deltas differ");
+            }
+        }, static_cast<double>(kItems));
+
+        MI::Bench::Register("StatDelta/Compute100kScalar", [](std::uint64_t iters) {
+            const auto inv = MakeInventory();
+            MI::StatDeltaEngine engine;
+            Load(inv, engine, 1);
+            MI::StatDeltaEngine::Equipped equipped;
+            equipped.multipliers = inv.multipliers;
+            equipped.count = inv.worn.size();
+            for (std::size_t j = 0; j < inv.worn.size(); ++j) {
+                equipped.slots[j] = inv.worn[j].slots;
+                equipped.rating[j] = inv.worn[j].base;
+            }
+            MI::StatDeltaColumns out;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                MI::StatDeltaEngine::Compute(engine.Items(), equipped, out, false);
+                MI::Bench::DoNotOptimize(out.rating.data());
+            }
+        }, static_cast<double>(kItems));
+
+        MI::Bench::Register("StatDelta/PerRowVirtual100k", [](std::uint64_t iters) {
+            const auto inv = MakeInventory();
+            std::vector<std::unique_ptr<IItem>> items;
+            for (const auto& row : inv.rows) {
+                items.push_back(std::make_unique<FormItem>(row));
+            }
+            std::vector<std::unique_ptr<IItem>> worn;
+            for (const auto& piece : inv.worn) {
+                worn.push_back(std::make_unique<FormItem>(piece));
+            }
+            std::vector<MI::StatDelta> out(items.size());
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                for (std::size_t r = 0; r < items.size(); ++r) {
+                    const auto& item = *items[r];
+                    MI::StatDelta d{ item.Rating(inv.multipliers), item.Weight(), item.Value() };
+                    for (const auto& w : worn) {
+                        if (item.Slots() & w->Slots()) {
+                            d.rating -= w->Rating(inv.multipliers);
+                            d.weight -= w->Weight();
+                            d.value -= w->Value();
+                        }
+                    }
+                    out[r] = d;
+                }
+                MI::Bench::DoNotOptimize(out.data());
+            }
+        }, static_cast<double>(kItems));
+
+        // Frames between equips: the panel reads the visible rows from the cached pass
+        MI::Bench::Register("StatDelta/CachedFrame", [](std::uint64_t iters) {
+            const auto inv = MakeInventory();
+            MI::StatDeltaEngine engine;
+            Load(inv, engine, 1);
+            float sum = 0.0f;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                engine.SetEquipped(inv.worn, inv.multipliers, 1);
+                const auto first = static_cast<std::size_t>(i * 7 % (kItems - 20));
+                for (std::size_t r = first; r < first + 20; ++r) {
+                    sum += engine.At(r).rating;
+                }
+            }
+            MI::Bench::DoNotOptimize(sum);
+            Expect(engine.GetStats().evaluations == 1, "an unchanged version re-evaluated");
+        });
+        return true;
+    }();
+}
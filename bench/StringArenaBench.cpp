@@ -0,0 +1,208 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ModernInventory/InventorySort.h"
+#include "ModernInventory/StringArena.h"
+
+// Names of a 100k-row synthetic inventory (about 13k distinct, some non-ASCII): interning them
+// into the arena against copying each into a std::string on every list change, then what the
+// list does with them per frame (text lengths, search). Cases abort if the arena takes more
+// than half the memory of the std::string copies, allocates on a session rebuild once warm,
+// or ranks names differently from NameCollation.
+
+namespace
+{
+    constexpr std::size_t kRows = 100'000;
+
+    std::vector<std::string> MakeNames()
+    {
+        static constexpr const char* kMaterial[] = { "Iron", "Steel", "Elven", "Glass", "Ebony", "Daedric", "Leather", "Épée de fer", "Ørskt" };
+        static constexpr const char* kPiece[] = { " Sword", " Dagger", " War Axe", " Helmet", " Boots", " Gauntlets", " Armor", " Shield" };
+        static constexpr const char* kSuffix[] = { "", " of Frost", " of Fire", " of Absorption", " of the Vampire", " of Binding" };
+        MI::Bench::Rng           rng;
+        std::vector<std::string> names;
+        names.reserve(kRows);
+        for (std::size_t i = 0; i < kRows; ++i) {
+            auto name = std::string(kMaterial[rng.Next() % std::size(kMaterial)]) + kPiece[rng.Next() % std::size(kPiece)] +
+                        kSuffix[rng.Next() % std::size(kSuffix)];
+            if (rng.Next() % 2 == 0) {
+                name += " (" + std::to_string(rng.Next() % 30) + ")";  // renamed / charged copies
+            }
+            names.push_back(std::move(name));
+        }
+        return names;
+    }
+
+    const std::vector<std::string>& Names()
+    {
+        static const auto names = MakeNames();
+        return names;
+    }
+
+    // Interned once, shared by the per-frame cases
+    struct Interned
+    {
+        MI::StringArena               arena;
+        std::vector<MI::StringHandle> rows;
+    };
+
+    Interned& SharedInterned()
+    {
+        static const auto interned = [] {
+            auto s = std::make_unique<Interned>();
+            for (const auto& name : Names()) {
+                s->rows.push_back(s->arena.Intern(name));
+            }
+            return s;
+        }();
+        return *interned;
+    }
+
+    // Heap behind a vector of std::string copies (SSO strings live in the vector itself)
+    std::size_t StdStringBytes(const std::vector<std::string>& strings)
+    {
+        std::size_t bytes = strings.capacity() * sizeof(std::string);
+        for (const auto& s : strings) {
+            bytes += s.capacity() > 15 ? s.capacity() + 1 : 0;
+        }
+        return bytes;
+    }
+
+    using MI::Bench::Expect;
+
+    const bool kRegistered = [] {
+        // The list changed: every row's name fetched again
+        MI::Bench::Register("StringArena/StdStringCopies100k", [](std::uint64_t iters) {
+            const auto& names = Names();
+            std::vector<std::string> rows;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                rows.clear();
+                rows.shrink_to_fit();  // a rebuilt model starts empty
+                for (const auto& name : names) {
+                    rows.emplace_back(std::string_view(name));
+                }
+                MI::Bench::DoNotOptimize(rows.data());
+            }
+        }, static_cast<double>(kRows));
+
+        MI::Bench::Register("StringArena/Intern100k", [](std::uint64_t iters) {
+            const auto& names = Names();
+            MI::StringArena arena;
+            std::vector<MI::StringHandle> rows(kRows);
+            std::size_t warm = 0;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                arena.Clear();  // new session
+                for (std::size_t r = 0; r < kRows; ++r) {
+                    rows[r] = arena.Intern(names[r]);
+                }
+                MI::Bench::DoNotOptimize(rows.data());
+                if (i == 0) {
+                    warm = arena.Bytes();
+                }
+            }
+            Expect(arena.Bytes() == warm, "a warm session rebuild grew the arena");
+
+            std::vector<std::string> copies(names.begin(), names.end());
+            Expect(arena.Bytes() * 2 <= StdStringBytes(copies), "arena is not half the size of std::string copies");
+            for (std::size_t r = 0; r < kRows; r += 97) {
+                Expect(arena.View(rows[r]) == names[r] && arena.CStr(rows[r])[names[r].size()] == '\0', "interned text differs");
+            }
+        }, static_cast<double>(kRows));
+
+        // Per frame: the visible rows' text and lengths (ImGui draws from begin/end pointers)
+        MI::Bench::Register("StringArena/RowText100k", [](std::uint64_t iters) {
+            const auto& [arena, rows] = SharedInterned();
+            std::size_t sum = 0;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                for (const auto h : rows) {
+                    sum += arena.Length(h) + arena.View(h).size();
+                }
+            }
+            MI::Bench::DoNotOptimize(sum);
+        }, static_cast<double>(kRows));
+
+        // Search box: case-insensitive substring over every row
+        MI::Bench::Register("StringArena/Search100k", [](std::uint64_t iters) {
+            const auto& [arena, rows] = SharedInterned();
+            std::vector<MI::StringHandle> hits;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                arena.Search(i % 2 ? "of frost" : "iron", rows, hits);
+                MI::Bench::DoNotOptimize(hits.data());
+            }
+        }, static_cast<double>(kRows));
+
+        MI::Bench::Register("StringArena/SearchStdString100k", [](std::uint64_t iters) {
+            const auto& names = Names();
+            std::vector<std::size_t> hits;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                const std::string needle = i % 2 ? "of frost" : "iron";
+                hits.clear();
+                for (std::size_t r = 0; r < names.size(); ++r) {
+                    std::string lower = names[r];
+                    std::transform(lower.begin(), lower.end(), lower.begin(),
+                                   [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; });
+                    if (lower.find(needle) != std::string::npos) {
+                        hits.push_back(r);
+                    }
+                }
+                MI::Bench::DoNotOptimize(hits.data());
+            }
+        }, static_cast<double>(kRows));
+
+        // End of session: half the items are gone, the survivors are re-packed
+        MI::Bench::Register("StringArena/CompactHalf", [](std::uint64_t iters) {
+            const auto& names = Names();
+            MI::StringArena arena;
+            std::vector<MI::StringHandle> live;
+            std::size_t freed = 0;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                arena.Clear();
+                live.clear();
+                for (std::size_t r = 0; r < kRows; ++r) {
+                    const auto h = arena.Intern(names[r]);
+                    if (r % 2 == 0) {
+                        live.push_back(h);
+                    }
+                }
+                freed += arena.Compact(live);
+            }
+            Expect(freed > 0, "compaction released nothing");
+            for (std::size_t r = 0; r < kRows; r += 2 * 89) {
+                Expect(arena.View(live[r / 2]) == names[r], "compaction remapped a handle to another string");
+            }
+        }, static_cast<double>(kRows));
+
+        // Ranks feed SortColumns::nameRank: same order as NameCollation
+        auto ranked = std::make_shared<Interned>();
+        MI::Bench::Register("StringArena/UpdateRanks", [ranked](std::uint64_t iters) {
+            const auto& names = Names();
+            auto& [arena, rows] = *ranked;
+            const bool first = rows.empty();
+            if (first) {
+                for (const auto& name : names) {
+                    rows.push_back(arena.Intern(name));
+                }
+            }
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                arena.Intern("Gold Ring (" + std::to_string(arena.Size()) + ")");  // a new name dirties the ranks
+                arena.UpdateRanks();
+                MI::Bench::DoNotOptimize(arena.Rank(rows[0]));
+            }
+            if (first) {
+                MI::NameCollation collation;
+                collation.Build(names);
+                for (std::size_t r = 1; r < kRows; r += 31) {
+                    const bool arenaLess = arena.Rank(rows[r - 1]) < arena.Rank(rows[r]);
+                    const bool collationLess = collation.Rank(names[r - 1]) < collation.Rank(names[r]);
+                    Expect(arenaLess == collationLess, "arena ranks disagree with NameCollation");
+                }
+            }
+        });
+        return true;
+    }();
+}
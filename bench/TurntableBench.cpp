@@ -0,0 +1,185 @@
+#include "Bench.h"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ModernInventory/Turntable.h"
+
+// Turntable atlas bookkeeping: bake scheduling (nearest frame to the current yaw first) and the
+// per-frame tile lookup while the user turns the preview. Cases abort if the bake order moves
+// away from the yaw and back, a lookup picks the wrong neighbours or blend weight (including
+// across the 0 / 2 pi seam), a key change leaves tiles marked baked, or a non-finite yaw
+// yields a frame outside the atlas.
+
+namespace
+{
+    constexpr std::uint32_t kFrames = 36;
+    constexpr float         kTwoPi = 6.283185307f;
+    constexpr float         kStep = kTwoPi / kFrames;
+
+    using MI::Bench::Expect;
+
+    MI::TurntableCache MakeCache()
+    {
+        MI::TurntableCache cache;
+        Expect(cache.Configure(kFrames, 256, 512, 16384), "36 tiles of 256x512 should fit a 16k atlas");
+        cache.Validate({ 1, 256, 512, 40.0f, 0.1f, 150.0f });
+        return cache;
+    }
+
+    // Circular distance in frames between frame and yaw
+    float FrameDistance(std::uint32_t frame, float yawRad)
+    {
+        return std::fabs(std::remainder(static_cast<float>(frame) * kStep - yawRad, kTwoPi)) / kStep;
+    }
+
+    void CheckBakeOrder(float yawRad)
+    {
+        auto              cache = MakeCache();
+        std::vector<bool> seen(kFrames);
+        float             last = 0.0f;
+        for (std::uint32_t n = 0; n < kFrames; ++n) {
+            const auto frame = cache.NextToBake(yawRad);
+            Expect(frame < kFrames && !seen[frame], "bake order repeated a frame or ran off the atlas");
+            const float d = FrameDistance(frame, yawRad);
+            Expect(n > 0 || d <= 0.5f + 1e-4f, "first baked frame is not the one nearest the yaw");
+            Expect(d + 1e-3f >= last, "bake order skipped a frame nearer the yaw");
+            last = d;
+            seen[frame] = true;
+            cache.MarkBaked(frame);
+        }
+        Expect(cache.Complete() && cache.NextToBake(yawRad) == MI::TurntableCache::kNone, "baking did not complete");
+    }
+
+    void CheckLookup()
+    {
+        auto cache = MakeCache();
+        for (std::uint32_t f = 0; f < kFrames; ++f) {
+            cache.MarkBaked(f);
+        }
+        // Between frames i and i + 1: both, weighted by the fraction; whole turns either way wrap
+        for (const float turn : { -2.0f, -1.0f, 0.0f, 1.0f, 5.0f }) {
+            for (std::uint32_t i = 0; i < kFrames; ++i) {
+                for (const float t : { 0.0f, 0.25f, 0.5f, 0.9f }) {
+                    const float yaw = turn * kTwoPi + (static_cast<float>(i) + t) * kStep;
+                    const auto  s = cache.Lookup(yaw, true);
+                    const float frac = s.frameA == i ? s.blend : s.blend - 1.0f;  // rounding may land on the previous frame
+                    Expect(s.frameA == i || s.frameA == (i + kFrames - 1) % kFrames, "lookup picked the wrong first frame");
+                    Expect(s.frameB == (s.frameA + 1) % kFrames, "lookup's second frame is not the next one");
+                    Expect(std::fabs(frac - t) < 2e-3f, "blend weight is not the fraction between the frames");
+
+                    const auto snap = cache.Lookup(yaw, false);
+                    Expect(snap.frameA == (t >= 0.5f ? (i + 1) % kFrames : i) || std::fabs(t - 0.5f) < 2e-3f,
+                           "snapping did not pick the nearest frame");
+                    Expect(snap.frameB == MI::TurntableCache::kNone, "snapping returned a second frame");
+                }
+            }
+        }
+        // Across the seam: just below 2 pi (or just below 0) is the last frame blending into frame 0
+        for (const float yaw : { kTwoPi - 0.25f * kStep, -0.25f * kStep }) {
+            const auto s = cache.Lookup(yaw, true);
+            Expect(s.frameA == kFrames - 1 && s.frameB == 0 && std::fabs(s.blend - 0.75f) < 2e-3f, "lookup does not wrap at 2 pi");
+        }
+
+        // Only one neighbour baked: that one alone, no blend
+        cache.Invalidate();
+        cache.MarkBaked(4);
+        const auto one = cache.Lookup(4.6f * kStep, true);
+        Expect(one.frameA == 4 && one.frameB == MI::TurntableCache::kNone && one.blend == 0.0f, "half-baked pair blended");
+        Expect(cache.Lookup(4.6f * kStep, false).frameA == 4, "snapping ignored the only baked neighbour");
+        Expect(cache.Lookup(7.0f * kStep, true).frameA == MI::TurntableCache::kNone, "lookup returned an unbaked frame");
+
+        // Tiles cover the atlas without overlap
+        for (std::uint32_t f = 0; f < kFrames; ++f) {
+            const auto tile = cache.TileOf(f);
+            Expect(tile.x + tile.w <= cache.AtlasWidth() && tile.y + tile.h <= cache.AtlasHeight(), "tile outside the atlas");
+            for (std::uint32_t g = 0; g < f; ++g) {
+                const auto o = cache.TileOf(g);
+                Expect(tile.x != o.x || tile.y != o.y, "two frames share a tile");
+            }
+        }
+    }
+
+    void CheckKey()
+    {
+        const MI::TurntableCache::Key base{ 1, 256, 512, 40.0f, 0.1f, 150.0f };
+        auto                          changes = std::vector<MI::TurntableCache::Key>(4, base);
+        changes[0].cloneGeneration = 2;
+        changes[1].fovDeg = 45.0f;
+        changes[2].pitch = 0.2f;
+        changes[3].distance = 120.0f;
+
+        for (const auto& changed : changes) {
+            auto cache = MakeCache();
+            Expect(!cache.Validate(base), "same key invalidated the atlas");
+            cache.MarkBaked(0);
+            cache.MarkBaked(1);
+            Expect(cache.Validate(changed), "a changed key (clone / fov / pitch / distance) kept the atlas");
+            Expect(cache.BakedCount() == 0 && !cache.IsBaked(0) && !cache.IsBaked(1), "stale tiles still marked baked");
+            Expect(!cache.Validate(changed), "validating the new key twice invalidated again");
+        }
+    }
+
+    void CheckNonFinite()
+    {
+        auto cache = MakeCache();
+        for (const float yaw : { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+                                 -std::numeric_limits<float>::infinity() }) {
+            Expect(cache.NextToBake(yaw) == 0, "non-finite yaw should bake from frame 0");
+            cache.MarkBaked(0);
+            cache.MarkBaked(1);
+            const auto s = cache.Lookup(yaw, true);
+            Expect(s.frameA == 0 && s.frameB == 1 && s.blend == 0.0f, "non-finite yaw should look up frame 0");
+            cache.Invalidate();
+        }
+        cache.MarkBaked(0);
+        Expect(cache.Lookup(1e30f, false).frameA < kFrames, "huge yaw looked up a frame outside the atlas");
+    }
+
+    const bool kRegistered = [] {
+        // A full bake from a random yaw, one tile per call as UpdateTurntable does on idle frames
+        auto checked = std::make_shared<bool>(false);
+        MI::Bench::Register("Turntable/BakeOrder/36", [checked](std::uint64_t iters) {
+            MI::Bench::Rng rng;
+            auto           cache = MakeCache();
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                cache.Invalidate();
+                const float yaw = rng.Uniform(-kTwoPi, kTwoPi);
+                for (auto f = cache.NextToBake(yaw); f != MI::TurntableCache::kNone; f = cache.NextToBake(yaw)) {
+                    cache.MarkBaked(f);
+                }
+                MI::Bench::DoNotOptimize(cache.BakedCount());
+            }
+            if (!std::exchange(*checked, true)) {
+                for (const float yaw : { 0.0f, 0.3f * kStep, 0.7f * kStep, 17.5f * kStep, -3.2f * kStep, 40.0f * kTwoPi + 0.1f }) {
+                    CheckBakeOrder(yaw);
+                }
+                CheckKey();
+                CheckNonFinite();
+            }
+        }, static_cast<double>(kFrames));
+
+        // Per-frame tile selection while dragging across a baked atlas
+        auto lookupChecked = std::make_shared<bool>(false);
+        MI::Bench::Register("Turntable/Lookup", [lookupChecked](std::uint64_t iters) {
+            auto cache = MakeCache();
+            for (std::uint32_t f = 0; f < kFrames; ++f) {
+                cache.MarkBaked(f);
+            }
+            float yaw = 0.0f, acc = 0.0f;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                yaw += 0.013f;
+                const auto s = cache.Lookup(yaw, true);
+                acc += s.blend + static_cast<float>(s.frameA);
+            }
+            MI::Bench::DoNotOptimize(acc);
+            if (!std::exchange(*lookupChecked, true)) {
+                CheckLookup();
+            }
+        });
+        return true;
+    }();
+}
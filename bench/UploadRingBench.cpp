@@ -0,0 +1,198 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ModernInventory/UploadRing.h"
+
+// The staging ring behind TextureUploader under a GPU 1, 2 and 4 frames behind. Cases abort
+// if a slot is handed out again before the fence of its previous copy completed, more slots
+// are in flight than the ring has, Acquire succeeds (or backpressure is not counted) while
+// every slot is in flight, or an upload's region is not the bounding box of everything
+// marked dirty since the previous upload.
+
+namespace
+{
+    using Rect = MI::UploadRing::Rect;
+
+    using MI::Bench::Expect;
+
+    bool operator==(const Rect& a, const Rect& b)
+    {
+        return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+    }
+
+    Rect Union(const Rect& a, const Rect& b)
+    {
+        if (a.Empty()) {
+            return b;
+        }
+        const auto x1 = std::max(a.x + a.w, b.x + b.w), y1 = std::max(a.y + a.h, b.y + b.h);
+        const auto x0 = std::min(a.x, b.x), y0 = std::min(a.y, b.y);
+        return { x0, y0, x1 - x0, y1 - y0 };
+    }
+
+    // Stand-in for the immediate context: a queued copy's fence signals `latency` frames
+    // after submission, in order, like a D3D11_QUERY_EVENT polled with DONOTFLUSH.
+    struct FakeGpu
+    {
+        std::uint32_t latency{};
+        std::uint64_t frame{};
+        std::deque<std::pair<std::uint64_t, std::uint64_t>> pending;  // (fence, completes at frame)
+
+        void Queue(std::uint64_t fence) { pending.emplace_back(fence, frame + latency); }
+
+        // Highest completed fence this frame (0 if none)
+        std::uint64_t Advance()
+        {
+            ++frame;
+            std::uint64_t done = 0;
+            while (!pending.empty() && pending.front().second <= frame) {
+                done = pending.front().first;
+                pending.pop_front();
+            }
+            return done;
+        }
+    };
+
+    // What the GPU has really finished, per slot, next to the ring's own bookkeeping
+    struct Shadow
+    {
+        std::vector<std::uint64_t> slotFence;  // fence of the slot's last copy (0: never used)
+        std::uint64_t              completed{};
+        Rect                       dirty{};   // union of everything marked since the last upload
+        std::uint64_t              backpressured{};
+    };
+
+    // One software-preview upload per frame (partial rect) against a GPU `latency` frames behind.
+    struct Stream
+    {
+        MI::UploadRing ring;
+        FakeGpu        gpu;
+        MI::Bench::Rng rng;
+
+        Stream(std::uint32_t slots, std::uint32_t latency)
+        {
+            ring.Configure(slots);
+            gpu.latency = latency;
+        }
+
+        void Frame(Shadow* shadow = nullptr)
+        {
+            if (const auto done = gpu.Advance()) {
+                ring.Complete(done);
+                if (shadow) {
+                    shadow->completed = done;
+                }
+            }
+            const std::uint32_t x = rng.Next() % 384, y = rng.Next() % 896;
+            ring.MarkDirty({ x, y, 128, 128 });
+            if (shadow) {
+                shadow->dirty = Union(shadow->dirty, { x, y, 128, 128 });
+            }
+            const bool full = ring.InFlight() == ring.Slots();
+            Rect       r;
+            const auto slot = ring.Acquire(r);
+            if (shadow) {
+                Check(*shadow, full, slot, r);
+            }
+            if (slot != MI::UploadRing::kNone) {
+                const auto fence = ring.Submit(slot, r);
+                if (shadow) {
+                    Expect(fence > shadow->completed, "submitted fence is not newer than the completed ones");
+                    shadow->slotFence[slot] = fence;
+                }
+                gpu.Queue(fence);
+            }
+        }
+
+        void Check(Shadow& shadow, bool full, std::uint32_t slot, const Rect& region)
+        {
+            Expect(ring.InFlight() <= ring.Slots(), "more slots in flight than the ring has");
+            if (slot == MI::UploadRing::kNone) {
+                Expect(full, "Acquire failed with a slot free");
+                Expect(ring.GetStats().backpressured == ++shadow.backpressured, "backpressure not counted");
+                Expect(ring.HasDirty(), "dirty region dropped while backpressured");
+                return;
+            }
+            Expect(!full, "Acquire handed out a slot with every slot in flight");
+            Expect(shadow.slotFence[slot] <= shadow.completed, "slot reused before its fence completed");
+            Expect(region == shadow.dirty, "upload region is not the union of the dirty rects since the last upload");
+            Expect(!ring.HasDirty(), "Acquire left the region dirty");
+            shadow.dirty = {};
+        }
+    };
+
+    // A few hundred frames of the stream with every Acquire checked against the fake GPU
+    void CheckStream(std::uint32_t slots, std::uint32_t latency)
+    {
+        Stream stream(slots, latency);
+        Shadow shadow;
+        shadow.slotFence.assign(slots, 0);
+        for (int i = 0; i < 512; ++i) {
+            stream.Frame(&shadow);
+        }
+        const auto& stats = stream.ring.GetStats();
+        // A GPU `latency` frames behind keeps min(latency, slots) copies in flight; backpressure
+        // engages exactly when it is further behind than the ring is deep
+        Expect(stats.maxInFlight == std::min(latency, slots), "in-flight depth does not follow the GPU latency");
+        Expect((stats.backpressured > 0) == (latency > slots), "backpressure engaged (or not) against the GPU latency");
+        Expect(stats.uploads + stats.backpressured == 512, "a frame neither uploaded nor backpressured");
+    }
+
+    // Partial regions: disjoint rects merge to their bounding box, empty ones are ignored, and
+    // an aborted write puts its region back under the next one
+    void CheckMerge()
+    {
+        MI::UploadRing ring;
+        ring.Configure(1);
+        Rect r;
+        Expect(ring.Acquire(r) == MI::UploadRing::kNone && ring.GetStats().backpressured == 0,
+               "nothing dirty should not count as backpressure");
+        ring.MarkDirty({ 10, 20, 0, 50 });
+        Expect(!ring.HasDirty(), "an empty rect marked the ring dirty");
+
+        ring.MarkDirty({ 10, 20, 30, 40 });
+        ring.MarkDirty({ 100, 5, 8, 8 });
+        auto slot = ring.Acquire(r);
+        Expect(slot == 0 && r == Rect{ 10, 5, 98, 55 }, "disjoint rects did not merge to their bounding box");
+
+        ring.MarkDirty({ 0, 0, 4, 4 });
+        ring.Abort(slot, r);
+        slot = ring.Acquire(r);
+        Expect(slot == 0 && r == Rect{ 0, 0, 108, 60 }, "aborted region was not merged back");
+        const auto fence = ring.Submit(slot, r);
+
+        // Backpressured: the rects keep merging until the fence lets the slot go
+        ring.MarkDirty({ 50, 50, 10, 10 });
+        Expect(ring.Acquire(r) == MI::UploadRing::kNone, "single slot handed out twice");
+        ring.MarkDirty({ 70, 90, 10, 10 });
+        ring.Complete(fence - 1);
+        Expect(ring.Acquire(r) == MI::UploadRing::kNone, "an older fence freed the slot");
+        ring.Complete(fence);
+        Expect(ring.Acquire(r) == 0 && r == Rect{ 50, 50, 30, 50 }, "rects marked while backpressured did not merge");
+        Expect(ring.GetStats().backpressured == 2, "backpressure miscounted");
+    }
+
+    const bool kRegistered = [] {
+        for (const std::uint32_t latency : { 1u, 2u, 4u }) {
+            auto stream = std::make_shared<Stream>(3, latency);
+            auto checked = std::make_shared<bool>(false);
+            MI::Bench::Register("UploadRing/Frame/3slots/latency" + std::to_string(latency), [stream, checked, latency](std::uint64_t iters) {
+                for (std::uint64_t i = 0; i < iters; ++i) {
+                    stream->Frame();
+                }
+                MI::Bench::DoNotOptimize(stream->ring.GetStats());
+                if (!std::exchange(*checked, true)) {
+                    CheckStream(3, latency);
+                    CheckMerge();
+                }
+            });
+        }
+        return true;
+    }();
+}
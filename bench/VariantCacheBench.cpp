@@ -0,0 +1,69 @@
+#include "Bench.h"
+
+
+#include "ModernInventory/VariantCache.h"
+
+// Per-frame bookkeeping of the hover preview: the hovered row's lookup plus the prefetcher's
+// scan of the rows around it, on the default 8-entry cache. Aborts if the variant on screen
+// is evicted or the prefetch window thrashes the cache.
+
+namespace
+{
+    constexpr std::uint32_t kRows = 60;
+    constexpr std::uint64_t kBase = 0x5EED;
+
+    std::uint32_t FormOf(std::uint32_t row) { return row % 5 != 4 ? 0x00012E46 + row : 0; }
+
+    using MI::Bench::Expect;
+
+    const bool kRegistered = [] {
+        // Scrolling down and back: one hover, up to one prefetch per frame
+        MI::Bench::Register("VariantCache/ScrollFrame", [](std::uint64_t iters) {
+            MI::VariantCache cache(8);
+            MI::HoverPrefetch prefetch;
+            std::uint32_t row = 0;
+            int step = 1;
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                if (i % 3 == 0) {  // a row every third frame
+                    if ((row == kRows - 1 && step > 0) || (row == 0 && step < 0)) {
+                        step = -step;
+                    }
+                    row += step;
+                    prefetch.OnHover(row);
+                    auto slot = MI::VariantCache::kNone;
+                    if (const auto form = FormOf(row); form != 0) {
+                        cache.Pin(MI::VariantCache::kNone);
+                        slot = cache.Lookup({ kBase, form });
+                        if (slot == MI::VariantCache::kNone) {
+                            slot = cache.Insert({ kBase, form }, false);
+                        }
+                        cache.Pin(slot);
+                    }
+                    MI::Bench::DoNotOptimize(slot);
+                }
+                const auto next = prefetch.Next(cache, kBase, kRows, FormOf);
+                if (next != MI::HoverPrefetch::kNoRow) {
+                    const auto slot = cache.Insert({ kBase, FormOf(next) }, true);
+                    Expect(slot != MI::VariantCache::kNone, "no slot for a prefetch");
+                }
+            }
+            const auto& stats = cache.GetStats();
+            Expect(iters < 3000 || stats.misses * 20 < stats.lookups, "steady scrolling misses the prefetched rows");
+            Expect(stats.prefetches <= stats.lookups + 16, "prefetches outran the hovers (window thrashing)");
+        });
+
+        // A pinned slot survives a full cache of newer inserts
+        MI::Bench::Register("VariantCache/InsertEvict", [](std::uint64_t iters) {
+            MI::VariantCache cache(8);
+            const auto pinned = cache.Insert({ kBase, 1 }, false);
+            cache.Pin(pinned);
+            for (std::uint64_t i = 0; i < iters; ++i) {
+                const auto slot = cache.Insert({ kBase, static_cast<std::uint32_t>(i + 2) }, true);
+                Expect(slot != pinned, "evicted the variant on screen");
+                MI::Bench::DoNotOptimize(slot);
+            }
+            Expect(cache.Find({ kBase, 1 }) == pinned, "pinned variant lost");
+        });
+        return true;
+    }();
+}
@@ -0,0 +1,52 @@
+// MI_bench: microbenchmarks for the portable core.
+//   MI_bench [--filter <substring>] [--min-time <seconds>] [--out <file.json>] [--list] [--check]
+// --check runs every case once for its correctness checks only (registered with ctest).
+#include "Bench.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    std::string filter;
+    std::string outPath;
+    double minSeconds = 0.5;
+    bool check = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue) {
+            minSeconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--out") == 0 && hasValue) {
+            outPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--check") == 0) {
+            check = true;
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            MI::Bench::List(std::cout);
+            return 0;
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--filter s] [--min-time sec] [--out file.json] [--list] [--check]\n";
+            return 2;
+        }
+    }
+
+    int ran = 0;
+    if (check) {
+        ran = MI::Bench::CheckAll(filter, std::cout);
+    } else if (outPath.empty()) {
+        ran = MI::Bench::RunAll(filter, minSeconds, std::cout);
+    } else {
+        std::ofstream out(outPath);
+        if (!out) {
+            std::cerr << "cannot open " << outPath << '\n';
+            return 1;
+        }
+        ran = MI::Bench::RunAll(filter, minSeconds, out);
+    }
+    return ran > 0 ? 0 : 1;
+}
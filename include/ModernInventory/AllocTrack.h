@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Allocation-tracking build mode (-DMI_ALLOC_TRACKING=ON): replaces the global operator
+// new/delete and routes ImGui's allocator through counters, attributed to the innermost
+// Scope on the allocating thread. Allocations outside any scope are not counted. When the
+// option is off, Scope compiles to nothing and TakeFrame reports zeros.
+#ifndef MI_ALLOC_TRACKING
+#define MI_ALLOC_TRACKING 0
+#endif
+
+namespace MI::AllocTrack
+{
+    inline constexpr bool kEnabled = MI_ALLOC_TRACKING != 0;
+
+    enum class Stage : std::uint8_t
+    {
+        kNone,        // not tracked
+        kPresent,     // Present_Hook outside the stages below (panel widgets, bookkeeping)
+        kImGui,       // ImGui NewFrame / Render / backend draw
+        kController,  // PreviewController::OnFrame outside the render
+        kRender,      // preview render (IGameWorld::RenderPreview)
+        kExport,      // preview export request + readback poll
+        kCount
+    };
+    inline constexpr std::size_t kStageCount = static_cast<std::size_t>(Stage::kCount);
+
+    struct Counts
+    {
+        std::uint64_t allocs{}, bytes{}, frees{};
+    };
+    using Frame = std::array<Counts, kStageCount>;
+
+    const char* StageName(Stage stage);
+
+    // This thread's counts since its previous TakeFrame (all zero when not tracking).
+    void TakeFrame(Frame& out);
+
+    inline std::uint64_t TotalAllocs(const Frame& f)
+    {
+        std::uint64_t n = 0;
+        for (const auto& c : f) {
+            n += c.allocs;
+        }
+        return n;
+    }
+
+#if MI_ALLOC_TRACKING
+    Stage Enter(Stage stage) noexcept;  // returns the previous stage
+    void  Leave(Stage previous) noexcept;
+
+    // For the replacement operator new/delete and ImGui::SetAllocatorFunctions
+    void* ImGuiAlloc(std::size_t size, void* user);
+    void  ImGuiFree(void* ptr, void* user);
+
+    class Scope
+    {
+    public:
+        explicit Scope(Stage stage) noexcept : m_previous(Enter(stage)) {}
+        ~Scope() { Leave(m_previous); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Stage m_previous;
+    };
+#else
+    class Scope
+    {
+    public:
+        explicit Scope(Stage) noexcept {}
+    };
+#endif
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <span>
+
+#include "ModernInventory/XformMath.h"
+
+// Camera math for the preview: sin/cos, look-at bases, orbit cameras and perspective frusta,
+// with SSE2 paths for batches (multi-view tiles, turntable frames, thumbnails). Bases follow
+// NiCamera: its world rotation's columns are the view direction, up and right, with +Z as
+// world up. Portable: no engine types; REConvert copies the results into NiTransform /
+// NiFrustum.
+
+namespace MI::Math
+{
+    // Cephes-style: ~1 ulp on |angle| < 8192, error grows past that (range reduction).
+    void SinCos(float angle, float& s, float& c);
+    // Elementwise; the three spans have the same length (sines / cosines may not alias angles).
+    void SinCos(std::span<const float> angles, std::span<float> sines, std::span<float> cosines);
+
+    // Rotation whose columns are forward (eye -> target), up and right; looking straight up
+    // or down picks +X as right. eye == target gives a zero forward.
+    void LookAt(const Vec3& eye, const Vec3& target, float (&rot)[3][3]);
+
+    // Yaw around +Z (0 looks down +Y) and pitch up from the horizon, distance from the target
+    struct Orbit
+    {
+        Vec3  target{};
+        float yawRad{}, pitchRad{}, distance{};
+    };
+
+    Vec3 OrbitOffset(float yawRad, float pitchRad, float distance);  // eye - target
+
+    // Camera world transform: eye at target + OrbitOffset, LookAt(eye, target) basis, unit
+    // scale. At |pitch| = 90 deg the right vector still follows yaw (LookAt would pick +X).
+    Xform OrbitCamera(const Orbit& orbit);
+    void  OrbitCameras(std::span<const Orbit> orbits, std::span<Xform> out);  // same length
+
+    // NiFrustum's convention: view-plane extents at unit distance, plus the clip planes
+    struct Frustum
+    {
+        float left{}, right{}, top{}, bottom{};
+        float nearZ{}, farZ{};
+    };
+
+    Frustum Perspective(float fovYRad, float aspect, float nearZ, float farZ);
+}
@@ -1,6 +1,10 @@
 ﻿#pragma once
 
+#include <iosfwd>
 #include <string>
+#include <vector>
+
+#include "ModernInventory/ImageEncode.h"
 
 namespace MI
 {
@@ -16,12 +20,57 @@ namespace MI
         float previewYawDeg     = 180.0f; // face camera
         float previewPitchDeg   = 0.0f;   // slight tilt optional
         float previewFitMargin  = 1.10f;  // expand bound to ensure full body fits
+
+        // Turntable cache: pre-baked yaw angles of the preview (0 = disabled)
+        int   turntableFrames        = 0;     // number of yaw angles in the atlas
+        int   turntableBakesPerFrame = 1;     // tiles baked per idle frame
+        bool  turntableBlend         = true;  // blend neighbouring tiles while rotating
+
+        // Views of the preview side by side in one target (1 = single view); view i is turned
+        // i/N of a turn from the interactive yaw. Unchanged views are not redrawn.
+        int   previewViews = 1;
+
+        // CPU-rasterized pose silhouette when the engine scene path can't draw the clone
+        bool  softwareFallback = true;
+
+        // Capture menu/equip/pane/frame events to ModernInventory.mievents for MI_replay
+        bool  recordEvents = false;
+
+        // Save the current preview to ModernInventoryExports/ (DirectInput scancode, 0 = off)
+        int         exportKey    = 0;
+        ImageFormat exportFormat = ImageFormat::kQoi;
+
+        // Inventory hotkey (scancode, same as resources/config.json "toggleKey"). Pressing it
+        // starts the preview clone before the menu opens; unused after the timeout (0 = off).
+        int   toggleKey         = 0x17;  // I
+        int   prebuildTimeoutMs = 1500;
+
+        // The clone is kept between inventory sessions; after this long closed it is freed if
+        // system memory load (percent) is at least cacheEvictMemoryLoad. 0 = never evict.
+        int   cacheEvictIdleSec    = 60;
+        int   cacheEvictMemoryLoad = 85;
+
+        // Hover preview: the hovered armor is shown on the clone without equipping it. Built
+        // variants are kept in an LRU of this many (0 = off); each frame builds up to
+        // hoverPrefetchPerFrame more for the rows next to the cursor.
+        int   variantCacheSize      = 8;
+        int   hoverPrefetchPerFrame = 1;
+
+        // Panel fonts, comma-separated paths from the game folder: the first is the main font,
+        // later ones add their glyphs to it (CJK, icons). Empty = ImGui's built-in font. The
+        // baked atlas is cached in ModernInventory.fontcache next to the log.
+        std::vector<std::string> fontFiles;
+        float                    fontSizePx = 13.0f;
     };
 
     namespace ConfigSys
     {
-        // Load from ModernInventory.ini next to the DLL (if present)
+        // Load from ModernInventory.ini next to the DLL (if present); the kConfig startup step
         void Load();
+        // Loads on first use (waits if the startup graph is loading it on another thread)
         const Config& Get();
+
+        // Apply "Key=Value" lines (# / ; comments) to cfg. Portable: used by Load and the benchmarks.
+        void Parse(std::istream& in, Config& cfg);
     }
 }
@@ -1,14 +1,27 @@
 ﻿#pragma once
 
 #include <cstdint>
+#include <string_view>
 
 namespace MI
 {
-    // Installs a Present() hook and initializes Dear ImGui on first Present.
-    void InstallD3D11Hook();
+    // Hooks D3D11CreateDeviceAndSwapChain so Present is hooked (and Dear ImGui initialized on
+    // the first Present) once the game creates its device. False if that isn't possible:
+    // InstallD3D11HookFallback then finds Present through a throwaway device + swapchain
+    // (tens of ms; safe on a background thread).
+    bool InstallD3D11Hook();
+    bool InstallD3D11HookFallback();
 
-    // Control overlay visibility from gameplay/menu events
+    // Overlay visibility; render thread (PreviewController applies queued menu events)
     void SetInventoryOpen(bool open);
     bool IsInventoryOpen();
+
+    // Save the preview on the next rendered panel frame (any thread; see Config::exportKey)
+    void RequestPreviewExport();
+
+    // Text about to be drawn (UTF-8, render thread): the hovered item's name in our panel and
+    // whatever overlay clients pass to OverlayInterfaceV2::NoteText. Scripts the font atlas
+    // lacks are baked in before the next frame (until then they draw as '?').
+    void NoteOverlayText(std::string_view utf8);
 }
 
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ModernInventory/MemStats.h"
+#include "ModernInventory/MpscQueue.h"
+
+namespace MI
+{
+    // Compact binary capture of the events that drive the preview, for headless replay.
+    // File: "MIEV" + version byte, then per event: type byte, varint delta-time (us),
+    // and a type-specific varint payload.
+    enum class EventType : std::uint8_t
+    {
+        kFrame     = 1,  // Present boundary (render with the last pane size if open)
+        kMenuOpen  = 2,  // InventoryMenu opening
+        kMenuClose = 3,  // InventoryMenu closing
+        kEquip     = 4,  // player equip/unequip
+        kPaneSize  = 5,  // preview pane size changed: a = width, b = height
+        kGpuCalls  = 6,  // D3D11 calls since the previous kFrame: a = GpuCall, b = count (v2)
+        kHotkey    = 7,  // inventory toggle key pressed (v3)
+        kHover     = 8,  // hovered item row changed: a = row (0xFFFFFFFF off the list), b = rows (v4)
+    };
+
+    struct Event
+    {
+        EventType     type{ EventType::kFrame };
+        std::uint64_t timeUs{};  // absolute, since capture start
+        std::uint32_t a{}, b{};
+    };
+
+    namespace EventLog
+    {
+        inline constexpr char         kMagic[4] = { 'M', 'I', 'E', 'V' };
+        inline constexpr std::uint8_t kVersion  = 4;  // v1-v3 captures (no kGpuCalls / kHotkey / kHover) still decode
+
+        void WriteHeader(std::vector<std::uint8_t>& out);
+        // Append one event; prevTimeUs is updated to e.timeUs.
+        void Encode(const Event& e, std::uint64_t& prevTimeUs, std::vector<std::uint8_t>& out);
+        // Decode a whole capture; returns false on a bad header or truncated stream
+        // (events decoded before the damage are kept).
+        bool Decode(const std::uint8_t* data, std::size_t size, std::vector<Event>& out);
+        bool ReadFile(const std::string& path, std::vector<Event>& out);
+    }
+
+    // Recorder for the sinks (game threads) and Present (render thread). Record only pushes
+    // the event into a lock-free queue; a background writer encodes and writes it in chunks,
+    // so no recording thread takes a lock or touches the file. A full queue drops the event
+    // (counted) rather than waiting on the writer.
+    class EventRecorder
+    {
+    public:
+        static constexpr std::size_t kQueueCapacity = 4096;  // ~0.5 s of frames with GPU counts
+        static constexpr auto        kWritePeriod = std::chrono::milliseconds(50);
+
+        struct Stats
+        {
+            std::atomic<std::uint64_t> recorded{};
+            std::atomic<std::uint64_t> dropped{};  // queue full
+            std::atomic<std::uint64_t> writes{};   // chunks written by the writer thread
+        };
+
+        ~EventRecorder() { Stop(); }
+
+        bool Start(const std::string& path, std::uint64_t nowUs);
+        // Writes everything recorded so far and closes the file (waits for the writer).
+        void Stop();
+        // Any thread, never waits: the writer writes what is queued now instead of at its
+        // next period.
+        void Flush();
+        bool Active() const { return m_active; }
+
+        // Any thread; lock-free.
+        void Record(EventType type, std::uint64_t nowUs, std::uint32_t a = 0, std::uint32_t b = 0);
+
+        const Stats& GetStats() const { return m_stats; }
+
+    private:
+        void WriterLoop();
+        bool DrainAndEncode();  // writer: queued events into m_buffer; false if none
+
+        MpscQueue<Event, kQueueCapacity> m_queue;
+        std::atomic<bool>                m_active{ false };
+        std::atomic<bool>                m_flush{ false };
+        std::uint64_t                    m_startUs{};
+        Stats                            m_stats;
+
+        // Writer thread (Start / Stop only while it is not running)
+        std::thread               m_writer;
+        std::mutex                m_wakeLock;  // only for the writer's sleep and Stop
+        std::condition_variable   m_wake;
+        bool                      m_quit{ false };
+        std::ofstream             m_file;
+        std::vector<std::uint8_t> m_buffer;
+        std::uint64_t             m_prevUs{};
+        MemCharge                 m_bufferMem{ MemStats::Register("EventRecorder/buffer", MemKind::kCpu) };
+    };
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ModernInventory/XformMath.h"
+
+namespace MI
+{
+    // Flattened structure-of-arrays mirror of a transform hierarchy.
+    // Nodes are stored breadth-first: every parent precedes its children and the nodes
+    // of one depth level are contiguous, so a level can be updated as one independent,
+    // vectorizable loop. Local and world transforms live in separate component streams.
+    class FlatHierarchy
+    {
+    public:
+        static constexpr std::uint32_t kNoParent = 0xFFFFFFFFu;
+
+        void Clear();
+        void Reserve(std::size_t n);
+
+        // Append a node in breadth-first order: the parent must already exist and the new
+        // node's depth must not be lower than the previous node's. Returns the node index,
+        // or kNoParent if the ordering rule is violated.
+        std::uint32_t Add(std::uint32_t parent, const Math::Xform& local);
+
+        // Replace a node's local transform and mark its subtree for update.
+        void SetLocal(std::uint32_t i, const Math::Xform& local);
+        void MarkAllDirty();
+
+        // Recompute world transforms from the first dirty level down, in one linear pass.
+        // Returns the number of nodes whose world transform changed.
+        std::size_t Update();
+
+        // Visit nodes whose world transform changed in the last Update() (for write-back).
+        template <class F>
+        void ForEachUpdated(F&& fn) const
+        {
+            for (std::uint32_t i = 0; i < m_parent.size(); ++i) {
+                if (m_updated[i]) {
+                    fn(i, World(i));
+                }
+            }
+        }
+
+        Math::Xform Local(std::uint32_t i) const { return Read(m_local, i); }
+        Math::Xform World(std::uint32_t i) const { return Read(m_world, i); }
+        std::uint32_t Parent(std::uint32_t i) const { return m_parent[i]; }
+        std::size_t Size() const { return m_parent.size(); }
+        std::size_t Levels() const { return m_levelEnd.size(); }
+        std::size_t Bytes() const;  // heap held (capacity, survives Clear) for MemStats
+
+    private:
+        // 13 float streams: rotation rows (9), translation (3), scale (1)
+        struct Streams
+        {
+            std::vector<float> r[9];
+            std::vector<float> t[3];
+            std::vector<float> s;
+        };
+
+        static Math::Xform Read(const Streams& st, std::uint32_t i);
+        static void Write(Streams& st, std::uint32_t i, const Math::Xform& x);
+        static void Resize(Streams& st, std::size_t n);
+        static void Reserve(Streams& st, std::size_t n);
+        void UpdateRange(std::uint32_t begin, std::uint32_t end);
+
+        std::vector<std::uint32_t> m_parent;
+        std::vector<std::uint32_t> m_depth;
+        std::vector<std::uint32_t> m_levelEnd;   // exclusive end index of each depth level
+        std::vector<std::uint8_t>  m_dirty;      // local changed since last Update()
+        std::vector<std::uint8_t>  m_updated;    // world changed by last Update()
+        Streams                    m_local;
+        Streams                    m_world;
+        std::uint32_t              m_firstDirtyLevel{ 0xFFFFFFFFu };
+    };
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MI
+{
+    // A baked font atlas without ImGui types: the alpha coverage texture plus, per font, the
+    // metrics and glyph table needed to draw text without rasterizing anything. Cached on disk
+    // so later runs skip the TrueType bake (FontAtlasImGui.h converts to and from ImFontAtlas).
+    struct BakedGlyph
+    {
+        std::uint32_t codepoint{};
+        float         advanceX{};
+        float         x0{}, y0{}, x1{}, y1{};  // quad relative to the pen position
+        float         u0{}, v0{}, u1{}, v1{};
+    };
+
+    struct BakedFont
+    {
+        float                   size{}, ascent{}, descent{};
+        std::vector<BakedGlyph> glyphs;
+    };
+
+    struct BakedAtlas
+    {
+        std::uint32_t                     width{}, height{};
+        float                             whiteU{}, whiteV{};  // solid texel for untextured shapes
+        std::vector<std::array<float, 4>> lineUvs;             // baked anti-aliased lines, by width
+        std::vector<std::uint32_t>        ranges;              // baked codepoints: first, last pairs
+        std::vector<BakedFont>            fonts;
+        std::vector<std::uint8_t>         alpha;               // width * height coverage
+    };
+
+    // One font in the atlas; an empty path is ImGui's built-in font.
+    struct FontSource
+    {
+        std::string path;
+        float       sizePx{ 13.0f };
+    };
+
+    namespace FontAtlasCache
+    {
+        // File: "MIFA" + version byte, the key, then the atlas (little-endian, fixed-size fields).
+        inline constexpr char         kMagic[4] = { 'M', 'I', 'F', 'A' };
+        inline constexpr std::uint8_t kVersion  = 1;
+
+        // What a cache was baked from: each font file's path, size and modification time, the
+        // pixel sizes, the configured glyph ranges and the rasterizer version. Ranges added on
+        // demand are stored in the cache itself (BakedAtlas::ranges), not in the key.
+        std::uint64_t Key(const std::vector<FontSource>& fonts, const std::vector<std::uint32_t>& ranges,
+                          std::uint32_t builderVersion);
+
+        void Encode(const BakedAtlas& atlas, std::uint64_t key, std::vector<std::uint8_t>& out);
+        // False on a bad header, another key or a truncated file; out is unspecified then.
+        bool Decode(const std::uint8_t* data, std::size_t size, std::uint64_t key, BakedAtlas& out);
+
+        // Written to a temporary name and renamed, so a crash can't leave half a cache behind.
+        bool WriteFile(const std::string& path, const BakedAtlas& atlas, std::uint64_t key);
+        bool ReadFile(const std::string& path, std::uint64_t key, BakedAtlas& out);
+    }
+
+    // Which codepoints the atlas holds and which ones drawn text needed that it doesn't, so
+    // rare scripts are baked only once something actually shows them. Basic Multilingual Plane
+    // only (ImGui's default 16-bit ImWchar); one thread (the renderer) at a time.
+    class GlyphCoverage
+    {
+    public:
+        static constexpr std::uint32_t kBlock = 128;  // missing codepoints are requested by aligned block
+
+        void Reset(const std::vector<std::uint32_t>& ranges);
+
+        // Every string about to be drawn; a bit test per codepoint for covered text.
+        void Note(std::string_view utf8);
+        bool HasPending() const { return !m_pending.empty(); }
+
+        // Adds the pending blocks to ranges (sorted and merged) and counts them as covered from
+        // now on, so a block the fonts don't have is asked for once. False if none were pending.
+        bool TakePending(std::vector<std::uint32_t>& ranges);
+
+    private:
+        bool Covered(std::uint32_t cp) const { return (m_covered[cp >> 6] >> (cp & 63)) & 1; }
+        void Cover(std::uint32_t first, std::uint32_t last);
+
+        std::array<std::uint64_t, 0x10000 / 64> m_covered{};
+        std::vector<std::uint32_t>              m_pending;  // block indices, unsorted
+    };
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ModernInventory/FontAtlasCache.h"
+
+struct ImFontAtlas;
+
+namespace MI::FontAtlasImGui
+{
+    // Rasterizes the fonts into atlas (cleared first): the first source is the main font and
+    // later ones are merged into it, all with the same glyph ranges (first, last pairs; empty =
+    // ImGui's default Latin set). Missing files fall back to ImGui's built-in font. The TrueType
+    // input data is released afterwards; the atlas keeps only the fonts and the texture.
+    bool Bake(ImFontAtlas& atlas, const std::vector<FontSource>& fonts, const std::vector<std::uint32_t>& ranges);
+
+    // Snapshot of a built atlas (Alpha8 pixels, glyph tables, white texel and line uvs).
+    void Capture(const ImFontAtlas& atlas, const std::vector<std::uint32_t>& ranges, BakedAtlas& out);
+
+    // Rebuilds atlas from a snapshot without rasterizing; the atlas is ready for the renderer
+    // backend to upload. False (atlas left cleared) for an empty or inconsistent snapshot.
+    bool Restore(const BakedAtlas& baked, ImFontAtlas& atlas);
+
+    // Part of the cache key: glyph placement depends on the ImGui version that baked it
+    std::uint32_t BuilderVersion();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ModernInventory/GpuCalls.h"
+
+namespace MI
+{
+    // Order-sensitive hash for IGameWorld::PreviewFingerprint (FNV-1a over 64-bit words,
+    // folded so high bits of one word reach the low bits of the next step).
+    struct Fingerprint
+    {
+        std::uint64_t value{ 0xCBF29CE484222325ull };
+
+        void Add(std::uint64_t v)
+        {
+            value = (value ^ v) * 0x100000001B3ull;
+            value ^= value >> 32;
+        }
+    };
+
+    // Thin facade over the engine singletons the event sinks and the preview renderer
+    // touch (PlayerCharacter, UI, Inventory3DManager, Preview3D). The in-game
+    // implementation forwards to RE; the replay tool supplies a headless one.
+    class IGameWorld
+    {
+    public:
+        virtual ~IGameWorld() = default;
+
+        virtual bool HasPlayer3D() = 0;                 // PlayerCharacter 3D loaded
+        virtual void HideVanillaPreview() = 0;          // Inventory3DManager::Clear3D (on the main thread)
+        virtual void SetPanelVisible(bool open) = 0;    // right panel overlay
+        // Clone player 3D into the preview scene; false if there was nothing to clone yet.
+        virtual bool RebuildPreview() = 0;
+        virtual void DiscardPreview() = 0;              // drop the clone (unused prebuild, eviction)
+        // Hash of what the clone is built from (equipped forms per biped slot, race, weight,
+        // head parts, drawn weapon); equal values mean a rebuild would produce the same tree.
+        virtual std::uint64_t PreviewFingerprint() = 0;
+        virtual bool UnderMemoryPressure() = 0;         // evict idle caches
+        // Size + render the preview; true if a clone was drawn (not the purple fallback).
+        virtual bool RenderPreview(unsigned width, unsigned height) = 0;
+        virtual void Notify(const char* text) = 0;      // debug notification / console line (on the main thread)
+        virtual std::uint64_t NowUs() = 0;              // event clock (recorded time on replay)
+        virtual void TakeGpuCalls(GpuCallFrame& out) = 0; // D3D11 calls since the last take
+        virtual void RequestExport() = 0;               // save the preview on the next panel frame
+
+        // Hover preview. Rows index the inventory item list as shown (kNone: cursor off the
+        // list); ItemForm is the row's item if it can be tried on (unequipped armor), else 0.
+        // Variants are copies of the current clone with that item swapped in, held in slots
+        // the controller's VariantCache assigns; ShowVariant(kNone) shows the clone itself.
+        static constexpr std::uint32_t kNone = 0xFFFFFFFF;
+        virtual std::uint32_t HoveredRow() = 0;
+        virtual std::uint32_t ItemCount() = 0;
+        virtual std::uint32_t ItemForm(std::uint32_t row) = 0;
+        virtual bool BuildVariant(std::uint32_t slot, std::uint32_t formID) = 0;  // false: not wearable / no clone
+        virtual void ShowVariant(std::uint32_t slot) = 0;
+        virtual void DiscardVariants() = 0;             // every slot (the clone they came from is gone)
+    };
+
+    // In-game facade (RE singletons); defined on the plugin side only.
+    IGameWorld& LiveGameWorld();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace MI
+{
+    // D3D11 calls made by our own rendering code (OffscreenRT, Preview3D, PreviewRenderer,
+    // Present_Hook). Call sites bump a counter right before the device/context call; the
+    // per-frame deltas go into the event capture so MI_replay can check them against a budget.
+    enum class GpuCall : std::uint8_t
+    {
+        kCreateTexture2D,
+        kCreateRenderTargetView,
+        kCreateShaderResourceView,
+        kCreateDepthStencilView,
+        kOMSetRenderTargets,
+        kRSSetViewports,
+        kClearRenderTargetView,
+        kClearDepthStencilView,
+        kCopySubresourceRegion,
+        kUpdateSubresource,
+        kCreateQuery,
+        kMap,
+        kCount
+    };
+    inline constexpr std::size_t kGpuCallCount = static_cast<std::size_t>(GpuCall::kCount);
+
+    using GpuCallFrame = std::array<std::uint32_t, kGpuCallCount>;
+
+    namespace GpuCalls
+    {
+        const char* Name(GpuCall call);
+        bool        IsCreation(GpuCall call);     // Create* (textures, views, queries)
+        bool        IsStateChange(GpuCall call);  // OMSetRenderTargets / RSSetViewports
+
+        // Any thread; relaxed atomics, cheap enough to leave on in release builds.
+        void Count(GpuCall call);
+
+        // Calls since the previous TakeFrame (render thread).
+        void TakeFrame(GpuCallFrame& out);
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MI
+{
+    enum class ImageFormat : std::uint8_t
+    {
+        kQoi,  // "Quite OK Image": lossless, fast, ~PNG-sized for flat preview art
+        kPng,  // lossless, stored (uncompressed) deflate: large but readable everywhere
+    };
+
+    namespace ImageEncode
+    {
+        // rgba: 8-bit R,G,B,A per pixel, rows rowPitch bytes apart. Output is appended to out.
+        void Qoi(const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height, std::size_t rowPitch,
+                 std::vector<std::uint8_t>& out);
+        void Png(const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height, std::size_t rowPitch,
+                 std::vector<std::uint8_t>& out);
+
+        inline void Encode(ImageFormat format, const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height,
+                           std::size_t rowPitch, std::vector<std::uint8_t>& out)
+        {
+            format == ImageFormat::kPng ? Png(rgba, width, height, rowPitch, out) : Qoi(rgba, width, height, rowPitch, out);
+        }
+
+        const char* Extension(ImageFormat format);  // ".qoi" / ".png"
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ModernInventory/ImageEncode.h"
+
+namespace MI
+{
+    // Background image writer: encodes and saves read-back frames on worker threads so the
+    // render thread only pays for a queue push. The queue is bounded; when it is full the
+    // job is dropped rather than waited on.
+    class ImageExporter
+    {
+    public:
+        struct Job
+        {
+            std::vector<std::uint8_t> rgba;  // tightly packed, width * 4 bytes per row
+            std::uint32_t             width{}, height{};
+            ImageFormat               format{ ImageFormat::kQoi };
+            std::string               path;  // parent folders are created as needed
+        };
+
+        struct Stats
+        {
+            std::atomic<std::uint64_t> submitted{};
+            std::atomic<std::uint64_t> dropped{};   // queue full
+            std::atomic<std::uint64_t> written{};
+            std::atomic<std::uint64_t> failed{};    // encode ok, file write failed
+            std::atomic<std::uint64_t> bytes{};     // encoded bytes written
+            std::atomic<std::uint64_t> encodeNs{};
+        };
+
+        explicit ImageExporter(unsigned workers = 1, std::size_t maxQueued = 4);
+        ~ImageExporter();  // finishes queued jobs
+
+        ImageExporter(const ImageExporter&) = delete;
+        ImageExporter& operator=(const ImageExporter&) = delete;
+
+        // Any thread; never waits for encoding. False if the queue is full (job dropped).
+        bool Submit(Job&& job);
+
+        // Block until every queued job is written (tools and shutdown only).
+        void Drain();
+
+        const Stats& GetStats() const { return m_stats; }
+
+    private:
+        void WorkerLoop();
+
+        std::vector<std::thread> m_threads;
+        std::mutex               m_lock;
+        std::condition_variable  m_wake;
+        std::condition_variable  m_idle;
+        std::deque<Job>          m_queue;
+        std::size_t              m_maxQueued;
+        unsigned                 m_active{ 0 };  // jobs being encoded
+        bool                     m_quit{ false };
+        Stats                    m_stats;
+    };
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MI
+{
+    // Plugin startup as a small dependency graph. Each step is timed and runs exactly once:
+    // sync steps during Run on the calling thread (SKSEPlugin_Load), background steps on one
+    // worker started by Run, lazy steps only when something Requires them. Require also
+    // pulls a background step forward (or waits for it), so a consumer never sees a
+    // half-initialized subsystem.
+    class InitGraph
+    {
+    public:
+        enum class Mode : std::uint8_t { kSync, kBackground, kLazy };
+        using StepId = std::uint32_t;
+        using Fn = std::function<bool()>;  // false (or a throw) is reported as failed
+
+        InitGraph() = default;
+        InitGraph(const InitGraph&) = delete;
+        InitGraph& operator=(const InitGraph&) = delete;
+        ~InitGraph() { WaitBackground(); }
+
+        // Before Run only. Dependencies must already be added, so ids are a valid order.
+        StepId Add(std::string name, Mode mode, Fn fn, std::initializer_list<StepId> deps = {});
+
+        // Sync steps now, in order; background steps on a worker thread.
+        void Run();
+
+        // Any thread, after Run or from inside a step: run the step (dependencies first) if
+        // nobody has, wait if it is running elsewhere. Returns its result; false if unknown.
+        bool Require(StepId id);
+        bool Done(StepId id) const;
+        void WaitBackground();  // join the worker
+
+        // One line per step: mode, thread it ran on, start offset, duration, time others
+        // spent waiting for it, result; headed by how long Run blocked its caller.
+        std::string Report() const;
+
+    private:
+        enum State : std::uint8_t { kPending, kRunning, kDone };
+        enum class Ran : std::uint8_t { kCaller, kWorker, kOther };
+
+        struct Step
+        {
+            std::string                name;
+            Mode                       mode{};
+            Fn                         fn;
+            std::vector<StepId>        deps;
+            std::atomic<std::uint8_t>  state{ kPending };
+            // Written by the running thread before state = kDone (release)
+            bool                       ok{ false };
+            Ran                        ran{ Ran::kCaller };
+            std::uint64_t              startNs{}, durationNs{};
+            std::atomic<std::uint64_t> waitedNs{ 0 };
+        };
+
+        std::uint64_t SinceOrigin() const;
+
+        std::deque<Step>        m_steps;  // stable addresses; not resized after Run
+        mutable std::mutex      m_lock;
+        std::condition_variable m_done;
+        std::thread             m_worker;
+        std::thread::id         m_caller;
+        std::uint64_t           m_originNs{ 0 };
+        std::uint64_t           m_runNs{ 0 };  // Run's own duration (the caller's blocked time)
+    };
+}
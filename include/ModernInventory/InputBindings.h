@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace MI
+{
+    // What a bound key does; a key may trigger several.
+    enum class InputAction : std::uint8_t
+    {
+        kExport,    // save the preview (inventory open)
+        kPrebuild,  // inventory hotkey: start the clone while the menu opens (gameplay)
+        kCount
+    };
+
+    // Keyboard bindings as a 256-bit scancode set plus a per-key action table, so the input
+    // sink rejects an unbound key with one bit test instead of reading settings and comparing
+    // per event. Only enabled actions' keys are in the set: the context (menu open or not)
+    // picks which actions can fire. Bind / Unbind / Rebind / SetEnabled take one write lock, as
+    // m_set and m_count are recomputed from several atomics (config load, remapping and menu
+    // events run on different threads); Match never locks. Portable: no engine types.
+    class InputBindings
+    {
+    public:
+        using ActionMask = std::uint8_t;
+        static constexpr std::uint32_t kKeys = 256;  // DirectInput keyboard scancodes
+        static constexpr std::uint32_t kMaxKeysPerAction = 4;
+        static constexpr ActionMask    kAll = (1u << static_cast<unsigned>(InputAction::kCount)) - 1;
+
+        static constexpr ActionMask Bit(InputAction action) { return static_cast<ActionMask>(1u << static_cast<unsigned>(action)); }
+
+        // Adds key to action (up to kMaxKeysPerAction keys each). false for key 0 (unbound),
+        // keys past kKeys or a full action.
+        bool Bind(InputAction action, std::uint32_t key);
+        void Unbind(InputAction action);                   // every key of action
+        bool Rebind(InputAction action, std::uint32_t key);  // Unbind + Bind; key 0 just unbinds
+
+        std::uint32_t KeyOf(InputAction action) const { return m_keys[Index(action)][0]; }  // first key, 0 = none
+
+        void       SetEnabled(ActionMask actions);
+        ActionMask Enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+        bool       Any() const { return m_count.load(std::memory_order_relaxed) != 0; }  // some enabled action has a key
+
+        // Enabled actions bound to key (0 for most keys: one load and a bit test)
+        ActionMask Match(std::uint32_t key) const
+        {
+            if (key >= kKeys || ((m_set[key >> 6].load(std::memory_order_relaxed) >> (key & 63)) & 1) == 0) {
+                return 0;
+            }
+            return static_cast<ActionMask>(m_actions[key].load(std::memory_order_relaxed) & m_enabled.load(std::memory_order_relaxed));
+        }
+
+    private:
+        static std::size_t Index(InputAction action) { return static_cast<std::size_t>(action); }
+
+        // Callers hold m_write
+        bool BindLocked(InputAction action, std::uint32_t key);
+        void UnbindLocked(InputAction action);
+        void Rebuild();  // m_set / m_count from m_actions and m_enabled
+
+        using Keys = std::array<std::uint32_t, kMaxKeysPerAction>;
+
+        // Atomics so remapping while input is dispatched on another thread is not a data race
+        std::array<std::atomic<ActionMask>, kKeys>                      m_actions{};  // every bound action per key
+        std::array<std::atomic<std::uint64_t>, kKeys / 64>              m_set{};      // keys with an enabled action
+        std::array<Keys, static_cast<std::size_t>(InputAction::kCount)> m_keys{};
+        std::atomic<ActionMask>                                         m_enabled{ kAll };
+        std::atomic<std::uint32_t>                                      m_count{ 0 };  // keys in m_set
+        std::mutex                                                      m_write;       // every writer
+    };
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace MI
+{
+    enum class SortField : std::uint8_t
+    {
+        kName,
+        kWeight,
+        kValue,
+        kValuePerWeight,  // weightless items count as infinitely valuable
+        kCategory
+    };
+
+    // An ordering as the list header offers it: one field, then a tie-breaker.
+    struct SortOrder
+    {
+        SortField primary{ SortField::kName };
+        SortField secondary{ SortField::kName };
+        bool      descending{ false };  // primary only; ties stay ascending
+    };
+
+    // Ranks of display names under the list's collation (case-insensitive, then by bytes), so
+    // sorting by name compares integers. Built once per set of names, not per sort.
+    class NameCollation
+    {
+    public:
+        void          Build(std::span<const std::string> names);
+        std::uint32_t Rank(std::string_view name) const;  // unknown names rank last
+        std::size_t   Size() const { return m_ranks.size(); }
+
+        static bool Less(std::string_view a, std::string_view b);
+
+    private:
+        std::unordered_map<std::string_view, std::uint32_t> m_ranks;  // views into m_names
+        std::vector<std::string>                            m_names;
+    };
+
+    // Sortable fields of the rows, one column each; name is already a collation rank.
+    struct SortColumns
+    {
+        std::vector<std::uint32_t> nameRank, category;
+        std::vector<float>         weight, value;
+
+        std::size_t Size() const { return nameRank.size(); }
+    };
+
+    // A whole ordering packed into one 64-bit key per row: the primary field in the high half,
+    // the secondary in the low half, each mapped so unsigned order is the wanted order.
+    void PackSortKeys(const SortColumns& rows, const SortOrder& order, std::vector<std::uint64_t>& keys);
+
+    // Stable argsort of 64-bit keys by LSD radix (8-bit digits, passes whose digit is the same
+    // for every key skipped), split across a worker pool for large lists. Keeps the result so
+    // a few changed rows are patched in by merging instead of sorting everything again.
+    // Ties keep row order, so Patch and Sort give identical orders. Portable: no engine types.
+    class InventorySorter
+    {
+    public:
+        // workers: extra threads besides the caller; kAuto picks hardware_concurrency - 1 (max 7).
+        static constexpr unsigned    kAuto = ~0u;
+        static constexpr std::size_t kParallelMin = 1u << 15;  // rows before the pool helps
+
+        struct Stats
+        {
+            std::uint64_t sorts{};           // full radix sorts
+            std::uint64_t passesSkipped{};   // digits equal across all keys
+            std::uint64_t patches{};         // Patch calls merged in place
+            std::uint64_t patchFallbacks{};  // ... too many changes: sorted in full
+        };
+
+        explicit InventorySorter(unsigned workers = kAuto);
+        ~InventorySorter();
+
+        InventorySorter(const InventorySorter&) = delete;
+        InventorySorter& operator=(const InventorySorter&) = delete;
+
+        unsigned Workers() const { return static_cast<unsigned>(m_threads.size()); }
+
+        // Row indices in key order
+        const std::vector<std::uint32_t>& Sort(std::span<const std::uint64_t> keys);
+
+        // keys is the full key array again, changed only at the listed rows; rows past the
+        // previous size are new (appended items). Removing rows needs a full Sort.
+        const std::vector<std::uint32_t>& Patch(std::span<const std::uint64_t> keys, std::span<const std::uint32_t> changed);
+
+        const std::vector<std::uint32_t>& Order() const { return m_order; }
+        const Stats&                      GetStats() const { return m_stats; }
+
+    private:
+        static constexpr std::size_t kDigits = 8;
+        static constexpr std::size_t kBuckets = 256;
+        using Histogram = std::array<std::uint32_t, kBuckets>;
+
+        void RadixSequential();
+        void RadixParallel();
+        void CountPart(unsigned part);    // m_partHist[part] for m_digit over the part's slice
+        void ScatterPart(unsigned part);  // the part's slice into m_tmp* at m_partOffset[part]
+        void RunParts(void (InventorySorter::*job)(unsigned), unsigned parts);
+        void WorkerLoop();
+
+        std::vector<std::uint64_t> m_keys, m_tmpKeys;
+        std::vector<std::uint32_t> m_order, m_tmpOrder;
+        std::vector<std::uint32_t> m_patch;   // scratch: changed rows in key order
+        std::vector<std::uint8_t>  m_marked;  // scratch: row changed
+        std::vector<Histogram>     m_partHist, m_partOffset;
+        unsigned                   m_digit{};
+        Stats                      m_stats;
+
+        // Pool: each RunParts bumps m_generation; workers pull parts from m_nextPart.
+        std::vector<std::thread>   m_threads;
+        std::mutex                 m_lock;
+        std::condition_variable    m_wake;
+        std::condition_variable    m_done;
+        std::uint64_t              m_generation{ 0 };
+        unsigned                   m_busy{ 0 };
+        bool                       m_quit{ false };
+        void (InventorySorter::*m_job)(unsigned) { nullptr };
+        unsigned                   m_parts{ 0 };
+        std::atomic<unsigned>      m_nextPart{ 0 };
+    };
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "ModernInventory/StatDelta.h"
+
+namespace MI::InventoryStats
+{
+    // The hovered inventory row against the worn pieces it would replace ("+12 armor /
+    // -3.5 weight"); false when the hovered row has nothing to compare. weapon says whether
+    // rating is damage; name is the row's display name (valid for this frame). Render thread,
+    // once per panel frame: rows are re-read from the engine when the list or the player's
+    // skills change, deltas re-evaluated when equipment does.
+    bool Hovered(StatDelta& out, bool& weapon, const char*& name);
+
+    // Menu closed: the next session starts from a fresh read (perks are taken while it is shut).
+    void Reset();
+}
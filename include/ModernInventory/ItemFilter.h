@@ -0,0 +1,130 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MI
+{
+    // One bitset per filter term (category, keyword or flag such as "stolen") over the rows of
+    // the item list, bit r set when row r has the term. Items are re-tagged one row at a time
+    // and every change stamps its block, so views re-evaluate only the blocks that moved.
+    // Portable: no engine types; the owner maps forms to term sets.
+    class ItemBitsets
+    {
+    public:
+        static constexpr std::uint32_t kNoTerm = 0xFFFFFFFF;
+        static constexpr std::size_t   kBlockWords = 64;  // 4096 rows: a view's unit of re-evaluation
+        static constexpr std::size_t   kBlockRows = kBlockWords * 64;
+
+        // Term names compare case-insensitively; registering an existing name returns its id.
+        std::uint32_t      AddTerm(std::string_view name);
+        std::uint32_t      Find(std::string_view name) const;  // kNoTerm if unknown
+        std::size_t        TermCount() const { return m_names.size(); }
+        const std::string& TermName(std::uint32_t term) const { return m_names[term]; }
+
+        // New rows start without terms; shrinking clears the dropped rows' bits.
+        void        Resize(std::size_t rows);
+        std::size_t Rows() const { return m_rows; }
+        std::size_t Words() const { return (m_rows + 63) / 64; }
+
+        void Set(std::uint32_t term, std::size_t row, bool on);
+        // Replace the row's term set (an item was added, enchanted, stolen, ...)
+        void SetRow(std::size_t row, std::span<const std::uint32_t> terms);
+
+        bool                 Has(std::uint32_t term, std::size_t row) const;
+        const std::uint64_t* Bits(std::uint32_t term) const { return m_bits[term].data(); }
+        std::size_t          Count(std::uint32_t term) const { return m_counts[term]; }  // rows with the term
+
+        std::uint64_t Generation() const { return m_generation; }
+        std::uint64_t BlockGeneration(std::size_t block) const { return m_blockGen[block]; }
+        std::size_t   Blocks() const { return m_blockGen.size(); }
+
+    private:
+        void Touch(std::size_t row);
+
+        std::vector<std::string>                m_names;
+        std::vector<std::vector<std::uint64_t>> m_bits;    // by term, Words() each
+        std::vector<std::size_t>                m_counts;  // by term
+        std::vector<std::uint64_t>              m_blockGen;
+        std::uint64_t                           m_generation{ 1 };
+        std::size_t                             m_rows{};
+    };
+
+    // A filter expression ("light armor AND enchanted AND NOT stolen") compiled to postfix
+    // bitset operations. NOT binds tightest, then AND, then OR; parentheses group. Term names
+    // may contain spaces; AND / OR / NOT are reserved words in any case. "x AND NOT y" fuses
+    // into one ANDNOT and a term operand is read in place rather than pushed. The empty
+    // expression matches every row.
+    struct FilterProgram
+    {
+        enum class Op : std::uint8_t
+        {
+            kTerm,    // push the term's bitset
+            kAll,     // push every row
+            kAnd,
+            kOr,
+            kAndNot,  // second from top AND NOT top
+            kNot,
+            kAndTerm,     // top AND term: a pushed term folded into the operation after it
+            kOrTerm,
+            kAndNotTerm
+        };
+        struct Step
+        {
+            Op            op{};
+            std::uint32_t term{};
+        };
+
+        std::vector<Step> steps;
+        std::size_t       depth{};  // stack slots Evaluate needs
+
+        // false with a message in error (unknown term, unbalanced parentheses, ...)
+        static bool Compile(std::string_view text, const ItemBitsets& bitsets, FilterProgram& out, std::string* error = nullptr);
+    };
+
+    // A program's matching rows, kept current against its bitsets: Update re-runs the program
+    // over the blocks changed since the last call (all of them after Set), 128 bits per
+    // instruction with SSE2. Chip badges count the matches that also have a term.
+    class FilterView
+    {
+    public:
+        void Set(const FilterProgram& program);  // next Update evaluates everything
+
+        // Returns the number of blocks evaluated (0: the result was current)
+        std::size_t Update(const ItemBitsets& bitsets);
+
+        std::size_t          Count() const { return m_count; }
+        bool                 Matches(std::size_t row) const { return (m_words[row / 64] >> (row % 64)) & 1; }
+        const std::uint64_t* Words() const { return m_words.data(); }
+
+        // counts[i] = matching rows that have terms[i]
+        void Badges(const ItemBitsets& bitsets, std::span<const std::uint32_t> terms, std::span<std::size_t> counts) const;
+
+        template <class Fn>
+        void ForEachRow(Fn&& fn) const
+        {
+            for (std::size_t w = 0; w < m_words.size(); ++w) {
+                for (auto bits = m_words[w]; bits; bits &= bits - 1) {
+                    fn(w * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+                }
+            }
+        }
+
+    private:
+        void EvaluateBlock(const ItemBitsets& bitsets, std::size_t block);
+
+        FilterProgram              m_program;
+        std::vector<std::uint64_t> m_words;       // result, Words() of the bitsets
+        std::vector<std::size_t>   m_blockCount;  // matches per block
+        std::vector<std::uint64_t> m_stack;       // scratch: depth * kBlockWords
+        std::uint64_t              m_seen{};      // bitsets generation evaluated against
+        std::size_t                m_rows{};
+        std::size_t                m_count{};
+        bool                       m_full{ true };
+    };
+}
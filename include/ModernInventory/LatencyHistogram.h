@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace MI
+{
+    // Log2-bucketed latency histogram: constant memory, O(1) insert, percentile
+    // estimates accurate to the bucket (reported as the bucket's upper edge, capped by max).
+    class LatencyHistogram
+    {
+    public:
+        void Add(std::uint64_t value)
+        {
+            ++m_buckets[Bucket(value)];
+            ++m_count;
+            m_sum += value;
+            m_max = (std::max)(m_max, value);
+            m_min = m_count == 1 ? value : (std::min)(m_min, value);
+        }
+
+        void Reset() { *this = LatencyHistogram{}; }
+
+        std::uint64_t Count() const { return m_count; }
+        std::uint64_t Min() const { return m_min; }
+        std::uint64_t Max() const { return m_max; }
+        double        Mean() const { return m_count ? static_cast<double>(m_sum) / static_cast<double>(m_count) : 0.0; }
+
+        // p in [0, 1]
+        std::uint64_t Percentile(double p) const
+        {
+            if (m_count == 0) {
+                return 0;
+            }
+            const auto rank = static_cast<std::uint64_t>(p * static_cast<double>(m_count - 1)) + 1;
+            std::uint64_t seen = 0;
+            for (std::size_t b = 0; b < m_buckets.size(); ++b) {
+                seen += m_buckets[b];
+                if (seen >= rank) {
+                    const std::uint64_t upper = b == 0 ? 0 : (b >= 64 ? ~0ull : (1ull << b) - 1);
+                    return (std::min)(upper, m_max);
+                }
+            }
+            return m_max;
+        }
+
+    private:
+        // bucket 0: value 0; bucket b: [2^(b-1), 2^b)
+        static std::size_t Bucket(std::uint64_t v)
+        {
+            std::size_t b = 0;
+            while (v) {
+                ++b;
+                v >>= 1;
+            }
+            return b;
+        }
+
+        std::array<std::uint64_t, 65> m_buckets{};
+        std::uint64_t                 m_count{};
+        std::uint64_t                 m_sum{};
+        std::uint64_t                 m_min{};
+        std::uint64_t                 m_max{};
+    };
+}
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include <filesystem>
 #include <string_view>
 
 namespace MI
@@ -7,6 +8,8 @@ namespace MI
     namespace Log
     {
         void Init();
+        // Folder holding ModernInventory.log (SKSE documents folder, else next to the DLL)
+        std::filesystem::path GetFolder();
         void Info(std::string_view msg);
         void Warn(std::string_view msg);
         void Error(std::string_view msg);
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MI
+{
+    // Memory held by ModernInventory, by owner. Each subsystem registers a named counter once
+    // and reports byte deltas (or absolute sizes) on allocate/release; readers take a snapshot
+    // for the panel or the log. Updates are relaxed atomics and safe from any thread.
+    enum class MemKind : std::uint8_t
+    {
+        kGpu,     // textures, staging rings, vertex buffers
+        kCpu,     // our own heap allocations
+        kEngine,  // game objects we keep alive (cloned NiAVObject tree), estimated
+        kCount
+    };
+    inline constexpr std::size_t kMemKindCount = static_cast<std::size_t>(MemKind::kCount);
+
+    class MemCounter
+    {
+    public:
+        MemCounter(const char* name, MemKind kind) : m_name(name), m_kind(kind) {}
+
+        void Add(std::int64_t bytes);  // negative on release
+        void Set(std::int64_t bytes);  // replace the current size (resize-style owners)
+
+        std::int64_t Current() const { return m_current.load(std::memory_order_relaxed); }
+        std::int64_t Peak() const { return m_peak.load(std::memory_order_relaxed); }
+        const char*  Name() const { return m_name; }
+        MemKind      Kind() const { return m_kind; }
+
+    private:
+        const char*               m_name;  // static storage
+        MemKind                   m_kind;
+        std::atomic<std::int64_t> m_current{ 0 };
+        std::atomic<std::int64_t> m_peak{ 0 };
+    };
+
+    // One owner's share of a counter, for owners that can have several instances (staging
+    // rings, exporters). Releases its share on destruction.
+    class MemCharge
+    {
+    public:
+        explicit MemCharge(MemCounter& counter) : m_counter(&counter) {}
+        ~MemCharge() { Set(0); }
+
+        MemCharge(const MemCharge&) = delete;
+        MemCharge& operator=(const MemCharge&) = delete;
+
+        void Set(std::int64_t bytes)
+        {
+            m_counter->Add(bytes - m_bytes);
+            m_bytes = bytes;
+        }
+        std::int64_t Bytes() const { return m_bytes; }
+
+    private:
+        MemCounter*  m_counter;
+        std::int64_t m_bytes{ 0 };
+    };
+
+    namespace MemStats
+    {
+        // Same name returns the same counter; the reference stays valid for the process.
+        // Takes a lock: cache the result (e.g. in a function-local static).
+        MemCounter& Register(const char* name, MemKind kind);
+
+        struct Entry
+        {
+            const char*  name{};
+            MemKind      kind{};
+            std::int64_t current{}, peak{};
+        };
+        void Snapshot(std::vector<Entry>& out);  // registration order
+
+        // Per-kind totals; the peak is the high-water mark of the sum, not a sum of peaks.
+        std::int64_t Total(MemKind kind);
+        std::int64_t TotalPeak(MemKind kind);
+
+        const char* KindName(MemKind kind);
+
+        // Human-readable table (one counter per line, then per-kind totals) for Log::Info.
+        std::string Format();
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace MI
+{
+    // Bounded lock-free queue for fixed-size commands: any number of producer threads, one
+    // consumer (Vyukov's bounded MPMC array queue with the consumer side simplified). Push
+    // never blocks; a full queue returns false and the caller decides what to drop.
+    template <class T, std::size_t N>
+    class MpscQueue
+    {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+        static_assert(std::is_trivially_copyable_v<T>, "commands are copied by value");
+
+    public:
+        MpscQueue()
+        {
+            for (std::size_t i = 0; i < N; ++i) {
+                m_cells[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        static constexpr std::size_t Capacity() { return N; }
+
+        // Any thread.
+        bool TryPush(const T& value)
+        {
+            auto pos = m_tail.load(std::memory_order_relaxed);
+            for (;;) {
+                auto&      cell = m_cells[pos & (N - 1)];
+                const auto seq = cell.seq.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                if (diff == 0) {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        cell.value = value;
+                        cell.seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;  // the consumer hasn't freed this cell yet: full
+                } else {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Consumer thread only.
+        bool TryPop(T& out)
+        {
+            auto&      cell = m_cells[m_head & (N - 1)];
+            const auto seq = cell.seq.load(std::memory_order_acquire);
+            if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(m_head + 1) < 0) {
+                return false;  // empty, or the producer that claimed it hasn't finished writing
+            }
+            out = cell.value;
+            cell.seq.store(m_head + N, std::memory_order_release);
+            ++m_head;
+            return true;
+        }
+
+        // Consumer thread only: pop at most `max` (default: what fits in one lap) into fn.
+        template <class Fn>
+        std::size_t Drain(Fn&& fn, std::size_t max = N)
+        {
+            std::size_t n = 0;
+            T           value;
+            while (n < max && TryPop(value)) {
+                fn(value);
+                ++n;
+            }
+            return n;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<std::size_t> seq;
+            T                        value;
+        };
+
+        alignas(64) std::array<Cell, N> m_cells;
+        alignas(64) std::atomic<std::size_t> m_tail{ 0 };  // next slot producers claim
+        alignas(64) std::size_t m_head{ 0 };               // consumer only
+    };
+}
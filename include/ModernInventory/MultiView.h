@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MI
+{
+    // Pixels of one view's tile in the shared preview target.
+    struct ViewRect
+    {
+        std::uint32_t x{}, y{}, w{}, h{};
+
+        bool Empty() const { return w == 0 || h == 0; }
+        bool operator==(const ViewRect&) const = default;
+    };
+
+    // One camera on one clone variant (0 = the player's current outfit).
+    struct PreviewView
+    {
+        std::uint32_t variant{};
+        float         yawRad{}, pitchRad{}, distance{};
+
+        bool operator==(const PreviewView&) const = default;
+    };
+
+    // Render-side half of a multi-view pass (Preview3D in game, a counting fake in MI_bench).
+    class IMultiViewBackend
+    {
+    public:
+        virtual ~IMultiViewBackend() = default;
+
+        virtual bool BeginPass() = 0;                      // bind the shared target; false skips the pass
+        virtual void ClearTarget() = 0;                    // the whole target, gutters included
+        virtual bool ClearRect(const ViewRect& rect) = 0;  // false if partial clears are unsupported
+        virtual bool DrawView(const ViewRect& rect, const PreviewView& view) = 0;  // viewport + scene
+        virtual void EndPass() {}
+    };
+
+    // Several preview views laid out as tiles of one render target and drawn in a single pass:
+    // one target bind per frame, and only views whose camera, tile or clone variant changed are
+    // cleared and redrawn; the rest keep last frame's pixels. Portable: no D3D.
+    class MultiViewPass
+    {
+    public:
+        static constexpr std::uint32_t kGutter = 4;  // px between tiles
+
+        struct Stats
+        {
+            std::uint64_t passes{};        // frames that bound the target
+            std::uint64_t viewsDrawn{};
+            std::uint64_t viewsReused{};   // clean views left as they were
+            std::uint64_t viewsFailed{};   // DrawView false; retried next frame
+            std::uint64_t fullClears{};
+        };
+
+        // Up to three views side by side, more in a near-square grid; tiles split the target
+        // evenly with kGutter between them (leftover pixels stay at the right / bottom edge).
+        static void Layout(std::size_t count, std::uint32_t width, std::uint32_t height, std::vector<ViewRect>& out);
+
+        // Views in display order; entries that differ from the previous call become dirty and
+        // a different count re-lays the target out.
+        void SetViews(const std::vector<PreviewView>& views);
+        void SetTargetSize(std::uint32_t width, std::uint32_t height);
+        // Bumped when a variant's clone is rebuilt; dirties every view showing it.
+        void SetVariantGeneration(std::uint32_t variant, std::uint64_t generation);
+        void Invalidate();  // target contents lost (recreated)
+
+        // Draws the dirty views; returns how many were drawn.
+        std::uint32_t Render(IMultiViewBackend& backend);
+
+        std::size_t     Count() const { return m_slots.size(); }
+        const ViewRect& RectOf(std::size_t view) const { return m_slots[view].rect; }
+        bool            IsDirty(std::size_t view) const { return m_slots[view].dirty; }
+        const Stats&    GetStats() const { return m_stats; }
+
+    private:
+        struct Slot
+        {
+            PreviewView   view{};
+            ViewRect      rect{};
+            std::uint64_t generation{};  // variant generation the pixels show
+            bool          dirty{ true };
+        };
+
+        void Relayout();
+        std::uint64_t GenerationOf(std::uint32_t variant) const;
+
+        std::vector<Slot>          m_slots;
+        std::vector<ViewRect>      m_rects;        // scratch for Layout
+        std::vector<std::uint64_t> m_generations;  // by variant
+        std::vector<std::uint32_t> m_dirty;        // scratch for Render
+        std::uint32_t              m_width{}, m_height{};
+        bool                       m_clearAll{ true };  // gutters / stale tiles after a relayout
+        Stats                      m_stats;
+    };
+}
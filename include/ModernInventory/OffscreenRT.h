@@ -2,6 +2,9 @@
 
 #include <d3d11.h>
 
+#include "ModernInventory/GpuCalls.h"
+#include "ModernInventory/MemStats.h"
+
 namespace MI
 {
     class OffscreenRT
@@ -33,13 +36,16 @@ namespace MI
             td.Usage = D3D11_USAGE_DEFAULT;
             td.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
 
+            GpuCalls::Count(GpuCall::kCreateTexture2D);
             if (FAILED(m_device->CreateTexture2D(&td, nullptr, &m_tex))) {
                 return;
             }
+            GpuCalls::Count(GpuCall::kCreateRenderTargetView);
             if (FAILED(m_device->CreateRenderTargetView(m_tex, nullptr, &m_rtv))) {
                 Release();
                 return;
             }
+            GpuCalls::Count(GpuCall::kCreateShaderResourceView);
             if (FAILED(m_device->CreateShaderResourceView(m_tex, nullptr, &m_srv))) {
                 Release();
                 return;
@@ -55,16 +61,19 @@ namespace MI
             dd.SampleDesc.Count = 1;
             dd.Usage = D3D11_USAGE_DEFAULT;
             dd.BindFlags = D3D11_BIND_DEPTH_STENCIL;
+            GpuCalls::Count(GpuCall::kCreateTexture2D);
             if (SUCCEEDED(m_device->CreateTexture2D(&dd, nullptr, &m_depth))) {
                 D3D11_DEPTH_STENCIL_VIEW_DESC dsvd{};
                 dsvd.Format = dd.Format;
                 dsvd.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
                 dsvd.Texture2D.MipSlice = 0;
+                GpuCalls::Count(GpuCall::kCreateDepthStencilView);
                 m_device->CreateDepthStencilView(m_depth, &dsvd, &m_dsv);
             }
 
             m_w = width;
             m_h = height;
+            m_mem.Set(static_cast<std::int64_t>(width) * height * (m_depth ? 8 : 4));  // RGBA8 + D24S8
         }
 
         void Clear(float r, float g, float b, float a)
@@ -72,9 +81,14 @@ namespace MI
             if (!m_rtv)
                 return;
             const float col[4] = { r, g, b, a };
+            GpuCalls::Count(GpuCall::kOMSetRenderTargets);
             m_context->OMSetRenderTargets(1, &m_rtv, m_dsv);
+            GpuCalls::Count(GpuCall::kClearRenderTargetView);
             m_context->ClearRenderTargetView(m_rtv, col);
-            if (m_dsv) m_context->ClearDepthStencilView(m_dsv, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+            if (m_dsv) {
+                GpuCalls::Count(GpuCall::kClearDepthStencilView);
+                m_context->ClearDepthStencilView(m_dsv, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+            }
         }
 
         ID3D11ShaderResourceView* GetSRV() const { return m_srv; }
@@ -91,6 +105,7 @@ namespace MI
             if (m_dsv) { m_dsv->Release(); m_dsv = nullptr; }
             if (m_depth) { m_depth->Release(); m_depth = nullptr; }
             m_w = m_h = 0;
+            m_mem.Set(0);
         }
 
     private:
@@ -102,5 +117,6 @@ namespace MI
         ID3D11Texture2D*           m_depth{ nullptr };
         ID3D11DepthStencilView*    m_dsv{ nullptr };
         UINT                       m_w{ 0 }, m_h{ 0 };
+        MemCharge                  m_mem{ MemStats::Register("OffscreenRT/color+depth", MemKind::kGpu) };
     };
 }
@@ -0,0 +1,75 @@
+#pragma once
+
+// Public overlay API for other SKSE plugins: draw into ModernInventory's ImGui frame instead
+// of hooking Present and running an ImGui context of your own. Self-contained (no
+// ModernInventory or ImGui includes) so it can be copied into another project.
+//
+// After kPostLoad, send the request to "ModernInventory":
+//
+//     ModernInventoryAPI::InterfaceRequest req{ ModernInventoryAPI::kInterfaceVersion };
+//     SKSE::GetMessagingInterface()->Dispatch(ModernInventoryAPI::kMessageGetInterface,
+//                                             &req, sizeof(req), "ModernInventory");
+//     if (auto* api = static_cast<const ModernInventoryAPI::OverlayInterfaceV1*>(req.result)) { ... }
+//
+// A V2 table (api->version >= 2, cast to OverlayInterfaceV2) adds NoteText: pass each string
+// you are about to draw, so scripts our font atlas lacks (CJK names, Cyrillic...) are baked in
+// before the next frame instead of drawing as '?'.
+//
+// Callbacks run on the render thread between NewFrame and Render, every frame. Before
+// calling ImGui, point your ImGui copy at ours (it must be built from the same ImGui version,
+// see imguiVersion):
+//
+//     ImGui::SetAllocatorFunctions(api->imguiAlloc, api->imguiFree, api->imguiAllocUser);
+//     ImGui::SetCurrentContext(static_cast<ImGuiContext*>(api->GetImGuiContext()));
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ModernInventoryAPI
+{
+    inline constexpr std::uint32_t kMessageGetInterface = 0x4D494F56;  // 'MIOV'
+    inline constexpr std::uint32_t kInterfaceVersion = 2;
+
+    using DrawCallback = void (*)(void* user);
+    using OverlayHandle = std::uint64_t;  // 0 = failed
+
+    // Ordering: lower priority draws first (further back). ModernInventory's own panel is 0.
+    struct OverlayInterfaceV1
+    {
+        std::uint32_t version;        // kInterfaceVersion this table implements
+        const char*   imguiVersion;   // IMGUI_VERSION ModernInventory was built with
+
+        // Null until the first Present has initialized ImGui; query it from the callback.
+        void* (*GetImGuiContext)();
+        void* (*imguiAlloc)(std::size_t size, void* user);
+        void  (*imguiFree)(void* ptr, void* user);
+        void*   imguiAllocUser;
+
+        // Lock-free, any thread. name must stay valid until Unregister.
+        OverlayHandle (*Register)(const char* name, std::int32_t priority, DrawCallback fn, void* user);
+        bool          (*Unregister)(OverlayHandle handle);
+    };
+
+    // V1 followed by the additions of version 2; the V1 part is laid out identically.
+    struct OverlayInterfaceV2
+    {
+        std::uint32_t version;
+        const char*   imguiVersion;
+        void* (*GetImGuiContext)();
+        void* (*imguiAlloc)(std::size_t size, void* user);
+        void  (*imguiFree)(void* ptr, void* user);
+        void*   imguiAllocUser;
+        OverlayHandle (*Register)(const char* name, std::int32_t priority, DrawCallback fn, void* user);
+        bool          (*Unregister)(OverlayHandle handle);
+
+        // From a draw callback only: UTF-8 text about to be drawn (size bytes, no terminator
+        // needed). A bit test per character when the atlas already covers it.
+        void (*NoteText)(const char* utf8, std::size_t size);
+    };
+
+    struct InterfaceRequest
+    {
+        std::uint32_t version;         // highest version the caller understands
+        const void*   result{ nullptr };  // the newest table <= version (check its ->version), or null
+    };
+}
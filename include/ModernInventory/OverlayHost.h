@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ModernInventory/OverlayRegistry.h"
+
+namespace MI
+{
+    // The registry Present_Hook dispatches every frame (our panel + external overlays).
+    OverlayRegistry& GetOverlayRegistry();
+
+    // SKSE messaging: answers ModernInventoryAPI::kMessageGetInterface requests from other
+    // plugins (see OverlayAPI.h). Returns true if the message was ours.
+    bool HandleOverlayMessage(std::uint32_t type, void* data, std::uint32_t dataLen);
+}
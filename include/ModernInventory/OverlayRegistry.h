@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace MI
+{
+    // Draw callbacks sharing our single ImGui frame (our own panel and other plugins' overlays
+    // registered through the SKSE messaging API). Registration is lock-free from any thread:
+    // a fixed slot is claimed with one CAS and published seqlock-style, so Dispatch never
+    // waits on it. Callbacks run in ascending priority (ties: registration order).
+    class OverlayRegistry
+    {
+    public:
+        static constexpr std::size_t kCapacity = 64;
+
+        using Callback = void (*)(void* user);
+        using Handle = std::uint64_t;  // 0 = invalid
+        static constexpr Handle kInvalid = 0;
+
+        struct Stats
+        {
+            std::atomic<std::uint64_t> registered{};
+            std::atomic<std::uint64_t> unregistered{};
+            std::atomic<std::uint64_t> rejected{};  // full, or null callback
+            std::atomic<std::uint64_t> reorders{};  // dispatch order rebuilds
+        };
+
+        // Any thread. name must outlive the registration. kInvalid when all slots are taken.
+        Handle Register(const char* name, std::int32_t priority, Callback fn, void* user);
+
+        // Any thread. A Dispatch already in progress on the render thread may still make one
+        // last call; unregister from inside the callback (or the render thread) to avoid that.
+        bool Unregister(Handle handle);
+
+        // Single dispatching thread (Present). Returns the number of callbacks run.
+        std::size_t Dispatch();
+
+        std::size_t   Size() const { return m_count.load(std::memory_order_relaxed); }
+        const Stats&  GetStats() const { return m_stats; }
+
+    private:
+        // state = seq << 2 | phase; seq changes on every claim so handles can't go stale
+        enum Phase : std::uint32_t { kFree = 0, kWriting = 1, kReady = 2 };
+
+        struct Slot
+        {
+            std::atomic<std::uint32_t> state{ kFree };
+            std::atomic<Callback>      fn{ nullptr };
+            std::atomic<void*>         user{ nullptr };
+            std::atomic<const char*>   name{ nullptr };
+            std::atomic<std::int32_t>  priority{ 0 };
+            std::atomic<std::uint64_t> serial{ 0 };  // registration order (tie-break)
+        };
+
+        void Reorder();
+
+        std::array<Slot, kCapacity> m_slots;
+        std::atomic<std::uint64_t>  m_generation{ 1 };  // bumped on every publish / removal
+        std::atomic<std::uint64_t>  m_serial{ 0 };
+        std::atomic<std::size_t>    m_count{ 0 };
+        Stats                       m_stats;
+
+        // Dispatch thread only: slots in call order with the state they were sorted under
+        std::uint64_t                          m_seenGeneration{ 0 };
+        std::array<std::uint8_t, kCapacity>    m_order{};
+        std::array<std::uint32_t, kCapacity>   m_orderState{};
+        std::size_t                            m_orderCount{ 0 };
+    };
+}
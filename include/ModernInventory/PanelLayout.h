@@ -0,0 +1,21 @@
+#pragma once
+
+#include <algorithm>
+
+namespace MI::Panel
+{
+    struct Rect
+    {
+        float x{}, y{}, w{}, h{};
+    };
+
+    // Right-side panel only (leave SkyUI left side visible): ratio of screen width,
+    // at least minWidth, but always keeping a small left margin.
+    inline Rect ComputeRightPanel(float screenW, float screenH, float ratio, float minWidth)
+    {
+        const float maxWidth = screenW - 40.0f; // keep a small left margin
+        const float target = (std::max)(minWidth, screenW * ratio);
+        const float panelWidth = (std::min)(target, maxWidth);
+        return Rect{ screenW - panelWidth, 0.0f, panelWidth, screenH };
+    }
+}
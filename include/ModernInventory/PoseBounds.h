@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "ModernInventory/XformMath.h"
+
+namespace MI::PoseBounds
+{
+    // Transform each bone-space bound by its bone's current world transform and
+    // union the results. Cost is linear in bone count; no vertices are touched.
+    // Returns false (and leaves outputs untouched) when there is nothing to bound.
+    // boneWorld and boneLocal must have the same length.
+    bool Compute(std::span<const Math::Xform> boneWorld,
+                 std::span<const Math::Sphere> boneLocal,
+                 Math::Sphere& outSphere,
+                 Math::Aabb* outBox = nullptr);
+}
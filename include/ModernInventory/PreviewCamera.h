@@ -1,7 +1,5 @@
 ﻿#pragma once
 
-#include <RE/N/NiBound.h>
-
 namespace MI
 {
     struct PreviewCamera
@@ -14,14 +12,29 @@ namespace MI
 
     namespace Camera
     {
+        // Compute simple camera parameters to fit a sphere of the given radius in the RT.
+        // Portable (no RE types) so it can be benchmarked off-target.
+        PreviewCamera ComputeFullBodyFromRadius(float boundRadius,
+                                                unsigned rtWidth,
+                                                unsigned rtHeight,
+                                                float fovYDeg,
+                                                float fitMargin,
+                                                float yawDeg,
+                                                float pitchDeg);
+
         // Compute simple camera parameters to fit a full body in the given RT size.
-        PreviewCamera ComputeFullBody(const RE::NiBound& bound,
+        // Bound is any type with a `radius` (RE::NiBound, Math::Sphere).
+        template <class Bound>
+        PreviewCamera ComputeFullBody(const Bound& bound,
                                       unsigned rtWidth,
                                       unsigned rtHeight,
                                       float fovYDeg,
                                       float fitMargin,
                                       float yawDeg,
-                                      float pitchDeg);
+                                      float pitchDeg)
+        {
+            return ComputeFullBodyFromRadius(bound.radius, rtWidth, rtHeight, fovYDeg, fitMargin, yawDeg, pitchDeg);
+        }
     }
 }
 
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "ModernInventory/LatencyHistogram.h"
+#include "ModernInventory/MpscQueue.h"
+#include "ModernInventory/VariantCache.h"
+
+namespace MI
+{
+    class EventRecorder;
+    class IGameWorld;
+
+    // Decision logic of the preview flow (inventory open/close, equip, per-frame render),
+    // kept free of engine types: in game it drives LiveGameWorld, in the replay tool a
+    // headless world. Every input can be recorded for later replay.
+    //
+    // Event sinks run on game threads; they only post fixed-size commands into a lock-free
+    // queue. The render thread applies them (ProcessCommands, also done by OnFrame), so all
+    // world / Preview3D state is touched from one thread.
+    class PreviewController
+    {
+    public:
+        enum class Stage : std::uint8_t
+        {
+            kMenu,     // open/close handling (excluding the rebuild)
+            kRebuild,  // preview clone rebuild
+            kRender,   // per-frame size + render
+            kVariant,  // hover variant builds (on demand and prefetched)
+            kCount
+        };
+        static constexpr std::size_t kStageCount = static_cast<std::size_t>(Stage::kCount);
+
+        struct Stats
+        {
+            std::atomic<std::uint64_t> frames{};
+            std::atomic<std::uint64_t> renderedFrames{};
+            std::atomic<std::uint64_t> rebuilds{};
+            std::atomic<std::uint64_t> menuOpens{};
+            std::atomic<std::uint64_t> equips{};
+            std::atomic<std::uint64_t> resizes{};
+            std::atomic<std::uint64_t> exports{};
+            std::atomic<std::uint64_t> prebuilds{};           // clones started from the hotkey
+            std::atomic<std::uint64_t> prebuildHits{};        // ... that a menu open reused
+            std::atomic<std::uint64_t> prebuildsDiscarded{};  // ... dropped after the timeout
+            std::atomic<std::uint64_t> cloneReuses{};         // opens that kept the cached clone
+            std::atomic<std::uint64_t> cloneEvictions{};      // idle clones freed under memory pressure
+            std::atomic<std::uint64_t> hoverChanges{};        // hovered row changed while open
+            std::atomic<std::uint64_t> variantsFailed{};      // hovered item couldn't be swapped in
+            std::atomic<std::uint64_t> commandsDropped{};  // queue full
+            std::atomic<std::uint64_t> stageCalls[kStageCount]{};
+            std::atomic<std::uint64_t> stageNs[kStageCount]{};
+
+            // Render thread only
+            LatencyHistogram frameNs;          // controller time per open frame
+            LatencyHistogram openToUsefulUs;   // menu open -> first frame showing a clone (event clock)
+            LatencyHistogram reopenToUsefulUs; // ... for every open after the first
+        };
+
+        explicit PreviewController(IGameWorld& world) : m_world(world) {}
+
+        void SetRecorder(EventRecorder* recorder) { m_recorder = recorder; }
+
+        // Hotkey prebuild: a menu open within timeoutUs of OnHotkey reuses the clone built
+        // then; otherwise the clone is discarded. 0 disables.
+        void SetPrebuildTimeout(std::uint64_t timeoutUs) { m_prebuildTimeoutUs = timeoutUs; }
+
+        // The clone is kept while the menu is closed and reused by the next open if
+        // IGameWorld::PreviewFingerprint still matches. After idleUs closed it is freed when
+        // the world reports memory pressure. 0 keeps it until the inputs change.
+        void SetEvictIdle(std::uint64_t idleUs) { m_evictIdleUs = idleUs; }
+
+        // Hover preview: the hovered item is shown on the clone, from an LRU of cacheSize
+        // variants keyed by (clone fingerprint, item). Each open frame builds up to
+        // prefetchPerFrame variants for the rows next to the cursor, so scrolling finds them
+        // built. cacheSize 0 disables it.
+        void SetHoverPreview(std::uint32_t cacheSize, std::uint32_t prefetchPerFrame)
+        {
+            m_variantCapacity = cacheSize;
+            m_prefetchPerFrame = prefetchPerFrame;
+        }
+
+        // Game threads (event sinks): enqueue only, never block.
+        void OnMenu(bool opening);
+        void OnEquip();
+        void OnExport();  // save the preview on the next rendered frame
+        void OnHotkey();  // inventory key pressed: the menu is probably about to open
+
+        // Render thread: apply queued commands. Present calls it before drawing; OnFrame
+        // calls it too, so a headless driver only needs OnFrame.
+        void ProcessCommands();
+
+        // Render thread, once per Present. Pass the preview pane size while the panel is
+        // shown and 0x0 otherwise.
+        void OnFrame(unsigned paneWidth, unsigned paneHeight);
+
+        bool         IsOpen() const { return m_open.load(std::memory_order_acquire); }
+        const Stats& GetStats() const { return m_stats; }
+        // Render thread only
+        const VariantCache::Stats& GetVariantStats() const { return m_variants.GetStats(); }
+
+        static constexpr std::size_t kQueueCapacity = 256;
+
+    private:
+        struct Command
+        {
+            enum class Type : std::uint8_t { kMenuOpen, kMenuClose, kEquip, kExport, kPrebuild };
+
+            Type          type{};
+            std::uint64_t timeUs{};  // event clock when posted
+        };
+
+        void Post(Command::Type type, std::uint64_t nowUs);
+        void Apply(const Command& cmd);
+        void Rebuild();
+        bool EnsureClone();  // rebuild unless the cached clone matches; true if rebuilt
+        void DropClone();
+        void DropVariants();
+        void UpdateHover();  // show the hovered row's variant, then prefetch around it
+        std::uint32_t BuildVariant(const VariantKey& key, bool prefetched);  // slot, or kNone
+        void AddStage(Stage stage, std::uint64_t ns);
+
+        IGameWorld&                 m_world;
+        std::atomic<EventRecorder*> m_recorder{ nullptr };
+        MpscQueue<Command, kQueueCapacity> m_commands;
+        std::atomic<bool>           m_open{ false };
+        std::atomic<std::uint64_t>  m_prebuildTimeoutUs{ 0 };
+        std::atomic<std::uint64_t>  m_evictIdleUs{ 0 };
+        std::atomic<std::uint32_t>  m_variantCapacity{ 0 };
+        std::atomic<std::uint32_t>  m_prefetchPerFrame{ 0 };
+        // Render thread only
+        bool                        m_awaitingUseful{ false };
+        std::uint64_t               m_openedAtUs{ 0 };
+        std::uint64_t               m_closedAtUs{ 0 };
+        std::uint64_t               m_nextPressureCheckUs{ 0 };
+        bool                        m_reopen{ false };        // current open is not the first
+        bool                        m_cloneValid{ false };    // the world holds a clone ...
+        std::uint64_t               m_cloneFingerprint{ 0 };  // ... built from these inputs
+        bool                        m_prebuilt{ false };  // speculative clone waiting for an open
+        std::uint64_t               m_prebuiltAtUs{ 0 };
+        unsigned                    m_paneW{ 0 }, m_paneH{ 0 };
+        VariantCache                m_variants;
+        HoverPrefetch               m_prefetch;
+        std::uint32_t               m_hoverRow{ VariantCache::kNone };
+        std::uint32_t               m_shownVariant{ VariantCache::kNone };
+        bool                        m_hoverDirty{ false };  // re-resolve the hovered row's variant
+        Stats                       m_stats;
+    };
+
+    // In-game controller bound to LiveGameWorld(); defined on the plugin side only.
+    PreviewController& GetPreviewController();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ModernInventory/ImageExporter.h"
+#include "ModernInventory/MemStats.h"
+
+namespace MI
+{
+    // Saves preview frames to disk without stalling the render thread: Capture copies the
+    // region into a free READ staging slot and fences it with an event query; Poll maps slots
+    // whose fence has signalled (DO_NOT_WAIT) and hands the pixels to a background
+    // ImageExporter for encoding. Formats must be R8G8B8A8.
+    class PreviewExporter
+    {
+    public:
+        bool Init(ID3D11Device* device, ID3D11DeviceContext* context, std::uint32_t slots = 3);
+        void Shutdown();  // drops captures still in flight; finishes queued encodes
+
+        // Queue a copy of `box` (z 0..1) from src. False if every slot is still busy.
+        bool Capture(ID3D11Texture2D* src, const D3D11_BOX& box, std::string path, ImageFormat format);
+
+        // Call once per frame: read back finished copies and submit them for encoding.
+        void Poll();
+
+        bool HasPending() const;
+        const ImageExporter::Stats* GetStats() const { return m_writer ? &m_writer->GetStats() : nullptr; }
+
+    private:
+        struct Slot
+        {
+            Microsoft::WRL::ComPtr<ID3D11Texture2D> staging;
+            Microsoft::WRL::ComPtr<ID3D11Query>     fence;  // D3D11_QUERY_EVENT
+            UINT                                    w{}, h{};
+            bool                                    busy{ false };
+            std::string                             path;
+            ImageFormat                             format{ ImageFormat::kQoi };
+        };
+
+        bool EnsureSlot(Slot& slot, UINT w, UINT h, DXGI_FORMAT format);
+        void UpdateMemory();
+
+        ID3D11Device*                  m_device{ nullptr };
+        ID3D11DeviceContext*           m_context{ nullptr };
+        std::vector<Slot>              m_slots;
+        std::uint32_t                  m_next{ 0 };  // oldest busy slot (copies finish in order)
+        std::unique_ptr<ImageExporter> m_writer;     // started on the first capture
+        MemCharge m_stagingMem{ MemStats::Register("PreviewExporter/staging", MemKind::kGpu) };
+    };
+}
@@ -2,10 +2,15 @@
 
 #include <RE/N/NiSmartPointer.h>
 
+#include <vector>
+
+#include "ModernInventory/XformMath.h"
+
 namespace RE
 {
     class NiAVObject;
     class NiNode;
+    class NiBound;
 }
 
 namespace MI::PreviewGraph
@@ -16,5 +21,13 @@ namespace MI::PreviewGraph
 
     // Basic sanitation for previewing (disable app cull, ensure visible).
     void Sanitize(RE::NiAVObject* root);
+
+    // Pose-accurate bound: per-bone skin bounds transformed by the current bone world
+    // matrices and unioned (see PoseBounds). Returns false if root has no skinned geometry.
+    bool ComputePoseBound(RE::NiAVObject* root, RE::NiBound& out);
+
+    // The same per-bone skin bounds as world-space spheres (software silhouette input).
+    // Returns false if root has no skinned geometry.
+    bool CollectPoseSpheres(RE::NiAVObject* root, std::vector<Math::Sphere>& out);
 }
 
@@ -0,0 +1,67 @@
+#pragma once
+
+// Glue between engine math types and the portable MI::Math types (RE side only).
+
+#include <RE/N/NiBound.h>
+#include <RE/N/NiTransform.h>
+
+#include "ModernInventory/CameraMath.h"
+#include "ModernInventory/XformMath.h"
+
+namespace MI::Convert
+{
+    inline Math::Vec3 ToVec3(const RE::NiPoint3& p) { return Math::Vec3{ p.x, p.y, p.z }; }
+    inline RE::NiPoint3 ToNi(const Math::Vec3& v) { return RE::NiPoint3{ v.x, v.y, v.z }; }
+
+    inline Math::Xform ToXform(const RE::NiTransform& t)
+    {
+        Math::Xform out;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                out.rot[r][c] = t.rotate.entry[r][c];
+            }
+        }
+        out.pos = ToVec3(t.translate);
+        out.scale = t.scale;
+        return out;
+    }
+
+    inline void ToNi(const Math::Xform& x, RE::NiTransform& out)
+    {
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                out.rotate.entry[r][c] = x.rot[r][c];
+            }
+        }
+        out.translate = ToNi(x.pos);
+        out.scale = x.scale;
+    }
+
+    inline Math::Sphere ToSphere(const RE::NiBound& b) { return Math::Sphere{ ToVec3(b.center), b.radius }; }
+
+    inline RE::NiBound ToNi(const Math::Sphere& s)
+    {
+        RE::NiBound b;
+        b.center = ToNi(s.center);
+        b.radius = s.radius;
+        return b;
+    }
+
+    // NiFrustum (NiCamera::frustum). A template so the clip plane spelling the headers have
+    // (fNear / fFar, or near / far) is the one compiled.
+    template <class NiFrustum>
+    inline void ToNi(const Math::Frustum& f, NiFrustum& out)
+    {
+        out.left = f.left;
+        out.right = f.right;
+        out.top = f.top;
+        out.bottom = f.bottom;
+        if constexpr (requires { out.fNear; }) {
+            out.fNear = f.nearZ;
+            out.fFar = f.farZ;
+        } else {
+            out.near = f.nearZ;
+            out.far = f.farZ;
+        }
+    }
+}
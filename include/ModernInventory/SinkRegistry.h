@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace MI
+{
+    // The plugin's event sinks, each with the calls that add it to and remove it from its
+    // event source. A sink is attached while at least one reason holds: kAlways for the
+    // menu / equip sinks, narrower ones for high-frequency sinks such as input, which then
+    // costs nothing while no bound key can do anything. Need is idempotent, so the
+    // kDataLoaded / kNewGame / kPostLoadGame handlers and menu events can all re-assert the
+    // state they want without double registration. A failed attach (event source not there
+    // yet) leaves the sink detached; the next Need retries. Thread-safe; the hooks run under
+    // the registry's lock. Portable: no engine types.
+    class SinkRegistry
+    {
+    public:
+        using SinkId = std::uint32_t;
+        using Reasons = std::uint32_t;  // bit set, caller-defined below kAlways
+        static constexpr Reasons kAlways = 1u << 31;
+
+        struct Hooks
+        {
+            std::function<bool()> attach;  // false: the source is missing, nothing was added
+            std::function<void()> detach;
+        };
+
+        struct Stats
+        {
+            std::uint64_t attaches{};
+            std::uint64_t detaches{};
+            std::uint64_t redundant{};  // Need calls that changed nothing attached
+            std::uint64_t failures{};   // attach hooks that returned false
+        };
+
+        SinkId Add(std::string name, Hooks hooks);
+
+        // Sets or clears reason; attaches on the first reason, detaches when none is left.
+        // Returns whether the sink is attached afterwards.
+        bool Need(SinkId id, Reasons reason, bool on);
+        bool Attach(SinkId id) { return Need(id, kAlways, true); }
+
+        bool    Attached(SinkId id) const;
+        Reasons ReasonsOf(SinkId id) const;
+
+        Stats       GetStats() const;
+        std::string Report() const;  // one line per sink: attached, reasons, attach count
+
+    private:
+        struct Sink
+        {
+            std::string   name;
+            Hooks         hooks;
+            Reasons       reasons{};
+            bool          attached{ false };
+            std::uint32_t attachCount{};
+        };
+
+        void Sync(Sink& sink);  // attach / detach to match sink.reasons (lock held)
+
+        mutable std::mutex m_lock;
+        std::vector<Sink>  m_sinks;
+        Stats              m_stats;
+    };
+}
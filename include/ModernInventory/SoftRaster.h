@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ModernInventory/XformMath.h"
+
+// CPU fallback for the paperdoll when the engine scene path is unavailable: a tiled,
+// binned triangle rasterizer (SSE2 edge functions where available, depth buffer, flat
+// Lambert shading) spread across a small worker pool. Output is RGBA8 ready for upload
+// into the preview texture (DXGI_FORMAT_R8G8B8A8_UNORM).
+namespace MI::SoftRaster
+{
+    struct Mesh
+    {
+        std::vector<Math::Vec3>    positions;
+        std::vector<std::uint32_t> indices;   // triangle list, counter-clockwise seen from outside
+
+        void Clear()
+        {
+            positions.clear();
+            indices.clear();
+        }
+
+        // UV sphere (rings >= 2, segments >= 3); used for the pose-bound silhouette.
+        void AddSphere(const Math::Sphere& s, unsigned rings = 6, unsigned segments = 10);
+    };
+
+    // Orbit-style look-at camera; up is +Z (Skyrim world convention).
+    struct View
+    {
+        Math::Vec3 eye{};
+        Math::Vec3 target{};
+        float      fovYDeg{ 50.0f };
+        float      nearZ{ 1.0f };
+    };
+
+    struct Image
+    {
+        std::uint32_t              width{}, height{};
+        std::uint32_t              stride{};  // pixels per row, multiple of 4
+        std::vector<std::uint32_t> rgba;      // 0xAABBGGRR (R in the low byte)
+        std::vector<float>         depth;     // 1/z, 0 = empty
+
+        void Resize(std::uint32_t w, std::uint32_t h);
+        void Clear(std::uint32_t color);  // also resets depth
+
+        std::uint32_t  At(std::uint32_t x, std::uint32_t y) const { return rgba[y * stride + x]; }
+    };
+
+    inline constexpr std::uint32_t kTileSize = 64;
+
+    class Rasterizer
+    {
+    public:
+        // workers: extra threads besides the caller; kAuto picks hardware_concurrency - 1 (max 7).
+        static constexpr unsigned kAuto = ~0u;
+        explicit Rasterizer(unsigned workers = kAuto);
+        ~Rasterizer();
+
+        Rasterizer(const Rasterizer&) = delete;
+        Rasterizer& operator=(const Rasterizer&) = delete;
+
+        unsigned Workers() const { return static_cast<unsigned>(m_threads.size()); }
+
+        // Depth-tested draw over the current image contents; rgba is the base colour,
+        // scaled per triangle by a fixed key light. Returns the number of triangles binned.
+        std::size_t Draw(const Mesh& mesh, const View& view, std::uint32_t rgba, Image& image);
+
+    private:
+        struct Tri
+        {
+            float         a[3], b[3], c[3];  // edge functions E(x, y) = a*x + b*y + c, >= 0 inside
+            float         za, zb, zc;        // 1/z plane
+            std::int32_t  minX, minY, maxX, maxY;
+            std::uint32_t color;
+        };
+
+        struct Projected
+        {
+            float x, y, invZ;
+            bool  valid;  // in front of the near plane
+        };
+
+        void Setup(const Mesh& mesh, const View& view, std::uint32_t rgba, const Image& image);
+        void Bin(const Image& image);
+        void RunTiles();
+        void RasterTile(std::uint32_t tile);
+        void WorkerLoop();
+
+        std::vector<Projected>                  m_verts;
+        std::vector<Tri>                        m_tris;
+        std::vector<std::vector<std::uint32_t>> m_bins;
+        std::uint32_t                           m_tilesX{}, m_tilesY{};
+        Image*                                  m_image{ nullptr };
+
+        // Pool: each Draw bumps m_generation; workers pull tiles from m_nextTile.
+        std::vector<std::thread>   m_threads;
+        std::mutex                 m_lock;
+        std::condition_variable    m_wake;
+        std::condition_variable    m_done;
+        std::uint64_t              m_generation{ 0 };
+        unsigned                   m_busy{ 0 };
+        bool                       m_quit{ false };
+        std::atomic<std::uint32_t> m_nextTile{ 0 };
+    };
+
+    // Pack 8-bit channels into the Image pixel layout.
+    constexpr std::uint32_t Rgba(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255)
+    {
+        return static_cast<std::uint32_t>(r) | (static_cast<std::uint32_t>(g) << 8) |
+               (static_cast<std::uint32_t>(b) << 16) | (static_cast<std::uint32_t>(a) << 24);
+    }
+}
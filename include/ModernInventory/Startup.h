@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ModernInventory/InitGraph.h"
+
+namespace MI
+{
+    // The plugin's init graph (built in main.cpp, in this order). Log and config are pulled in
+    // by their first use (Log::*, ConfigSys::Get), so neither may use the other while it runs.
+    enum class StartupStep : InitGraph::StepId
+    {
+        kMessaging,     // sync: SKSE listeners
+        kPresentHook,   // sync: D3D11CreateDeviceAndSwapChain hook (before the game's device exists)
+        kLog,           // background: ModernInventory.log
+        kConfig,        // lazy: ModernInventory.ini
+        kHookFallback,  // background: throwaway swapchain probe if the CreateDevice hook failed
+        kController,    // background: controller settings + optional event capture
+        kSinks,         // lazy: menu / equip / input sinks, required on kDataLoaded
+        kCount
+    };
+
+    InitGraph& GetInitGraph();
+
+    inline bool RequireStartup(StartupStep step)
+    {
+        return GetInitGraph().Require(static_cast<InitGraph::StepId>(step));
+    }
+}
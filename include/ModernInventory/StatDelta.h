@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace MI
+{
+    // Perk / skill multiplier group of an item
+    enum class ItemKind : std::uint8_t
+    {
+        kOther,  // not compared (potions, books, misc)
+        kLightArmor,
+        kHeavyArmor,
+        kClothing,
+        kOneHanded,
+        kTwoHanded,
+        kRanged,  // bows, crossbows, staves
+        kCount
+    };
+    inline constexpr std::size_t kItemKindCount = static_cast<std::size_t>(ItemKind::kCount);
+
+    // Rated against worn gear at all (kOther rows keep a zero delta)
+    constexpr bool IsComparable(ItemKind kind) { return kind != ItemKind::kOther && kind < ItemKind::kCount; }
+
+    // Rated by armor value; the other comparable kinds are rated by damage
+    constexpr bool IsArmor(ItemKind kind)
+    {
+        return kind == ItemKind::kLightArmor || kind == ItemKind::kHeavyArmor || kind == ItemKind::kClothing;
+    }
+
+    // One inventory row as read from the game
+    struct ItemStats
+    {
+        float         base{};    // armor rating or weapon damage before skill / perk multipliers
+        float         bonus{};   // flat points added after them (tempering)
+        float         weight{};
+        float         value{};   // gold, enchantments included
+        std::uint32_t slots{};   // biped slot bits, kWeaponSlot for weapons, 0 = not wearable
+        ItemKind      kind{};
+    };
+
+    // The item list as columns, one element per row, so deltas run four rows per instruction
+    struct ItemColumns
+    {
+        std::vector<float>         base, bonus, weight, value;
+        std::vector<std::uint32_t> slots;
+        std::vector<std::uint32_t> kind;  // ItemKind widened to the lane size of the compares
+
+        void        Clear();
+        void        Reserve(std::size_t n);
+        void        Add(const ItemStats& item);
+        std::size_t Size() const { return base.size(); }
+    };
+
+    // "+12 armor / -3.5 weight" for a row: the item against what it would replace
+    struct StatDelta
+    {
+        float rating{}, weight{}, value{};
+    };
+
+    struct StatDeltaColumns
+    {
+        std::vector<float> rating, weight, value;
+
+        StatDelta At(std::size_t row) const { return { rating[row], weight[row], value[row] }; }
+    };
+
+    // Equip comparisons for a whole item list. A row's delta is its effective rating
+    // (base * the multiplier of its kind + bonus), weight and value minus the sums over the
+    // worn pieces sharing a slot with it. Evaluated over ItemColumns with SSE2 (scalar
+    // elsewhere) and cached until the items or the equipped-set version change, so frames
+    // in between only read results. Portable: no engine types.
+    class StatDeltaEngine
+    {
+    public:
+        static constexpr std::uint32_t kWeaponSlot = 1u << 31;  // biped slot 61 (FX01) stands for the weapon hand
+        static constexpr std::size_t   kMaxEquipped = 32;
+
+        struct Stats
+        {
+            std::uint64_t evaluations{};  // full passes over the columns
+            std::uint64_t cacheHits{};    // Evaluate calls answered from the last pass
+        };
+
+        // Rows to compare; any edit through this reference re-evaluates on the next call.
+        ItemColumns& EditItems();
+        const ItemColumns& Items() const { return m_items; }
+
+        // What the player wears (pieces past kMaxEquipped are ignored) and the multiplier of each
+        // ItemKind. version identifies the set: equips, perks, skills and enchantments change
+        // it; an unchanged version is ignored, so this can be called every frame.
+        void SetEquipped(std::span<const ItemStats> worn, const std::array<float, kItemKindCount>& multipliers,
+                         std::uint64_t version);
+
+        const StatDeltaColumns& Evaluate();
+        StatDelta At(std::size_t row) { return Evaluate().At(row); }
+
+        const Stats& GetStats() const { return m_stats; }
+
+        // One pass without the cache; simd = false runs the scalar loop (benchmarks compare both).
+        struct Equipped
+        {
+            std::array<std::uint32_t, kMaxEquipped> slots{};
+            std::array<float, kMaxEquipped>         rating{}, weight{}, value{};
+            std::size_t                             count{};
+            std::array<float, kItemKindCount>       multipliers{};
+        };
+        static void Compute(const ItemColumns& items, const Equipped& equipped, StatDeltaColumns& out, bool simd = true);
+
+    private:
+        ItemColumns      m_items;
+        Equipped         m_equipped;
+        std::uint64_t    m_version{};
+        bool             m_haveEquipped{ false };
+        bool             m_dirty{ true };
+        StatDeltaColumns m_results;
+        Stats            m_stats;
+    };
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "ModernInventory/MemStats.h"
+
+namespace MI
+{
+    using StringHandle = std::uint32_t;
+    inline constexpr StringHandle kNoString = 0xFFFFFFFF;
+
+    // Interned UTF-8 strings (item names, enchantment and tooltip text) packed into large
+    // chunks and named by 32-bit handles. Each string is stored once, NUL-terminated, with
+    // its code point count, a lowercase form for search (shared with the text when it has no
+    // capitals) and a collation rank, so rendering, search and sort read views instead of
+    // copying std::strings. Cleared per inventory session; Compact re-packs the survivors.
+    // Not thread-safe. Portable: no engine types.
+    class StringArena
+    {
+    public:
+        static constexpr std::size_t kChunkBytes = 64 * 1024;  // longer strings get a chunk of their own
+
+        struct Stats
+        {
+            std::uint64_t interns{};  // Intern calls
+            std::uint64_t hits{};     // ... that found the text already stored
+            std::uint64_t compactions{};
+        };
+
+        // Same text, same handle (byte-exact; "Iron" and "iron" are two strings).
+        StringHandle Intern(std::string_view text);
+        StringHandle Find(std::string_view text) const;  // kNoString if not interned
+
+        std::string_view View(StringHandle h) const { return { m_entries[h].text, m_entries[h].bytes }; }
+        const char*      CStr(StringHandle h) const { return m_entries[h].text; }
+        std::string_view Lower(StringHandle h) const { return { m_entries[h].lower, m_entries[h].bytes }; }  // ASCII folded
+        std::uint32_t    Length(StringHandle h) const { return m_entries[h].codepoints; }
+
+        // Position in name order: case-insensitive, then by bytes (NameCollation's order, so
+        // the ranks can be SortColumns::nameRank directly). Valid after UpdateRanks.
+        std::uint32_t Rank(StringHandle h) const { return m_entries[h].rank; }
+        void          UpdateRanks();  // no-op unless strings were added since the last call
+
+        // Handles whose lowercase form contains needleLower (already lowercase), in handle order
+        void Search(std::string_view needleLower, std::span<const StringHandle> among, std::vector<StringHandle>& out) const;
+
+        std::size_t Size() const { return m_entries.size(); }
+        std::size_t Bytes() const;      // chunks + entries + hash table
+        std::size_t UsedBytes() const;  // string bytes actually stored (text, lower forms, NULs)
+
+        // New session: forget every string but keep the chunks for reuse.
+        void Clear();
+        // Keep only the strings in live (rewritten to their new handles), packed into as few
+        // chunks as they need; the rest is freed. Returns the bytes released.
+        std::size_t Compact(std::span<StringHandle> live);
+
+        const Stats& GetStats() const { return m_stats; }
+
+    private:
+        struct Entry
+        {
+            const char*   text{};
+            const char*   lower{};  // == text when folding changes nothing
+            std::uint32_t bytes{};
+            std::uint32_t codepoints{};
+            std::uint32_t hash{};
+            std::uint32_t rank{};
+        };
+
+        struct Chunk
+        {
+            std::unique_ptr<char[]> data;
+            std::size_t             size{}, used{};
+        };
+
+        StringHandle FindOrAdd(std::string_view text, bool& found);
+        char*        Allocate(std::size_t bytes);
+        void         Rehash(std::size_t slots);
+        void         Insert(StringHandle h);
+        void         Account();
+
+        std::vector<Chunk>        m_chunks;
+        std::size_t               m_chunk{};  // the one being filled
+        std::vector<Entry>        m_entries;
+        std::vector<StringHandle> m_table;    // open addressing by hash, power of two
+        std::vector<StringHandle> m_scratch;  // UpdateRanks / Compact
+        bool                      m_ranksDirty{ false };
+        Stats                     m_stats;
+        MemCharge                 m_mem{ MemStats::Register("StringArena", MemKind::kCpu) };
+    };
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <vector>
+
+#include "ModernInventory/MemStats.h"
+#include "ModernInventory/UploadRing.h"
+
+namespace MI
+{
+    // Streams CPU-produced images (software preview, decoded thumbnails, charts) into a
+    // DEFAULT-usage texture without stalling the immediate context: the dirty region is
+    // written into a free staging slot, copied with CopySubresourceRegion and fenced with an
+    // event query. When all slots are still in flight the upload is deferred, not waited on.
+    // Formats must be 4 bytes per pixel (R8G8B8A8 / B8G8R8A8).
+    class TextureUploader
+    {
+    public:
+        bool Init(ID3D11Device* device, ID3D11DeviceContext* context, std::uint32_t slots = 3);
+        void Shutdown();
+
+        // Queue `region` of the CPU image (top-left origin, rowPitch bytes per row) for dst.
+        // Returns false when the GPU is behind; the region stays pending and is merged into
+        // the next call, which must pass the same (or a newer) image. An empty region just
+        // retries whatever is pending.
+        bool Upload(ID3D11Texture2D* dst, const void* pixels, UINT rowPitch, const UploadRing::Rect& region);
+
+        bool HasPending() const { return m_ring.HasDirty(); }
+        const UploadRing::Stats& GetStats() const { return m_ring.GetStats(); }
+
+    private:
+        void Poll();
+        bool EnsureStaging(const D3D11_TEXTURE2D_DESC& dstDesc);
+
+        ID3D11Device*        m_device{ nullptr };
+        ID3D11DeviceContext* m_context{ nullptr };
+        std::uint32_t        m_slotCount{ 3 };
+        UINT                 m_w{ 0 }, m_h{ 0 };
+        DXGI_FORMAT          m_format{ DXGI_FORMAT_UNKNOWN };
+
+        std::vector<Microsoft::WRL::ComPtr<ID3D11Texture2D>> m_staging;  // one per ring slot
+        std::vector<Microsoft::WRL::ComPtr<ID3D11Query>>     m_fences;   // D3D11_QUERY_EVENT per slot
+        UploadRing                                           m_ring;
+        MemCharge m_stagingMem{ MemStats::Register("TextureUploader/staging", MemKind::kGpu) };
+    };
+}
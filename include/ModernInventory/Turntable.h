@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace MI
+{
+    // Bookkeeping for a pre-baked turntable: N evenly spaced yaw angles of the current
+    // outfit rendered into tiles of one atlas. Baking is incremental (a few tiles per idle
+    // frame, nearest to the current yaw first); once complete, rotating the preview is a
+    // UV-rectangle selection. Portable: the D3D side lives in Preview3D.
+    class TurntableCache
+    {
+    public:
+        static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+
+        struct Tile
+        {
+            std::uint32_t x{}, y{}, w{}, h{};   // pixels in the atlas
+        };
+
+        struct UVRect
+        {
+            float u0{}, v0{}, u1{}, v1{};
+        };
+
+        // Two neighbouring frames and the weight of the second one (0 = frameA only).
+        struct Sample
+        {
+            std::uint32_t frameA{ kNone };
+            std::uint32_t frameB{ kNone };
+            float         blend{};
+        };
+
+        // Everything a baked frame depends on; any change invalidates the atlas.
+        struct Key
+        {
+            std::uint64_t cloneGeneration{};
+            std::uint32_t tileW{}, tileH{};
+            float         fovDeg{}, pitch{}, distance{};
+
+            bool operator==(const Key&) const = default;
+        };
+
+        // Lay out `frames` tiles of tileW x tileH in a near-square grid. Returns false (and
+        // disables the cache) if the atlas would exceed maxAtlasDim in either direction.
+        bool Configure(std::uint32_t frames, std::uint32_t tileW, std::uint32_t tileH, std::uint32_t maxAtlasDim);
+
+        // Compare against the key the current tiles were baked with; on mismatch all tiles
+        // are marked stale. Returns true if the cache was invalidated.
+        bool Validate(const Key& key);
+        void Invalidate();
+
+        // yawRad may be any finite angle (wrapped); non-finite angles count as 0.
+        std::uint32_t NextToBake(float yawRad) const;
+        void          MarkBaked(std::uint32_t frame);
+
+        Sample Lookup(float yawRad, bool blend) const;
+        float  FrameYaw(std::uint32_t frame) const;
+        Tile   TileOf(std::uint32_t frame) const;
+        UVRect UVOf(std::uint32_t frame) const;
+
+        bool          Enabled() const { return m_frames > 0; }
+        bool          Complete() const { return Enabled() && m_bakedCount == m_frames; }
+        bool          IsBaked(std::uint32_t frame) const { return frame < m_frames && m_baked[frame]; }
+        std::uint32_t Frames() const { return m_frames; }
+        std::uint32_t BakedCount() const { return m_bakedCount; }
+        std::uint32_t AtlasWidth() const { return m_cols * m_tileW; }
+        std::uint32_t AtlasHeight() const { return m_rows * m_tileH; }
+
+    private:
+        std::uint32_t FrameAt(float yawRad, float* frac) const;
+
+        std::uint32_t             m_frames{ 0 };
+        std::uint32_t             m_cols{ 0 }, m_rows{ 0 };
+        std::uint32_t             m_tileW{ 0 }, m_tileH{ 0 };
+        std::uint32_t             m_bakedCount{ 0 };
+        std::vector<std::uint8_t> m_baked;
+        Key                       m_key{};
+        bool                      m_hasKey{ false };
+    };
+}
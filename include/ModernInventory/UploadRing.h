@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace MI
+{
+    // Bookkeeping for streaming CPU-produced images to the GPU through a small ring of
+    // staging slots. A slot is written on the CPU, copied into the destination texture and
+    // then stays in flight until the GPU signals its fence. When every slot is in flight
+    // Acquire fails instead of waiting (backpressure): the caller keeps its image and the
+    // dirty region accumulates until a slot frees up. Portable: the D3D side (staging
+    // textures, event queries) lives in TextureUploader.
+    class UploadRing
+    {
+    public:
+        static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+
+        struct Rect
+        {
+            std::uint32_t x{}, y{}, w{}, h{};
+
+            bool Empty() const { return w == 0 || h == 0; }
+        };
+
+        struct Stats
+        {
+            std::uint64_t uploads{};        // submitted slots
+            std::uint64_t pixels{};         // sum of submitted region areas
+            std::uint64_t backpressured{};  // Acquire calls that found no free slot
+            std::uint32_t maxInFlight{};
+        };
+
+        // slots >= 1; 2-3 covers one to two frames of GPU latency.
+        void Configure(std::uint32_t slots);
+        // Drop all state (device lost / resize); every slot is free again.
+        void Reset();
+
+        // Accumulate a changed region (union bounding box) until the next successful upload.
+        void MarkDirty(const Rect& r);
+        bool HasDirty() const { return !m_dirty.Empty(); }
+
+        // Free slot to write the pending dirty region into, or kNone when there is nothing to
+        // upload or every slot is still in flight. On success `region` receives the dirty
+        // rect and the pending dirty region is cleared.
+        std::uint32_t Acquire(Rect& region);
+        // The write failed (e.g. Map error): free the slot and restore the region as dirty.
+        void Abort(std::uint32_t slot, const Rect& region);
+        // Copy for the slot was queued; returns its fence (monotonic, starts at 1).
+        std::uint64_t Submit(std::uint32_t slot, const Rect& region);
+
+        // The GPU finished everything up to and including `fence` (in-order completion).
+        void Complete(std::uint64_t fence);
+
+        // Oldest in-flight slot (poll its fence first) or kNone.
+        std::uint32_t OldestInFlight() const;
+        std::uint64_t FenceOf(std::uint32_t slot) const { return m_slots[slot].fence; }
+        std::uint32_t InFlight() const { return m_inFlight; }
+        std::uint32_t Slots() const { return static_cast<std::uint32_t>(m_slots.size()); }
+
+        const Stats& GetStats() const { return m_stats; }
+
+    private:
+        enum class State : std::uint8_t
+        {
+            kFree,
+            kWriting,
+            kInFlight
+        };
+
+        struct Slot
+        {
+            State         state{ State::kFree };
+            std::uint64_t fence{};
+        };
+
+        std::vector<Slot> m_slots;
+        std::uint32_t     m_next{ 0 };       // round-robin start for Acquire
+        std::uint32_t     m_inFlight{ 0 };
+        std::uint64_t     m_lastFence{ 0 };
+        Rect              m_dirty{};
+        Stats             m_stats{};
+    };
+}
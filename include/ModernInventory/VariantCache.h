@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace MI
+{
+    // What a hover variant was built from: the base clone's inputs (IGameWorld::PreviewFingerprint)
+    // and the item swapped into it.
+    struct VariantKey
+    {
+        std::uint64_t base{};
+        std::uint32_t formID{};
+
+        bool operator==(const VariantKey&) const = default;
+    };
+
+    // Fixed-size LRU over hover-preview variants. Bookkeeping only: the owner keeps the built
+    // clones in slots of its own (Preview3D in game) and the cache says which slot holds what
+    // and which one to reuse next. A handful of entries, so lookups are a linear scan and
+    // nothing allocates after Reset. Portable: no engine types.
+    class VariantCache
+    {
+    public:
+        static constexpr std::uint32_t kNone = 0xFFFFFFFF;
+
+        struct Stats
+        {
+            std::uint64_t lookups{};         // hovers onto a previewable item
+            std::uint64_t hits{};            // ... already built
+            std::uint64_t prefetchHits{};    // ... built ahead by the prefetcher, first use
+            std::uint64_t misses{};          // ... not built yet: the caller builds it now
+            std::uint64_t prefetches{};
+            std::uint64_t prefetchWasted{};  // prefetched, dropped before anyone hovered it
+            std::uint64_t evictions{};
+        };
+
+        explicit VariantCache(std::uint32_t capacity = 0) { Reset(capacity); }
+
+        // Drop every entry and resize; 0 turns the cache off (Insert returns kNone).
+        void Reset(std::uint32_t capacity);
+        std::uint32_t Capacity() const { return static_cast<std::uint32_t>(m_entries.size()); }
+
+        // Hover: the slot holding key (now most recently used) or kNone; counted in Stats.
+        std::uint32_t Lookup(const VariantKey& key);
+        // Policy queries: like Lookup without touching recency or stats.
+        std::uint32_t Find(const VariantKey& key) const;
+
+        // Slot to build key into: a free one, else the least recently used that isn't pinned
+        // (the owner builds over whatever that slot held). kNone if every slot is pinned.
+        // A failed build stays cached, so it is neither retried nor prefetched again.
+        std::uint32_t Insert(const VariantKey& key, bool prefetched);
+        void Clear();  // base clone rebuilt or dropped: every variant is stale
+
+        // The slot on screen is never evicted (kNone unpins).
+        void Pin(std::uint32_t slot) { m_pinned = slot; }
+
+        bool              Occupied(std::uint32_t slot) const { return m_entries[slot].occupied; }
+        const VariantKey& KeyOf(std::uint32_t slot) const { return m_entries[slot].key; }
+        const Stats&      GetStats() const { return m_stats; }
+
+    private:
+        struct Entry
+        {
+            VariantKey    key{};
+            std::uint64_t lastUse{};
+            bool          occupied{};
+            bool          unusedPrefetch{};  // built ahead and not hovered yet
+        };
+
+        std::vector<Entry> m_entries;
+        std::uint64_t      m_clock{};
+        std::uint32_t      m_pinned{ kNone };
+        Stats              m_stats;
+    };
+
+    // Which row of the item list to build next while the cursor moves: the rows ahead in the
+    // direction the user is scrolling first (nearest first), then a few behind for a step back.
+    class HoverPrefetch
+    {
+    public:
+        static constexpr std::uint32_t kNoRow = 0xFFFFFFFF;
+
+        void SetWindow(std::uint32_t ahead, std::uint32_t behind)
+        {
+            m_ahead = ahead;
+            m_behind = behind;
+        }
+
+        // The cursor moved to row (kNoRow: off the list)
+        void OnHover(std::uint32_t row);
+        std::uint32_t Row() const { return m_row; }
+
+        // Nearest row in the window whose item isn't cached yet, or kNoRow. formOf(row) gives
+        // the row's previewable form (0 = nothing to swap in, e.g. potions).
+        template <class FormOf>
+        std::uint32_t Next(const VariantCache& cache, std::uint64_t base, std::uint32_t rows, FormOf&& formOf) const
+        {
+            if (m_row == kNoRow) {
+                return kNoRow;
+            }
+            const auto candidate = [&](std::uint32_t distance, bool forward) -> std::uint32_t {
+                const bool down = forward == (m_direction >= 0);
+                if (down ? distance >= rows - (std::min)(m_row, rows) : distance > m_row) {
+                    return kNoRow;
+                }
+                const auto row = down ? m_row + distance : m_row - distance;
+                const std::uint32_t form = formOf(row);
+                return form != 0 && cache.Find({ base, form }) == VariantCache::kNone ? row : kNoRow;
+            };
+            for (std::uint32_t d = 1; d <= m_ahead; ++d) {
+                if (const auto row = candidate(d, true); row != kNoRow) {
+                    return row;
+                }
+            }
+            for (std::uint32_t d = 1; d <= m_behind; ++d) {
+                if (const auto row = candidate(d, false); row != kNoRow) {
+                    return row;
+                }
+            }
+            return kNoRow;
+        }
+
+    private:
+        std::uint32_t m_row{ kNoRow };
+        int           m_direction{ 1 };  // +1 down the list, -1 up; a new list starts downwards
+        std::uint32_t m_ahead{ 4 };
+        std::uint32_t m_behind{ 2 };
+    };
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+// Portable transform math for the preview core (no RE / Windows includes).
+// Layouts mirror RE::NiPoint3 / RE::NiTransform so glue code can copy fields 1:1.
+
+#include <algorithm>
+#include <cmath>
+
+namespace MI::Math
+{
+    struct Vec3
+    {
+        float x{}, y{}, z{};
+    };
+
+    // Row-major rotation, translation and uniform scale (same semantics as NiTransform)
+    struct Xform
+    {
+        float rot[3][3]{ { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+        Vec3  pos{};
+        float scale{ 1.0f };
+    };
+
+    struct Sphere
+    {
+        Vec3  center{};
+        float radius{};
+    };
+
+    struct Aabb
+    {
+        Vec3 min{};
+        Vec3 max{};
+    };
+
+    inline Vec3 Rotate(const float (&m)[3][3], const Vec3& v)
+    {
+        return Vec3{
+            m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+            m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+            m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z
+        };
+    }
+
+    // p' = R * (s * p) + t
+    inline Vec3 Apply(const Xform& t, const Vec3& p)
+    {
+        const Vec3 r = Rotate(t.rot, p);
+        return Vec3{ r.x * t.scale + t.pos.x, r.y * t.scale + t.pos.y, r.z * t.scale + t.pos.z };
+    }
+
+    // world = parent * local (NiAVObject::UpdateWorldData rules)
+    inline Xform Compose(const Xform& parent, const Xform& local)
+    {
+        Xform out;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                out.rot[r][c] = parent.rot[r][0] * local.rot[0][c] +
+                                parent.rot[r][1] * local.rot[1][c] +
+                                parent.rot[r][2] * local.rot[2][c];
+            }
+        }
+        out.pos = Apply(parent, local.pos);
+        out.scale = parent.scale * local.scale;
+        return out;
+    }
+
+    // Inverse of an orthonormal rotation + uniform scale: p = R^T * (p' - t) / s
+    inline Xform Inverse(const Xform& t)
+    {
+        Xform out;
+        const float inv = t.scale != 0.0f ? 1.0f / t.scale : 0.0f;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                out.rot[r][c] = t.rot[c][r];
+            }
+        }
+        const Vec3 p = Rotate(out.rot, t.pos);
+        out.pos = Vec3{ -p.x * inv, -p.y * inv, -p.z * inv };
+        out.scale = inv;
+        return out;
+    }
+
+    inline float Distance(const Vec3& a, const Vec3& b)
+    {
+        const float dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
@@ -0,0 +1,178 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/AllocTrack.h"
+
+#include <cstdlib>
+#include <new>
+
+#if MI_ALLOC_TRACKING && defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace MI
+{
+    namespace
+    {
+#if MI_ALLOC_TRACKING
+        // Plain data only: operator new can run before and after dynamic initialization
+        struct ThreadState
+        {
+            AllocTrack::Stage stage;
+            AllocTrack::Frame counts;
+        };
+        thread_local constinit ThreadState t_state{ AllocTrack::Stage::kNone, {} };
+
+        void CountAlloc(std::size_t bytes) noexcept
+        {
+            if (t_state.stage != AllocTrack::Stage::kNone) {
+                auto& c = t_state.counts[static_cast<std::size_t>(t_state.stage)];
+                ++c.allocs;
+                c.bytes += bytes;
+            }
+        }
+
+        void CountFree(void* ptr) noexcept
+        {
+            if (ptr && t_state.stage != AllocTrack::Stage::kNone) {
+                ++t_state.counts[static_cast<std::size_t>(t_state.stage)].frees;
+            }
+        }
+
+        void* AlignedAlloc(std::size_t size, std::size_t align) noexcept
+        {
+#if defined(_MSC_VER)
+            return _aligned_malloc(size ? size : 1, align);
+#else
+            void* p = nullptr;
+            return posix_memalign(&p, align < sizeof(void*) ? sizeof(void*) : align, size ? size : 1) == 0 ? p : nullptr;
+#endif
+        }
+
+        void AlignedFree(void* ptr) noexcept
+        {
+#if defined(_MSC_VER)
+            _aligned_free(ptr);
+#else
+            std::free(ptr);
+#endif
+        }
+#endif
+    }
+
+    const char* AllocTrack::StageName(Stage stage)
+    {
+        switch (stage) {
+        case Stage::kNone:
+            return "none";
+        case Stage::kPresent:
+            return "present";
+        case Stage::kImGui:
+            return "imgui";
+        case Stage::kController:
+            return "controller";
+        case Stage::kRender:
+            return "render";
+        case Stage::kExport:
+            return "export";
+        default:
+            return "?";
+        }
+    }
+
+#if MI_ALLOC_TRACKING
+    AllocTrack::Stage AllocTrack::Enter(Stage stage) noexcept
+    {
+        const auto previous = t_state.stage;
+        t_state.stage = stage;
+        return previous;
+    }
+
+    void AllocTrack::Leave(Stage previous) noexcept
+    {
+        t_state.stage = previous;
+    }
+
+    void AllocTrack::TakeFrame(Frame& out)
+    {
+        out = t_state.counts;
+        t_state.counts = {};
+    }
+
+    void* AllocTrack::ImGuiAlloc(std::size_t size, void*)
+    {
+        CountAlloc(size);
+        return std::malloc(size);
+    }
+
+    void AllocTrack::ImGuiFree(void* ptr, void*)
+    {
+        CountFree(ptr);
+        std::free(ptr);
+    }
+#else
+    void AllocTrack::TakeFrame(Frame& out)
+    {
+        out = {};
+    }
+#endif
+}
+
+#if MI_ALLOC_TRACKING
+// Replaceable global allocation functions (every variant, so sized/aligned/nothrow forms
+// can't bypass the counters or mismatch allocator and deallocator).
+void* operator new(std::size_t size)
+{
+    MI::CountAlloc(size);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    MI::CountAlloc(size);
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return ::operator new(size, tag); }
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    MI::CountAlloc(size);
+    if (void* p = MI::AlignedAlloc(size, static_cast<std::size_t>(align))) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) { return ::operator new(size, align); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+    MI::CountAlloc(size);
+    return MI::AlignedAlloc(size, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t& tag) noexcept
+{
+    return ::operator new(size, align, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    MI::CountFree(ptr);
+    std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept { ::operator delete(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { ::operator delete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { ::operator delete(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { ::operator delete(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { ::operator delete(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    MI::CountFree(ptr);
+    MI::AlignedFree(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t align) noexcept { ::operator delete(ptr, align); }
+void operator delete(void* ptr, std::size_t, std::align_val_t align) noexcept { ::operator delete(ptr, align); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t align) noexcept { ::operator delete(ptr, align); }
+void operator delete(void* ptr, std::align_val_t align, const std::nothrow_t&) noexcept { ::operator delete(ptr, align); }
+void operator delete[](void* ptr, std::align_val_t align, const std::nothrow_t&) noexcept { ::operator delete(ptr, align); }
+#endif
@@ -0,0 +1,203 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/CameraMath.h"
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define MI_CAMERAMATH_SSE2 1
+#else
+#   define MI_CAMERAMATH_SSE2 0
+#endif
+
+namespace MI::Math
+{
+    namespace
+    {
+        // Cephes sinf/cosf: reduce by pi/4 in three parts (the first two exact in float), then
+        // a degree-7 sine and degree-8 cosine on [-pi/4, pi/4]. The SSE2 path runs the same
+        // steps four lanes at a time, so both agree to the last bit barring FMA contraction.
+        constexpr float kFourOverPi = 1.27323954473516f;
+        constexpr float kDP1 = 0.78515625f;
+        constexpr float kDP2 = 2.4187564849853515625e-4f;
+        constexpr float kDP3 = 3.77489497744594108e-8f;
+        constexpr float kS0 = -1.9515295891e-4f, kS1 = 8.3321608736e-3f, kS2 = -1.6666654611e-1f;
+        constexpr float kC0 = 2.443315711809948e-5f, kC1 = -1.388731625493765e-3f, kC2 = 4.166664568298827e-2f;
+
+        inline Vec3  Sub(const Vec3& a, const Vec3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+        inline float Dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+        inline Vec3 Cross(const Vec3& a, const Vec3& b)
+        {
+            return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+        }
+
+        inline Vec3 Normalize(const Vec3& v)
+        {
+            const float len = std::sqrt(Dot(v, v));
+            return len > 0.0f ? Vec3{ v.x / len, v.y / len, v.z / len } : Vec3{};
+        }
+
+        inline void SetColumns(float (&rot)[3][3], const Vec3& forward, const Vec3& up, const Vec3& right)
+        {
+            rot[0][0] = forward.x; rot[0][1] = up.x; rot[0][2] = right.x;
+            rot[1][0] = forward.y; rot[1][1] = up.y; rot[1][2] = right.y;
+            rot[2][0] = forward.z; rot[2][1] = up.z; rot[2][2] = right.z;
+        }
+
+        // Forward from yaw/pitch, right as cross(forward, +Z) normalized in closed form, up as
+        // cross(right, forward); flipping with cos(pitch) keeps it LookAt's basis past 90 deg
+        inline void OrbitFromSinCos(const Orbit& o, float sy, float cy, float sp, float cp, Xform& out)
+        {
+            const Vec3  forward{ sy * cp, cy * cp, sp };
+            const float flip = std::signbit(cp) ? -1.0f : 1.0f;
+            const Vec3  right{ cy * flip, -sy * flip, 0.0f };
+            const Vec3  up{ -sy * sp * flip, -cy * sp * flip, std::fabs(cp) };
+            SetColumns(out.rot, forward, up, right);
+            out.pos = Vec3{ o.target.x - forward.x * o.distance, o.target.y - forward.y * o.distance,
+                            o.target.z - forward.z * o.distance };
+            out.scale = 1.0f;
+        }
+
+#if MI_CAMERAMATH_SSE2
+        inline void SinCos4(__m128 x, __m128& s, __m128& c)
+        {
+            const __m128  signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+            const __m128  sinSign = _mm_and_ps(x, signMask);
+            x = _mm_andnot_ps(signMask, x);
+
+            // Octant j rounded up to even, and the remainder in [-pi/4, pi/4]
+            __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(kFourOverPi)));
+            j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+            const __m128 y = _mm_cvtepi32_ps(j);
+            x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP1)));
+            x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP2)));
+            x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(kDP3)));
+
+            const __m128 swapSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+            const __m128 cosSign = _mm_castsi128_ps(
+                _mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+            const __m128 usePoly = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+            const __m128 z = _mm_mul_ps(x, x);
+            __m128 pc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kC0), z), _mm_set1_ps(kC1));
+            pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(kC2));
+            pc = _mm_mul_ps(_mm_mul_ps(pc, z), z);
+            pc = _mm_add_ps(_mm_sub_ps(pc, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+            __m128 ps = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kS0), z), _mm_set1_ps(kS1));
+            ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(kS2));
+            ps = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, z), x), x);
+
+            // Octants 2 and 6 (mod 8) swap the two polynomials
+            s = _mm_or_ps(_mm_and_ps(usePoly, ps), _mm_andnot_ps(usePoly, pc));
+            c = _mm_or_ps(_mm_and_ps(usePoly, pc), _mm_andnot_ps(usePoly, ps));
+            s = _mm_xor_ps(s, _mm_xor_ps(sinSign, swapSin));
+            c = _mm_xor_ps(c, cosSign);
+        }
+#endif
+    }
+
+    void SinCos(float angle, float& s, float& c)
+    {
+        const bool negative = std::signbit(angle);
+        float      x = std::fabs(angle);
+
+        auto        j = static_cast<std::int32_t>(x * kFourOverPi);
+        j = (j + 1) & ~1;
+        const float y = static_cast<float>(j);
+        x = x - y * kDP1;
+        x = x - y * kDP2;
+        x = x - y * kDP3;
+
+        const float z = x * x;
+        const float pc = ((kC0 * z + kC1) * z + kC2) * z * z - z * 0.5f + 1.0f;
+        const float ps = ((kS0 * z + kS1) * z + kS2) * z * x + x;
+        const bool  swap = (j & 2) != 0;
+        s = swap ? pc : ps;
+        c = swap ? ps : pc;
+        if (negative != ((j & 4) != 0)) {
+            s = -s;
+        }
+        if (((j - 2) & 4) == 0) {
+            c = -c;
+        }
+    }
+
+    void SinCos(std::span<const float> angles, std::span<float> sines, std::span<float> cosines)
+    {
+        std::size_t i = 0;
+#if MI_CAMERAMATH_SSE2
+        for (; i + 4 <= angles.size(); i += 4) {
+            __m128 s, c;
+            SinCos4(_mm_loadu_ps(angles.data() + i), s, c);
+            _mm_storeu_ps(sines.data() + i, s);
+            _mm_storeu_ps(cosines.data() + i, c);
+        }
+#endif
+        for (; i < angles.size(); ++i) {
+            SinCos(angles[i], sines[i], cosines[i]);
+        }
+    }
+
+    void LookAt(const Vec3& eye, const Vec3& target, float (&rot)[3][3])
+    {
+        const Vec3 forward = Normalize(Sub(target, eye));
+        Vec3       right = Normalize(Cross(forward, Vec3{ 0.0f, 0.0f, 1.0f }));
+        if (Dot(right, right) == 0.0f) {
+            right = { 1.0f, 0.0f, 0.0f };  // looking straight up/down
+        }
+        SetColumns(rot, forward, Cross(right, forward), right);
+    }
+
+    Vec3 OrbitOffset(float yawRad, float pitchRad, float distance)
+    {
+        float sy, cy, sp, cp;
+        SinCos(yawRad, sy, cy);
+        SinCos(pitchRad, sp, cp);
+        return Vec3{ -sy * cp * distance, -cy * cp * distance, -sp * distance };
+    }
+
+    Xform OrbitCamera(const Orbit& orbit)
+    {
+        float sy, cy, sp, cp;
+        SinCos(orbit.yawRad, sy, cy);
+        SinCos(orbit.pitchRad, sp, cp);
+        Xform out;
+        OrbitFromSinCos(orbit, sy, cy, sp, cp, out);
+        return out;
+    }
+
+    void OrbitCameras(std::span<const Orbit> orbits, std::span<Xform> out)
+    {
+        std::size_t i = 0;
+#if MI_CAMERAMATH_SSE2
+        // Both angles of four cameras per SinCos4; the basis is a handful of products on top
+        alignas(16) float sy[4], cy[4], sp[4], cp[4];
+        for (; i + 4 <= orbits.size(); i += 4) {
+            const Orbit* o = orbits.data() + i;
+            __m128 s, c;
+            SinCos4(_mm_set_ps(o[3].yawRad, o[2].yawRad, o[1].yawRad, o[0].yawRad), s, c);
+            _mm_store_ps(sy, s);
+            _mm_store_ps(cy, c);
+            SinCos4(_mm_set_ps(o[3].pitchRad, o[2].pitchRad, o[1].pitchRad, o[0].pitchRad), s, c);
+            _mm_store_ps(sp, s);
+            _mm_store_ps(cp, c);
+            for (int k = 0; k < 4; ++k) {
+                OrbitFromSinCos(o[k], sy[k], cy[k], sp[k], cp[k], out[i + k]);
+            }
+        }
+#endif
+        for (; i < orbits.size(); ++i) {
+            out[i] = OrbitCamera(orbits[i]);
+        }
+    }
+
+    Frustum Perspective(float fovYRad, float aspect, float nearZ, float farZ)
+    {
+        float s, c;
+        SinCos(fovYRad * 0.5f, s, c);
+        const float top = s / c;
+        return Frustum{ -top * aspect, top * aspect, top, -top, nearZ, farZ };
+    }
+}
@@ -0,0 +1,126 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux benchmark target).
+#include "ModernInventory/Config.h"
+
+#include <algorithm>
+#include <cctype>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace MI
+{
+    namespace
+    {
+        inline std::string trim(std::string_view sv)
+        {
+            size_t b = 0, e = sv.size();
+            while (b < e && isspace(static_cast<unsigned char>(sv[b]))) b++;
+            while (e > b && isspace(static_cast<unsigned char>(sv[e - 1]))) e--;
+            return std::string{ sv.substr(b, e - b) };
+        }
+
+        // Case-insensitive ASCII compare (portable stand-in for _stricmp == 0)
+        inline bool iequals(std::string_view a, std::string_view b)
+        {
+            return a.size() == b.size() &&
+                   std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                       return tolower(static_cast<unsigned char>(x)) == tolower(static_cast<unsigned char>(y));
+                   });
+        }
+
+        inline bool parseBool(std::string_view v)
+        {
+            return v == "1" || iequals(v, "true") || iequals(v, "yes");
+        }
+
+        // DirectInput scancode: a number (0x hex ok) or a single letter A-Z; -1 if neither
+        inline int parseKey(std::string_view v)
+        {
+            // DIK_A..DIK_Z (the codes follow keyboard rows, not the alphabet)
+            static constexpr unsigned char kLetters[26] = {
+                0x1E, 0x30, 0x2E, 0x20, 0x12, 0x21, 0x22, 0x23, 0x17, 0x24, 0x25, 0x26, 0x32,
+                0x31, 0x18, 0x19, 0x10, 0x13, 0x1F, 0x14, 0x16, 0x2F, 0x11, 0x2D, 0x15, 0x2C,
+            };
+            if (v.size() == 1 && isalpha(static_cast<unsigned char>(v[0]))) {
+                return kLetters[toupper(static_cast<unsigned char>(v[0])) - 'A'];
+            }
+            try { return std::clamp(std::stoi(std::string{ v }, nullptr, 0), 0, 255); } catch (...) {}
+            return -1;
+        }
+    }
+
+    void ConfigSys::Parse(std::istream& in, Config& cfg)
+    {
+        std::string line;
+        while (std::getline(in, line)) {
+            // strip comments (# or ;) and trim
+            auto posc = line.find_first_of("#;");
+            if (posc != std::string::npos) line.erase(posc);
+            auto eq = line.find('=');
+            if (eq == std::string::npos) continue;
+            auto k = trim(std::string_view{ line }.substr(0, eq));
+            auto v = trim(std::string_view{ line }.substr(eq + 1));
+            if (k.empty()) continue;
+
+            if (iequals(k, "PanelWidthRatio")) {
+                try {
+                    cfg.panelWidthRatio = std::clamp(std::stof(v), 0.2f, 0.98f);
+                } catch (...) {}
+            } else if (iequals(k, "PanelMinWidth")) {
+                try {
+                    cfg.panelMinWidth = (std::max)(320, std::stoi(v));
+                } catch (...) {}
+            } else if (iequals(k, "DebugToasts")) {
+                cfg.debugToasts = parseBool(v);
+            } else if (iequals(k, "PreviewFovDeg")) {
+                try { cfg.previewFovDeg = std::clamp(std::stof(v), 20.0f, 90.0f); } catch (...) {}
+            } else if (iequals(k, "PreviewYawDeg")) {
+                try { cfg.previewYawDeg = std::stof(v); } catch (...) {}
+            } else if (iequals(k, "PreviewPitchDeg")) {
+                try { cfg.previewPitchDeg = std::clamp(std::stof(v), -45.0f, 45.0f); } catch (...) {}
+            } else if (iequals(k, "PreviewFitMargin")) {
+                try { cfg.previewFitMargin = std::clamp(std::stof(v), 1.0f, 1.5f); } catch (...) {}
+            } else if (iequals(k, "TurntableFrames")) {
+                try { cfg.turntableFrames = std::clamp(std::stoi(v), 0, 64); } catch (...) {}
+            } else if (iequals(k, "TurntableBakesPerFrame")) {
+                try { cfg.turntableBakesPerFrame = std::clamp(std::stoi(v), 1, 8); } catch (...) {}
+            } else if (iequals(k, "TurntableBlend")) {
+                cfg.turntableBlend = parseBool(v);
+            } else if (iequals(k, "PreviewViews")) {
+                try { cfg.previewViews = std::clamp(std::stoi(v), 1, 4); } catch (...) {}
+            } else if (iequals(k, "SoftwareFallback")) {
+                cfg.softwareFallback = parseBool(v);
+            } else if (iequals(k, "RecordEvents")) {
+                cfg.recordEvents = parseBool(v);
+            } else if (iequals(k, "ExportKey")) {
+                if (const auto key = parseKey(v); key >= 0) cfg.exportKey = key;
+            } else if (iequals(k, "ExportFormat")) {
+                cfg.exportFormat = iequals(v, "png") ? ImageFormat::kPng : ImageFormat::kQoi;
+            } else if (iequals(k, "ToggleKey")) {
+                if (const auto key = parseKey(v); key >= 0) cfg.toggleKey = key;
+            } else if (iequals(k, "PrebuildTimeoutMs")) {
+                try { cfg.prebuildTimeoutMs = std::clamp(std::stoi(v), 0, 10000); } catch (...) {}
+            } else if (iequals(k, "CacheEvictIdleSec")) {
+                try { cfg.cacheEvictIdleSec = std::clamp(std::stoi(v), 0, 3600); } catch (...) {}
+            } else if (iequals(k, "CacheEvictMemoryLoad")) {
+                try { cfg.cacheEvictMemoryLoad = std::clamp(std::stoi(v), 50, 100); } catch (...) {}
+            } else if (iequals(k, "VariantCacheSize")) {
+                try { cfg.variantCacheSize = std::clamp(std::stoi(v), 0, 32); } catch (...) {}
+            } else if (iequals(k, "HoverPrefetchPerFrame")) {
+                try { cfg.hoverPrefetchPerFrame = std::clamp(std::stoi(v), 0, 4); } catch (...) {}
+            } else if (iequals(k, "FontFiles")) {
+                cfg.fontFiles.clear();
+                for (std::size_t b = 0; b <= v.size();) {
+                    const auto e = (std::min)(v.find(',', b), v.size());
+                    if (auto file = trim(std::string_view{ v }.substr(b, e - b)); !file.empty()) {
+                        cfg.fontFiles.push_back(std::move(file));
+                    }
+                    b = e + 1;
+                }
+            } else if (iequals(k, "FontSize")) {
+                try { cfg.fontSizePx = std::clamp(std::stof(v), 8.0f, 48.0f); } catch (...) {}
+            }
+        }
+    }
+}
@@ -0,0 +1,196 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/EventLog.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace MI
+{
+    namespace
+    {
+        constexpr std::size_t kFlushBytes = 4096;
+
+        void PutVarint(std::vector<std::uint8_t>& out, std::uint64_t v)
+        {
+            while (v >= 0x80) {
+                out.push_back(static_cast<std::uint8_t>(v | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<std::uint8_t>(v));
+        }
+
+        bool GetVarint(const std::uint8_t*& p, const std::uint8_t* end, std::uint64_t& v)
+        {
+            v = 0;
+            for (int shift = 0; shift < 64 && p < end; shift += 7) {
+                const std::uint8_t byte = *p++;
+                v |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Types carrying the a/b varints
+        bool HasPayload(EventType type)
+        {
+            return type == EventType::kPaneSize || type == EventType::kGpuCalls || type == EventType::kHover;
+        }
+    }
+
+    void EventLog::WriteHeader(std::vector<std::uint8_t>& out)
+    {
+        out.insert(out.end(), std::begin(kMagic), std::end(kMagic));
+        out.push_back(kVersion);
+    }
+
+    void EventLog::Encode(const Event& e, std::uint64_t& prevTimeUs, std::vector<std::uint8_t>& out)
+    {
+        out.push_back(static_cast<std::uint8_t>(e.type));
+        PutVarint(out, e.timeUs >= prevTimeUs ? e.timeUs - prevTimeUs : 0);
+        prevTimeUs = (std::max)(prevTimeUs, e.timeUs);
+        if (HasPayload(e.type)) {
+            PutVarint(out, e.a);
+            PutVarint(out, e.b);
+        }
+    }
+
+    bool EventLog::Decode(const std::uint8_t* data, std::size_t size, std::vector<Event>& out)
+    {
+        if (size < sizeof(kMagic) + 1 || std::memcmp(data, kMagic, sizeof(kMagic)) != 0 || data[4] == 0 || data[4] > kVersion) {
+            return false;
+        }
+        const std::uint8_t* p = data + sizeof(kMagic) + 1;
+        const std::uint8_t* end = data + size;
+        std::uint64_t now = 0;
+        while (p < end) {
+            Event e{};
+            const auto type = *p++;
+            if (type < static_cast<std::uint8_t>(EventType::kFrame) || type > static_cast<std::uint8_t>(EventType::kHover)) {
+                return false;
+            }
+            e.type = static_cast<EventType>(type);
+            std::uint64_t delta = 0;
+            if (!GetVarint(p, end, delta)) {
+                return false;
+            }
+            now += delta;
+            e.timeUs = now;
+            if (HasPayload(e.type)) {
+                std::uint64_t w = 0, h = 0;
+                if (!GetVarint(p, end, w) || !GetVarint(p, end, h)) {
+                    return false;
+                }
+                e.a = static_cast<std::uint32_t>(w);
+                e.b = static_cast<std::uint32_t>(h);
+            }
+            out.push_back(e);
+        }
+        return true;
+    }
+
+    bool EventLog::ReadFile(const std::string& path, std::vector<Event>& out)
+    {
+        std::ifstream f(path, std::ios::binary);
+        if (!f) {
+            return false;
+        }
+        const std::vector<std::uint8_t> bytes{ std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>() };
+        return Decode(bytes.data(), bytes.size(), out);
+    }
+
+    bool EventRecorder::Start(const std::string& path, std::uint64_t nowUs)
+    {
+        if (m_active) {
+            return true;
+        }
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_file) {
+            return false;
+        }
+        Event stale;
+        while (m_queue.TryPop(stale)) {
+            // Recorded after the previous Stop's final drain
+        }
+        m_buffer.clear();
+        m_buffer.reserve(kFlushBytes * 2);
+        EventLog::WriteHeader(m_buffer);
+        m_bufferMem.Set(static_cast<std::int64_t>(sizeof(m_queue) + m_buffer.capacity()));
+        m_startUs = nowUs;
+        m_prevUs = 0;
+        m_quit = false;
+        m_writer = std::thread([this] { WriterLoop(); });
+        m_active.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void EventRecorder::Stop()
+    {
+        if (!m_active.exchange(false)) {
+            return;
+        }
+        {
+            std::lock_guard lock(m_wakeLock);
+            m_quit = true;
+        }
+        m_wake.notify_one();
+        m_writer.join();
+        m_file.close();
+        m_buffer = {};
+        m_bufferMem.Set(0);
+    }
+
+    void EventRecorder::Flush()
+    {
+        if (m_active.load(std::memory_order_acquire)) {
+            m_flush.store(true, std::memory_order_release);
+            m_wake.notify_one();  // a missed wake-up only delays the write to the next period
+        }
+    }
+
+    void EventRecorder::Record(EventType type, std::uint64_t nowUs, std::uint32_t a, std::uint32_t b)
+    {
+        if (!m_active.load(std::memory_order_acquire)) {
+            return;
+        }
+        if (m_queue.TryPush(Event{ type, nowUs >= m_startUs ? nowUs - m_startUs : 0, a, b })) {
+            m_stats.recorded.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            m_stats.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    bool EventRecorder::DrainAndEncode()
+    {
+        return m_queue.Drain([this](const Event& e) { EventLog::Encode(e, m_prevUs, m_buffer); }) > 0;
+    }
+
+    void EventRecorder::WriterLoop()
+    {
+        std::unique_lock lock(m_wakeLock);
+        for (;;) {
+            m_wake.wait_for(lock, kWritePeriod, [this] { return m_quit || m_flush.load(std::memory_order_acquire); });
+            const bool quit = m_quit;
+            lock.unlock();
+
+            // One lap of the queue per wake-up; Stop drains to the end
+            const bool flush = m_flush.exchange(false, std::memory_order_acq_rel) || quit;
+            while (DrainAndEncode() && quit) {
+            }
+            if (!m_buffer.empty() && (flush || m_buffer.size() >= kFlushBytes)) {
+                m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+                m_file.flush();
+                m_buffer.clear();
+                m_bufferMem.Set(static_cast<std::int64_t>(sizeof(m_queue) + m_buffer.capacity()));
+                m_stats.writes.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            lock.lock();
+            if (quit) {
+                return;
+            }
+        }
+    }
+}
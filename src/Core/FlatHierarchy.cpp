@@ -0,0 +1,194 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux benchmark target).
+#include "ModernInventory/FlatHierarchy.h"
+
+#include <algorithm>
+
+namespace MI
+{
+    void FlatHierarchy::Clear()
+    {
+        m_parent.clear();
+        m_depth.clear();
+        m_levelEnd.clear();
+        m_dirty.clear();
+        m_updated.clear();
+        Resize(m_local, 0);
+        Resize(m_world, 0);
+        m_firstDirtyLevel = kNoParent;
+    }
+
+    std::size_t FlatHierarchy::Bytes() const
+    {
+        std::size_t floats = m_local.s.capacity() + m_world.s.capacity();
+        for (const auto* st : { &m_local, &m_world }) {
+            for (const auto& v : st->r) floats += v.capacity();
+            for (const auto& v : st->t) floats += v.capacity();
+        }
+        return floats * sizeof(float) +
+               (m_parent.capacity() + m_depth.capacity() + m_levelEnd.capacity()) * sizeof(std::uint32_t) +
+               m_dirty.capacity() + m_updated.capacity();
+    }
+
+    void FlatHierarchy::Reserve(std::size_t n)
+    {
+        m_parent.reserve(n);
+        m_depth.reserve(n);
+        m_dirty.reserve(n);
+        m_updated.reserve(n);
+        Reserve(m_local, n);
+        Reserve(m_world, n);
+    }
+
+    std::uint32_t FlatHierarchy::Add(std::uint32_t parent, const Math::Xform& local)
+    {
+        const auto i = static_cast<std::uint32_t>(m_parent.size());
+        if (parent != kNoParent && parent >= i) {
+            return kNoParent;
+        }
+        const std::uint32_t depth = (parent == kNoParent) ? 0u : m_depth[parent] + 1u;
+        if (!m_depth.empty() && depth < m_depth.back()) {
+            return kNoParent;
+        }
+
+        m_parent.push_back(parent);
+        m_depth.push_back(depth);
+        m_dirty.push_back(1);
+        m_updated.push_back(0);
+        Resize(m_local, i + 1);
+        Resize(m_world, i + 1);
+        Write(m_local, i, local);
+
+        if (depth >= m_levelEnd.size()) {
+            m_levelEnd.push_back(i + 1);
+        } else {
+            m_levelEnd[depth] = i + 1;
+        }
+        m_firstDirtyLevel = (std::min)(m_firstDirtyLevel, depth);
+        return i;
+    }
+
+    void FlatHierarchy::SetLocal(std::uint32_t i, const Math::Xform& local)
+    {
+        if (i >= m_parent.size()) {
+            return;
+        }
+        Write(m_local, i, local);
+        m_dirty[i] = 1;
+        m_firstDirtyLevel = (std::min)(m_firstDirtyLevel, m_depth[i]);
+    }
+
+    void FlatHierarchy::MarkAllDirty()
+    {
+        std::fill(m_dirty.begin(), m_dirty.end(), std::uint8_t{ 1 });
+        m_firstDirtyLevel = m_parent.empty() ? kNoParent : 0u;
+    }
+
+    std::size_t FlatHierarchy::Update()
+    {
+        std::fill(m_updated.begin(), m_updated.end(), std::uint8_t{ 0 });
+        if (m_firstDirtyLevel == kNoParent) {
+            return 0;
+        }
+
+        // Parents precede children, so everything from the first dirty level to the end
+        // is a single forward pass.
+        const auto begin = m_firstDirtyLevel == 0 ? 0u : m_levelEnd[m_firstDirtyLevel - 1];
+        UpdateRange(begin, static_cast<std::uint32_t>(m_parent.size()));
+
+        std::size_t changed = 0;
+        for (auto u : m_updated) {
+            changed += u;
+        }
+        std::fill(m_dirty.begin(), m_dirty.end(), std::uint8_t{ 0 });
+        m_firstDirtyLevel = kNoParent;
+        return changed;
+    }
+
+    // Within a depth level no node depends on another, so consecutive iterations are
+    // independent; only the parent reads are gathers.
+    void FlatHierarchy::UpdateRange(std::uint32_t begin, std::uint32_t end)
+    {
+        const std::uint32_t* parent = m_parent.data();
+        const std::uint8_t*  dirty = m_dirty.data();
+        std::uint8_t*        updated = m_updated.data();
+
+        const float* lr[9];
+        const float* pr[9];
+        float*       wr[9];
+        for (int k = 0; k < 9; ++k) {
+            lr[k] = m_local.r[k].data();
+            pr[k] = m_world.r[k].data();
+            wr[k] = m_world.r[k].data();
+        }
+        const float* lt[3] = { m_local.t[0].data(), m_local.t[1].data(), m_local.t[2].data() };
+        float*       wt[3] = { m_world.t[0].data(), m_world.t[1].data(), m_world.t[2].data() };
+        const float* ls = m_local.s.data();
+        float*       ws = m_world.s.data();
+
+        for (std::uint32_t i = begin; i < end; ++i) {
+            const std::uint32_t p = parent[i];
+            if (p == kNoParent) {
+                for (int k = 0; k < 9; ++k) wr[k][i] = lr[k][i];
+                for (int k = 0; k < 3; ++k) wt[k][i] = lt[k][i];
+                ws[i] = ls[i];
+                updated[i] = dirty[i];
+                continue;
+            }
+
+            // Load parent world and local into registers first: stores below can't alias them.
+            float P[9], L[9];
+            for (int k = 0; k < 9; ++k) {
+                P[k] = pr[k][p];
+                L[k] = lr[k][i];
+            }
+            const float pt[3] = { wt[0][p], wt[1][p], wt[2][p] };
+            const float ps = ws[p];
+            const float l0 = lt[0][i], l1 = lt[1][i], l2 = lt[2][i];
+
+            for (int r = 0; r < 3; ++r) {
+                for (int c = 0; c < 3; ++c) {
+                    wr[r * 3 + c][i] = P[r * 3 + 0] * L[0 * 3 + c] + P[r * 3 + 1] * L[1 * 3 + c] + P[r * 3 + 2] * L[2 * 3 + c];
+                }
+                wt[r][i] = (P[r * 3 + 0] * l0 + P[r * 3 + 1] * l1 + P[r * 3 + 2] * l2) * ps + pt[r];
+            }
+            ws[i] = ps * ls[i];
+            updated[i] = static_cast<std::uint8_t>(dirty[i] | updated[p]);
+        }
+    }
+
+    Math::Xform FlatHierarchy::Read(const Streams& st, std::uint32_t i)
+    {
+        Math::Xform x;
+        for (int k = 0; k < 9; ++k) {
+            x.rot[k / 3][k % 3] = st.r[k][i];
+        }
+        x.pos = Math::Vec3{ st.t[0][i], st.t[1][i], st.t[2][i] };
+        x.scale = st.s[i];
+        return x;
+    }
+
+    void FlatHierarchy::Write(Streams& st, std::uint32_t i, const Math::Xform& x)
+    {
+        for (int k = 0; k < 9; ++k) {
+            st.r[k][i] = x.rot[k / 3][k % 3];
+        }
+        st.t[0][i] = x.pos.x;
+        st.t[1][i] = x.pos.y;
+        st.t[2][i] = x.pos.z;
+        st.s[i] = x.scale;
+    }
+
+    void FlatHierarchy::Resize(Streams& st, std::size_t n)
+    {
+        for (auto& v : st.r) v.resize(n);
+        for (auto& v : st.t) v.resize(n);
+        st.s.resize(n);
+    }
+
+    void FlatHierarchy::Reserve(Streams& st, std::size_t n)
+    {
+        for (auto& v : st.r) v.reserve(n);
+        for (auto& v : st.t) v.reserve(n);
+        st.s.reserve(n);
+    }
+}
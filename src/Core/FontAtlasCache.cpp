@@ -0,0 +1,273 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/FontAtlasCache.h"
+#include "ModernInventory/GameWorld.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+namespace MI
+{
+    namespace
+    {
+        static_assert(sizeof(BakedGlyph) == 10 * 4, "BakedGlyph is written as raw 32-bit fields");
+
+        template <class T>
+        void Put(std::vector<std::uint8_t>& out, const T& v)
+        {
+            const auto* p = reinterpret_cast<const std::uint8_t*>(&v);
+            out.insert(out.end(), p, p + sizeof(T));
+        }
+
+        // Bounds-checked cursor over the file bytes
+        struct Reader
+        {
+            const std::uint8_t* p;
+            const std::uint8_t* end;
+
+            bool Raw(void* dst, std::size_t n)
+            {
+                if (static_cast<std::size_t>(end - p) < n) {
+                    return false;
+                }
+                std::memcpy(dst, p, n);
+                p += n;
+                return true;
+            }
+
+            template <class T>
+            bool Get(T& v) { return Raw(&v, sizeof(T)); }
+
+            // Element count that can't exceed what is left in the file
+            bool Count(std::uint32_t& n, std::size_t elemSize)
+            {
+                return Get(n) && static_cast<std::size_t>(end - p) / elemSize >= n;
+            }
+        };
+
+        std::uint64_t Bits(float f)
+        {
+            std::uint32_t u = 0;
+            std::memcpy(&u, &f, sizeof(u));
+            return u;
+        }
+
+        // UTF-8 -> codepoint; invalid bytes decode as U+FFFD and advance by one
+        std::uint32_t NextCodepoint(const unsigned char*& p, const unsigned char* end)
+        {
+            const std::uint32_t c = *p++;
+            if (c < 0x80) {
+                return c;
+            }
+            const int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : -1;
+            if (extra < 0 || end - p < extra) {
+                return 0xFFFD;
+            }
+            std::uint32_t cp = c & (0x3Fu >> extra);
+            for (int i = 0; i < extra; ++i) {
+                if ((p[i] & 0xC0) != 0x80) {
+                    return 0xFFFD;
+                }
+                cp = (cp << 6) | (p[i] & 0x3Fu);
+            }
+            p += extra;
+            return cp;
+        }
+    }
+
+    std::uint64_t FontAtlasCache::Key(const std::vector<FontSource>& fonts, const std::vector<std::uint32_t>& ranges,
+                                      std::uint32_t builderVersion)
+    {
+        Fingerprint fp;
+        fp.Add(kVersion);
+        fp.Add(builderVersion);
+        for (const auto& font : fonts) {
+            for (const char c : font.path) {
+                fp.Add(static_cast<unsigned char>(c));
+            }
+            std::error_code ec;
+            const auto size = font.path.empty() ? 0 : std::filesystem::file_size(font.path, ec);
+            fp.Add(ec ? 0 : size);
+            const auto time = font.path.empty() ? std::filesystem::file_time_type{}
+                                                : std::filesystem::last_write_time(font.path, ec);
+            fp.Add(ec ? 0 : static_cast<std::uint64_t>(time.time_since_epoch().count()));
+            fp.Add(Bits(font.sizePx));
+        }
+        for (const auto r : ranges) {
+            fp.Add(r);
+        }
+        return fp.value;
+    }
+
+    void FontAtlasCache::Encode(const BakedAtlas& atlas, std::uint64_t key, std::vector<std::uint8_t>& out)
+    {
+        std::size_t glyphs = 0;
+        for (const auto& font : atlas.fonts) {
+            glyphs += font.glyphs.size();
+        }
+        out.reserve(out.size() + 64 + atlas.lineUvs.size() * 16 + atlas.ranges.size() * 4 + atlas.fonts.size() * 16 +
+                    glyphs * sizeof(BakedGlyph) + atlas.alpha.size());
+
+        out.insert(out.end(), std::begin(kMagic), std::end(kMagic));
+        out.push_back(kVersion);
+        Put(out, key);
+        Put(out, atlas.width);
+        Put(out, atlas.height);
+        Put(out, atlas.whiteU);
+        Put(out, atlas.whiteV);
+        Put(out, static_cast<std::uint32_t>(atlas.lineUvs.size()));
+        for (const auto& uv : atlas.lineUvs) {
+            Put(out, uv);
+        }
+        Put(out, static_cast<std::uint32_t>(atlas.ranges.size()));
+        for (const auto r : atlas.ranges) {
+            Put(out, r);
+        }
+        Put(out, static_cast<std::uint32_t>(atlas.fonts.size()));
+        for (const auto& font : atlas.fonts) {
+            Put(out, font.size);
+            Put(out, font.ascent);
+            Put(out, font.descent);
+            Put(out, static_cast<std::uint32_t>(font.glyphs.size()));
+            const auto* g = reinterpret_cast<const std::uint8_t*>(font.glyphs.data());
+            out.insert(out.end(), g, g + font.glyphs.size() * sizeof(BakedGlyph));
+        }
+        out.insert(out.end(), atlas.alpha.begin(), atlas.alpha.end());
+    }
+
+    bool FontAtlasCache::Decode(const std::uint8_t* data, std::size_t size, std::uint64_t key, BakedAtlas& out)
+    {
+        if (size < sizeof(kMagic) + 1 || std::memcmp(data, kMagic, sizeof(kMagic)) != 0 || data[4] != kVersion) {
+            return false;
+        }
+        Reader in{ data + sizeof(kMagic) + 1, data + size };
+        std::uint64_t fileKey = 0;
+        std::uint32_t n = 0;
+        if (!in.Get(fileKey) || fileKey != key || !in.Get(out.width) || !in.Get(out.height) || !in.Get(out.whiteU) ||
+            !in.Get(out.whiteV) || !in.Count(n, sizeof(out.lineUvs[0]))) {
+            return false;
+        }
+        out.lineUvs.resize(n);
+        if (!in.Raw(out.lineUvs.data(), n * sizeof(out.lineUvs[0])) || !in.Count(n, sizeof(std::uint32_t))) {
+            return false;
+        }
+        out.ranges.resize(n);
+        if (!in.Raw(out.ranges.data(), n * sizeof(std::uint32_t)) || !in.Count(n, 16)) {
+            return false;
+        }
+        out.fonts.resize(n);
+        for (auto& font : out.fonts) {
+            if (!in.Get(font.size) || !in.Get(font.ascent) || !in.Get(font.descent) || !in.Count(n, sizeof(BakedGlyph))) {
+                return false;
+            }
+            font.glyphs.resize(n);
+            if (!in.Raw(font.glyphs.data(), n * sizeof(BakedGlyph))) {
+                return false;
+            }
+        }
+        const auto pixels = static_cast<std::size_t>(out.width) * out.height;
+        if (static_cast<std::size_t>(in.end - in.p) != pixels) {
+            return false;
+        }
+        out.alpha.assign(in.p, in.end);
+        return true;
+    }
+
+    bool FontAtlasCache::WriteFile(const std::string& path, const BakedAtlas& atlas, std::uint64_t key)
+    {
+        std::vector<std::uint8_t> bytes;
+        Encode(atlas, key, bytes);
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+            if (!f.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        return !ec;
+    }
+
+    bool FontAtlasCache::ReadFile(const std::string& path, std::uint64_t key, BakedAtlas& out)
+    {
+        std::ifstream f(path, std::ios::binary | std::ios::ate);
+        if (!f) {
+            return false;
+        }
+        // One sized read: the cache is mostly pixels, a streambuf_iterator copy would dominate
+        std::vector<std::uint8_t> bytes(static_cast<std::size_t>(f.tellg()));
+        f.seekg(0);
+        if (!f.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+            return false;
+        }
+        return Decode(bytes.data(), bytes.size(), key, out);
+    }
+
+    void GlyphCoverage::Reset(const std::vector<std::uint32_t>& ranges)
+    {
+        m_covered.fill(0);
+        m_pending.clear();
+        for (std::size_t i = 0; i + 1 < ranges.size(); i += 2) {
+            Cover(ranges[i], ranges[i + 1]);
+        }
+    }
+
+    void GlyphCoverage::Cover(std::uint32_t first, std::uint32_t last)
+    {
+        last = (std::min)(last, 0xFFFFu);
+        for (std::uint32_t cp = first; cp <= last; ++cp) {
+            m_covered[cp >> 6] |= 1ull << (cp & 63);
+        }
+    }
+
+    void GlyphCoverage::Note(std::string_view utf8)
+    {
+        const auto* p = reinterpret_cast<const unsigned char*>(utf8.data());
+        const auto* end = p + utf8.size();
+        while (p < end) {
+            const auto cp = NextCodepoint(p, end);
+            if (cp < 0x20 || cp > 0xFFFF || Covered(cp)) {
+                continue;
+            }
+            const auto block = cp / kBlock;
+            if (std::find(m_pending.begin(), m_pending.end(), block) == m_pending.end()) {
+                m_pending.push_back(block);
+            }
+        }
+    }
+
+    bool GlyphCoverage::TakePending(std::vector<std::uint32_t>& ranges)
+    {
+        if (m_pending.empty()) {
+            return false;
+        }
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> spans;
+        for (std::size_t i = 0; i + 1 < ranges.size(); i += 2) {
+            spans.emplace_back(ranges[i], ranges[i + 1]);
+        }
+        for (const auto block : m_pending) {
+            // Codepoint 0 terminates ImGui range lists, so block 0 starts at 1
+            const std::uint32_t first = (std::max)(block * kBlock, 1u);
+            const std::uint32_t last = block * kBlock + kBlock - 1;
+            spans.emplace_back(first, last);
+            Cover(first, last);
+        }
+        m_pending.clear();
+
+        std::sort(spans.begin(), spans.end());
+        ranges.clear();
+        for (const auto& [first, last] : spans) {
+            if (!ranges.empty() && first <= ranges.back() + 1) {
+                ranges.back() = (std::max)(ranges.back(), last);
+            } else {
+                ranges.push_back(first);
+                ranges.push_back(last);
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,57 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/GpuCalls.h"
+
+namespace MI
+{
+    namespace
+    {
+        std::array<std::atomic<std::uint32_t>, kGpuCallCount> g_counts{};
+        GpuCallFrame                                           g_taken{};  // render thread only
+
+        constexpr const char* kNames[kGpuCallCount] = {
+            "CreateTexture2D",
+            "CreateRenderTargetView",
+            "CreateShaderResourceView",
+            "CreateDepthStencilView",
+            "OMSetRenderTargets",
+            "RSSetViewports",
+            "ClearRenderTargetView",
+            "ClearDepthStencilView",
+            "CopySubresourceRegion",
+            "UpdateSubresource",
+            "CreateQuery",
+            "Map",
+        };
+    }
+
+    const char* GpuCalls::Name(GpuCall call)
+    {
+        const auto i = static_cast<std::size_t>(call);
+        return i < kGpuCallCount ? kNames[i] : "?";
+    }
+
+    bool GpuCalls::IsCreation(GpuCall call)
+    {
+        return call <= GpuCall::kCreateDepthStencilView || call == GpuCall::kCreateQuery;
+    }
+
+    bool GpuCalls::IsStateChange(GpuCall call)
+    {
+        return call == GpuCall::kOMSetRenderTargets || call == GpuCall::kRSSetViewports;
+    }
+
+    void GpuCalls::Count(GpuCall call)
+    {
+        g_counts[static_cast<std::size_t>(call)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void GpuCalls::TakeFrame(GpuCallFrame& out)
+    {
+        // Counters only grow; the frame is the (wrapping) difference to the last snapshot.
+        for (std::size_t i = 0; i < kGpuCallCount; ++i) {
+            const auto now = g_counts[i].load(std::memory_order_relaxed);
+            out[i] = now - g_taken[i];
+            g_taken[i] = now;
+        }
+    }
+}
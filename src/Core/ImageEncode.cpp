@@ -0,0 +1,199 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/ImageEncode.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace MI
+{
+    namespace
+    {
+        void PutU32BE(std::vector<std::uint8_t>& out, std::uint32_t v)
+        {
+            out.push_back(static_cast<std::uint8_t>(v >> 24));
+            out.push_back(static_cast<std::uint8_t>(v >> 16));
+            out.push_back(static_cast<std::uint8_t>(v >> 8));
+            out.push_back(static_cast<std::uint8_t>(v));
+        }
+
+        const std::array<std::uint32_t, 256>& CrcTable()
+        {
+            static const auto table = [] {
+                std::array<std::uint32_t, 256> t{};
+                for (std::uint32_t n = 0; n < 256; ++n) {
+                    std::uint32_t c = n;
+                    for (int k = 0; k < 8; ++k) {
+                        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    }
+                    t[n] = c;
+                }
+                return t;
+            }();
+            return table;
+        }
+
+        std::uint32_t Crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0)
+        {
+            const auto& t = CrcTable();
+            crc = ~crc;
+            for (std::size_t i = 0; i < size; ++i) {
+                crc = t[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            }
+            return ~crc;
+        }
+
+        // Length + type + data + CRC(type + data)
+        void PutChunk(std::vector<std::uint8_t>& out, const char (&type)[5], const std::uint8_t* data, std::size_t size)
+        {
+            PutU32BE(out, static_cast<std::uint32_t>(size));
+            const auto typeAt = out.size();
+            out.insert(out.end(), type, type + 4);
+            if (size) {
+                out.insert(out.end(), data, data + size);
+            }
+            PutU32BE(out, Crc32(out.data() + typeAt, size + 4));
+        }
+
+        struct Px
+        {
+            std::uint8_t r, g, b, a;
+            bool operator==(const Px&) const = default;
+        };
+    }
+
+    // https://qoiformat.org/qoi-specification.pdf
+    void ImageEncode::Qoi(const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height, std::size_t rowPitch,
+                          std::vector<std::uint8_t>& out)
+    {
+        out.reserve(out.size() + 14 + static_cast<std::size_t>(width) * height + 8);
+        out.insert(out.end(), { 'q', 'o', 'i', 'f' });
+        PutU32BE(out, width);
+        PutU32BE(out, height);
+        out.push_back(4);  // RGBA
+        out.push_back(0);  // sRGB with linear alpha
+
+        std::array<Px, 64> index{};
+        Px prev{ 0, 0, 0, 255 };
+        std::uint32_t run = 0;
+        const std::size_t total = static_cast<std::size_t>(width) * height;
+        std::size_t n = 0;
+
+        for (std::uint32_t y = 0; y < height; ++y) {
+            const std::uint8_t* row = rgba + y * rowPitch;
+            for (std::uint32_t x = 0; x < width; ++x, ++n) {
+                const Px px{ row[x * 4], row[x * 4 + 1], row[x * 4 + 2], row[x * 4 + 3] };
+                if (px == prev) {
+                    if (++run == 62 || n + 1 == total) {
+                        out.push_back(static_cast<std::uint8_t>(0xC0 | (run - 1)));  // QOI_OP_RUN
+                        run = 0;
+                    }
+                    continue;
+                }
+                if (run > 0) {
+                    out.push_back(static_cast<std::uint8_t>(0xC0 | (run - 1)));
+                    run = 0;
+                }
+
+                const auto hash = (px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64;
+                if (index[hash] == px) {
+                    out.push_back(static_cast<std::uint8_t>(hash));  // QOI_OP_INDEX
+                } else {
+                    index[hash] = px;
+                    if (px.a == prev.a) {
+                        const auto vr = static_cast<std::int8_t>(px.r - prev.r);
+                        const auto vg = static_cast<std::int8_t>(px.g - prev.g);
+                        const auto vb = static_cast<std::int8_t>(px.b - prev.b);
+                        const int vgr = vr - vg;
+                        const int vgb = vb - vg;
+                        if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                            out.push_back(static_cast<std::uint8_t>(0x40 | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2)));  // QOI_OP_DIFF
+                        } else if (vgr > -9 && vgr < 8 && vg > -33 && vg < 32 && vgb > -9 && vgb < 8) {
+                            out.push_back(static_cast<std::uint8_t>(0x80 | (vg + 32)));  // QOI_OP_LUMA
+                            out.push_back(static_cast<std::uint8_t>((vgr + 8) << 4 | (vgb + 8)));
+                        } else {
+                            out.insert(out.end(), { 0xFE, px.r, px.g, px.b });  // QOI_OP_RGB
+                        }
+                    } else {
+                        out.insert(out.end(), { 0xFF, px.r, px.g, px.b, px.a });  // QOI_OP_RGBA
+                    }
+                }
+                prev = px;
+            }
+        }
+        out.insert(out.end(), { 0, 0, 0, 0, 0, 0, 0, 1 });
+    }
+
+    void ImageEncode::Png(const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height, std::size_t rowPitch,
+                          std::vector<std::uint8_t>& out)
+    {
+        static constexpr std::uint8_t kSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        out.insert(out.end(), std::begin(kSignature), std::end(kSignature));
+
+        std::uint8_t ihdr[13]{};
+        for (int i = 0; i < 4; ++i) {
+            ihdr[i] = static_cast<std::uint8_t>(width >> (24 - 8 * i));
+            ihdr[4 + i] = static_cast<std::uint8_t>(height >> (24 - 8 * i));
+        }
+        ihdr[8] = 8;  // bit depth
+        ihdr[9] = 6;  // colour type RGBA; compression, filter, interlace = 0
+        PutChunk(out, "IHDR", ihdr, sizeof(ihdr));
+
+        // zlib stream of stored deflate blocks over filter-type-0 scanlines
+        const std::size_t rowBytes = static_cast<std::size_t>(width) * 4 + 1;
+        const std::size_t raw = rowBytes * height;
+        const std::size_t blocks = (std::max<std::size_t>)(1, (raw + 65534) / 65535);
+        const std::size_t idatSize = 2 + raw + blocks * 5 + 4;
+
+        // Chunk written in place: length, type, zlib data, CRC
+        PutU32BE(out, static_cast<std::uint32_t>(idatSize));
+        const auto typeAt = out.size();
+        out.insert(out.end(), { 'I', 'D', 'A', 'T', 0x78, 0x01 });
+        std::uint32_t a = 1, b = 0;  // Adler-32
+        std::size_t left = raw, blockLeft = 0;
+        const auto emit = [&](const std::uint8_t* p, std::size_t size) {
+            while (size) {
+                if (blockLeft == 0) {
+                    const auto len = static_cast<std::uint16_t>((std::min<std::size_t>)(left, 65535));
+                    out.push_back(left <= 65535 ? 1 : 0);  // BFINAL, BTYPE = stored
+                    out.insert(out.end(), { static_cast<std::uint8_t>(len), static_cast<std::uint8_t>(len >> 8),
+                                            static_cast<std::uint8_t>(~len), static_cast<std::uint8_t>(~len >> 8) });
+                    blockLeft = len;
+                }
+                const auto take = (std::min)(size, blockLeft);
+                out.insert(out.end(), p, p + take);
+                // Defer the modulo: 5552 bytes is the most that can't overflow b
+                for (std::size_t i = 0; i < take;) {
+                    const std::size_t end = i + (std::min<std::size_t>)(take - i, 5552);
+                    for (; i < end; ++i) {
+                        a += p[i];
+                        b += a;
+                    }
+                    a %= 65521;
+                    b %= 65521;
+                }
+                p += take;
+                size -= take;
+                blockLeft -= take;
+                left -= take;
+            }
+        };
+        static constexpr std::uint8_t kFilterNone = 0;
+        for (std::uint32_t y = 0; y < height; ++y) {
+            emit(&kFilterNone, 1);
+            emit(rgba + y * rowPitch, rowBytes - 1);
+        }
+        if (raw == 0) {
+            out.insert(out.end(), { 1, 0, 0, 0xFF, 0xFF });  // empty final block
+        }
+        PutU32BE(out, (b << 16) | a);
+        PutU32BE(out, Crc32(out.data() + typeAt, out.size() - typeAt));
+
+        PutChunk(out, "IEND", nullptr, 0);
+    }
+
+    const char* ImageEncode::Extension(ImageFormat format)
+    {
+        return format == ImageFormat::kPng ? ".png" : ".qoi";
+    }
+}
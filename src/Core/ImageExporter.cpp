@@ -0,0 +1,112 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/ImageExporter.h"
+#include "ModernInventory/MemStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace MI
+{
+    namespace
+    {
+        // Pixels of queued and in-progress jobs
+        MemCounter& JobMemory()
+        {
+            static auto& counter = MemStats::Register("ImageExporter/jobs", MemKind::kCpu);
+            return counter;
+        }
+    }
+
+    ImageExporter::ImageExporter(unsigned workers, std::size_t maxQueued) :
+        m_maxQueued((std::max<std::size_t>)(maxQueued, 1))
+    {
+        workers = (std::max)(workers, 1u);
+        for (unsigned i = 0; i < workers; ++i) {
+            m_threads.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ImageExporter::~ImageExporter()
+    {
+        {
+            std::lock_guard lock(m_lock);
+            m_quit = true;
+        }
+        m_wake.notify_all();
+        for (auto& t : m_threads) {
+            t.join();
+        }
+    }
+
+    bool ImageExporter::Submit(Job&& job)
+    {
+        const auto bytes = static_cast<std::int64_t>(job.rgba.capacity());
+        {
+            std::lock_guard lock(m_lock);
+            if (m_queue.size() >= m_maxQueued) {
+                m_stats.dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            m_queue.push_back(std::move(job));
+        }
+        JobMemory().Add(bytes);
+        m_stats.submitted.fetch_add(1, std::memory_order_relaxed);
+        m_wake.notify_one();
+        return true;
+    }
+
+    void ImageExporter::Drain()
+    {
+        std::unique_lock lock(m_lock);
+        m_idle.wait(lock, [&] { return m_queue.empty() && m_active == 0; });
+    }
+
+    void ImageExporter::WorkerLoop()
+    {
+        std::vector<std::uint8_t> encoded;
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock lock(m_lock);
+                m_wake.wait(lock, [&] { return m_quit || !m_queue.empty(); });
+                if (m_queue.empty()) {
+                    return;  // quitting with nothing left to write
+                }
+                job = std::move(m_queue.front());
+                m_queue.pop_front();
+                ++m_active;
+            }
+
+            const auto t0 = std::chrono::steady_clock::now();
+            encoded.clear();
+            ImageEncode::Encode(job.format, job.rgba.data(), job.width, job.height, static_cast<std::size_t>(job.width) * 4, encoded);
+            m_stats.encodeNs.fetch_add(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count()),
+                std::memory_order_relaxed);
+
+            std::error_code ec;
+            const std::filesystem::path path{ job.path };
+            if (path.has_parent_path()) {
+                std::filesystem::create_directories(path.parent_path(), ec);
+            }
+            std::ofstream f(path, std::ios::binary | std::ios::trunc);
+            f.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+            if (f) {
+                m_stats.written.fetch_add(1, std::memory_order_relaxed);
+                m_stats.bytes.fetch_add(encoded.size(), std::memory_order_relaxed);
+            } else {
+                m_stats.failed.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            JobMemory().Add(-static_cast<std::int64_t>(job.rgba.capacity()));
+            job.rgba = {};
+            {
+                std::lock_guard lock(m_lock);
+                --m_active;
+            }
+            m_idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,154 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/InitGraph.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace MI
+{
+    namespace
+    {
+        thread_local bool t_inWorker = false;
+
+        std::uint64_t NowNs()
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        const char* ModeName(InitGraph::Mode mode)
+        {
+            switch (mode) {
+            case InitGraph::Mode::kSync:       return "sync";
+            case InitGraph::Mode::kBackground: return "background";
+            case InitGraph::Mode::kLazy:       return "lazy";
+            }
+            return "?";
+        }
+    }
+
+    InitGraph::StepId InitGraph::Add(std::string name, Mode mode, Fn fn, std::initializer_list<StepId> deps)
+    {
+        auto& step = m_steps.emplace_back();
+        step.name = std::move(name);
+        step.mode = mode;
+        step.fn = std::move(fn);
+        const auto id = static_cast<StepId>(m_steps.size() - 1);
+        for (const auto dep : deps) {
+            if (dep < id) {  // later ids can't be dependencies: that would allow cycles
+                step.deps.push_back(dep);
+            }
+        }
+        return id;
+    }
+
+    std::uint64_t InitGraph::SinceOrigin() const
+    {
+        const auto now = NowNs();
+        return now > m_originNs ? now - m_originNs : 0;
+    }
+
+    void InitGraph::Run()
+    {
+        m_originNs = NowNs();
+        m_caller = std::this_thread::get_id();
+        bool background = false;
+        for (StepId id = 0; id < m_steps.size(); ++id) {
+            if (m_steps[id].mode == Mode::kSync) {
+                Require(id);
+            }
+            background |= m_steps[id].mode == Mode::kBackground;
+        }
+        if (background) {
+            m_worker = std::thread([this] {
+                t_inWorker = true;
+                for (StepId id = 0; id < m_steps.size(); ++id) {
+                    if (m_steps[id].mode == Mode::kBackground) {
+                        Require(id);
+                    }
+                }
+            });
+        }
+        m_runNs = SinceOrigin();
+    }
+
+    bool InitGraph::Require(StepId id)
+    {
+        if (id >= m_steps.size()) {
+            return false;
+        }
+        auto& step = m_steps[id];
+        if (step.state.load(std::memory_order_acquire) == kDone) {
+            return step.ok;
+        }
+        for (const auto dep : step.deps) {
+            Require(dep);  // a failed dependency is the step's own business
+        }
+
+        std::uint8_t expected = kPending;
+        if (step.state.compare_exchange_strong(expected, kRunning, std::memory_order_acq_rel)) {
+            step.startNs = SinceOrigin();
+            bool ok = false;
+            try {
+                ok = step.fn ? step.fn() : true;
+            } catch (...) {
+                ok = false;
+            }
+            step.durationNs = SinceOrigin() - step.startNs;
+            step.ok = ok;
+            step.ran = t_inWorker ? Ran::kWorker : (std::this_thread::get_id() == m_caller ? Ran::kCaller : Ran::kOther);
+            {
+                std::lock_guard lock(m_lock);
+                step.state.store(kDone, std::memory_order_release);
+            }
+            m_done.notify_all();
+            return ok;
+        }
+
+        // Running on another thread
+        const auto t0 = NowNs();
+        std::unique_lock lock(m_lock);
+        m_done.wait(lock, [&] { return step.state.load(std::memory_order_acquire) == kDone; });
+        step.waitedNs.fetch_add(NowNs() - t0, std::memory_order_relaxed);
+        return step.ok;
+    }
+
+    bool InitGraph::Done(StepId id) const
+    {
+        return id < m_steps.size() && m_steps[id].state.load(std::memory_order_acquire) == kDone;
+    }
+
+    void InitGraph::WaitBackground()
+    {
+        if (m_worker.joinable()) {
+            m_worker.join();
+        }
+    }
+
+    std::string InitGraph::Report() const
+    {
+        static constexpr const char* kRanNames[] = { "caller", "worker", "other" };
+        char line[192];
+        std::snprintf(line, sizeof(line), "Startup: %.3f ms blocking the loader, %zu steps\n",
+                      static_cast<double>(m_runNs) / 1e6, m_steps.size());
+        std::string out = line;
+        std::snprintf(line, sizeof(line), "  %-20s %-10s %-7s %10s %10s %10s  %s\n", "step", "mode", "thread", "start ms",
+                      "time ms", "waited ms", "result");
+        out += line;
+        for (const auto& step : m_steps) {
+            const auto state = step.state.load(std::memory_order_acquire);
+            if (state != kDone) {
+                std::snprintf(line, sizeof(line), "  %-20s %-10s %-7s %10s %10s %10s  %s\n", step.name.c_str(),
+                              ModeName(step.mode), "-", "-", "-", "-", state == kRunning ? "running" : "not run");
+            } else {
+                std::snprintf(line, sizeof(line), "  %-20s %-10s %-7s %10.3f %10.3f %10.3f  %s\n", step.name.c_str(),
+                              ModeName(step.mode), kRanNames[static_cast<int>(step.ran)],
+                              static_cast<double>(step.startNs) / 1e6, static_cast<double>(step.durationNs) / 1e6,
+                              static_cast<double>(step.waitedNs.load(std::memory_order_relaxed)) / 1e6,
+                              step.ok ? "ok" : "failed");
+            }
+            out += line;
+        }
+        return out;
+    }
+}
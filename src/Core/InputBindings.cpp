@@ -0,0 +1,84 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/InputBindings.h"
+
+#include <algorithm>
+
+namespace MI
+{
+    bool InputBindings::Bind(InputAction action, std::uint32_t key)
+    {
+        std::lock_guard guard(m_write);
+        return BindLocked(action, key);
+    }
+
+    void InputBindings::Unbind(InputAction action)
+    {
+        std::lock_guard guard(m_write);
+        UnbindLocked(action);
+    }
+
+    bool InputBindings::Rebind(InputAction action, std::uint32_t key)
+    {
+        std::lock_guard guard(m_write);
+        UnbindLocked(action);
+        return key == 0 || BindLocked(action, key);
+    }
+
+    void InputBindings::SetEnabled(ActionMask actions)
+    {
+        std::lock_guard guard(m_write);
+        if (m_enabled.exchange(static_cast<ActionMask>(actions & kAll), std::memory_order_relaxed) != (actions & kAll)) {
+            Rebuild();
+        }
+    }
+
+    bool InputBindings::BindLocked(InputAction action, std::uint32_t key)
+    {
+        if (key == 0 || key >= kKeys || action >= InputAction::kCount) {
+            return false;
+        }
+        auto& keys = m_keys[Index(action)];
+        if (std::find(keys.begin(), keys.end(), key) != keys.end()) {
+            return true;
+        }
+        const auto free = std::find(keys.begin(), keys.end(), 0u);
+        if (free == keys.end()) {
+            return false;
+        }
+        *free = key;
+        m_actions[key].fetch_or(Bit(action), std::memory_order_relaxed);
+        Rebuild();
+        return true;
+    }
+
+    void InputBindings::UnbindLocked(InputAction action)
+    {
+        if (action >= InputAction::kCount) {
+            return;
+        }
+        for (auto& key : m_keys[Index(action)]) {
+            if (key != 0) {
+                m_actions[key].fetch_and(static_cast<ActionMask>(~Bit(action)), std::memory_order_relaxed);
+                key = 0;
+            }
+        }
+        Rebuild();
+    }
+
+    void InputBindings::Rebuild()
+    {
+        const auto    enabled = m_enabled.load(std::memory_order_relaxed);
+        std::uint32_t count = 0;
+        for (std::uint32_t word = 0; word < kKeys / 64; ++word) {
+            std::uint64_t bits = 0;
+            for (std::uint32_t bit = 0; bit < 64; ++bit) {
+                if (m_actions[word * 64 + bit].load(std::memory_order_relaxed) & enabled) {
+                    bits |= std::uint64_t{ 1 } << bit;
+                    ++count;
+                }
+            }
+            m_set[word].store(bits, std::memory_order_relaxed);
+        }
+        m_count.store(count, std::memory_order_relaxed);
+    }
+}
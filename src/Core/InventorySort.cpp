@@ -0,0 +1,310 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/InventorySort.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <numeric>
+
+namespace MI
+{
+    namespace
+    {
+        char Fold(char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+
+        // IEEE-754 bits reordered so unsigned comparison matches float comparison
+        std::uint32_t OrderedFloat(float f)
+        {
+            const auto u = std::bit_cast<std::uint32_t>(f);
+            return (u & 0x80000000u) ? ~u : u | 0x80000000u;
+        }
+
+        template <class Encode>
+        void PackHalf(std::size_t n, unsigned shift, std::vector<std::uint64_t>& keys, Encode&& encode)
+        {
+            for (std::size_t i = 0; i < n; ++i) {
+                keys[i] |= static_cast<std::uint64_t>(encode(i)) << shift;
+            }
+        }
+
+        void PackField(const SortColumns& rows, SortField field, bool invert, unsigned shift, std::vector<std::uint64_t>& keys)
+        {
+            const std::uint32_t flip = invert ? 0xFFFFFFFFu : 0u;
+            const auto n = rows.Size();
+            switch (field) {
+            case SortField::kName:
+                PackHalf(n, shift, keys, [&](std::size_t i) { return rows.nameRank[i] ^ flip; });
+                break;
+            case SortField::kWeight:
+                PackHalf(n, shift, keys, [&](std::size_t i) { return OrderedFloat(rows.weight[i]) ^ flip; });
+                break;
+            case SortField::kValue:
+                PackHalf(n, shift, keys, [&](std::size_t i) { return OrderedFloat(rows.value[i]) ^ flip; });
+                break;
+            case SortField::kValuePerWeight:
+                PackHalf(n, shift, keys, [&](std::size_t i) {
+                    const auto w = rows.weight[i];
+                    const auto vpw = w > 0.0f ? rows.value[i] / w : std::numeric_limits<float>::infinity();
+                    return OrderedFloat(vpw) ^ flip;
+                });
+                break;
+            case SortField::kCategory:
+                PackHalf(n, shift, keys, [&](std::size_t i) { return rows.category[i] ^ flip; });
+                break;
+            }
+        }
+    }
+
+    bool NameCollation::Less(std::string_view a, std::string_view b)
+    {
+        const auto n = (std::min)(a.size(), b.size());
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto fa = Fold(a[i]);
+            const auto fb = Fold(b[i]);
+            if (fa != fb) {
+                return static_cast<unsigned char>(fa) < static_cast<unsigned char>(fb);
+            }
+        }
+        if (a.size() != b.size()) {
+            return a.size() < b.size();
+        }
+        return a < b;  // same letters: a fixed order between "Iron" and "iron"
+    }
+
+    void NameCollation::Build(std::span<const std::string> names)
+    {
+        m_ranks.clear();
+        m_names.assign(names.begin(), names.end());
+        std::sort(m_names.begin(), m_names.end(), Less);
+        m_names.erase(std::unique(m_names.begin(), m_names.end()), m_names.end());
+        m_ranks.reserve(m_names.size());
+        for (std::size_t i = 0; i < m_names.size(); ++i) {
+            m_ranks.emplace(m_names[i], static_cast<std::uint32_t>(i));
+        }
+    }
+
+    std::uint32_t NameCollation::Rank(std::string_view name) const
+    {
+        const auto it = m_ranks.find(name);
+        return it != m_ranks.end() ? it->second : static_cast<std::uint32_t>(m_names.size());
+    }
+
+    void PackSortKeys(const SortColumns& rows, const SortOrder& order, std::vector<std::uint64_t>& keys)
+    {
+        keys.assign(rows.Size(), 0);
+        PackField(rows, order.primary, order.descending, 32, keys);
+        PackField(rows, order.secondary, false, 0, keys);
+    }
+
+    InventorySorter::InventorySorter(unsigned workers)
+    {
+        if (workers == kAuto) {
+            const unsigned hw = std::thread::hardware_concurrency();
+            workers = hw > 1 ? (std::min)(hw - 1, 7u) : 0u;
+        }
+        m_partHist.resize(workers + 1);
+        m_partOffset.resize(workers + 1);
+        m_threads.reserve(workers);
+        for (unsigned i = 0; i < workers; ++i) {
+            m_threads.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    InventorySorter::~InventorySorter()
+    {
+        {
+            std::lock_guard lock(m_lock);
+            m_quit = true;
+        }
+        m_wake.notify_all();
+        for (auto& t : m_threads) {
+            t.join();
+        }
+    }
+
+    const std::vector<std::uint32_t>& InventorySorter::Sort(std::span<const std::uint64_t> keys)
+    {
+        const auto n = keys.size();
+        m_keys.assign(keys.begin(), keys.end());
+        m_order.resize(n);
+        std::iota(m_order.begin(), m_order.end(), 0u);
+        m_tmpKeys.resize(n);
+        m_tmpOrder.resize(n);
+        if (n >= kParallelMin && !m_threads.empty()) {
+            RadixParallel();
+        } else {
+            RadixSequential();
+        }
+        ++m_stats.sorts;
+        return m_order;
+    }
+
+    void InventorySorter::RadixSequential()
+    {
+        const auto n = m_keys.size();
+        std::array<Histogram, kDigits> hist{};
+        for (const auto key : m_keys) {
+            for (std::size_t d = 0; d < kDigits; ++d) {
+                ++hist[d][(key >> (d * 8)) & 0xFF];
+            }
+        }
+        for (std::size_t d = 0; d < kDigits; ++d) {
+            const auto shift = d * 8;
+            if (hist[d][(m_keys.empty() ? 0 : m_keys[0] >> shift) & 0xFF] == n) {
+                ++m_stats.passesSkipped;  // every key has this digit: order unchanged
+                continue;
+            }
+            std::uint32_t sum = 0;
+            for (auto& count : hist[d]) {
+                const auto c = count;
+                count = sum;
+                sum += c;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto at = hist[d][(m_keys[i] >> shift) & 0xFF]++;
+                m_tmpKeys[at] = m_keys[i];
+                m_tmpOrder[at] = m_order[i];
+            }
+            m_keys.swap(m_tmpKeys);
+            m_order.swap(m_tmpOrder);
+        }
+    }
+
+    // Per digit: every part counts its slice, the counts become per-part write offsets
+    // (parts in order within a bucket, so the pass stays stable), then every part scatters.
+    void InventorySorter::RadixParallel()
+    {
+        const auto n = m_keys.size();
+        const auto parts = static_cast<unsigned>(m_partHist.size());
+        for (m_digit = 0; m_digit < kDigits; ++m_digit) {
+            RunParts(&InventorySorter::CountPart, parts);
+            std::uint32_t sum = 0;
+            bool          trivial = false;
+            for (std::size_t b = 0; b < kBuckets; ++b) {
+                std::uint32_t bucket = 0;
+                for (unsigned p = 0; p < parts; ++p) {
+                    m_partOffset[p][b] = sum + bucket;
+                    bucket += m_partHist[p][b];
+                }
+                trivial |= bucket == n;
+                sum += bucket;
+            }
+            if (trivial) {
+                ++m_stats.passesSkipped;
+                continue;
+            }
+            RunParts(&InventorySorter::ScatterPart, parts);
+            m_keys.swap(m_tmpKeys);
+            m_order.swap(m_tmpOrder);
+        }
+    }
+
+    void InventorySorter::CountPart(unsigned part)
+    {
+        const auto n = m_keys.size();
+        const auto parts = m_partHist.size();
+        const auto shift = m_digit * 8;
+        auto&      hist = m_partHist[part];
+        hist.fill(0);
+        for (std::size_t i = n * part / parts, end = n * (part + 1) / parts; i < end; ++i) {
+            ++hist[(m_keys[i] >> shift) & 0xFF];
+        }
+    }
+
+    void InventorySorter::ScatterPart(unsigned part)
+    {
+        const auto n = m_keys.size();
+        const auto parts = m_partHist.size();
+        const auto shift = m_digit * 8;
+        auto&      offset = m_partOffset[part];
+        for (std::size_t i = n * part / parts, end = n * (part + 1) / parts; i < end; ++i) {
+            const auto at = offset[(m_keys[i] >> shift) & 0xFF]++;
+            m_tmpKeys[at] = m_keys[i];
+            m_tmpOrder[at] = m_order[i];
+        }
+    }
+
+    const std::vector<std::uint32_t>& InventorySorter::Patch(std::span<const std::uint64_t> keys,
+                                                             std::span<const std::uint32_t> changed)
+    {
+        const auto n = keys.size();
+        const auto before = m_order.size();
+        if (before == 0 || n < before || changed.size() + (n - before) > n / 8) {
+            ++m_stats.patchFallbacks;
+            return Sort(keys);
+        }
+        const auto less = [&](std::uint32_t a, std::uint32_t b) { return keys[a] != keys[b] ? keys[a] < keys[b] : a < b; };
+
+        m_marked.resize(n, 0);
+        m_patch.clear();
+        for (const auto row : changed) {
+            if (row < n && !m_marked[row]) {
+                m_marked[row] = 1;
+                m_patch.push_back(row);
+            }
+        }
+        for (auto row = static_cast<std::uint32_t>(before); row < n; ++row) {
+            m_marked[row] = 1;
+            m_patch.push_back(row);
+        }
+        std::sort(m_patch.begin(), m_patch.end(), less);
+
+        // Unchanged rows keep their relative order; merge the re-keyed ones back in
+        m_tmpOrder.clear();
+        for (const auto row : m_order) {
+            if (!m_marked[row]) {
+                m_tmpOrder.push_back(row);
+            }
+        }
+        m_order.resize(n);
+        std::merge(m_tmpOrder.begin(), m_tmpOrder.end(), m_patch.begin(), m_patch.end(), m_order.begin(), less);
+        for (const auto row : m_patch) {
+            m_marked[row] = 0;
+        }
+        ++m_stats.patches;
+        return m_order;
+    }
+
+    void InventorySorter::RunParts(void (InventorySorter::*job)(unsigned), unsigned parts)
+    {
+        m_job = job;
+        m_parts = parts;
+        m_nextPart.store(0, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(m_lock);
+            m_busy = static_cast<unsigned>(m_threads.size());
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        for (auto part = m_nextPart.fetch_add(1); part < parts; part = m_nextPart.fetch_add(1)) {
+            (this->*job)(part);
+        }
+
+        std::unique_lock lock(m_lock);
+        m_done.wait(lock, [&] { return m_busy == 0; });
+    }
+
+    void InventorySorter::WorkerLoop()
+    {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock lock(m_lock);
+                m_wake.wait(lock, [&] { return m_quit || m_generation != seen; });
+                if (m_quit) {
+                    return;
+                }
+                seen = m_generation;
+            }
+            for (auto part = m_nextPart.fetch_add(1); part < m_parts; part = m_nextPart.fetch_add(1)) {
+                (this->*m_job)(part);
+            }
+            {
+                std::lock_guard lock(m_lock);
+                --m_busy;
+            }
+            m_done.notify_one();
+        }
+    }
+}
@@ -0,0 +1,443 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/ItemFilter.h"
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define MI_FILTER_SSE2 1
+#else
+#   define MI_FILTER_SSE2 0
+#endif
+
+namespace MI
+{
+    namespace
+    {
+        bool IEquals(std::string_view a, std::string_view b)
+        {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                       return (x >= 'A' && x <= 'Z' ? x - 'A' + 'a' : x) == (y >= 'A' && y <= 'Z' ? y - 'A' + 'a' : y);
+                   });
+        }
+
+        // dst = dst OP src over n words, two per instruction where SSE2 is available
+        enum class Bitwise
+        {
+            kAnd,
+            kOr,
+            kAndNot
+        };
+
+        template <Bitwise kOp>
+        void Combine(std::uint64_t* dst, const std::uint64_t* src, std::size_t n)
+        {
+            std::size_t i = 0;
+#if MI_FILTER_SSE2
+            for (; i + 2 <= n; i += 2) {
+                const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+                const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i    r;
+                if constexpr (kOp == Bitwise::kAnd) {
+                    r = _mm_and_si128(a, b);
+                } else if constexpr (kOp == Bitwise::kOr) {
+                    r = _mm_or_si128(a, b);
+                } else {
+                    r = _mm_andnot_si128(b, a);
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+            }
+#endif
+            for (; i < n; ++i) {
+                if constexpr (kOp == Bitwise::kAnd) {
+                    dst[i] &= src[i];
+                } else if constexpr (kOp == Bitwise::kOr) {
+                    dst[i] |= src[i];
+                } else {
+                    dst[i] &= ~src[i];
+                }
+            }
+        }
+
+        void Invert(std::uint64_t* dst, std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; ++i) {
+                dst[i] = ~dst[i];
+            }
+        }
+
+        struct Token
+        {
+            enum Kind { kWord, kAnd, kOr, kNot, kOpen, kClose, kEnd } kind{ kEnd };
+            std::string_view text;
+        };
+
+        class Parser
+        {
+        public:
+            Parser(std::string_view text, const ItemBitsets& bitsets, FilterProgram& out) : m_text(text), m_bitsets(bitsets), m_out(out)
+            {
+                Advance();
+            }
+
+            bool Run(std::string& error)
+            {
+                if (m_token.kind == Token::kEnd) {
+                    m_out.steps.push_back({ FilterProgram::Op::kAll, 0 });
+                    return true;
+                }
+                if (Or() && m_token.kind != Token::kEnd) {
+                    Fail("unexpected ')'");
+                }
+                error = m_error;
+                return m_error.empty();
+            }
+
+        private:
+            void Advance()
+            {
+                while (m_pos < m_text.size() && m_text[m_pos] == ' ') {
+                    ++m_pos;
+                }
+                if (m_pos >= m_text.size()) {
+                    m_token = { Token::kEnd, {} };
+                    return;
+                }
+                const char c = m_text[m_pos];
+                if (c == '(' || c == ')') {
+                    m_token = { c == '(' ? Token::kOpen : Token::kClose, m_text.substr(m_pos++, 1) };
+                    return;
+                }
+                const auto start = m_pos;
+                while (m_pos < m_text.size() && m_text[m_pos] != ' ' && m_text[m_pos] != '(' && m_text[m_pos] != ')') {
+                    ++m_pos;
+                }
+                const auto word = m_text.substr(start, m_pos - start);
+                const auto kind = IEquals(word, "AND") ? Token::kAnd
+                                : IEquals(word, "OR")  ? Token::kOr
+                                : IEquals(word, "NOT") ? Token::kNot
+                                                       : Token::kWord;
+                m_token = { kind, word };
+            }
+
+            bool Fail(std::string what)
+            {
+                if (m_error.empty()) {
+                    m_error = std::move(what);
+                }
+                return false;
+            }
+
+            bool Or()
+            {
+                if (!And()) {
+                    return false;
+                }
+                while (m_token.kind == Token::kOr) {
+                    Advance();
+                    if (!And()) {
+                        return false;
+                    }
+                    m_out.steps.push_back({ FilterProgram::Op::kOr, 0 });
+                }
+                return true;
+            }
+
+            bool And()
+            {
+                if (!Unary()) {
+                    return false;
+                }
+                while (m_token.kind == Token::kAnd) {
+                    Advance();
+                    if (!Unary()) {
+                        return false;
+                    }
+                    auto& last = m_out.steps.back();
+                    if (last.op == FilterProgram::Op::kNot) {
+                        last.op = FilterProgram::Op::kAndNot;
+                    } else {
+                        m_out.steps.push_back({ FilterProgram::Op::kAnd, 0 });
+                    }
+                }
+                return true;
+            }
+
+            bool Unary()
+            {
+                switch (m_token.kind) {
+                case Token::kNot:
+                    Advance();
+                    if (!Unary()) {
+                        return false;
+                    }
+                    m_out.steps.push_back({ FilterProgram::Op::kNot, 0 });
+                    return true;
+                case Token::kOpen:
+                    Advance();
+                    if (!Or()) {
+                        return false;
+                    }
+                    if (m_token.kind != Token::kClose) {
+                        return Fail("missing ')'");
+                    }
+                    Advance();
+                    return true;
+                case Token::kWord:
+                    return Term();
+                default:
+                    return Fail(m_token.kind == Token::kEnd ? "expression ends early" : "expected a term");
+                }
+            }
+
+            // Consecutive words up to the next reserved word or parenthesis: "light armor"
+            bool Term()
+            {
+                const char* first = m_token.text.data();
+                const char* last = first + m_token.text.size();
+                Advance();
+                while (m_token.kind == Token::kWord) {
+                    last = m_token.text.data() + m_token.text.size();
+                    Advance();
+                }
+                std::string name;
+                for (const char* c = first; c < last; ++c) {  // collapse runs of spaces
+                    if (*c != ' ' || (name.size() && name.back() != ' ')) {
+                        name += *c;
+                    }
+                }
+                const auto term = m_bitsets.Find(name);
+                if (term == ItemBitsets::kNoTerm) {
+                    return Fail("unknown term '" + name + "'");
+                }
+                m_out.steps.push_back({ FilterProgram::Op::kTerm, term });
+                return true;
+            }
+
+            std::string_view   m_text;
+            std::size_t        m_pos{};
+            Token              m_token;
+            const ItemBitsets& m_bitsets;
+            FilterProgram&     m_out;
+            std::string        m_error;
+        };
+    }
+
+    std::uint32_t ItemBitsets::AddTerm(std::string_view name)
+    {
+        if (const auto term = Find(name); term != kNoTerm) {
+            return term;
+        }
+        m_names.emplace_back(name);
+        m_bits.emplace_back(Words(), 0);
+        m_counts.push_back(0);
+        return static_cast<std::uint32_t>(m_names.size() - 1);
+    }
+
+    std::uint32_t ItemBitsets::Find(std::string_view name) const
+    {
+        for (std::size_t i = 0; i < m_names.size(); ++i) {
+            if (IEquals(m_names[i], name)) {
+                return static_cast<std::uint32_t>(i);
+            }
+        }
+        return kNoTerm;
+    }
+
+    void ItemBitsets::Resize(std::size_t rows)
+    {
+        if (rows < m_rows) {
+            for (std::size_t t = 0; t < m_bits.size(); ++t) {
+                for (auto row = rows; row < m_rows; ++row) {
+                    Set(static_cast<std::uint32_t>(t), row, false);
+                }
+            }
+        }
+        m_rows = rows;
+        for (auto& bits : m_bits) {
+            bits.resize(Words(), 0);
+        }
+        m_blockGen.resize((Words() + kBlockWords - 1) / kBlockWords, m_generation);
+        ++m_generation;
+    }
+
+    void ItemBitsets::Touch(std::size_t row)
+    {
+        m_blockGen[row / kBlockRows] = ++m_generation;
+    }
+
+    void ItemBitsets::Set(std::uint32_t term, std::size_t row, bool on)
+    {
+        auto&      word = m_bits[term][row / 64];
+        const auto bit = std::uint64_t{ 1 } << (row % 64);
+        if (((word & bit) != 0) == on) {
+            return;
+        }
+        word ^= bit;
+        m_counts[term] += on ? 1 : static_cast<std::size_t>(-1);
+        Touch(row);
+    }
+
+    void ItemBitsets::SetRow(std::size_t row, std::span<const std::uint32_t> terms)
+    {
+        for (std::uint32_t t = 0; t < m_bits.size(); ++t) {
+            Set(t, row, std::find(terms.begin(), terms.end(), t) != terms.end());
+        }
+    }
+
+    bool ItemBitsets::Has(std::uint32_t term, std::size_t row) const
+    {
+        return (m_bits[term][row / 64] >> (row % 64)) & 1;
+    }
+
+    bool FilterProgram::Compile(std::string_view text, const ItemBitsets& bitsets, FilterProgram& out, std::string* error)
+    {
+        out.steps.clear();
+        out.depth = 0;
+        std::string message;
+        if (!Parser(text, bitsets, out).Run(message)) {
+            out.steps.clear();
+            if (error) {
+                *error = message;
+            }
+            return false;
+        }
+
+        // A term pushed right before a binary operation is read in place by it
+        std::vector<Step> fused;
+        fused.reserve(out.steps.size());
+        for (std::size_t i = 0; i < out.steps.size(); ++i) {
+            const auto& step = out.steps[i];
+            const auto* next = i + 1 < out.steps.size() ? &out.steps[i + 1] : nullptr;
+            if (step.op == Op::kTerm && next && (next->op == Op::kAnd || next->op == Op::kOr || next->op == Op::kAndNot)) {
+                fused.push_back({ next->op == Op::kAnd ? Op::kAndTerm : next->op == Op::kOr ? Op::kOrTerm : Op::kAndNotTerm, step.term });
+                ++i;
+            } else {
+                fused.push_back(step);
+            }
+        }
+        out.steps.swap(fused);
+
+        std::size_t sp = 0;
+        for (const auto& step : out.steps) {
+            switch (step.op) {
+            case Op::kTerm:
+            case Op::kAll:
+                out.depth = (std::max)(out.depth, ++sp);
+                break;
+            case Op::kAnd:
+            case Op::kOr:
+            case Op::kAndNot:
+                --sp;
+                break;
+            default:
+                break;
+            }
+        }
+        return true;
+    }
+
+    void FilterView::Set(const FilterProgram& program)
+    {
+        m_program = program;
+        m_stack.assign(program.depth * ItemBitsets::kBlockWords, 0);
+        m_full = true;
+    }
+
+    std::size_t FilterView::Update(const ItemBitsets& bitsets)
+    {
+        if (m_full || m_rows != bitsets.Rows()) {
+            m_full = false;
+            m_rows = bitsets.Rows();
+            m_words.assign(bitsets.Words(), 0);
+            m_blockCount.assign(bitsets.Blocks(), 0);
+            m_count = 0;
+            for (std::size_t b = 0; b < bitsets.Blocks(); ++b) {
+                EvaluateBlock(bitsets, b);
+            }
+            m_seen = bitsets.Generation();
+            return bitsets.Blocks();
+        }
+        if (bitsets.Generation() == m_seen) {
+            return 0;
+        }
+        std::size_t evaluated = 0;
+        for (std::size_t b = 0; b < bitsets.Blocks(); ++b) {
+            if (bitsets.BlockGeneration(b) > m_seen) {
+                EvaluateBlock(bitsets, b);
+                ++evaluated;
+            }
+        }
+        m_seen = bitsets.Generation();
+        return evaluated;
+    }
+
+    void FilterView::EvaluateBlock(const ItemBitsets& bitsets, std::size_t block)
+    {
+        using Op = FilterProgram::Op;
+        constexpr auto kBlockWords = ItemBitsets::kBlockWords;
+        const auto     w0 = block * kBlockWords;
+        const auto     n = (std::min)(bitsets.Words() - w0, kBlockWords);
+        std::size_t    sp = 0;
+        const auto     slot = [&](std::size_t i) { return m_stack.data() + i * kBlockWords; };
+        for (const auto& step : m_program.steps) {
+            switch (step.op) {
+            case Op::kTerm:
+                std::copy_n(bitsets.Bits(step.term) + w0, n, slot(sp++));
+                break;
+            case Op::kAll:
+                std::fill_n(slot(sp++), n, ~std::uint64_t{ 0 });
+                break;
+            case Op::kAnd:
+                --sp;
+                Combine<Bitwise::kAnd>(slot(sp - 1), slot(sp), n);
+                break;
+            case Op::kOr:
+                --sp;
+                Combine<Bitwise::kOr>(slot(sp - 1), slot(sp), n);
+                break;
+            case Op::kAndNot:
+                --sp;
+                Combine<Bitwise::kAndNot>(slot(sp - 1), slot(sp), n);
+                break;
+            case Op::kNot:
+                Invert(slot(sp - 1), n);
+                break;
+            case Op::kAndTerm:
+                Combine<Bitwise::kAnd>(slot(sp - 1), bitsets.Bits(step.term) + w0, n);
+                break;
+            case Op::kOrTerm:
+                Combine<Bitwise::kOr>(slot(sp - 1), bitsets.Bits(step.term) + w0, n);
+                break;
+            case Op::kAndNotTerm:
+                Combine<Bitwise::kAndNot>(slot(sp - 1), bitsets.Bits(step.term) + w0, n);
+                break;
+            }
+        }
+
+        auto* out = m_words.data() + w0;
+        std::copy_n(slot(0), n, out);
+        if (w0 + n == bitsets.Words() && m_rows % 64) {
+            out[n - 1] &= (std::uint64_t{ 1 } << (m_rows % 64)) - 1;  // NOT / all set bits past the last row
+        }
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            count += static_cast<std::size_t>(std::popcount(out[i]));
+        }
+        m_count += count - m_blockCount[block];
+        m_blockCount[block] = count;
+    }
+
+    void FilterView::Badges(const ItemBitsets& bitsets, std::span<const std::uint32_t> terms, std::span<std::size_t> counts) const
+    {
+        for (std::size_t t = 0; t < terms.size() && t < counts.size(); ++t) {
+            const auto* bits = bitsets.Bits(terms[t]);
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < m_words.size(); ++i) {
+                count += static_cast<std::size_t>(std::popcount(m_words[i] & bits[i]));
+            }
+            counts[t] = count;
+        }
+    }
+}
@@ -0,0 +1,144 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/MemStats.h"
+
+#include <array>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+
+namespace MI
+{
+    namespace
+    {
+        std::mutex g_lock;  // registration and snapshots only
+
+        // Deque: references survive growth. Never destroyed, so static owners can still
+        // release their share during shutdown.
+        std::deque<MemCounter>& Counters()
+        {
+            static auto* counters = new std::deque<MemCounter>();
+            return *counters;
+        }
+
+        std::array<std::atomic<std::int64_t>, kMemKindCount> g_total{};
+        std::array<std::atomic<std::int64_t>, kMemKindCount> g_totalPeak{};
+
+        void RaisePeak(std::atomic<std::int64_t>& peak, std::int64_t value)
+        {
+            auto seen = peak.load(std::memory_order_relaxed);
+            while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+        }
+
+        void AddToKind(MemKind kind, std::int64_t delta)
+        {
+            const auto i = static_cast<std::size_t>(kind);
+            const auto now = g_total[i].fetch_add(delta, std::memory_order_relaxed) + delta;
+            if (delta > 0) {
+                RaisePeak(g_totalPeak[i], now);
+            }
+        }
+
+        void FormatBytes(char* out, std::size_t size, std::int64_t bytes)
+        {
+            const double v = static_cast<double>(bytes);
+            if (bytes >= (std::int64_t{ 1 } << 20) || bytes <= -(std::int64_t{ 1 } << 20)) {
+                std::snprintf(out, size, "%.2f MiB", v / (1024.0 * 1024.0));
+            } else if (bytes >= 1024 || bytes <= -1024) {
+                std::snprintf(out, size, "%.1f KiB", v / 1024.0);
+            } else {
+                std::snprintf(out, size, "%" PRId64 " B", bytes);
+            }
+        }
+    }
+
+    void MemCounter::Add(std::int64_t bytes)
+    {
+        if (bytes == 0) {
+            return;
+        }
+        const auto now = m_current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        if (bytes > 0) {
+            RaisePeak(m_peak, now);
+        }
+        AddToKind(m_kind, bytes);
+    }
+
+    void MemCounter::Set(std::int64_t bytes)
+    {
+        const auto before = m_current.exchange(bytes, std::memory_order_relaxed);
+        RaisePeak(m_peak, bytes);
+        AddToKind(m_kind, bytes - before);
+    }
+
+    MemCounter& MemStats::Register(const char* name, MemKind kind)
+    {
+        std::lock_guard lock(g_lock);
+        auto& counters = Counters();
+        for (auto& c : counters) {
+            if (std::strcmp(c.Name(), name) == 0) {
+                return c;
+            }
+        }
+        return counters.emplace_back(name, kind);
+    }
+
+    void MemStats::Snapshot(std::vector<Entry>& out)
+    {
+        std::lock_guard lock(g_lock);
+        out.clear();
+        const auto& counters = Counters();
+        out.reserve(counters.size());
+        for (const auto& c : counters) {
+            out.push_back({ c.Name(), c.Kind(), c.Current(), c.Peak() });
+        }
+    }
+
+    std::int64_t MemStats::Total(MemKind kind)
+    {
+        return g_total[static_cast<std::size_t>(kind)].load(std::memory_order_relaxed);
+    }
+
+    std::int64_t MemStats::TotalPeak(MemKind kind)
+    {
+        return g_totalPeak[static_cast<std::size_t>(kind)].load(std::memory_order_relaxed);
+    }
+
+    const char* MemStats::KindName(MemKind kind)
+    {
+        switch (kind) {
+        case MemKind::kGpu:
+            return "gpu";
+        case MemKind::kCpu:
+            return "cpu";
+        case MemKind::kEngine:
+            return "engine";
+        default:
+            return "?";
+        }
+    }
+
+    std::string MemStats::Format()
+    {
+        std::vector<Entry> entries;
+        Snapshot(entries);
+
+        std::string out = "Memory (current / peak):\n";
+        char        line[160], cur[32], peak[32];
+        for (const auto& e : entries) {
+            FormatBytes(cur, sizeof(cur), e.current);
+            FormatBytes(peak, sizeof(peak), e.peak);
+            std::snprintf(line, sizeof(line), "  %-6s %-32s %12s / %12s\n", KindName(e.kind), e.name, cur, peak);
+            out += line;
+        }
+        for (std::size_t i = 0; i < kMemKindCount; ++i) {
+            const auto kind = static_cast<MemKind>(i);
+            FormatBytes(cur, sizeof(cur), Total(kind));
+            FormatBytes(peak, sizeof(peak), TotalPeak(kind));
+            std::snprintf(line, sizeof(line), "  total  %-32s %12s / %12s\n", KindName(kind), cur, peak);
+            out += line;
+        }
+        return out;
+    }
+}
@@ -0,0 +1,149 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/MultiView.h"
+
+#include <cmath>
+
+namespace MI
+{
+    void MultiViewPass::Layout(std::size_t count, std::uint32_t width, std::uint32_t height, std::vector<ViewRect>& out)
+    {
+        out.clear();
+        if (count == 0) {
+            return;
+        }
+        const auto cols = static_cast<std::uint32_t>(
+            count <= 3 ? count : static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count)))));
+        const auto rows = static_cast<std::uint32_t>((count + cols - 1) / cols);
+        const std::uint32_t gutterW = kGutter * (cols - 1);
+        const std::uint32_t gutterH = kGutter * (rows - 1);
+        const std::uint32_t tileW = width > gutterW ? (width - gutterW) / cols : 0;
+        const std::uint32_t tileH = height > gutterH ? (height - gutterH) / rows : 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto col = static_cast<std::uint32_t>(i % cols);
+            const auto row = static_cast<std::uint32_t>(i / cols);
+            out.push_back({ col * (tileW + kGutter), row * (tileH + kGutter), tileW, tileH });
+        }
+    }
+
+    void MultiViewPass::SetViews(const std::vector<PreviewView>& views)
+    {
+        if (views.size() != m_slots.size()) {
+            m_slots.resize(views.size());
+            for (std::size_t i = 0; i < views.size(); ++i) {
+                m_slots[i].view = views[i];
+            }
+            Relayout();
+            return;
+        }
+        for (std::size_t i = 0; i < views.size(); ++i) {
+            if (!(m_slots[i].view == views[i])) {
+                m_slots[i].view = views[i];
+                m_slots[i].dirty = true;
+            }
+        }
+    }
+
+    void MultiViewPass::SetTargetSize(std::uint32_t width, std::uint32_t height)
+    {
+        if (width == m_width && height == m_height) {
+            return;
+        }
+        m_width = width;
+        m_height = height;
+        Relayout();
+    }
+
+    void MultiViewPass::SetVariantGeneration(std::uint32_t variant, std::uint64_t generation)
+    {
+        if (variant >= m_generations.size()) {
+            m_generations.resize(variant + 1, 0);
+        }
+        m_generations[variant] = generation;
+    }
+
+    void MultiViewPass::Invalidate()
+    {
+        for (auto& slot : m_slots) {
+            slot.dirty = true;
+        }
+        m_clearAll = true;
+    }
+
+    void MultiViewPass::Relayout()
+    {
+        Layout(m_slots.size(), m_width, m_height, m_rects);
+        for (std::size_t i = 0; i < m_slots.size(); ++i) {
+            m_slots[i].rect = m_rects[i];
+        }
+        Invalidate();
+    }
+
+    std::uint64_t MultiViewPass::GenerationOf(std::uint32_t variant) const
+    {
+        return variant < m_generations.size() ? m_generations[variant] : 0;
+    }
+
+    std::uint32_t MultiViewPass::Render(IMultiViewBackend& backend)
+    {
+        m_dirty.clear();
+        std::uint64_t visible = 0;
+        for (std::uint32_t i = 0; i < m_slots.size(); ++i) {
+            auto& slot = m_slots[i];
+            if (slot.rect.Empty()) {
+                continue;
+            }
+            ++visible;
+            if (slot.generation != GenerationOf(slot.view.variant)) {
+                slot.dirty = true;
+            }
+            if (slot.dirty) {
+                m_dirty.push_back(i);
+            }
+        }
+        if (m_dirty.empty() && !m_clearAll) {
+            m_stats.viewsReused += visible;
+            return 0;
+        }
+        if (!backend.BeginPass()) {
+            return 0;
+        }
+        ++m_stats.passes;
+
+        if (!m_clearAll) {
+            for (const auto i : m_dirty) {
+                if (!backend.ClearRect(m_slots[i].rect)) {
+                    m_clearAll = true;  // no partial clears: start the whole target over
+                    break;
+                }
+            }
+        }
+        if (m_clearAll) {
+            backend.ClearTarget();
+            ++m_stats.fullClears;
+            m_clearAll = false;
+            m_dirty.clear();
+            for (std::uint32_t i = 0; i < m_slots.size(); ++i) {
+                if (!m_slots[i].rect.Empty()) {
+                    m_slots[i].dirty = true;
+                    m_dirty.push_back(i);
+                }
+            }
+        }
+
+        std::uint32_t drawn = 0;
+        for (const auto i : m_dirty) {
+            auto& slot = m_slots[i];
+            if (backend.DrawView(slot.rect, slot.view)) {
+                slot.dirty = false;
+                slot.generation = GenerationOf(slot.view.variant);
+                ++drawn;
+            } else {
+                ++m_stats.viewsFailed;
+            }
+        }
+        backend.EndPass();
+        m_stats.viewsDrawn += drawn;
+        m_stats.viewsReused += visible - m_dirty.size();
+        return drawn;
+    }
+}
@@ -0,0 +1,133 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/OverlayRegistry.h"
+
+namespace MI
+{
+    namespace
+    {
+        constexpr std::uint32_t kPhaseMask = 3u;
+
+        constexpr std::uint32_t SeqOf(std::uint32_t state) { return state >> 2; }
+        constexpr std::uint32_t PhaseOf(std::uint32_t state) { return state & kPhaseMask; }
+        constexpr std::uint32_t State(std::uint32_t seq, std::uint32_t phase) { return (seq << 2) | phase; }
+
+        // Handle = seq << 8 | slot index; seq >= 1 after the first claim, so never 0
+        constexpr OverlayRegistry::Handle MakeHandle(std::uint32_t seq, std::size_t index)
+        {
+            return (static_cast<std::uint64_t>(seq) << 8) | index;
+        }
+    }
+
+    OverlayRegistry::Handle OverlayRegistry::Register(const char* name, std::int32_t priority, Callback fn, void* user)
+    {
+        if (!fn) {
+            m_stats.rejected.fetch_add(1, std::memory_order_relaxed);
+            return kInvalid;
+        }
+        for (std::size_t i = 0; i < kCapacity; ++i) {
+            auto& slot = m_slots[i];
+            auto  state = slot.state.load(std::memory_order_relaxed);
+            if (PhaseOf(state) != kFree) {
+                continue;
+            }
+            const auto seq = SeqOf(state) + 1;
+            if (!slot.state.compare_exchange_strong(state, State(seq, kWriting), std::memory_order_relaxed)) {
+                continue;  // another registrant took it
+            }
+            // Release stores: a reader that loads one of these (acquire) also sees kWriting
+            // when it re-checks state, so a half-written slot is never taken for the old one
+            slot.fn.store(fn, std::memory_order_release);
+            slot.user.store(user, std::memory_order_release);
+            slot.name.store(name, std::memory_order_release);
+            slot.priority.store(priority, std::memory_order_release);
+            slot.serial.store(m_serial.fetch_add(1, std::memory_order_relaxed), std::memory_order_release);
+            slot.state.store(State(seq, kReady), std::memory_order_release);
+
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            m_generation.fetch_add(1, std::memory_order_release);
+            m_stats.registered.fetch_add(1, std::memory_order_relaxed);
+            return MakeHandle(seq, i);
+        }
+        m_stats.rejected.fetch_add(1, std::memory_order_relaxed);
+        return kInvalid;
+    }
+
+    bool OverlayRegistry::Unregister(Handle handle)
+    {
+        const auto index = static_cast<std::size_t>(handle & 0xFFu);
+        const auto seq = static_cast<std::uint32_t>(handle >> 8);
+        if (handle == kInvalid || index >= kCapacity) {
+            return false;
+        }
+        auto expected = State(seq, kReady);
+        if (!m_slots[index].state.compare_exchange_strong(expected, State(seq, kFree), std::memory_order_acq_rel)) {
+            return false;  // stale or already removed
+        }
+        m_count.fetch_sub(1, std::memory_order_relaxed);
+        m_generation.fetch_add(1, std::memory_order_release);
+        m_stats.unregistered.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void OverlayRegistry::Reorder()
+    {
+        struct Key
+        {
+            std::int32_t  priority;
+            std::uint64_t serial;
+        };
+        std::array<Key, kCapacity> keys{};
+
+        m_orderCount = 0;
+        for (std::size_t i = 0; i < kCapacity; ++i) {
+            auto&      slot = m_slots[i];
+            const auto state = slot.state.load(std::memory_order_acquire);
+            if (PhaseOf(state) != kReady) {
+                continue;
+            }
+            const Key key{ slot.priority.load(std::memory_order_acquire), slot.serial.load(std::memory_order_acquire) };
+            if (slot.state.load(std::memory_order_relaxed) != state) {
+                continue;  // replaced while reading; the generation bump brings us back
+            }
+            // Insertion sort: a handful of overlays, and it never allocates
+            auto n = m_orderCount++;
+            while (n > 0 && (keys[n - 1].priority > key.priority ||
+                             (keys[n - 1].priority == key.priority && keys[n - 1].serial > key.serial))) {
+                keys[n] = keys[n - 1];
+                m_order[n] = m_order[n - 1];
+                m_orderState[n] = m_orderState[n - 1];
+                --n;
+            }
+            keys[n] = key;
+            m_order[n] = static_cast<std::uint8_t>(i);
+            m_orderState[n] = state;
+        }
+        m_stats.reorders.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::size_t OverlayRegistry::Dispatch()
+    {
+        const auto generation = m_generation.load(std::memory_order_acquire);
+        if (generation != m_seenGeneration) {
+            m_seenGeneration = generation;
+            Reorder();
+        }
+
+        std::size_t calls = 0;
+        for (std::size_t k = 0; k < m_orderCount; ++k) {
+            auto&      slot = m_slots[m_order[k]];
+            const auto state = m_orderState[k];
+            if (slot.state.load(std::memory_order_acquire) != state) {
+                continue;  // removed (or replaced) since the order was built
+            }
+            const auto fn = slot.fn.load(std::memory_order_acquire);
+            auto*      user = slot.user.load(std::memory_order_acquire);
+            if (slot.state.load(std::memory_order_relaxed) != state) {
+                continue;
+            }
+            fn(user);
+            ++calls;
+        }
+        return calls;
+    }
+}
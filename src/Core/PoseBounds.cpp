@@ -0,0 +1,68 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux benchmark target).
+#include "ModernInventory/PoseBounds.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace MI::PoseBounds
+{
+    bool Compute(std::span<const Math::Xform> boneWorld,
+                 std::span<const Math::Sphere> boneLocal,
+                 Math::Sphere& outSphere,
+                 Math::Aabb* outBox)
+    {
+        const std::size_t n = (std::min)(boneWorld.size(), boneLocal.size());
+        if (n == 0) {
+            return false;
+        }
+
+        // Pass 1: world-space sphere per bone, accumulated into an AABB.
+        constexpr float kInf = std::numeric_limits<float>::infinity();
+        Math::Aabb box{ { kInf, kInf, kInf }, { -kInf, -kInf, -kInf } };
+        std::size_t used = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto& local = boneLocal[i];
+            if (!(local.radius > 0.0f)) {
+                continue; // bones without influenced vertices carry an empty bound
+            }
+            const auto& w = boneWorld[i];
+            const Math::Vec3 c = Math::Apply(w, local.center);
+            const float r = local.radius * std::fabs(w.scale);
+            box.min.x = (std::min)(box.min.x, c.x - r);
+            box.min.y = (std::min)(box.min.y, c.y - r);
+            box.min.z = (std::min)(box.min.z, c.z - r);
+            box.max.x = (std::max)(box.max.x, c.x + r);
+            box.max.y = (std::max)(box.max.y, c.y + r);
+            box.max.z = (std::max)(box.max.z, c.z + r);
+            ++used;
+        }
+        if (used == 0) {
+            return false;
+        }
+
+        // Pass 2: sphere around the box centre, tightened to the actual bone spheres
+        // (never larger than the box's circumscribed sphere).
+        const Math::Vec3 center{
+            0.5f * (box.min.x + box.max.x),
+            0.5f * (box.min.y + box.max.y),
+            0.5f * (box.min.z + box.max.z)
+        };
+        float radius = 0.0f;
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto& local = boneLocal[i];
+            if (!(local.radius > 0.0f)) {
+                continue;
+            }
+            const auto& w = boneWorld[i];
+            const Math::Vec3 c = Math::Apply(w, local.center);
+            radius = (std::max)(radius, Math::Distance(c, center) + local.radius * std::fabs(w.scale));
+        }
+
+        outSphere = Math::Sphere{ center, radius };
+        if (outBox) {
+            *outBox = box;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,319 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/PreviewController.h"
+#include "ModernInventory/AllocTrack.h"
+#include "ModernInventory/EventLog.h"
+#include "ModernInventory/GameWorld.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace MI
+{
+    namespace
+    {
+        constexpr std::uint64_t kPressureCheckIntervalUs = 1'000'000;
+        constexpr std::uint32_t kPrefetchAhead = 4;   // hover rows built in the scroll direction
+        constexpr std::uint32_t kPrefetchBehind = 2;  // ... and against it
+
+        std::uint64_t NowNs()
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    }
+
+    void PreviewController::AddStage(Stage stage, std::uint64_t ns)
+    {
+        const auto i = static_cast<std::size_t>(stage);
+        m_stats.stageCalls[i].fetch_add(1, std::memory_order_relaxed);
+        m_stats.stageNs[i].fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    void PreviewController::Rebuild()
+    {
+        const auto t0 = NowNs();
+        m_cloneFingerprint = m_world.PreviewFingerprint();
+        m_cloneValid = m_world.RebuildPreview();
+        AddStage(Stage::kRebuild, NowNs() - t0);
+        m_stats.rebuilds.fetch_add(1, std::memory_order_relaxed);
+        DropVariants();  // built from the old clone; the hovered item may be worn now
+    }
+
+    bool PreviewController::EnsureClone()
+    {
+        if (m_cloneValid && m_world.PreviewFingerprint() == m_cloneFingerprint) {
+            return false;
+        }
+        Rebuild();
+        return true;
+    }
+
+    void PreviewController::DropClone()
+    {
+        m_world.DiscardPreview();
+        m_cloneValid = false;
+        DropVariants();
+    }
+
+    void PreviewController::DropVariants()
+    {
+        if (m_variants.Capacity() == 0) {
+            return;
+        }
+        m_variants.Clear();
+        m_world.DiscardVariants();
+        m_shownVariant = VariantCache::kNone;
+        m_hoverDirty = true;
+    }
+
+    std::uint32_t PreviewController::BuildVariant(const VariantKey& key, bool prefetched)
+    {
+        const auto t0 = NowNs();
+        const auto slot = m_variants.Insert(key, prefetched);
+        if (slot != VariantCache::kNone && !m_world.BuildVariant(slot, key.formID)) {
+            // Stays cached as an empty slot (shows the clone): not retried every frame
+            m_stats.variantsFailed.fetch_add(1, std::memory_order_relaxed);
+        }
+        AddStage(Stage::kVariant, NowNs() - t0);
+        return slot;
+    }
+
+    void PreviewController::UpdateHover()
+    {
+        if (m_hoverDirty) {
+            m_hoverDirty = false;
+            m_prefetch.OnHover(m_hoverRow);
+            const auto form = m_hoverRow == IGameWorld::kNone ? 0 : m_world.ItemForm(m_hoverRow);
+            auto       slot = VariantCache::kNone;
+            m_variants.Pin(VariantCache::kNone);
+            if (form != 0 && m_cloneValid) {
+                const VariantKey key{ m_cloneFingerprint, form };
+                slot = m_variants.Lookup(key);
+                if (slot == VariantCache::kNone) {
+                    slot = BuildVariant(key, false);  // miss: this frame pays a build
+                }
+            }
+            m_variants.Pin(slot);
+            if (slot != m_shownVariant) {
+                m_shownVariant = slot;
+                m_world.ShowVariant(slot);
+            }
+        }
+        if (!m_cloneValid) {
+            return;
+        }
+        // A few builds per frame around the cursor keep the frame cost flat; engine clones
+        // can't be made off the render thread
+        const auto perFrame = m_prefetchPerFrame.load(std::memory_order_relaxed);
+        const auto rows = perFrame ? m_world.ItemCount() : 0;
+        const auto formOf = [this](std::uint32_t row) { return m_world.ItemForm(row); };
+        for (std::uint32_t i = 0; i < perFrame; ++i) {
+            const auto row = m_prefetch.Next(m_variants, m_cloneFingerprint, rows, formOf);
+            if (row == HoverPrefetch::kNoRow || BuildVariant({ m_cloneFingerprint, formOf(row) }, true) == VariantCache::kNone) {
+                break;
+            }
+        }
+    }
+
+    void PreviewController::Post(Command::Type type, std::uint64_t nowUs)
+    {
+        if (!m_commands.TryPush(Command{ type, nowUs })) {
+            // Hundreds of unapplied events means the render thread is stalled; the next
+            // open/equip rebuilds from the player anyway.
+            m_stats.commandsDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void PreviewController::OnMenu(bool opening)
+    {
+        const auto nowUs = m_world.NowUs();
+        if (auto* rec = m_recorder.load(std::memory_order_acquire)) {
+            rec->Record(opening ? EventType::kMenuOpen : EventType::kMenuClose, nowUs);
+        }
+        Post(opening ? Command::Type::kMenuOpen : Command::Type::kMenuClose, nowUs);
+    }
+
+    void PreviewController::OnEquip()
+    {
+        const auto nowUs = m_world.NowUs();
+        if (auto* rec = m_recorder.load(std::memory_order_acquire)) {
+            rec->Record(EventType::kEquip, nowUs);
+        }
+        Post(Command::Type::kEquip, nowUs);
+    }
+
+    void PreviewController::OnExport()
+    {
+        Post(Command::Type::kExport, m_world.NowUs());
+    }
+
+    void PreviewController::OnHotkey()
+    {
+        const auto nowUs = m_world.NowUs();
+        if (auto* rec = m_recorder.load(std::memory_order_acquire)) {
+            rec->Record(EventType::kHotkey, nowUs);
+        }
+        Post(Command::Type::kPrebuild, nowUs);
+    }
+
+    void PreviewController::ProcessCommands()
+    {
+        m_commands.Drain([this](const Command& cmd) { Apply(cmd); });
+    }
+
+    void PreviewController::Apply(const Command& cmd)
+    {
+        using Type = Command::Type;
+        const auto t0 = NowNs();
+        switch (cmd.type) {
+        case Type::kMenuOpen:
+            m_world.Notify("ModernInventory: Inventory opened");
+            m_open.store(true, std::memory_order_release);
+            m_world.SetPanelVisible(true);
+            m_world.HideVanillaPreview(); // hide vanilla 3D preview under our panel
+            m_openedAtUs = cmd.timeUs;    // latency counts from the event, not from the drain
+            m_awaitingUseful = true;
+            m_reopen = m_stats.menuOpens.fetch_add(1, std::memory_order_relaxed) > 0;
+            AddStage(Stage::kMenu, NowNs() - t0);
+
+            // Kick off our paperdoll build unless the clone from the last session (or the
+            // hotkey prebuild) still matches; if player 3D isn't ready yet we'll briefly
+            // show purple until it becomes available.
+            if (!EnsureClone()) {
+                (m_prebuilt ? m_stats.prebuildHits : m_stats.cloneReuses).fetch_add(1, std::memory_order_relaxed);
+            }
+            m_prebuilt = false;
+            break;
+        case Type::kMenuClose:
+            m_world.Notify("ModernInventory: Inventory closed");
+            m_open.store(false, std::memory_order_release);
+            m_world.SetPanelVisible(false);
+            m_awaitingUseful = false;
+            m_closedAtUs = cmd.timeUs;
+            m_hoverRow = VariantCache::kNone;  // the next open starts from the clone
+            m_hoverDirty = true;
+            AddStage(Stage::kMenu, NowNs() - t0);
+            if (auto* rec = m_recorder.load(std::memory_order_acquire)) {
+                rec->Flush();
+            }
+            break;
+        case Type::kEquip:
+            // Any equip or unequip while shown -> rebuild the paper-doll now. While closed
+            // the fingerprint check on the next open (or prebuild) picks the change up.
+            m_stats.equips.fetch_add(1, std::memory_order_relaxed);
+            if (IsOpen()) {
+                Rebuild();
+            }
+            break;
+        case Type::kExport:
+            m_stats.exports.fetch_add(1, std::memory_order_relaxed);
+            m_world.RequestExport();
+            break;
+        case Type::kPrebuild:
+            // Ignored while open: the same key closes the menu
+            if (IsOpen() || m_prebuildTimeoutUs.load(std::memory_order_relaxed) == 0) {
+                break;
+            }
+            // Speculative only when the cached clone is stale; a repeated press restarts the timeout
+            if (!m_prebuilt && EnsureClone()) {
+                m_stats.prebuilds.fetch_add(1, std::memory_order_relaxed);
+                m_prebuilt = true;
+            }
+            if (m_prebuilt) {
+                m_prebuiltAtUs = cmd.timeUs;
+            }
+            break;
+        }
+    }
+
+    void PreviewController::OnFrame(unsigned paneWidth, unsigned paneHeight)
+    {
+        const AllocTrack::Scope allocScope(AllocTrack::Stage::kController);
+        ProcessCommands();  // no-op in game (Present drained already); replay relies on it
+        const auto nowUs = m_world.NowUs();
+        auto* rec = m_recorder.load(std::memory_order_acquire);
+        if (const auto capacity = m_variantCapacity.load(std::memory_order_relaxed); capacity != m_variants.Capacity()) {
+            DropVariants();
+            m_variants.Reset(capacity);
+            // The window must fit beside the variant on screen, or prefetches evict each other
+            const auto ahead = capacity > 1 ? (std::min)(capacity - 1, kPrefetchAhead) : 0;
+            m_prefetch.SetWindow(ahead, capacity > 1 ? (std::min)(capacity - 1 - ahead, kPrefetchBehind) : 0);
+        }
+        if (paneWidth != m_paneW || paneHeight != m_paneH) {
+            m_paneW = paneWidth;
+            m_paneH = paneHeight;
+            m_stats.resizes.fetch_add(1, std::memory_order_relaxed);
+            if (rec) {
+                rec->Record(EventType::kPaneSize, nowUs, paneWidth, paneHeight);
+            }
+        }
+        if (IsOpen() && m_variants.Capacity() != 0) {
+            // Polled before kFrame is recorded, so a replay hovers in the same frame
+            if (const auto row = m_world.HoveredRow(); row != m_hoverRow) {
+                m_hoverRow = row;
+                m_hoverDirty = true;
+                m_stats.hoverChanges.fetch_add(1, std::memory_order_relaxed);
+                if (rec) {
+                    rec->Record(EventType::kHover, nowUs, row, m_world.ItemCount());
+                }
+            }
+        }
+        if (rec) {
+            // Calls made since the previous Present (its tail included) belong to that frame
+            GpuCallFrame calls{};
+            m_world.TakeGpuCalls(calls);
+            for (std::size_t i = 0; i < kGpuCallCount; ++i) {
+                if (calls[i]) {
+                    rec->Record(EventType::kGpuCalls, nowUs, static_cast<std::uint32_t>(i), calls[i]);
+                }
+            }
+            rec->Record(EventType::kFrame, nowUs);
+        }
+        m_stats.frames.fetch_add(1, std::memory_order_relaxed);
+
+        if (m_prebuilt && !IsOpen() && nowUs > m_prebuiltAtUs + m_prebuildTimeoutUs.load(std::memory_order_relaxed)) {
+            // Key pressed but no menu followed (blocked in combat, dialogue, ...)
+            m_prebuilt = false;
+            DropClone();
+            m_stats.prebuildsDiscarded.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const auto evictIdleUs = m_evictIdleUs.load(std::memory_order_relaxed);
+        if (m_cloneValid && !IsOpen() && evictIdleUs != 0 && nowUs >= m_closedAtUs + evictIdleUs &&
+            nowUs >= m_nextPressureCheckUs) {
+            // Idle long enough to be worth freeing; ask the world at most once a second
+            m_nextPressureCheckUs = nowUs + kPressureCheckIntervalUs;
+            if (m_world.UnderMemoryPressure()) {
+                DropClone();
+                m_stats.cloneEvictions.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (!IsOpen() || paneWidth == 0 || paneHeight == 0) {
+            return;
+        }
+        if (m_variants.Capacity() != 0) {
+            UpdateHover();
+        }
+
+        const auto t0 = NowNs();
+        bool useful;
+        {
+            const AllocTrack::Scope renderScope(AllocTrack::Stage::kRender);
+            useful = m_world.RenderPreview(paneWidth, paneHeight);
+        }
+        const auto dt = NowNs() - t0;
+        AddStage(Stage::kRender, dt);
+        m_stats.frameNs.Add(dt);
+        m_stats.renderedFrames.fetch_add(1, std::memory_order_relaxed);
+
+        if (useful && m_awaitingUseful) {
+            m_awaitingUseful = false;
+            const auto latencyUs = nowUs >= m_openedAtUs ? nowUs - m_openedAtUs : 0;
+            m_stats.openToUsefulUs.Add(latencyUs);
+            if (m_reopen) {
+                m_stats.reopenToUsefulUs.Add(latencyUs);
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/SinkRegistry.h"
+
+#include <cstdio>
+#include <utility>
+
+namespace MI
+{
+    SinkRegistry::SinkId SinkRegistry::Add(std::string name, Hooks hooks)
+    {
+        std::lock_guard lock(m_lock);
+        m_sinks.push_back(Sink{ std::move(name), std::move(hooks) });
+        return static_cast<SinkId>(m_sinks.size() - 1);
+    }
+
+    bool SinkRegistry::Need(SinkId id, Reasons reason, bool on)
+    {
+        std::lock_guard lock(m_lock);
+        if (id >= m_sinks.size()) {
+            return false;
+        }
+        auto& sink = m_sinks[id];
+        sink.reasons = on ? (sink.reasons | reason) : (sink.reasons & ~reason);
+        const bool want = sink.reasons != 0;
+        if (want == sink.attached) {
+            ++m_stats.redundant;
+            return sink.attached;
+        }
+        Sync(sink);
+        return sink.attached;
+    }
+
+    void SinkRegistry::Sync(Sink& sink)
+    {
+        if (sink.reasons != 0) {
+            if (!sink.hooks.attach || sink.hooks.attach()) {
+                sink.attached = true;
+                ++sink.attachCount;
+                ++m_stats.attaches;
+            } else {
+                ++m_stats.failures;
+            }
+        } else {
+            if (sink.hooks.detach) {
+                sink.hooks.detach();
+            }
+            sink.attached = false;
+            ++m_stats.detaches;
+        }
+    }
+
+    bool SinkRegistry::Attached(SinkId id) const
+    {
+        std::lock_guard lock(m_lock);
+        return id < m_sinks.size() && m_sinks[id].attached;
+    }
+
+    SinkRegistry::Reasons SinkRegistry::ReasonsOf(SinkId id) const
+    {
+        std::lock_guard lock(m_lock);
+        return id < m_sinks.size() ? m_sinks[id].reasons : 0;
+    }
+
+    SinkRegistry::Stats SinkRegistry::GetStats() const
+    {
+        std::lock_guard lock(m_lock);
+        return m_stats;
+    }
+
+    std::string SinkRegistry::Report() const
+    {
+        std::lock_guard lock(m_lock);
+        char line[160];
+        std::snprintf(line, sizeof(line), "Event sinks: %llu attaches, %llu detaches, %llu redundant, %llu failed\n",
+                      static_cast<unsigned long long>(m_stats.attaches), static_cast<unsigned long long>(m_stats.detaches),
+                      static_cast<unsigned long long>(m_stats.redundant), static_cast<unsigned long long>(m_stats.failures));
+        std::string out = line;
+        for (const auto& sink : m_sinks) {
+            std::snprintf(line, sizeof(line), "  %-12s %-9s reasons 0x%08X  attached %u time(s)\n", sink.name.c_str(),
+                          sink.attached ? "attached" : "detached", sink.reasons, sink.attachCount);
+            out += line;
+        }
+        return out;
+    }
+}
@@ -0,0 +1,361 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/SoftRaster.h"
+
+#include "ModernInventory/CameraMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define MI_SOFTRASTER_SSE2 1
+#else
+#   define MI_SOFTRASTER_SSE2 0
+#endif
+
+namespace MI::SoftRaster
+{
+    namespace
+    {
+        inline Math::Vec3 Sub(const Math::Vec3& a, const Math::Vec3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+        inline float      Dot(const Math::Vec3& a, const Math::Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+        inline Math::Vec3 Cross(const Math::Vec3& a, const Math::Vec3& b)
+        {
+            return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+        }
+
+        inline Math::Vec3 Normalize(const Math::Vec3& v)
+        {
+            const float len = std::sqrt(Dot(v, v));
+            return len > 0.0f ? Math::Vec3{ v.x / len, v.y / len, v.z / len } : Math::Vec3{};
+        }
+
+        inline std::uint32_t Shade(std::uint32_t rgba, float k)
+        {
+            const auto ch = [&](int shift) {
+                const float v = static_cast<float>((rgba >> shift) & 0xFF) * k;
+                return static_cast<std::uint32_t>((std::min)(255.0f, v + 0.5f)) << shift;
+            };
+            return ch(0) | ch(8) | ch(16) | (rgba & 0xFF000000u);
+        }
+    }
+
+    void Mesh::AddSphere(const Math::Sphere& s, unsigned rings, unsigned segments)
+    {
+        rings = (std::max)(rings, 2u);
+        segments = (std::max)(segments, 3u);
+        const auto base = static_cast<std::uint32_t>(positions.size());
+        constexpr float kPi = 3.14159265f;
+
+        // (rings + 1) latitude rows from +Z to -Z; poles are duplicated per segment for simplicity
+        for (unsigned i = 0; i <= rings; ++i) {
+            const float theta = kPi * static_cast<float>(i) / static_cast<float>(rings);
+            for (unsigned j = 0; j < segments; ++j) {
+                const float phi = 2.0f * kPi * static_cast<float>(j) / static_cast<float>(segments);
+                positions.push_back({ s.center.x + s.radius * std::sin(theta) * std::cos(phi),
+                                      s.center.y + s.radius * std::sin(theta) * std::sin(phi),
+                                      s.center.z + s.radius * std::cos(theta) });
+            }
+        }
+        // d/dtheta x d/dphi points outward, so (i,j) -> (i+1,j) -> (i+1,j+1) is counter-clockwise
+        for (unsigned i = 0; i < rings; ++i) {
+            for (unsigned j = 0; j < segments; ++j) {
+                const std::uint32_t a = base + i * segments + j;
+                const std::uint32_t b = base + (i + 1) * segments + j;
+                const std::uint32_t c = base + (i + 1) * segments + (j + 1) % segments;
+                const std::uint32_t d = base + i * segments + (j + 1) % segments;
+                if (i + 1 < rings) indices.insert(indices.end(), { a, b, c });
+                if (i > 0)         indices.insert(indices.end(), { a, c, d });
+            }
+        }
+    }
+
+    void Image::Resize(std::uint32_t w, std::uint32_t h)
+    {
+        width = w;
+        height = h;
+        stride = (w + 3u) & ~3u;
+        rgba.assign(static_cast<std::size_t>(stride) * h, 0);
+        depth.assign(static_cast<std::size_t>(stride) * h, 0.0f);
+    }
+
+    void Image::Clear(std::uint32_t color)
+    {
+        std::fill(rgba.begin(), rgba.end(), color);
+        std::fill(depth.begin(), depth.end(), 0.0f);
+    }
+
+    Rasterizer::Rasterizer(unsigned workers)
+    {
+        if (workers == kAuto) {
+            const unsigned hw = std::thread::hardware_concurrency();
+            workers = hw > 1 ? (std::min)(hw - 1, 7u) : 0u;
+        }
+        m_threads.reserve(workers);
+        for (unsigned i = 0; i < workers; ++i) {
+            m_threads.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    Rasterizer::~Rasterizer()
+    {
+        {
+            std::lock_guard lock(m_lock);
+            m_quit = true;
+        }
+        m_wake.notify_all();
+        for (auto& t : m_threads) {
+            t.join();
+        }
+    }
+
+    std::size_t Rasterizer::Draw(const Mesh& mesh, const View& view, std::uint32_t rgba, Image& image)
+    {
+        if (image.width == 0 || image.height == 0 || mesh.indices.size() < 3) {
+            return 0;
+        }
+        Setup(mesh, view, rgba, image);
+        Bin(image);
+        m_image = &image;
+        RunTiles();
+        m_image = nullptr;
+        return m_tris.size();
+    }
+
+    void Rasterizer::Setup(const Mesh& mesh, const View& view, std::uint32_t rgba, const Image& image)
+    {
+        m_tris.clear();
+
+        float basis[3][3];
+        Math::LookAt(view.eye, view.target, basis);
+        const Math::Vec3 fwd{ basis[0][0], basis[1][0], basis[2][0] };
+        const Math::Vec3 up{ basis[0][1], basis[1][1], basis[2][1] };
+        const Math::Vec3 right{ basis[0][2], basis[1][2], basis[2][2] };
+
+        // Key light from the camera's upper left, so the silhouette reads as a volume
+        const Math::Vec3 light = Normalize(Math::Vec3{ -fwd.x + 0.5f * up.x - 0.3f * right.x,
+                                                       -fwd.y + 0.5f * up.y - 0.3f * right.y,
+                                                       -fwd.z + 0.5f * up.z - 0.3f * right.z });
+
+        const float w = static_cast<float>(image.width);
+        const float h = static_cast<float>(image.height);
+        const auto  frustum = Math::Perspective(view.fovYDeg * 3.14159265f / 180.0f, w / h, view.nearZ, 0.0f);
+        const float fy = 1.0f / frustum.top;
+        const float fx = 1.0f / frustum.right;
+
+        // Project each vertex once; triangles share them
+        const auto& pos = mesh.positions;
+        m_verts.resize(pos.size());
+        for (std::size_t i = 0; i < pos.size(); ++i) {
+            const Math::Vec3 v = Sub(pos[i], view.eye);
+            const float z = Dot(v, fwd);
+            if (z < view.nearZ) {
+                m_verts[i] = Projected{ 0.0f, 0.0f, 0.0f, false };
+                continue;
+            }
+            const float iz = 1.0f / z;
+            m_verts[i] = Projected{ (Dot(v, right) * iz * fx + 1.0f) * 0.5f * w,
+                                    (1.0f - Dot(v, up) * iz * fy) * 0.5f * h, iz, true };
+        }
+
+        const auto& idx = mesh.indices;
+        for (std::size_t t = 0; t + 2 < idx.size(); t += 3) {
+            if (idx[t] >= pos.size() || idx[t + 1] >= pos.size() || idx[t + 2] >= pos.size()) {
+                continue;
+            }
+            const Projected v[3] = { m_verts[idx[t]], m_verts[idx[t + 1]], m_verts[idx[t + 2]] };
+            if (!v[0].valid || !v[1].valid || !v[2].valid) {
+                continue;  // no near clipping: the orbit camera never gets that close
+            }
+
+            // Screen space is y-down, so counter-clockwise (front-facing) triangles have negative area
+            const float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+            if (area >= 0.0f) {
+                continue;
+            }
+
+            // Pixel centres sit at +0.5, so truncating the extents covers every candidate
+            const float minX = (std::min)(v[0].x, (std::min)(v[1].x, v[2].x));
+            const float minY = (std::min)(v[0].y, (std::min)(v[1].y, v[2].y));
+            const float maxX = (std::max)(v[0].x, (std::max)(v[1].x, v[2].x));
+            const float maxY = (std::max)(v[0].y, (std::max)(v[1].y, v[2].y));
+            if (maxX < 0.0f || maxY < 0.0f || minX >= w || minY >= h) {
+                continue;
+            }
+            Tri tri{};
+            tri.minX = (std::max)(0, static_cast<std::int32_t>(minX));
+            tri.minY = (std::max)(0, static_cast<std::int32_t>(minY));
+            tri.maxX = (std::min)(static_cast<std::int32_t>(image.width) - 1, static_cast<std::int32_t>(maxX));
+            tri.maxY = (std::min)(static_cast<std::int32_t>(image.height) - 1, static_cast<std::int32_t>(maxY));
+            if (tri.minX > tri.maxX || tri.minY > tri.maxY) {
+                continue;
+            }
+
+            // Edge i runs v[i] -> v[i+1]; with negative area every edge is >= 0 inside
+            for (int e = 0; e < 3; ++e) {
+                const Projected& va = v[e];
+                const Projected& vb = v[(e + 1) % 3];
+                tri.a[e] = vb.y - va.y;
+                tri.b[e] = va.x - vb.x;
+                tri.c[e] = -va.x * tri.a[e] - va.y * tri.b[e];
+            }
+
+            // 1/z is affine in screen space
+            const float dx1 = v[1].x - v[0].x, dy1 = v[1].y - v[0].y, dz1 = v[1].invZ - v[0].invZ;
+            const float dx2 = v[2].x - v[0].x, dy2 = v[2].y - v[0].y, dz2 = v[2].invZ - v[0].invZ;
+            tri.za = (dz1 * dy2 - dz2 * dy1) / area;
+            tri.zb = (dz2 * dx1 - dz1 * dx2) / area;
+            tri.zc = v[0].invZ - tri.za * v[0].x - tri.zb * v[0].y;
+
+            const Math::Vec3& p0 = pos[idx[t]];
+            const Math::Vec3 n = Normalize(Cross(Sub(pos[idx[t + 1]], p0), Sub(pos[idx[t + 2]], p0)));
+            tri.color = Shade(rgba, 0.2f + 0.8f * (std::max)(0.0f, Dot(n, light)));
+            m_tris.push_back(tri);
+        }
+    }
+
+    void Rasterizer::Bin(const Image& image)
+    {
+        m_tilesX = (image.width + kTileSize - 1) / kTileSize;
+        m_tilesY = (image.height + kTileSize - 1) / kTileSize;
+        m_bins.resize(static_cast<std::size_t>(m_tilesX) * m_tilesY);
+        for (auto& bin : m_bins) {
+            bin.clear();  // keeps capacity across frames
+        }
+        for (std::uint32_t i = 0; i < m_tris.size(); ++i) {
+            const Tri& t = m_tris[i];
+            const auto tx0 = static_cast<std::uint32_t>(t.minX) / kTileSize;
+            const auto ty0 = static_cast<std::uint32_t>(t.minY) / kTileSize;
+            const auto tx1 = static_cast<std::uint32_t>(t.maxX) / kTileSize;
+            const auto ty1 = static_cast<std::uint32_t>(t.maxY) / kTileSize;
+            for (auto ty = ty0; ty <= ty1; ++ty) {
+                for (auto tx = tx0; tx <= tx1; ++tx) {
+                    m_bins[ty * m_tilesX + tx].push_back(i);
+                }
+            }
+        }
+    }
+
+    void Rasterizer::RunTiles()
+    {
+        const auto tileCount = static_cast<std::uint32_t>(m_bins.size());
+        m_nextTile.store(0, std::memory_order_relaxed);
+        if (!m_threads.empty()) {
+            std::lock_guard lock(m_lock);
+            m_busy = static_cast<unsigned>(m_threads.size());
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        // The caller works too; tiles are disjoint so no pixel is touched by two threads
+        for (auto tile = m_nextTile.fetch_add(1); tile < tileCount; tile = m_nextTile.fetch_add(1)) {
+            RasterTile(tile);
+        }
+
+        std::unique_lock lock(m_lock);
+        m_done.wait(lock, [&] { return m_busy == 0; });
+    }
+
+    void Rasterizer::WorkerLoop()
+    {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock lock(m_lock);
+                m_wake.wait(lock, [&] { return m_quit || m_generation != seen; });
+                if (m_quit) {
+                    return;
+                }
+                seen = m_generation;
+            }
+            const auto tileCount = static_cast<std::uint32_t>(m_bins.size());
+            for (auto tile = m_nextTile.fetch_add(1); tile < tileCount; tile = m_nextTile.fetch_add(1)) {
+                RasterTile(tile);
+            }
+            {
+                std::lock_guard lock(m_lock);
+                --m_busy;
+            }
+            m_done.notify_one();
+        }
+    }
+
+    void Rasterizer::RasterTile(std::uint32_t tile)
+    {
+        Image& img = *m_image;
+        const auto tx = static_cast<std::int32_t>((tile % m_tilesX) * kTileSize);
+        const auto ty = static_cast<std::int32_t>((tile / m_tilesX) * kTileSize);
+        const auto tx1 = (std::min)(tx + static_cast<std::int32_t>(kTileSize), static_cast<std::int32_t>(img.width)) - 1;
+        const auto ty1 = (std::min)(ty + static_cast<std::int32_t>(kTileSize), static_cast<std::int32_t>(img.height)) - 1;
+
+        for (const auto triIndex : m_bins[tile]) {
+            const Tri& t = m_tris[triIndex];
+            // Start on a 4-pixel boundary (tiles and stride are multiples of 4); lanes past
+            // maxX are masked off and never leave the padded row.
+            const std::int32_t x0 = (std::max)(t.minX, tx) & ~3;
+            const std::int32_t x1 = (std::min)(t.maxX, tx1);
+            const std::int32_t y0 = (std::max)(t.minY, ty);
+            const std::int32_t y1 = (std::min)(t.maxY, ty1);
+            if (x0 > x1 || y0 > y1) {
+                continue;
+            }
+
+            for (std::int32_t y = y0; y <= y1; ++y) {
+                const float py = static_cast<float>(y) + 0.5f;
+                const float px = static_cast<float>(x0) + 0.5f;
+                float e0 = t.a[0] * px + t.b[0] * py + t.c[0];
+                float e1 = t.a[1] * px + t.b[1] * py + t.c[1];
+                float e2 = t.a[2] * px + t.b[2] * py + t.c[2];
+                float z  = t.za * px + t.zb * py + t.zc;
+                std::uint32_t* color = img.rgba.data() + static_cast<std::size_t>(y) * img.stride;
+                float*         depth = img.depth.data() + static_cast<std::size_t>(y) * img.stride;
+
+#if MI_SOFTRASTER_SSE2
+                const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+                const __m128 a0 = _mm_set1_ps(t.a[0]), a1 = _mm_set1_ps(t.a[1]), a2 = _mm_set1_ps(t.a[2]), za = _mm_set1_ps(t.za);
+                __m128 ve0 = _mm_add_ps(_mm_set1_ps(e0), _mm_mul_ps(a0, lane));
+                __m128 ve1 = _mm_add_ps(_mm_set1_ps(e1), _mm_mul_ps(a1, lane));
+                __m128 ve2 = _mm_add_ps(_mm_set1_ps(e2), _mm_mul_ps(a2, lane));
+                __m128 vz  = _mm_add_ps(_mm_set1_ps(z), _mm_mul_ps(za, lane));
+                const __m128 step0 = _mm_mul_ps(a0, _mm_set1_ps(4.0f)), step1 = _mm_mul_ps(a1, _mm_set1_ps(4.0f));
+                const __m128 step2 = _mm_mul_ps(a2, _mm_set1_ps(4.0f)), stepZ = _mm_mul_ps(za, _mm_set1_ps(4.0f));
+                const __m128i laneX = _mm_set_epi32(3, 2, 1, 0);
+                const __m128i rgba = _mm_set1_epi32(static_cast<int>(t.color));
+                const __m128 zero = _mm_setzero_ps();
+
+                for (std::int32_t x = x0; x <= x1; x += 4) {
+                    // inside = all edges >= 0, x within the span, nearer than the stored 1/z
+                    __m128 inside = _mm_and_ps(_mm_cmpge_ps(ve0, zero), _mm_and_ps(_mm_cmpge_ps(ve1, zero), _mm_cmpge_ps(ve2, zero)));
+                    const __m128i xs = _mm_add_epi32(_mm_set1_epi32(x), laneX);
+                    inside = _mm_and_ps(inside, _mm_castsi128_ps(_mm_cmplt_epi32(xs, _mm_set1_epi32(x1 + 1))));
+                    const __m128 stored = _mm_loadu_ps(depth + x);
+                    const __m128 pass = _mm_and_ps(inside, _mm_cmpgt_ps(vz, stored));
+                    if (_mm_movemask_ps(pass)) {
+                        _mm_storeu_ps(depth + x, _mm_or_ps(_mm_and_ps(pass, vz), _mm_andnot_ps(pass, stored)));
+                        const __m128i mask = _mm_castps_si128(pass);
+                        const __m128i old = _mm_loadu_si128(reinterpret_cast<const __m128i*>(color + x));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(color + x),
+                                         _mm_or_si128(_mm_and_si128(mask, rgba), _mm_andnot_si128(mask, old)));
+                    }
+                    ve0 = _mm_add_ps(ve0, step0);
+                    ve1 = _mm_add_ps(ve1, step1);
+                    ve2 = _mm_add_ps(ve2, step2);
+                    vz  = _mm_add_ps(vz, stepZ);
+                }
+#else
+                for (std::int32_t x = x0; x <= x1; ++x) {
+                    if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f && z > depth[x]) {
+                        depth[x] = z;
+                        color[x] = t.color;
+                    }
+                    e0 += t.a[0];
+                    e1 += t.a[1];
+                    e2 += t.a[2];
+                    z  += t.za;
+                }
+#endif
+            }
+        }
+    }
+}
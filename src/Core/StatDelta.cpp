@@ -0,0 +1,142 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/StatDelta.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define MI_STATDELTA_SSE2 1
+#else
+#   define MI_STATDELTA_SSE2 0
+#endif
+
+namespace MI
+{
+    void ItemColumns::Clear()
+    {
+        base.clear();
+        bonus.clear();
+        weight.clear();
+        value.clear();
+        slots.clear();
+        kind.clear();
+    }
+
+    void ItemColumns::Reserve(std::size_t n)
+    {
+        base.reserve(n);
+        bonus.reserve(n);
+        weight.reserve(n);
+        value.reserve(n);
+        slots.reserve(n);
+        kind.reserve(n);
+    }
+
+    void ItemColumns::Add(const ItemStats& item)
+    {
+        base.push_back(item.base);
+        bonus.push_back(item.bonus);
+        weight.push_back(item.weight);
+        value.push_back(item.value);
+        slots.push_back(item.slots);
+        kind.push_back(static_cast<std::uint32_t>(item.kind));
+    }
+
+    ItemColumns& StatDeltaEngine::EditItems()
+    {
+        m_dirty = true;
+        return m_items;
+    }
+
+    void StatDeltaEngine::SetEquipped(std::span<const ItemStats> worn, const std::array<float, kItemKindCount>& multipliers,
+                                      std::uint64_t version)
+    {
+        if (m_haveEquipped && version == m_version) {
+            return;
+        }
+        m_haveEquipped = true;
+        m_version = version;
+        m_dirty = true;
+        m_equipped.multipliers = multipliers;
+        m_equipped.count = (std::min)(worn.size(), kMaxEquipped);
+        for (std::size_t j = 0; j < m_equipped.count; ++j) {
+            const auto& piece = worn[j];
+            m_equipped.slots[j] = piece.slots;
+            m_equipped.rating[j] = piece.base * multipliers[static_cast<std::size_t>(piece.kind)] + piece.bonus;
+            m_equipped.weight[j] = piece.weight;
+            m_equipped.value[j] = piece.value;
+        }
+    }
+
+    const StatDeltaColumns& StatDeltaEngine::Evaluate()
+    {
+        if (!m_dirty) {
+            ++m_stats.cacheHits;
+            return m_results;
+        }
+        Compute(m_items, m_equipped, m_results);
+        m_dirty = false;
+        ++m_stats.evaluations;
+        return m_results;
+    }
+
+    void StatDeltaEngine::Compute(const ItemColumns& items, const Equipped& equipped, StatDeltaColumns& out, bool simd)
+    {
+        const std::size_t n = items.Size();
+        out.rating.resize(n);
+        out.weight.resize(n);
+        out.value.resize(n);
+        std::size_t i = 0;
+
+#if MI_STATDELTA_SSE2
+        if (simd) {
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 4 <= n; i += 4) {
+                // Multiplier of each lane's kind: one compare + blend per kind (no gather in SSE2)
+                const __m128i kind = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items.kind.data() + i));
+                __m128 mult = _mm_setzero_ps();
+                for (std::size_t k = 0; k < kItemKindCount; ++k) {
+                    const __m128 is = _mm_castsi128_ps(_mm_cmpeq_epi32(kind, _mm_set1_epi32(static_cast<int>(k))));
+                    mult = _mm_or_ps(mult, _mm_and_ps(is, _mm_set1_ps(equipped.multipliers[k])));
+                }
+                __m128 rating = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(items.base.data() + i), mult),
+                                           _mm_loadu_ps(items.bonus.data() + i));
+                __m128 weight = _mm_loadu_ps(items.weight.data() + i);
+                __m128 value = _mm_loadu_ps(items.value.data() + i);
+
+                // Subtract every worn piece that shares a slot with the lane's item
+                const __m128i slots = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items.slots.data() + i));
+                for (std::size_t j = 0; j < equipped.count; ++j) {
+                    const __m128i shared = _mm_and_si128(slots, _mm_set1_epi32(static_cast<int>(equipped.slots[j])));
+                    const __m128 free = _mm_castsi128_ps(_mm_cmpeq_epi32(shared, zero));
+                    rating = _mm_sub_ps(rating, _mm_andnot_ps(free, _mm_set1_ps(equipped.rating[j])));
+                    weight = _mm_sub_ps(weight, _mm_andnot_ps(free, _mm_set1_ps(equipped.weight[j])));
+                    value = _mm_sub_ps(value, _mm_andnot_ps(free, _mm_set1_ps(equipped.value[j])));
+                }
+                _mm_storeu_ps(out.rating.data() + i, rating);
+                _mm_storeu_ps(out.weight.data() + i, weight);
+                _mm_storeu_ps(out.value.data() + i, value);
+            }
+        }
+#else
+        (void)simd;
+#endif
+
+        for (; i < n; ++i) {
+            const auto kind = items.kind[i];
+            float rating = items.base[i] * (kind < kItemKindCount ? equipped.multipliers[kind] : 0.0f) + items.bonus[i];
+            float weight = items.weight[i];
+            float value = items.value[i];
+            for (std::size_t j = 0; j < equipped.count; ++j) {
+                if (items.slots[i] & equipped.slots[j]) {
+                    rating -= equipped.rating[j];
+                    weight -= equipped.weight[j];
+                    value -= equipped.value[j];
+                }
+            }
+            out.rating[i] = rating;
+            out.weight[i] = weight;
+            out.value[i] = value;
+        }
+    }
+}
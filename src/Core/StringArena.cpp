@@ -0,0 +1,257 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/StringArena.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+
+namespace MI
+{
+    namespace
+    {
+        // Eight bytes per multiply; names are short, so this is most of an Intern hit
+        std::uint32_t Hash(std::string_view text)
+        {
+            std::uint64_t h = 0xCBF29CE484222325ull ^ text.size();
+            std::size_t   i = 0;
+            for (; i + 8 <= text.size(); i += 8) {
+                std::uint64_t word;
+                std::memcpy(&word, text.data() + i, 8);
+                h = (h ^ word) * 0x9E3779B97F4A7C15ull;
+                h ^= h >> 29;
+            }
+            std::uint64_t tail = 0;
+            std::memcpy(&tail, text.data() + i, text.size() - i);
+            h = (h ^ tail) * 0x9E3779B97F4A7C15ull;
+            return static_cast<std::uint32_t>(h ^ (h >> 32));
+        }
+
+        bool HasUpper(std::string_view text)
+        {
+            return std::any_of(text.begin(), text.end(), [](char c) { return c >= 'A' && c <= 'Z'; });
+        }
+
+        std::uint32_t CodePoints(std::string_view text)
+        {
+            std::uint32_t n = 0;
+            for (const char c : text) {
+                n += (static_cast<unsigned char>(c) & 0xC0) != 0x80;  // continuation bytes don't start one
+            }
+            return n;
+        }
+    }
+
+    StringHandle StringArena::Intern(std::string_view text)
+    {
+        ++m_stats.interns;
+        bool found = false;
+        const auto h = FindOrAdd(text, found);
+        m_stats.hits += found;
+        return h;
+    }
+
+    StringHandle StringArena::Find(std::string_view text) const
+    {
+        if (m_table.empty()) {
+            return kNoString;
+        }
+        const auto hash = Hash(text);
+        const auto mask = m_table.size() - 1;
+        for (auto slot = hash & mask; m_table[slot] != kNoString; slot = (slot + 1) & mask) {
+            const auto& e = m_entries[m_table[slot]];
+            if (e.hash == hash && View(m_table[slot]) == text) {
+                return m_table[slot];
+            }
+        }
+        return kNoString;
+    }
+
+    StringHandle StringArena::FindOrAdd(std::string_view text, bool& found)
+    {
+        if (const auto h = Find(text); h != kNoString) {
+            found = true;
+            return h;
+        }
+        found = false;
+
+        const bool fold = HasUpper(text);
+        char*      p = Allocate((text.size() + 1) * (fold ? 2 : 1));
+        std::memcpy(p, text.data(), text.size());
+        p[text.size()] = '\0';
+        Entry e;
+        e.text = e.lower = p;
+        if (fold) {
+            char* lower = p + text.size() + 1;
+            std::transform(text.begin(), text.end(), lower,
+                           [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; });
+            lower[text.size()] = '\0';
+            e.lower = lower;
+        }
+        e.bytes = static_cast<std::uint32_t>(text.size());
+        e.codepoints = CodePoints(text);
+        e.hash = Hash(text);
+
+        const auto capacity = m_entries.capacity();
+        m_entries.push_back(e);
+        const auto h = static_cast<StringHandle>(m_entries.size() - 1);
+        if (m_entries.size() * 2 > m_table.size()) {
+            Rehash((std::max)(m_table.size() * 2, std::size_t{ 64 }));  // inserts h too
+        } else {
+            Insert(h);
+        }
+        if (m_entries.capacity() != capacity) {
+            Account();
+        }
+        m_ranksDirty = true;
+        return h;
+    }
+
+    char* StringArena::Allocate(std::size_t bytes)
+    {
+        if (bytes > kChunkBytes) {
+            // Its own chunk, slotted in before the one being filled so that one keeps filling
+            Chunk big{ std::make_unique<char[]>(bytes), bytes, bytes };
+            char* p = big.data.get();
+            m_chunks.insert(m_chunks.begin() + static_cast<std::ptrdiff_t>((std::min)(m_chunk, m_chunks.size())), std::move(big));
+            ++m_chunk;
+            Account();
+            return p;
+        }
+        while (m_chunk < m_chunks.size() && m_chunks[m_chunk].size - m_chunks[m_chunk].used < bytes) {
+            ++m_chunk;
+        }
+        if (m_chunk == m_chunks.size()) {
+            m_chunks.push_back({ std::make_unique<char[]>(kChunkBytes), kChunkBytes, 0 });
+            Account();
+        }
+        auto& chunk = m_chunks[m_chunk];
+        char* p = chunk.data.get() + chunk.used;
+        chunk.used += bytes;
+        return p;
+    }
+
+    void StringArena::Rehash(std::size_t slots)
+    {
+        m_table.assign(slots, kNoString);
+        for (StringHandle h = 0; h < m_entries.size(); ++h) {
+            Insert(h);
+        }
+        Account();
+    }
+
+    void StringArena::Insert(StringHandle h)
+    {
+        const auto mask = m_table.size() - 1;
+        auto       slot = m_entries[h].hash & mask;
+        while (m_table[slot] != kNoString) {
+            slot = (slot + 1) & mask;
+        }
+        m_table[slot] = h;
+    }
+
+    void StringArena::UpdateRanks()
+    {
+        if (!m_ranksDirty) {
+            return;
+        }
+        m_scratch.resize(m_entries.size());
+        std::iota(m_scratch.begin(), m_scratch.end(), 0u);
+        std::sort(m_scratch.begin(), m_scratch.end(), [&](StringHandle a, StringHandle b) {
+            const auto la = Lower(a), lb = Lower(b);
+            return la != lb ? la < lb : View(a) < View(b);
+        });
+        for (std::uint32_t rank = 0; rank < m_scratch.size(); ++rank) {
+            m_entries[m_scratch[rank]].rank = rank;
+        }
+        m_ranksDirty = false;
+    }
+
+    void StringArena::Search(std::string_view needleLower, std::span<const StringHandle> among, std::vector<StringHandle>& out) const
+    {
+        out.clear();
+        for (const auto h : among) {
+            if (Lower(h).find(needleLower) != std::string_view::npos) {
+                out.push_back(h);
+            }
+        }
+    }
+
+    std::size_t StringArena::Bytes() const
+    {
+        std::size_t bytes = m_entries.capacity() * sizeof(Entry) + (m_table.capacity() + m_scratch.capacity()) * sizeof(StringHandle);
+        for (const auto& chunk : m_chunks) {
+            bytes += chunk.size;
+        }
+        return bytes;
+    }
+
+    std::size_t StringArena::UsedBytes() const
+    {
+        std::size_t bytes = 0;
+        for (const auto& chunk : m_chunks) {
+            bytes += chunk.used;
+        }
+        return bytes;
+    }
+
+    void StringArena::Clear()
+    {
+        m_entries.clear();
+        std::fill(m_table.begin(), m_table.end(), kNoString);
+        for (auto& chunk : m_chunks) {
+            chunk.used = 0;
+        }
+        m_chunk = 0;
+        m_ranksDirty = false;
+    }
+
+    std::size_t StringArena::Compact(std::span<StringHandle> live)
+    {
+        const auto before = Bytes();
+        auto       oldEntries = std::move(m_entries);
+        auto       oldChunks = std::move(m_chunks);
+
+        // One chunk sized to the survivors; later interns start new ones
+        std::vector<StringHandle> remap(oldEntries.size(), kNoString);
+        std::size_t               bytes = 0, count = 0;
+        for (const auto h : live) {
+            if (h != kNoString && remap[h] == kNoString) {
+                remap[h] = 0;
+                bytes += (oldEntries[h].bytes + 1) * (oldEntries[h].lower != oldEntries[h].text ? 2 : 1);
+                ++count;
+            }
+        }
+        m_entries.clear();  // moved from: no capacity left
+        m_entries.reserve(count);
+        m_chunks.clear();
+        m_chunks.push_back({ std::make_unique<char[]>((std::max)(bytes, std::size_t{ 1 })), (std::max)(bytes, std::size_t{ 1 }), 0 });
+        m_chunk = 0;
+        m_table.clear();
+        m_table.shrink_to_fit();
+        Rehash((std::max)(std::bit_ceil(count * 2), std::size_t{ 64 }));
+        m_scratch.clear();
+        m_scratch.shrink_to_fit();
+
+        std::fill(remap.begin(), remap.end(), kNoString);
+        for (auto& h : live) {
+            if (h == kNoString) {
+                continue;
+            }
+            if (remap[h] == kNoString) {
+                bool found = false;
+                remap[h] = FindOrAdd({ oldEntries[h].text, oldEntries[h].bytes }, found);
+            }
+            h = remap[h];
+        }
+        m_ranksDirty = true;
+        ++m_stats.compactions;
+        Account();
+        return before - (std::min)(before, Bytes());
+    }
+
+    void StringArena::Account()
+    {
+        m_mem.Set(static_cast<std::int64_t>(Bytes()));
+    }
+}
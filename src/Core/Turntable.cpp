@@ -0,0 +1,157 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux benchmark target).
+#include "ModernInventory/Turntable.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MI
+{
+    namespace
+    {
+        constexpr float kTwoPi = 6.283185307f;
+    }
+
+    bool TurntableCache::Configure(std::uint32_t frames, std::uint32_t tileW, std::uint32_t tileH, std::uint32_t maxAtlasDim)
+    {
+        m_frames = 0;
+        m_cols = m_rows = 0;
+        m_tileW = tileW;
+        m_tileH = tileH;
+        m_baked.clear();
+        m_bakedCount = 0;
+        m_hasKey = false;
+        if (frames == 0 || tileW == 0 || tileH == 0) {
+            return false;
+        }
+
+        const auto cols = static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<float>(frames))));
+        const auto rows = (frames + cols - 1) / cols;
+        if (static_cast<std::uint64_t>(cols) * tileW > maxAtlasDim ||
+            static_cast<std::uint64_t>(rows) * tileH > maxAtlasDim) {
+            return false;
+        }
+
+        m_frames = frames;
+        m_cols = cols;
+        m_rows = rows;
+        m_baked.assign(frames, 0);
+        return true;
+    }
+
+    bool TurntableCache::Validate(const Key& key)
+    {
+        if (m_hasKey && m_key == key) {
+            return false;
+        }
+        m_key = key;
+        m_hasKey = true;
+        Invalidate();
+        return true;
+    }
+
+    void TurntableCache::Invalidate()
+    {
+        std::fill(m_baked.begin(), m_baked.end(), std::uint8_t{ 0 });
+        m_bakedCount = 0;
+    }
+
+    std::uint32_t TurntableCache::FrameAt(float yawRad, float* frac) const
+    {
+        // NaN / inf would reach the uint32_t cast below (undefined); treat them as yaw 0
+        if (!std::isfinite(yawRad)) {
+            yawRad = 0.0f;
+        }
+        float turns = yawRad / kTwoPi;
+        turns -= std::floor(turns); // [0, 1)
+        const float f = turns * static_cast<float>(m_frames);
+        const float base = std::floor(f);
+        if (frac) {
+            *frac = f - base;
+        }
+        return static_cast<std::uint32_t>(base) % m_frames;
+    }
+
+    // Nearest frame to the current yaw first, then alternating outwards (the side the yaw
+    // leans towards first), so the angles the user is most likely to rotate to become
+    // available first.
+    std::uint32_t TurntableCache::NextToBake(float yawRad) const
+    {
+        if (!Enabled() || Complete()) {
+            return kNone;
+        }
+        float frac = 0.0f;
+        std::uint32_t start = FrameAt(yawRad, &frac);
+        const bool    backFirst = frac >= 0.5f;  // yaw is just before the rounded-up start
+        if (backFirst) {
+            start = (start + 1) % m_frames;
+        }
+        for (std::uint32_t step = 0; step <= m_frames / 2; ++step) {
+            const std::uint32_t fwd = (start + step) % m_frames;
+            const std::uint32_t back = (start + m_frames - step) % m_frames;
+            const std::uint32_t first = backFirst ? back : fwd;
+            const std::uint32_t second = backFirst ? fwd : back;
+            if (!m_baked[first]) {
+                return first;
+            }
+            if (!m_baked[second]) {
+                return second;
+            }
+        }
+        return kNone;
+    }
+
+    void TurntableCache::MarkBaked(std::uint32_t frame)
+    {
+        if (frame < m_frames && !m_baked[frame]) {
+            m_baked[frame] = 1;
+            ++m_bakedCount;
+        }
+    }
+
+    TurntableCache::Sample TurntableCache::Lookup(float yawRad, bool blend) const
+    {
+        Sample s{};
+        if (!Enabled()) {
+            return s;
+        }
+        float frac = 0.0f;
+        const std::uint32_t a = FrameAt(yawRad, &frac);
+        const std::uint32_t b = (a + 1) % m_frames;
+        if (!blend) {
+            // Snap to the nearest baked neighbour
+            const std::uint32_t nearest = (frac >= 0.5f) ? b : a;
+            const std::uint32_t other = (nearest == a) ? b : a;
+            s.frameA = m_baked[nearest] ? nearest : (m_baked[other] ? other : kNone);
+            return s;
+        }
+        if (m_baked[a] && m_baked[b]) {
+            s.frameA = a;
+            s.frameB = b;
+            s.blend = frac;
+        } else if (m_baked[a] || m_baked[b]) {
+            s.frameA = m_baked[a] ? a : b;
+        }
+        return s;
+    }
+
+    float TurntableCache::FrameYaw(std::uint32_t frame) const
+    {
+        return m_frames ? kTwoPi * static_cast<float>(frame) / static_cast<float>(m_frames) : 0.0f;
+    }
+
+    TurntableCache::Tile TurntableCache::TileOf(std::uint32_t frame) const
+    {
+        if (frame >= m_frames) {
+            return {};
+        }
+        return Tile{ (frame % m_cols) * m_tileW, (frame / m_cols) * m_tileH, m_tileW, m_tileH };
+    }
+
+    TurntableCache::UVRect TurntableCache::UVOf(std::uint32_t frame) const
+    {
+        const Tile t = TileOf(frame);
+        const float aw = static_cast<float>((std::max)(AtlasWidth(), 1u));
+        const float ah = static_cast<float>((std::max)(AtlasHeight(), 1u));
+        return UVRect{ t.x / aw, t.y / ah, (t.x + t.w) / aw, (t.y + t.h) / ah };
+    }
+}
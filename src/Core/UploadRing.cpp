@@ -0,0 +1,105 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/UploadRing.h"
+
+#include <algorithm>
+
+namespace MI
+{
+    void UploadRing::Configure(std::uint32_t slots)
+    {
+        m_slots.assign((std::max)(slots, 1u), Slot{});
+        m_stats = {};
+        m_lastFence = 0;
+        Reset();
+    }
+
+    void UploadRing::Reset()
+    {
+        for (auto& s : m_slots) {
+            s = Slot{};
+        }
+        m_next = 0;
+        m_inFlight = 0;
+        m_dirty = {};
+    }
+
+    void UploadRing::MarkDirty(const Rect& r)
+    {
+        if (r.Empty()) {
+            return;
+        }
+        if (m_dirty.Empty()) {
+            m_dirty = r;
+            return;
+        }
+        const auto x0 = (std::min)(m_dirty.x, r.x);
+        const auto y0 = (std::min)(m_dirty.y, r.y);
+        const auto x1 = (std::max)(m_dirty.x + m_dirty.w, r.x + r.w);
+        const auto y1 = (std::max)(m_dirty.y + m_dirty.h, r.y + r.h);
+        m_dirty = { x0, y0, x1 - x0, y1 - y0 };
+    }
+
+    std::uint32_t UploadRing::Acquire(Rect& region)
+    {
+        if (m_dirty.Empty() || m_slots.empty()) {
+            return kNone;
+        }
+        const auto n = static_cast<std::uint32_t>(m_slots.size());
+        for (std::uint32_t i = 0; i < n; ++i) {
+            const auto slot = (m_next + i) % n;
+            if (m_slots[slot].state == State::kFree) {
+                m_slots[slot].state = State::kWriting;
+                m_next = (slot + 1) % n;
+                region = m_dirty;
+                m_dirty = {};
+                return slot;
+            }
+        }
+        ++m_stats.backpressured;
+        return kNone;
+    }
+
+    void UploadRing::Abort(std::uint32_t slot, const Rect& region)
+    {
+        if (slot < m_slots.size() && m_slots[slot].state == State::kWriting) {
+            m_slots[slot].state = State::kFree;
+        }
+        MarkDirty(region);
+    }
+
+    std::uint64_t UploadRing::Submit(std::uint32_t slot, const Rect& region)
+    {
+        if (slot >= m_slots.size() || m_slots[slot].state != State::kWriting) {
+            return 0;
+        }
+        auto& s = m_slots[slot];
+        s.state = State::kInFlight;
+        s.fence = ++m_lastFence;
+        ++m_inFlight;
+        ++m_stats.uploads;
+        m_stats.pixels += static_cast<std::uint64_t>(region.w) * region.h;
+        m_stats.maxInFlight = (std::max)(m_stats.maxInFlight, m_inFlight);
+        return s.fence;
+    }
+
+    void UploadRing::Complete(std::uint64_t fence)
+    {
+        for (auto& s : m_slots) {
+            if (s.state == State::kInFlight && s.fence <= fence) {
+                s.state = State::kFree;
+                --m_inFlight;
+            }
+        }
+    }
+
+    std::uint32_t UploadRing::OldestInFlight() const
+    {
+        std::uint32_t best = kNone;
+        for (std::uint32_t i = 0; i < m_slots.size(); ++i) {
+            if (m_slots[i].state == State::kInFlight && (best == kNone || m_slots[i].fence < m_slots[best].fence)) {
+                best = i;
+            }
+        }
+        return best;
+    }
+}
@@ -0,0 +1,85 @@
+// Portable: no PCH / RE / Windows includes (also built by the Linux host tools).
+#include "ModernInventory/VariantCache.h"
+
+namespace MI
+{
+    void VariantCache::Reset(std::uint32_t capacity)
+    {
+        Clear();
+        m_entries.assign(capacity, Entry{});
+        m_pinned = kNone;
+    }
+
+    std::uint32_t VariantCache::Find(const VariantKey& key) const
+    {
+        for (std::uint32_t i = 0; i < m_entries.size(); ++i) {
+            if (m_entries[i].occupied && m_entries[i].key == key) {
+                return i;
+            }
+        }
+        return kNone;
+    }
+
+    std::uint32_t VariantCache::Lookup(const VariantKey& key)
+    {
+        ++m_stats.lookups;
+        const auto slot = Find(key);
+        if (slot == kNone) {
+            ++m_stats.misses;
+            return kNone;
+        }
+        auto& entry = m_entries[slot];
+        ++m_stats.hits;
+        if (entry.unusedPrefetch) {
+            ++m_stats.prefetchHits;
+            entry.unusedPrefetch = false;
+        }
+        entry.lastUse = ++m_clock;
+        return slot;
+    }
+
+    std::uint32_t VariantCache::Insert(const VariantKey& key, bool prefetched)
+    {
+        std::uint32_t slot = kNone;
+        for (std::uint32_t i = 0; i < m_entries.size(); ++i) {
+            if (i == m_pinned) {
+                continue;
+            }
+            if (!m_entries[i].occupied) {
+                slot = i;
+                break;
+            }
+            if (slot == kNone || m_entries[i].lastUse < m_entries[slot].lastUse) {
+                slot = i;
+            }
+        }
+        if (slot == kNone) {
+            return kNone;
+        }
+        auto& entry = m_entries[slot];
+        if (entry.occupied) {
+            ++m_stats.evictions;
+            m_stats.prefetchWasted += entry.unusedPrefetch;
+        }
+        m_stats.prefetches += prefetched;
+        entry = Entry{ key, ++m_clock, true, prefetched };
+        return slot;
+    }
+
+    void VariantCache::Clear()
+    {
+        for (auto& entry : m_entries) {
+            m_stats.prefetchWasted += entry.occupied && entry.unusedPrefetch;
+            entry = Entry{};
+        }
+        m_pinned = kNone;
+    }
+
+    void HoverPrefetch::OnHover(std::uint32_t row)
+    {
+        if (row != kNoRow && m_row != kNoRow && row != m_row) {
+            m_direction = row > m_row ? 1 : -1;
+        }
+        m_row = row;
+    }
+}
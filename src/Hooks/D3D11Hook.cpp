@@ -11,6 +11,12 @@
 #include <d3d11.h>
 #include <dxgi.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <vector>
 
 #include <MinHook.h>
 
@@ -42,8 +48,18 @@
 #include "ModernInventory/OffscreenRT.h"
 #include "ModernInventory/PreviewRenderer.h"
 
+#include "ModernInventory/AllocTrack.h"
 #include "ModernInventory/Config.h"
+#include "ModernInventory/FontAtlasCache.h"
+#include "ModernInventory/FontAtlasImGui.h"
+#include "ModernInventory/GpuCalls.h"
+#include "ModernInventory/ImageEncode.h"
+#include "ModernInventory/InventoryStats.h"
 #include "ModernInventory/Log.h"
+#include "ModernInventory/MemStats.h"
+#include "ModernInventory/OverlayHost.h"
+#include "ModernInventory/PanelLayout.h"
+#include "ModernInventory/PreviewController.h"
 namespace MI
 {
     namespace
@@ -70,11 +86,256 @@ namespace MI
         bool                 g_ImGuiInitNotified = false;
         OffscreenRT          g_Offscreen;
         PreviewRenderer      g_Preview;
+        std::atomic<bool>    g_ExportRequested{ false };
+        AllocTrack::Frame    g_LastAllocs{};  // previous Present (MI_ALLOC_TRACKING builds)
+
+        // Font atlas inputs and the codepoints it holds (configured + added on demand)
+        std::vector<FontSource>    g_FontSources;
+        std::vector<std::uint32_t> g_FontRanges;
+        std::uint64_t              g_FontKey = 0;
+        GlyphCoverage              g_GlyphCoverage;
+        constexpr std::uint32_t    kBaseGlyphRanges[] = { 0x0020, 0x00FF };  // ImGui's default Latin set
+
+        // ImGui's font atlas (GPU texture + the RGBA copy it keeps) and the DX11 backend's
+        // dynamic buffers, estimated with the backend's growth slack (+5000 / +10000).
+        void ReportImGuiMemory()
+        {
+            static auto& fontGpu = MemStats::Register("ImGui/fontAtlas", MemKind::kGpu);
+            static auto& fontCpu = MemStats::Register("ImGui/fontAtlasPixels", MemKind::kCpu);
+            static auto& buffers = MemStats::Register("ImGui/drawBuffers (est.)", MemKind::kGpu);
+            const auto* fonts = ImGui::GetIO().Fonts;
+            const auto  atlas = static_cast<std::int64_t>(fonts->TexWidth) * fonts->TexHeight * 4;
+            fontGpu.Set(atlas);
+            fontCpu.Set((fonts->TexPixelsRGBA32 ? atlas : 0) + (fonts->TexPixelsAlpha8 ? atlas / 4 : 0));
+            if (const auto* dd = ImGui::GetDrawData()) {
+                buffers.Set(static_cast<std::int64_t>(dd->TotalVtxCount + 5000) * sizeof(ImDrawVert) +
+                            static_cast<std::int64_t>(dd->TotalIdxCount + 10000) * sizeof(ImDrawIdx));
+            }
+        }
+
+        void DrawMemorySection()
+        {
+            if (!ImGui::CollapsingHeader("Memory")) {
+                return;
+            }
+            thread_local std::vector<MemStats::Entry> entries;
+            MemStats::Snapshot(entries);
+            for (const auto& e : entries) {
+                ImGui::Text("%-6s %-30s %8.2f / %8.2f MiB", MemStats::KindName(e.kind), e.name,
+                            e.current / (1024.0 * 1024.0), e.peak / (1024.0 * 1024.0));
+            }
+            for (std::size_t i = 0; i < kMemKindCount; ++i) {
+                const auto kind = static_cast<MemKind>(i);
+                ImGui::Text("total  %-30s %8.2f / %8.2f MiB", MemStats::KindName(kind),
+                            MemStats::Total(kind) / (1024.0 * 1024.0), MemStats::TotalPeak(kind) / (1024.0 * 1024.0));
+            }
+            if constexpr (AllocTrack::kEnabled) {
+                ImGui::Separator();
+                for (std::size_t i = 1; i < AllocTrack::kStageCount; ++i) {
+                    const auto& c = g_LastAllocs[i];
+                    ImGui::Text("allocs %-10s %4llu (%llu B)", AllocTrack::StageName(static_cast<AllocTrack::Stage>(i)),
+                                static_cast<unsigned long long>(c.allocs), static_cast<unsigned long long>(c.bytes));
+                }
+            }
+            if (ImGui::Button("Dump to log")) {
+                MI::Log::Info(MemStats::Format());
+            }
+        }
+
+        // Hovered item against what it would replace; the deltas come cached from InventoryStats
+        void DrawItemComparison()
+        {
+            MI::StatDelta delta;
+            bool weapon = false;
+            const char* name = nullptr;
+            if (!MI::InventoryStats::Hovered(delta, weapon, name)) {
+                return;
+            }
+            if (name && *name) {
+                NoteOverlayText(name);  // localized names may need glyphs the atlas lacks
+                ImGui::TextUnformatted(name);
+            }
+            const auto signColor = [](float v, bool lowerIsBetter) {
+                if (std::fabs(v) < 0.05f) {
+                    return ImVec4(0.8f, 0.8f, 0.8f, 1.0f);
+                }
+                return (v > 0.0f) != lowerIsBetter ? ImVec4(0.4f, 0.9f, 0.4f, 1.0f) : ImVec4(0.9f, 0.4f, 0.4f, 1.0f);
+            };
+            ImGui::TextColored(signColor(delta.rating, false), "%+.0f %s", delta.rating, weapon ? "damage" : "armor");
+            ImGui::SameLine();
+            ImGui::TextColored(signColor(delta.weight, true), "%+.1f weight", delta.weight);
+            ImGui::SameLine();
+            ImGui::TextColored(signColor(delta.value, false), "%+.0f gold", delta.value);
+        }
+
+        // <SKSE log folder>/ModernInventoryExports/preview_YYYYMMDD_HHMMSS_mmm.<ext>
+        std::string MakeExportPath(MI::ImageFormat format)
+        {
+            const auto now = std::chrono::system_clock::now();
+            const auto t = std::chrono::system_clock::to_time_t(now);
+            const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+            std::tm tm{};
+            localtime_s(&tm, &t);
+            char name[64];
+            std::snprintf(name, sizeof(name), "preview_%04d%02d%02d_%02d%02d%02d_%03d%s", tm.tm_year + 1900, tm.tm_mon + 1,
+                          tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, static_cast<int>(ms), MI::ImageEncode::Extension(format));
+            return (MI::Log::GetFolder() / L"ModernInventoryExports" / name).string();
+        }
+
+        std::string FontCachePath()
+        {
+            return (MI::Log::GetFolder() / L"ModernInventory.fontcache").string();
+        }
+
+        double MsSince(std::chrono::steady_clock::time_point t0)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        }
+
+        // Rasterize g_FontSources with g_FontRanges into atlas and cache the result for the next run
+        void BakeFonts(ImFontAtlas& atlas)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            if (!FontAtlasImGui::Bake(atlas, g_FontSources, g_FontRanges)) {
+                atlas.Clear();  // the backend's first upload builds ImGui's default font instead
+                MI::Log::Warn("Font atlas bake failed; using ImGui's default font");
+                return;
+            }
+            const auto bakeMs = MsSince(t0);
+            BakedAtlas baked;
+            FontAtlasImGui::Capture(atlas, g_FontRanges, baked);
+            const bool saved = FontAtlasCache::WriteFile(FontCachePath(), baked, g_FontKey);
+            char line[160];
+            std::snprintf(line, sizeof(line), "Font atlas baked: %dx%d, %zu ranges, %.2f ms (+%.2f ms %s)", atlas.TexWidth,
+                          atlas.TexHeight, g_FontRanges.size() / 2, bakeMs, MsSince(t0) - bakeMs,
+                          saved ? "cached" : "cache write failed");
+            MI::Log::Info(line);
+        }
+
+        // Before the first frame: the cached atlas when fonts, sizes and ranges are unchanged,
+        // otherwise a fresh bake (the backend uploads either on its first NewFrame)
+        void InitFonts(ImFontAtlas& atlas)
+        {
+            const auto& cfg = MI::ConfigSys::Get();
+            g_FontSources.clear();
+            for (const auto& file : cfg.fontFiles) {
+                g_FontSources.push_back({ file, cfg.fontSizePx });
+            }
+            if (g_FontSources.empty()) {
+                g_FontSources.push_back({ {}, cfg.fontSizePx });
+            }
+            g_FontRanges.assign(std::begin(kBaseGlyphRanges), std::end(kBaseGlyphRanges));
+            g_FontKey = FontAtlasCache::Key(g_FontSources, g_FontRanges, FontAtlasImGui::BuilderVersion());
+
+            const auto t0 = std::chrono::steady_clock::now();
+            BakedAtlas cached;
+            if (FontAtlasCache::ReadFile(FontCachePath(), g_FontKey, cached) && FontAtlasImGui::Restore(cached, atlas)) {
+                g_FontRanges = cached.ranges;  // includes scripts earlier runs added on demand
+                char line[128];
+                std::snprintf(line, sizeof(line), "Font atlas loaded from cache: %ux%u, %zu ranges, %.2f ms",
+                              cached.width, cached.height, g_FontRanges.size() / 2, MsSince(t0));
+                MI::Log::Info(line);
+            } else {
+                BakeFonts(atlas);
+            }
+            g_GlyphCoverage.Reset(g_FontRanges);
+        }
+
+        // Between frames: codepoints drawn text needed that the atlas lacks are baked in (one
+        // hitch per new block, cached afterwards); the backend re-uploads on its next NewFrame
+        void UpdateFonts()
+        {
+            if (!g_GlyphCoverage.TakePending(g_FontRanges)) {
+                return;
+            }
+            BakeFonts(*ImGui::GetIO().Fonts);
+            ImGui_ImplDX11_InvalidateDeviceObjects();
+        }
+
+        // Built-in panel: registered with the overlay host at priority 0 like any other overlay
+        void DrawInventoryPanel(void*)
+        {
+            if (g_InventoryOpen) {
+                // Right-side panel only (leave SkyUI left side visible)
+                const float ratio = MI::ConfigSys::Get().panelWidthRatio; // configurable
+                const float minWidth = static_cast<float>(MI::ConfigSys::Get().panelMinWidth);
+                const auto panel = MI::Panel::ComputeRightPanel(static_cast<float>(g_Width), static_cast<float>(g_Height), ratio, minWidth);
+                const ImVec2 panelPos = ImVec2(panel.x, panel.y);
+                const ImVec2 panelSize = ImVec2(panel.w, panel.h);
+
+                ImGui::SetNextWindowPos(panelPos);
+                ImGui::SetNextWindowSize(panelSize);
+                ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 0.0f);
+                ImGui::Begin("MI_RightPanelRoot", nullptr,
+                    ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove |
+                    ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoSavedSettings |
+                    ImGuiWindowFlags_NoCollapse);
+
+                ImGui::PushStyleColor(ImGuiCol_ChildBg, IM_COL32(20, 20, 20, 230));
+                ImGui::BeginChild("MI_RightPanelBg", ImVec2(-1, -1), false,
+                    ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse);
+
+                ImGui::Text("ModernInventory");
+                ImGui::Separator();
+                ImGui::TextWrapped("Right-side preview area (Preview3D RT).");
+                DrawMemorySection();
+                DrawItemComparison();
+
+                // Use Preview3D off-screen SRV inside this pane
+                const ImVec2 avail = ImGui::GetContentRegionAvail();
+                const UINT w = static_cast<UINT>((std::max)(1.0f, avail.x));
+                const UINT h = static_cast<UINT>((std::max)(1.0f, avail.y));
+
+                MI::GetPreviewController().OnFrame(w, h); // sizes + renders Preview3D
+                auto& preview = Preview3D::Get();
+                if (g_ExportRequested.exchange(false)) {
+                    const AllocTrack::Scope exportScope(AllocTrack::Stage::kExport);
+                    const auto format = MI::ConfigSys::Get().exportFormat;
+                    if (!preview.RequestExport(MakeExportPath(format), format)) {
+                        MI::Log::Warn("Preview export skipped (no image yet or readback ring busy)");
+                    }
+                }
+
+                Preview3D::TurntableView turntable{};
+                if (preview.GetTurntableView(turntable)) {
+                    // Pre-baked yaw: pick the atlas tile(s) instead of re-rendering
+                    const auto id = reinterpret_cast<ImTextureID>(turntable.srv);
+                    const ImVec2 p0 = ImGui::GetCursorScreenPos();
+                    const ImVec2 size(static_cast<float>(w), static_cast<float>(h));
+                    ImGui::Image(id, size, ImVec2(turntable.a.u0, turntable.a.v0), ImVec2(turntable.a.u1, turntable.a.v1));
+                    if (turntable.blend > 0.0f) {
+                        const auto alpha = static_cast<int>(turntable.blend * 255.0f + 0.5f);
+                        ImGui::GetWindowDrawList()->AddImage(id, p0, ImVec2(p0.x + size.x, p0.y + size.y),
+                            ImVec2(turntable.b.u0, turntable.b.v0), ImVec2(turntable.b.u1, turntable.b.v1),
+                            IM_COL32(255, 255, 255, alpha));
+                    }
+                } else if (auto* srv = preview.GetSRV()) {
+                    ImGui::Image(reinterpret_cast<ImTextureID>(srv), ImVec2(static_cast<float>(w), static_cast<float>(h)));
+                } else {
+                    ImGui::TextUnformatted("No SRV yet");
+                }
+                // Drag across the preview to turn it (tiles come from the turntable atlas once baked)
+                if (ImGui::IsItemHovered() && ImGui::IsMouseDragging(ImGuiMouseButton_Left, 0.0f)) {
+                    constexpr float kYawPerPixel = 0.01f;
+                    preview.SetYaw(preview.Yaw() + ImGui::GetIO().MouseDelta.x * kYawPerPixel);
+                }
+            
+                ImGui::EndChild();
+                ImGui::PopStyleColor();
+                ImGui::End();
+                ImGui::PopStyleVar();
+            } else {
+                MI::GetPreviewController().OnFrame(0, 0); // frame boundary only
+                g_ExportRequested = false;                // nothing on screen to save
+                MI::InventoryStats::Reset();
+            }
+        }
 
         void CreateRenderTarget(IDXGISwapChain* swap)
         {
             ID3D11Texture2D* backBuffer = nullptr;
             if (SUCCEEDED(swap->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&backBuffer))) {
+                GpuCalls::Count(GpuCall::kCreateRenderTargetView);
                 g_Device->CreateRenderTargetView(backBuffer, nullptr, &g_MainRTV);
                 backBuffer->Release();
             }
@@ -111,17 +372,22 @@ namespace MI
             CreateRenderTarget(swap);
 
             IMGUI_CHECKVERSION();
+#if MI_ALLOC_TRACKING
+            ImGui::SetAllocatorFunctions(AllocTrack::ImGuiAlloc, AllocTrack::ImGuiFree);
+#endif
             ImGui::CreateContext();
             ImGuiIO& io = ImGui::GetIO();
             io.IniFilename = nullptr; // avoid imgui.ini on disk
             io.ConfigFlags |= ImGuiConfigFlags_NoMouseCursorChange;
 
             ImGui::StyleColorsDark();
+            InitFonts(*io.Fonts);
             ImGui_ImplWin32_Init(g_hWnd);
             ImGui_ImplDX11_Init(g_Device, g_Context);
             g_Offscreen.Init(g_Device, g_Context);
             g_Preview.Init(g_Device, g_Context);
             Preview3D::Get().Init(g_Device, g_Context);
+            GetOverlayRegistry().Register("ModernInventory", 0, &DrawInventoryPanel, nullptr);
 
             g_ImGuiInitialized = true;
             if (!g_ImGuiInitNotified) {
@@ -150,71 +416,56 @@ namespace MI
                 MI::Toast("MI: Present hook called");
             }
 
+            const AllocTrack::Scope allocScope(AllocTrack::Stage::kPresent);
             EnsureImGuiInit(swap);
             if (g_ImGuiInitialized) {
                 OnResize(swap);
 
-                ImGui_ImplDX11_NewFrame();
-                ImGui_ImplWin32_NewFrame();
-                ImGui::NewFrame();
-
-                if (g_InventoryOpen) {
-                    // Right-side panel only (leave SkyUI left side visible)
-                    const float ratio = MI::ConfigSys::Get().panelWidthRatio; // configurable
-                    const float minWidth = static_cast<float>(MI::ConfigSys::Get().panelMinWidth);
-                    const float maxWidth = static_cast<float>(g_Width) - 40.0f; // keep a small left margin
-                    const float target = (std::max)(minWidth, static_cast<float>(g_Width) * ratio);
-                    const float panelWidth = (std::min)(target, maxWidth);
-                    const ImVec2 panelPos = ImVec2(static_cast<float>(g_Width) - panelWidth, 0.0f);
-                    const ImVec2 panelSize = ImVec2(panelWidth, static_cast<float>(g_Height));
-
-                    ImGui::SetNextWindowPos(panelPos);
-                    ImGui::SetNextWindowSize(panelSize);
-                    ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 0.0f);
-                    ImGui::Begin("MI_RightPanelRoot", nullptr,
-                        ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove |
-                        ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoSavedSettings |
-                        ImGuiWindowFlags_NoCollapse);
-
-                    ImGui::PushStyleColor(ImGuiCol_ChildBg, IM_COL32(20, 20, 20, 230));
-                    ImGui::BeginChild("MI_RightPanelBg", ImVec2(-1, -1), false,
-                        ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse);
-
-                    ImGui::Text("ModernInventory");
-                    ImGui::Separator();
-                    ImGui::TextWrapped("Right-side preview area (Preview3D RT).");
-
-                    // Use Preview3D off-screen SRV inside this pane
-                    const ImVec2 avail = ImGui::GetContentRegionAvail();
-                    const UINT w = static_cast<UINT>((std::max)(1.0f, avail.x));
-                    const UINT h = static_cast<UINT>((std::max)(1.0f, avail.y));
-
-                    auto& preview = Preview3D::Get();
-                    preview.EnsureSize(w, h);
-                    preview.Render();
-
-                    if (auto* srv = preview.GetSRV()) {
-                        ImGui::Image(reinterpret_cast<ImTextureID>(srv), ImVec2(static_cast<float>(w), static_cast<float>(h)));
-                    } else {
-                        ImGui::TextUnformatted("No SRV yet");
-                    }
-                    
-                    ImGui::EndChild();
-                    ImGui::PopStyleColor();
-                    ImGui::End();
-                    ImGui::PopStyleVar();
+                {
+                    const AllocTrack::Scope imguiScope(AllocTrack::Stage::kImGui);
+                    UpdateFonts();
+                    ImGui_ImplDX11_NewFrame();
+                    ImGui_ImplWin32_NewFrame();
+                    ImGui::NewFrame();
+                }
+
+                // Apply what the event sinks posted since the last frame (open/close, equip,
+                // export) here, before anything reads the open flag or the preview scene
+                MI::GetPreviewController().ProcessCommands();
+
+                // Our panel and other plugins' overlays, in priority order, into this one frame
+                GetOverlayRegistry().Dispatch();
+                {
+                    const AllocTrack::Scope exportScope(AllocTrack::Stage::kExport);
+                    Preview3D::Get().PollExports(); // finished readbacks -> background encoder
                 }
 
-                ImGui::Render();
-                if (g_MainRTV) {
-                    g_Context->OMSetRenderTargets(1, &g_MainRTV, nullptr);
+                {
+                    const AllocTrack::Scope imguiScope(AllocTrack::Stage::kImGui);
+                    ImGui::Render();
+                    if (g_MainRTV) {
+                        GpuCalls::Count(GpuCall::kOMSetRenderTargets);
+                        g_Context->OMSetRenderTargets(1, &g_MainRTV, nullptr);
+                    }
+                    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
                 }
-                ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+                ReportImGuiMemory();
+                AllocTrack::TakeFrame(g_LastAllocs);
             }
 
             return g_OrigPresent(swap, syncInterval, flags);
         }
 
+        // Hook Present through a swapchain's vtable (shared by every IDXGISwapChain)
+        bool HookPresentFrom(IDXGISwapChain* sc)
+        {
+            auto** vtbl = *reinterpret_cast<void***>(sc);
+            auto presentAddr = reinterpret_cast<Present_t>(vtbl[8]);
+            return MH_CreateHook(reinterpret_cast<LPVOID>(presentAddr), reinterpret_cast<LPVOID>(&Present_Hook),
+                                 reinterpret_cast<LPVOID*>(&g_OrigPresent)) == MH_OK &&
+                   MH_EnableHook(reinterpret_cast<LPVOID>(presentAddr)) == MH_OK;
+        }
+
         // Hook D3D11CreateDeviceAndSwapChain; then hook Present on the game's swapchain.
         HRESULT WINAPI CreateDeviceAndSwapChain_Hook(
             IDXGIAdapter* pAdapter,
@@ -234,101 +485,94 @@ namespace MI
                 pAdapter, DriverType, Software, Flags, pFeatureLevels, FeatureLevels, SDKVersion,
                 pSwapChainDesc, ppSwapChain, ppDevice, pFeatureLevel, ppImmediateContext);
 
-            if (SUCCEEDED(hr) && ppSwapChain && *ppSwapChain && !g_OrigPresent) {
-                auto** vtbl = *reinterpret_cast<void***>(*ppSwapChain);
-                auto presentAddr = reinterpret_cast<Present_t>(vtbl[8]);
-                if (MH_CreateHook(reinterpret_cast<LPVOID>(presentAddr), reinterpret_cast<LPVOID>(&Present_Hook),
-                                  reinterpret_cast<LPVOID*>(&g_OrigPresent)) == MH_OK) {
-                    if (MH_EnableHook(reinterpret_cast<LPVOID>(presentAddr)) == MH_OK) {
-                        if (!g_HookEnabledNotified) {
-                            g_HookEnabledNotified = true;
-                            MI::Toast("MI: Present hook enabled (CreateDevice hook)");
-                        }
-                    }
+            if (SUCCEEDED(hr) && ppSwapChain && *ppSwapChain && !g_OrigPresent && HookPresentFrom(*ppSwapChain)) {
+                if (!g_HookEnabledNotified) {
+                    g_HookEnabledNotified = true;
+                    MI::Toast("MI: Present hook enabled (CreateDevice hook)");
                 }
             }
             return hr;
         }
 
-        void InstallPresentHook()
-        {
-            if (MH_Initialize() != MH_OK) {
-                return;
-            }
+    } // namespace
 
-            if (!g_OrigCreateDevSwap) {
-                HMODULE d3d11 = GetModuleHandleW(L"d3d11.dll");
-                if (!d3d11) {
-                    d3d11 = LoadLibraryW(L"d3d11.dll");
-                }
-                if (d3d11) {
-                    auto addr = GetProcAddress(d3d11, "D3D11CreateDeviceAndSwapChain");
-                    if (addr && MH_CreateHook(addr, &CreateDeviceAndSwapChain_Hook,
-                                              reinterpret_cast<LPVOID*>(&g_OrigCreateDevSwap)) == MH_OK) {
-                        MH_EnableHook(addr);
-                        MI::Toast("MI: Hooked D3D11CreateDeviceAndSwapChain");
-                        return;
-                    }
-                }
-            }
+    void NoteOverlayText(std::string_view utf8)
+    {
+        g_GlyphCoverage.Note(utf8);
+    }
 
-            // Fallback: create a dummy swapchain to get the Present address and hook globally
-            WNDCLASSEXW wc{ sizeof(WNDCLASSEXW) };
-            wc.lpfnWndProc = DefWindowProcW;
-            wc.hInstance = GetModuleHandleW(nullptr);
-            wc.lpszClassName = L"MI_D3D11_WND";
-            RegisterClassExW(&wc);
-            HWND hwnd = CreateWindowW(wc.lpszClassName, L"MI_D3D11", WS_OVERLAPPEDWINDOW,
-                CW_USEDEFAULT, CW_USEDEFAULT, 100, 100, nullptr, nullptr, wc.hInstance, nullptr);
-
-            DXGI_SWAP_CHAIN_DESC sd{};
-            sd.BufferCount = 2;
-            sd.BufferDesc.Width = 100;
-            sd.BufferDesc.Height = 100;
-            sd.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-            sd.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-            sd.OutputWindow = hwnd;
-            sd.SampleDesc.Count = 1;
-            sd.Windowed = TRUE;
-            sd.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
-
-            ID3D11Device* dev = nullptr;
-            ID3D11DeviceContext* ctx = nullptr;
-            IDXGISwapChain* sc = nullptr;
-
-            D3D_FEATURE_LEVEL featureLevel = D3D_FEATURE_LEVEL_11_0;
-            const UINT flags = 0;
-            if (SUCCEEDED(D3D11CreateDeviceAndSwapChain(
-                    nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, flags, &featureLevel, 1,
-                    D3D11_SDK_VERSION, &sd, &sc, &dev, nullptr, &ctx))) {
-                auto** vtbl = *reinterpret_cast<void***>(sc);
-                auto presentAddr = reinterpret_cast<Present_t>(vtbl[8]);
-                if (MH_CreateHook(reinterpret_cast<LPVOID>(presentAddr), reinterpret_cast<LPVOID>(&Present_Hook),
-                                  reinterpret_cast<LPVOID*>(&g_OrigPresent)) == MH_OK) {
-                    if (MH_EnableHook(reinterpret_cast<LPVOID>(presentAddr)) == MH_OK) {
-                        if (!g_HookEnabledNotified) {
-                            g_HookEnabledNotified = true;
-                            MI::Toast("MI: Present hook enabled (fallback)");
-                        }
-                    }
+    bool InstallD3D11Hook()
+    {
+        if (MH_Initialize() != MH_OK) {
+            return false;
+        }
+
+        if (!g_OrigCreateDevSwap) {
+            HMODULE d3d11 = GetModuleHandleW(L"d3d11.dll");
+            if (!d3d11) {
+                d3d11 = LoadLibraryW(L"d3d11.dll");
+            }
+            if (d3d11) {
+                auto addr = GetProcAddress(d3d11, "D3D11CreateDeviceAndSwapChain");
+                if (addr && MH_CreateHook(addr, &CreateDeviceAndSwapChain_Hook,
+                                          reinterpret_cast<LPVOID*>(&g_OrigCreateDevSwap)) == MH_OK) {
+                    MH_EnableHook(addr);
+                    return true;
                 }
             }
-
-            if (sc)
-                sc->Release();
-            if (ctx)
-                ctx->Release();
-            if (dev)
-                dev->Release();
-            if (hwnd)
-                DestroyWindow(hwnd);
-            UnregisterClassW(wc.lpszClassName, wc.hInstance);
         }
-    } // namespace
+        return g_OrigCreateDevSwap != nullptr;
+    }
 
-    void InstallD3D11Hook()
+    bool InstallD3D11HookFallback()
     {
-        InstallPresentHook();
+        // Create a dummy swapchain to get the Present address and hook globally
+        WNDCLASSEXW wc{ sizeof(WNDCLASSEXW) };
+        wc.lpfnWndProc = DefWindowProcW;
+        wc.hInstance = GetModuleHandleW(nullptr);
+        wc.lpszClassName = L"MI_D3D11_WND";
+        RegisterClassExW(&wc);
+        HWND hwnd = CreateWindowW(wc.lpszClassName, L"MI_D3D11", WS_OVERLAPPEDWINDOW,
+            CW_USEDEFAULT, CW_USEDEFAULT, 100, 100, nullptr, nullptr, wc.hInstance, nullptr);
+
+        DXGI_SWAP_CHAIN_DESC sd{};
+        sd.BufferCount = 2;
+        sd.BufferDesc.Width = 100;
+        sd.BufferDesc.Height = 100;
+        sd.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        sd.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+        sd.OutputWindow = hwnd;
+        sd.SampleDesc.Count = 1;
+        sd.Windowed = TRUE;
+        sd.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
+
+        ID3D11Device* dev = nullptr;
+        ID3D11DeviceContext* ctx = nullptr;
+        IDXGISwapChain* sc = nullptr;
+
+        bool hooked = false;
+        D3D_FEATURE_LEVEL featureLevel = D3D_FEATURE_LEVEL_11_0;
+        const UINT flags = 0;
+        if (SUCCEEDED(D3D11CreateDeviceAndSwapChain(
+                nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, flags, &featureLevel, 1,
+                D3D11_SDK_VERSION, &sd, &sc, &dev, nullptr, &ctx))) {
+            hooked = HookPresentFrom(sc);
+            if (hooked) {
+                g_HookEnabledNotified = true;
+                MI::Log::Info("Present hook enabled (fallback)");  // background thread: no toast
+            }
+        }
+
+        if (sc)
+            sc->Release();
+        if (ctx)
+            ctx->Release();
+        if (dev)
+            dev->Release();
+        if (hwnd)
+            DestroyWindow(hwnd);
+        UnregisterClassW(wc.lpszClassName, wc.hInstance);
+        return hooked;
     }
 
     void SetInventoryOpen(bool open)
@@ -339,6 +583,10 @@ namespace MI
     {
         return g_InventoryOpen;
     }
+    void RequestPreviewExport()
+    {
+        g_ExportRequested = true;
+    }
 }
 
 
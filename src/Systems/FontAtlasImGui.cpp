@@ -0,0 +1,148 @@
+// Portable apart from ImGui core: no PCH / RE / Windows includes (MI_bench builds it when
+// imgui is available).
+#include "ModernInventory/FontAtlasImGui.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include <imgui.h>
+
+namespace MI
+{
+    namespace
+    {
+        // First, last pairs -> ImGui's zero-terminated ImWchar list (16-bit codepoints)
+        std::vector<ImWchar> ToImGuiRanges(const std::vector<std::uint32_t>& ranges)
+        {
+            std::vector<ImWchar> out;
+            for (std::size_t i = 0; i + 1 < ranges.size(); i += 2) {
+                const auto first = (std::max)(ranges[i], 1u);
+                const auto last = (std::min)(ranges[i + 1], 0xFFFFu);
+                if (first <= last) {
+                    out.push_back(static_cast<ImWchar>(first));
+                    out.push_back(static_cast<ImWchar>(last));
+                }
+            }
+            out.push_back(0);
+            return out;
+        }
+
+        bool FileExists(const std::string& path)
+        {
+            std::error_code ec;
+            return std::filesystem::is_regular_file(path, ec);
+        }
+    }
+
+    bool FontAtlasImGui::Bake(ImFontAtlas& atlas, const std::vector<FontSource>& fonts,
+                              const std::vector<std::uint32_t>& ranges)
+    {
+        atlas.Clear();
+        atlas.Flags |= ImFontAtlasFlags_NoMouseCursors;  // no software cursor; Restore can't rebuild them
+        // Referenced by the font configs until Build
+        const auto glyphRanges = ToImGuiRanges(ranges);
+        const ImWchar* imRanges = ranges.empty() ? nullptr : glyphRanges.data();
+
+        bool haveMain = false;
+        for (const auto& src : fonts) {
+            ImFontConfig cfg;
+            cfg.SizePixels = src.sizePx;
+            cfg.MergeMode = haveMain;
+            if (!src.path.empty() && FileExists(src.path)) {
+                haveMain |= atlas.AddFontFromFileTTF(src.path.c_str(), src.sizePx, &cfg, imRanges) != nullptr;
+            } else if (!haveMain) {
+                // What AddFontDefault does without a template, plus our ranges
+                cfg.OversampleH = cfg.OversampleV = 1;
+                cfg.PixelSnapH = true;
+                cfg.GlyphRanges = imRanges;
+                haveMain = atlas.AddFontDefault(&cfg) != nullptr;
+            }
+        }
+        if (!haveMain) {
+            atlas.AddFontDefault();
+        }
+        const bool ok = atlas.Build();
+        atlas.ClearInputData();
+        return ok;
+    }
+
+    void FontAtlasImGui::Capture(const ImFontAtlas& atlas, const std::vector<std::uint32_t>& ranges, BakedAtlas& out)
+    {
+        out.width = static_cast<std::uint32_t>(atlas.TexWidth);
+        out.height = static_cast<std::uint32_t>(atlas.TexHeight);
+        out.whiteU = atlas.TexUvWhitePixel.x;
+        out.whiteV = atlas.TexUvWhitePixel.y;
+        out.lineUvs.clear();
+        if (!(atlas.Flags & ImFontAtlasFlags_NoBakedLines)) {
+            for (const auto& uv : atlas.TexUvLines) {
+                out.lineUvs.push_back({ uv.x, uv.y, uv.z, uv.w });
+            }
+        }
+        out.ranges = ranges;
+        out.fonts.clear();
+        for (const ImFont* font : atlas.Fonts) {
+            auto& baked = out.fonts.emplace_back();
+            baked.size = font->FontSize;
+            baked.ascent = font->Ascent;
+            baked.descent = font->Descent;
+            baked.glyphs.reserve(static_cast<std::size_t>(font->Glyphs.Size));
+            for (const auto& g : font->Glyphs) {
+                baked.glyphs.push_back({ g.Codepoint, g.AdvanceX, g.X0, g.Y0, g.X1, g.Y1, g.U0, g.V0, g.U1, g.V1 });
+            }
+        }
+        const auto pixels = static_cast<std::size_t>(out.width) * out.height;
+        out.alpha.assign(atlas.TexPixelsAlpha8, atlas.TexPixelsAlpha8 ? atlas.TexPixelsAlpha8 + pixels : nullptr);
+    }
+
+    bool FontAtlasImGui::Restore(const BakedAtlas& baked, ImFontAtlas& atlas)
+    {
+        atlas.Clear();
+        const auto pixels = static_cast<std::size_t>(baked.width) * baked.height;
+        if (pixels == 0 || baked.alpha.size() != pixels || baked.fonts.empty()) {
+            return false;
+        }
+
+        atlas.Flags |= ImFontAtlasFlags_NoMouseCursors;
+        atlas.TexWidth = static_cast<int>(baked.width);
+        atlas.TexHeight = static_cast<int>(baked.height);
+        atlas.TexUvScale = ImVec2(1.0f / baked.width, 1.0f / baked.height);
+        atlas.TexUvWhitePixel = ImVec2(baked.whiteU, baked.whiteV);
+        if (baked.lineUvs.size() == IM_ARRAYSIZE(atlas.TexUvLines)) {
+            for (std::size_t i = 0; i < baked.lineUvs.size(); ++i) {
+                const auto& uv = baked.lineUvs[i];
+                atlas.TexUvLines[i] = ImVec4(uv[0], uv[1], uv[2], uv[3]);
+            }
+        } else {
+            atlas.Flags |= ImFontAtlasFlags_NoBakedLines;  // draw lists fall back to geometry AA
+        }
+        // The atlas frees its pixels with IM_FREE, so they must come from ImGui's allocator;
+        // the backend expands them to RGBA on upload as it would after a fresh Build
+        atlas.TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(pixels));
+        std::memcpy(atlas.TexPixelsAlpha8, baked.alpha.data(), pixels);
+
+        for (const auto& src : baked.fonts) {
+            ImFont* font = IM_NEW(ImFont);
+            font->ContainerAtlas = &atlas;  // before AddGlyph, which reads the texture size
+            font->FontSize = src.size;
+            font->Ascent = src.ascent;
+            font->Descent = src.descent;
+            font->Glyphs.reserve(static_cast<int>(src.glyphs.size()));
+            for (const auto& g : src.glyphs) {
+                // No config: the advance was already clamped, snapped and spaced when baked
+                font->AddGlyph(nullptr, static_cast<ImWchar>(g.codepoint), g.x0, g.y0, g.x1, g.y1, g.u0, g.v0, g.u1,
+                               g.v1, g.advanceX);
+            }
+            font->BuildLookupTable();  // fallback and ellipsis glyphs, as Build does
+            atlas.Fonts.push_back(font);
+        }
+        atlas.TexReady = true;
+        return true;
+    }
+
+    std::uint32_t FontAtlasImGui::BuilderVersion()
+    {
+        return IMGUI_VERSION_NUM;
+    }
+}
@@ -0,0 +1,196 @@
+#include "PCH.h"
+#include "ModernInventory/GameWorld.h"
+#include "ModernInventory/Config.h"
+#include "ModernInventory/D3D11Hook.h"
+#include "ModernInventory/PreviewController.h"
+#include "game/Preview3D.h"
+
+#include <Windows.h>
+#include <bit>
+#include <chrono>
+#include <iterator>
+#include <string>
+#include <utility>
+
+namespace MI
+{
+    namespace
+    {
+        // The inventory's item list while the menu is up (rows as shown, current tab)
+        RE::ItemList* InventoryItemList()
+        {
+            auto* ui = RE::UI::GetSingleton();
+            const auto menu = ui ? ui->GetMenu<RE::InventoryMenu>() : nullptr;
+            return menu ? menu->GetRuntimeData().itemList : nullptr;
+        }
+
+        // The controller applies commands on the Present thread; the HUD, the console and the
+        // inventory's 3D manager belong to the game's main thread, so their calls are queued there
+        template <class F>
+        void RunOnMainThread(F&& task)
+        {
+            if (const auto* tasks = SKSE::GetTaskInterface()) {
+                tasks->AddTask(std::forward<F>(task));
+            }
+        }
+
+        class LiveWorld final : public IGameWorld
+        {
+        public:
+            bool HasPlayer3D() override
+            {
+                const auto* pc = RE::PlayerCharacter::GetSingleton();
+                return pc && pc->Get3D(false);
+            }
+
+            void HideVanillaPreview() override
+            {
+                RunOnMainThread([] {
+                    if (auto* inv3d = RE::Inventory3DManager::GetSingleton()) {
+                        inv3d->Clear3D();
+                    }
+                });
+            }
+
+            void SetPanelVisible(bool open) override { MI::SetInventoryOpen(open); }
+
+            bool RebuildPreview() override { return Preview3D::Get().BuildFromPlayer(); }
+
+            void DiscardPreview() override { Preview3D::Get().ReleaseClone(); }
+
+            std::uint64_t PreviewFingerprint() override
+            {
+                auto* pc = RE::PlayerCharacter::GetSingleton();
+                if (!pc) {
+                    return 0;
+                }
+                Fingerprint fp;
+                // A reloaded 3D (cell change, race menu, transformation) always rebuilds
+                fp.Add(reinterpret_cast<std::uintptr_t>(pc->Get3D(false)));
+                if (const auto biped = pc->GetBiped(false)) {
+                    for (const auto& object : biped->objects) {  // what each biped slot shows
+                        fp.Add(object.item ? object.item->GetFormID() : 0);
+                        fp.Add(object.addon ? object.addon->GetFormID() : 0);
+                    }
+                }
+                if (const auto* race = pc->GetRace()) {
+                    fp.Add(race->GetFormID());
+                }
+                if (const auto* npc = pc->GetActorBase()) {
+                    fp.Add(std::bit_cast<std::uint32_t>(npc->weight));
+                    for (std::int8_t i = 0; npc->headParts && i < npc->numHeadParts; ++i) {
+                        fp.Add(npc->headParts[i] ? npc->headParts[i]->GetFormID() : 0);
+                    }
+                    const auto* hair = npc->headRelatedData ? npc->headRelatedData->hairColor : nullptr;
+                    fp.Add(hair ? hair->GetFormID() : 0);
+                }
+                fp.Add(pc->AsActorState()->IsWeaponDrawn() ? 1 : 0);  // pose of the cloned tree
+                return fp.value;
+            }
+
+            bool UnderMemoryPressure() override
+            {
+                MEMORYSTATUSEX status{};
+                status.dwLength = sizeof(status);
+                return GlobalMemoryStatusEx(&status) &&
+                       status.dwMemoryLoad >= static_cast<DWORD>(ConfigSys::Get().cacheEvictMemoryLoad);
+            }
+
+            bool RenderPreview(unsigned width, unsigned height) override
+            {
+                auto& preview = Preview3D::Get();
+                preview.EnsureSize(width, height);
+                preview.Render();
+                return preview.HasClone();
+            }
+
+            void Notify(const char* text) override
+            {
+                RunOnMainThread([line = std::string(text)] {
+                    RE::DebugNotification(line.c_str());
+                    if (auto* con = RE::ConsoleLog::GetSingleton()) {
+                        con->Print("%s", line.c_str());
+                    }
+                });
+            }
+
+            std::uint64_t NowUs() override
+            {
+                return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+            }
+
+            void TakeGpuCalls(GpuCallFrame& out) override { GpuCalls::TakeFrame(out); }
+
+            void RequestExport() override { MI::RequestPreviewExport(); }
+
+            // Asked by the controller and InventoryStats each frame. The selection mostly stays
+            // put or steps one row, so the last answer and its neighbours are tried before the list.
+            std::uint32_t HoveredRow() override
+            {
+                auto* list = InventoryItemList();
+                const auto* selected = list ? list->GetSelectedItem() : nullptr;
+                if (!selected) {
+                    return kNone;
+                }
+                const auto count = list->items.size();
+                if (list == m_hoverList && m_hoverRow != kNone) {
+                    for (const auto i : { m_hoverRow, m_hoverRow + 1, m_hoverRow - 1 }) {
+                        if (i < count && list->items[i] == selected) {
+                            return m_hoverRow = i;
+                        }
+                    }
+                }
+                m_hoverList = list;
+                m_hoverRow = kNone;
+                for (std::uint32_t i = 0; i < count; ++i) {
+                    if (list->items[i] == selected) {
+                        return m_hoverRow = i;
+                    }
+                }
+                return kNone;
+            }
+
+            std::uint32_t ItemCount() override
+            {
+                const auto* list = InventoryItemList();
+                return list ? list->items.size() : 0;
+            }
+
+            // Armor the player isn't wearing; anything else has nothing to swap in
+            std::uint32_t ItemForm(std::uint32_t row) override
+            {
+                const auto* list = InventoryItemList();
+                const auto* item = list && row < list->items.size() ? list->items[row] : nullptr;
+                const auto* entry = item ? item->data.objDesc : nullptr;
+                const auto* object = entry ? entry->GetObject() : nullptr;
+                return object && object->IsArmor() && !entry->IsWorn() ? object->GetFormID() : 0;
+            }
+
+            bool BuildVariant(std::uint32_t slot, std::uint32_t formID) override
+            {
+                return Preview3D::Get().BuildVariant(slot, RE::TESForm::LookupByID<RE::TESObjectARMO>(formID));
+            }
+
+            void ShowVariant(std::uint32_t slot) override { Preview3D::Get().ShowVariant(slot); }
+
+            void DiscardVariants() override { Preview3D::Get().ReleaseVariants(); }
+
+        private:
+            const RE::ItemList* m_hoverList{ nullptr };  // list m_hoverRow was found in
+            std::uint32_t       m_hoverRow{ kNone };
+        };
+    }
+
+    IGameWorld& LiveGameWorld()
+    {
+        static LiveWorld world;
+        return world;
+    }
+
+    PreviewController& GetPreviewController()
+    {
+        static PreviewController controller{ LiveGameWorld() };
+        return controller;
+    }
+}
@@ -0,0 +1,260 @@
+#include "PCH.h"
+#include "ModernInventory/InventoryStats.h"
+#include "ModernInventory/GameWorld.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace MI::InventoryStats
+{
+    namespace
+    {
+        // The rated skills and their *Modifier values: Fortify <skill> enchantments and potions
+        // change the modifier (e.g. OneHandedModifier), not the skill itself
+        constexpr RE::ActorValue kSkills[] = { RE::ActorValue::kLightArmor, RE::ActorValue::kHeavyArmor,
+                                               RE::ActorValue::kOneHanded, RE::ActorValue::kTwoHanded,
+                                               RE::ActorValue::kArchery,
+                                               RE::ActorValue::kLightArmorModifier, RE::ActorValue::kHeavyArmorModifier,
+                                               RE::ActorValue::kOneHandedModifier, RE::ActorValue::kTwoHandedModifier,
+                                               RE::ActorValue::kMarksmanModifier };
+
+        StatDeltaEngine                      g_Engine;
+        std::vector<RE::InventoryEntryData*> g_Rows;       // entry behind each column row
+        std::vector<float>                   g_Effective;  // what the menu shows for the row
+        std::vector<ItemStats>               g_Worn;
+        std::array<float, kItemKindCount>    g_Multipliers{};
+        std::uint64_t                        g_ListProbe = 0;
+        std::uint64_t                        g_ListKey = 0;
+        std::uint64_t                        g_SkillKey = 0;
+        std::uint64_t                        g_EquipKey = 0;
+        std::uint64_t                        g_Reads = 0;  // ReadEffective passes: bonuses changed
+
+        RE::ItemList* InventoryItemList()
+        {
+            auto* ui = RE::UI::GetSingleton();
+            const auto menu = ui ? ui->GetMenu<RE::InventoryMenu>() : nullptr;
+            return menu ? menu->GetRuntimeData().itemList : nullptr;
+        }
+
+        ItemKind KindOf(const RE::TESBoundObject* object)
+        {
+            if (const auto* armor = object->As<RE::TESObjectARMO>()) {
+                return armor->IsHeavyArmor() ? ItemKind::kHeavyArmor
+                     : armor->IsLightArmor() ? ItemKind::kLightArmor
+                                             : ItemKind::kClothing;
+            }
+            if (const auto* weapon = object->As<RE::TESObjectWEAP>()) {
+                switch (weapon->GetWeaponType()) {
+                case RE::WEAPON_TYPE::kTwoHandSword:
+                case RE::WEAPON_TYPE::kTwoHandAxe:
+                    return ItemKind::kTwoHanded;
+                case RE::WEAPON_TYPE::kBow:
+                case RE::WEAPON_TYPE::kCrossbow:
+                case RE::WEAPON_TYPE::kStaff:
+                    return ItemKind::kRanged;
+                default:
+                    return ItemKind::kOneHanded;
+                }
+            }
+            return ItemKind::kOther;
+        }
+
+        // Form stat before the player's skills and perks
+        float BaseOf(const RE::TESBoundObject* object)
+        {
+            if (const auto* armor = object->As<RE::TESObjectARMO>()) {
+                return static_cast<float>(armor->armorRating) / 100.0f;
+            }
+            if (const auto* weapon = object->As<RE::TESObjectWEAP>()) {
+                return static_cast<float>(weapon->GetAttackDamage());
+            }
+            return 0.0f;
+        }
+
+        const RE::InventoryEntryData* EntryAt(const RE::ItemList* list, std::uint32_t row)
+        {
+            const auto* item = row < list->items.size() ? list->items[row] : nullptr;
+            return item ? item->data.objDesc : nullptr;
+        }
+
+        // Identity of the rows as listed (tab, sorting, items added or removed)
+        std::uint64_t ListKey(const RE::ItemList* list)
+        {
+            Fingerprint fp;
+            for (const auto* row : list->items) {
+                fp.Add(reinterpret_cast<std::uintptr_t>(row ? row->data.objDesc : nullptr));
+            }
+            return fp.value;
+        }
+
+        // Per-frame stand-in for ListKey: the storage, length, hovered row and the rows at either
+        // end. Moving the selection moves it, so a reorder elsewhere is caught by ListKey on the
+        // next move; until then the hovered row itself is checked and the rest only feed the
+        // worn set and multipliers, which a reorder does not change.
+        std::uint64_t ListProbe(const RE::ItemList* list, std::uint32_t row)
+        {
+            const auto count = list->items.size();
+            Fingerprint fp;
+            fp.Add(reinterpret_cast<std::uintptr_t>(list->items.data()));
+            fp.Add(count);
+            fp.Add(row);
+            fp.Add(reinterpret_cast<std::uintptr_t>(EntryAt(list, row)));
+            fp.Add(reinterpret_cast<std::uintptr_t>(EntryAt(list, 0)));
+            fp.Add(reinterpret_cast<std::uintptr_t>(EntryAt(list, count - 1)));
+            return fp.value;
+        }
+
+        // Only the rated skills and their modifiers (kSkills). Worn enchantments and potions act
+        // through these values, and perks cannot be taken while the menu is open (Reset runs on
+        // close), so a perk change is picked up on the next open rather than keyed here.
+        std::uint64_t SkillKey(RE::PlayerCharacter* pc)
+        {
+            Fingerprint fp;
+            auto* owner = pc->AsActorValueOwner();
+            for (const auto skill : kSkills) {
+                fp.Add(static_cast<std::uint64_t>(std::lround(owner->GetActorValue(skill) * 100.0f)));
+            }
+            return fp.value;
+        }
+
+        // What each biped slot and hand holds; cheaper than asking every row IsWorn per frame
+        std::uint64_t EquipKey(RE::PlayerCharacter* pc)
+        {
+            Fingerprint fp;
+            if (const auto biped = pc->GetBiped(false)) {
+                for (const auto& object : biped->objects) {
+                    fp.Add(object.item ? object.item->GetFormID() : 0);
+                }
+            }
+            for (const bool left : { false, true }) {
+                const auto* hand = pc->GetEquippedObject(left);
+                fp.Add(hand ? hand->GetFormID() : 0);
+            }
+            return fp.value;
+        }
+
+        // The static columns of the list; effective ratings follow in ReadEffective
+        void ReadRows(RE::ItemList* list)
+        {
+            auto& items = g_Engine.EditItems();
+            items.Clear();
+            items.Reserve(list->items.size());
+            g_Rows.clear();
+            for (auto* row : list->items) {
+                auto* entry = row ? row->data.objDesc : nullptr;
+                auto* object = entry ? entry->GetObject() : nullptr;
+                ItemStats stats;
+                if (object) {
+                    stats.kind = KindOf(object);
+                    stats.base = BaseOf(object);
+                    stats.weight = object->GetWeight();
+                    stats.value = static_cast<float>(entry->GetValue());
+                    if (const auto* armor = object->As<RE::TESObjectARMO>()) {
+                        stats.slots = static_cast<std::uint32_t>(armor->GetSlotMask()) & ~StatDeltaEngine::kWeaponSlot;
+                    } else if (IsComparable(stats.kind)) {
+                        stats.slots = StatDeltaEngine::kWeaponSlot;
+                    }
+                }
+                items.Add(stats);
+                g_Rows.push_back(entry);
+            }
+        }
+
+        // One engine call per comparable row, then split each into base * the multiplier of its
+        // kind + bonus. The multiplier is the smallest effective / base ratio of the kind:
+        // tempering only ever adds, so the least improved item is the untempered one.
+        void ReadEffective(RE::PlayerCharacter* pc)
+        {
+            auto& items = g_Engine.EditItems();
+            ++g_Reads;
+            g_Effective.assign(g_Rows.size(), 0.0f);
+            g_Multipliers.fill(0.0f);
+            std::array<bool, kItemKindCount> seen{};
+            for (std::size_t i = 0; i < g_Rows.size(); ++i) {
+                const auto kind = static_cast<ItemKind>(items.kind[i]);
+                if (!IsComparable(kind) || !g_Rows[i]) {
+                    continue;
+                }
+                g_Effective[i] = IsArmor(kind) ? pc->GetArmorValue(g_Rows[i]) : pc->GetDamage(g_Rows[i]);
+                if (items.base[i] > 0.0f) {
+                    const auto ratio = g_Effective[i] / items.base[i];
+                    g_Multipliers[items.kind[i]] = seen[items.kind[i]] ? (std::min)(g_Multipliers[items.kind[i]], ratio) : ratio;
+                    seen[items.kind[i]] = true;
+                }
+            }
+            for (std::size_t i = 0; i < g_Rows.size(); ++i) {
+                if (IsComparable(static_cast<ItemKind>(items.kind[i]))) {
+                    items.bonus[i] = (std::max)(g_Effective[i] - items.base[i] * g_Multipliers[items.kind[i]], 0.0f);
+                }
+            }
+        }
+
+        void ReadWorn()
+        {
+            const auto& items = g_Engine.Items();
+            g_Worn.clear();
+            for (std::size_t i = 0; i < g_Rows.size(); ++i) {
+                if (g_Rows[i] && items.slots[i] != 0 && g_Rows[i]->IsWorn()) {
+                    g_Worn.push_back({ items.base[i], items.bonus[i], items.weight[i], items.value[i], items.slots[i],
+                                       static_cast<ItemKind>(items.kind[i]) });
+                }
+            }
+        }
+    }
+
+    bool Hovered(StatDelta& out, bool& weapon, const char*& name)
+    {
+        auto* pc = RE::PlayerCharacter::GetSingleton();
+        auto* list = InventoryItemList();
+        if (!pc || !list) {
+            return false;
+        }
+        const auto row = LiveGameWorld().HoveredRow();
+        if (row == IGameWorld::kNone) {
+            return false;
+        }
+
+        // Per frame: a list probe and two fingerprints; the rows are only walked when one moves
+        const auto probe = ListProbe(list, row);
+        const auto listKey = probe != g_ListProbe ? ListKey(list) : g_ListKey;
+        const auto skillKey = SkillKey(pc);
+        const auto equipKey = EquipKey(pc);
+        const bool listChanged = listKey != g_ListKey || g_Rows.size() != list->items.size();
+        if (listChanged) {
+            ReadRows(list);
+        }
+        if (listChanged || skillKey != g_SkillKey) {
+            ReadEffective(pc);
+        }
+        if (listChanged || skillKey != g_SkillKey || equipKey != g_EquipKey) {
+            ReadWorn();
+        }
+        g_ListProbe = probe;
+        g_ListKey = listKey;
+        g_SkillKey = skillKey;
+        g_EquipKey = equipKey;
+
+        Fingerprint version;
+        version.Add(listKey);
+        version.Add(skillKey);
+        version.Add(equipKey);
+        version.Add(g_Reads);
+        g_Engine.SetEquipped(g_Worn, g_Multipliers, version.value);
+
+        const auto& items = g_Engine.Items();
+        if (row >= items.Size() || items.slots[row] == 0) {
+            return false;
+        }
+        out = g_Engine.At(row);
+        weapon = items.slots[row] == StatDeltaEngine::kWeaponSlot;
+        name = row < g_Rows.size() && g_Rows[row] ? g_Rows[row]->GetDisplayName() : nullptr;
+        return true;
+    }
+
+    void Reset()
+    {
+        g_ListProbe = g_ListKey = g_SkillKey = g_EquipKey = 0;
+        g_Rows.clear();
+    }
+}
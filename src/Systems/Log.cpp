@@ -1,6 +1,7 @@
 ﻿#include "PCH.h"
 #include "ModernInventory/Log.h"
 #include "ModernInventory/Config.h"
+#include "ModernInventory/Startup.h"
 
 #include <Windows.h>
 #include <ShlObj.h>
@@ -42,14 +43,20 @@ namespace MI
         }
     }
 
+    std::filesystem::path Log::GetFolder()
+    {
+        // Prefer SKSE documents folder; fallback to module folder if not available
+        std::filesystem::path folder = GetSkseDocumentsFolder();
+        if (folder.empty()) {
+            folder = GetModuleFolder();
+        }
+        return folder;
+    }
+
     void Log::Init()
     {
         try {
-            // Prefer SKSE documents folder; fallback to module folder if not available
-            std::filesystem::path folder = GetSkseDocumentsFolder();
-            if (folder.empty()) {
-                folder = GetModuleFolder();
-            }
+            const std::filesystem::path folder = GetFolder();
             std::error_code ec;
             std::filesystem::create_directories(folder, ec);
             auto logPath = folder / L"ModernInventory.log";
@@ -63,9 +70,10 @@ namespace MI
         }
     }
 
-    void Log::Info(std::string_view msg)  { spdlog::info("{}", msg); }
-    void Log::Warn(std::string_view msg)  { spdlog::warn("{}", msg); }
-    void Log::Error(std::string_view msg) { spdlog::error("{}", msg); }
+    // The file logger is created by a startup step; the first message waits for it
+    void Log::Info(std::string_view msg)  { RequireStartup(StartupStep::kLog); spdlog::info("{}", msg); }
+    void Log::Warn(std::string_view msg)  { RequireStartup(StartupStep::kLog); spdlog::warn("{}", msg); }
+    void Log::Error(std::string_view msg) { RequireStartup(StartupStep::kLog); spdlog::error("{}", msg); }
 
     void Toast(const char* text)
     {
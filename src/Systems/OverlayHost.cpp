@@ -0,0 +1,91 @@
+#include "PCH.h"
+#include "ModernInventory/OverlayHost.h"
+#include "ModernInventory/D3D11Hook.h"
+#include "ModernInventory/Log.h"
+#include "ModernInventory/OverlayAPI.h"
+
+#include <cstddef>
+
+#include <imgui.h>
+
+namespace MI
+{
+    namespace
+    {
+        void* GetImGuiContext() { return ImGui::GetCurrentContext(); }
+
+        // Forward to whatever allocator our context uses (AllocTrack swaps it in tracking builds)
+        void* ImGuiAlloc(std::size_t size, void*) { return ImGui::MemAlloc(size); }
+        void  ImGuiFree(void* ptr, void*) { ImGui::MemFree(ptr); }
+
+        ModernInventoryAPI::OverlayHandle Register(const char* name, std::int32_t priority,
+                                                   ModernInventoryAPI::DrawCallback fn, void* user)
+        {
+            const auto handle = GetOverlayRegistry().Register(name, priority, fn, user);
+            MI::Log::Info(std::string(handle ? "Overlay registered: " : "Overlay rejected: ") + (name ? name : "?"));
+            return handle;
+        }
+
+        bool Unregister(ModernInventoryAPI::OverlayHandle handle)
+        {
+            return GetOverlayRegistry().Unregister(handle);
+        }
+
+        void NoteText(const char* utf8, std::size_t size)
+        {
+            if (utf8) {
+                NoteOverlayText(std::string_view(utf8, size));
+            }
+        }
+
+        const ModernInventoryAPI::OverlayInterfaceV1 kInterfaceV1{
+            1,
+            IMGUI_VERSION,
+            &GetImGuiContext,
+            &ImGuiAlloc,
+            &ImGuiFree,
+            nullptr,
+            &Register,
+            &Unregister,
+        };
+
+        // A V2 table must read correctly through a V1 pointer
+        static_assert(offsetof(ModernInventoryAPI::OverlayInterfaceV2, Unregister) ==
+                      offsetof(ModernInventoryAPI::OverlayInterfaceV1, Unregister));
+
+        const ModernInventoryAPI::OverlayInterfaceV2 kInterfaceV2{
+            2,
+            IMGUI_VERSION,
+            &GetImGuiContext,
+            &ImGuiAlloc,
+            &ImGuiFree,
+            nullptr,
+            &Register,
+            &Unregister,
+            &NoteText,
+        };
+    }
+
+    OverlayRegistry& GetOverlayRegistry()
+    {
+        static OverlayRegistry registry;
+        return registry;
+    }
+
+    bool HandleOverlayMessage(std::uint32_t type, void* data, std::uint32_t dataLen)
+    {
+        if (type != ModernInventoryAPI::kMessageGetInterface) {
+            return false;
+        }
+        if (!data || dataLen < sizeof(ModernInventoryAPI::InterfaceRequest)) {
+            MI::Log::Warn("Overlay API request with a malformed payload ignored");
+            return true;
+        }
+        auto* req = static_cast<ModernInventoryAPI::InterfaceRequest*>(data);
+        // The newest table the caller understands; newer callers get V2 and check ->version
+        req->result = req->version >= 2 ? static_cast<const void*>(&kInterfaceV2)
+                    : req->version == 1 ? static_cast<const void*>(&kInterfaceV1)
+                                        : nullptr;
+        return true;
+    }
+}
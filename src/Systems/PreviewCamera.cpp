@@ -1,17 +1,18 @@
-﻿#include "PCH.h"
+﻿// Portable: no PCH / RE / Windows includes (also built by the Linux benchmark target).
 #include "ModernInventory/PreviewCamera.h"
+#include "ModernInventory/CameraMath.h"
 #include <algorithm>
 #include <cmath>
 
 namespace MI::Camera
 {
-    PreviewCamera ComputeFullBody(const RE::NiBound& bound,
-                                  unsigned rtWidth,
-                                  unsigned rtHeight,
-                                  float fovYDeg,
-                                  float fitMargin,
-                                  float yawDeg,
-                                  float pitchDeg)
+    PreviewCamera ComputeFullBodyFromRadius(float boundRadius,
+                                            unsigned rtWidth,
+                                            unsigned rtHeight,
+                                            float fovYDeg,
+                                            float fitMargin,
+                                            float yawDeg,
+                                            float pitchDeg)
     {
         PreviewCamera cam{};
         const float fovY = std::clamp(fovYDeg, 20.0f, 90.0f) * (3.1415926535f / 180.0f);
@@ -22,14 +23,17 @@ namespace MI::Camera
         cam.pitchRad = pitch;
 
         // Fit sphere of radius R inside vertical FOV: distance = (R * fitMargin) / sin(FOV/2)
-        const float R = std::max(bound.radius, 0.01f) * fitMargin;
+        const float R = std::max(boundRadius, 0.01f) * fitMargin;
         const float halfF = std::max(fovY * 0.5f, 0.1f);
-        const float dist = R / std::sin(halfF);
+        float sinHalf, cosHalf;
+        Math::SinCos(halfF, sinHalf, cosHalf);
+        const float dist = R / sinHalf;
 
-        // Also consider aspect ratio; ensure horizontal fit if RT is very wide.
+        // Also consider aspect ratio; ensure horizontal fit if RT is very wide. With
+        // t = tan(FOV_x/2) = tan(FOV/2) * aspect, sin(FOV_x/2) = t / sqrt(1 + t^2).
         const float aspect = (rtHeight > 0) ? (static_cast<float>(rtWidth) / static_cast<float>(rtHeight)) : 1.777f;
-        const float fovX = 2.0f * std::atan(std::tan(halfF) * aspect);
-        const float distX = R / std::sin(std::max(fovX * 0.5f, 0.1f));
+        const float tanX = std::max(sinHalf / cosHalf * aspect, 0.10033467f);  // FOV_x/2 >= 0.1 like halfF
+        const float distX = R * std::sqrt(1.0f + tanX * tanX) / tanX;
 
         cam.distance = std::max(dist, distX);
         return cam;
@@ -0,0 +1,159 @@
+#include "PCH.h"
+#include "ModernInventory/PreviewExporter.h"
+#include "ModernInventory/GpuCalls.h"
+#include "ModernInventory/Log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MI
+{
+    bool PreviewExporter::Init(ID3D11Device* device, ID3D11DeviceContext* context, std::uint32_t slots)
+    {
+        m_device = device;
+        m_context = context;
+        m_slots.clear();
+        m_slots.resize((std::max)(slots, 1u));
+        m_next = 0;
+        return m_device && m_context;
+    }
+
+    void PreviewExporter::Shutdown()
+    {
+        m_slots.clear();
+        m_next = 0;
+        m_stagingMem.Set(0);
+        if (m_writer) {
+            m_writer->Drain();
+            m_writer.reset();
+        }
+    }
+
+    bool PreviewExporter::HasPending() const
+    {
+        return std::any_of(m_slots.begin(), m_slots.end(), [](const Slot& s) { return s.busy; });
+    }
+
+    void PreviewExporter::UpdateMemory()
+    {
+        std::int64_t bytes = 0;
+        for (const auto& s : m_slots) {
+            bytes += static_cast<std::int64_t>(s.w) * s.h * 4;
+        }
+        m_stagingMem.Set(bytes);
+    }
+
+    bool PreviewExporter::EnsureSlot(Slot& slot, UINT w, UINT h, DXGI_FORMAT format)
+    {
+        if (slot.staging && slot.w == w && slot.h == h) {
+            D3D11_TEXTURE2D_DESC have{};
+            slot.staging->GetDesc(&have);
+            if (have.Format == format) {
+                return true;
+            }
+        }
+        slot.staging.Reset();
+        slot.w = slot.h = 0;
+
+        D3D11_TEXTURE2D_DESC td{};
+        td.Width = w;
+        td.Height = h;
+        td.MipLevels = 1;
+        td.ArraySize = 1;
+        td.Format = format;
+        td.SampleDesc.Count = 1;
+        td.Usage = D3D11_USAGE_STAGING;
+        td.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+
+        GpuCalls::Count(GpuCall::kCreateTexture2D);
+        if (FAILED(m_device->CreateTexture2D(&td, nullptr, &slot.staging))) {
+            MI::Log::Warn("PreviewExporter: staging texture creation failed");
+            UpdateMemory();
+            return false;
+        }
+        if (!slot.fence) {
+            D3D11_QUERY_DESC qd{};
+            qd.Query = D3D11_QUERY_EVENT;
+            GpuCalls::Count(GpuCall::kCreateQuery);
+            if (FAILED(m_device->CreateQuery(&qd, &slot.fence))) {
+                slot.staging.Reset();
+                UpdateMemory();
+                return false;
+            }
+        }
+        slot.w = w;
+        slot.h = h;
+        UpdateMemory();
+        return true;
+    }
+
+    bool PreviewExporter::Capture(ID3D11Texture2D* src, const D3D11_BOX& box, std::string path, ImageFormat format)
+    {
+        if (!m_device || !m_context || !src || m_slots.empty() || box.right <= box.left || box.bottom <= box.top) {
+            return false;
+        }
+        D3D11_TEXTURE2D_DESC desc{};
+        src->GetDesc(&desc);
+        if (desc.Format != DXGI_FORMAT_R8G8B8A8_UNORM && desc.Format != DXGI_FORMAT_R8G8B8A8_UNORM_SRGB) {
+            MI::Log::Warn("PreviewExporter: unsupported source format");
+            return false;
+        }
+
+        // Slots are used round-robin, so the one after the newest is the oldest
+        const auto index = (m_next + static_cast<std::uint32_t>(std::count_if(m_slots.begin(), m_slots.end(),
+                                                                              [](const Slot& s) { return s.busy; }))) %
+                           static_cast<std::uint32_t>(m_slots.size());
+        auto& slot = m_slots[index];
+        if (slot.busy || !EnsureSlot(slot, box.right - box.left, box.bottom - box.top, desc.Format)) {
+            return false;
+        }
+
+        GpuCalls::Count(GpuCall::kCopySubresourceRegion);
+        m_context->CopySubresourceRegion(slot.staging.Get(), 0, 0, 0, 0, src, 0, &box);
+        m_context->End(slot.fence.Get());
+        slot.busy = true;
+        slot.path = std::move(path);
+        slot.format = format;
+        return true;
+    }
+
+    void PreviewExporter::Poll()
+    {
+        while (!m_slots.empty() && m_slots[m_next].busy) {
+            auto& slot = m_slots[m_next];
+            if (m_context->GetData(slot.fence.Get(), nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK) {
+                return;
+            }
+            // The copy has landed, so the read map never waits on the GPU
+            D3D11_MAPPED_SUBRESOURCE mapped{};
+            GpuCalls::Count(GpuCall::kMap);
+            if (FAILED(m_context->Map(slot.staging.Get(), 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped))) {
+                return;
+            }
+            ImageExporter::Job job;
+            job.width = slot.w;
+            job.height = slot.h;
+            job.format = slot.format;
+            job.path = std::move(slot.path);
+            job.rgba.resize(static_cast<std::size_t>(slot.w) * slot.h * 4u);
+            const auto* in = static_cast<const std::uint8_t*>(mapped.pData);
+            for (UINT y = 0; y < slot.h; ++y) {
+                std::memcpy(job.rgba.data() + static_cast<std::size_t>(y) * slot.w * 4u,
+                            in + static_cast<std::size_t>(y) * mapped.RowPitch, slot.w * 4u);
+            }
+            m_context->Unmap(slot.staging.Get(), 0);
+            slot.busy = false;
+            m_next = (m_next + 1) % static_cast<std::uint32_t>(m_slots.size());
+
+            if (!m_writer) {
+                m_writer = std::make_unique<ImageExporter>(1, 4);
+            }
+            const auto path = job.path;
+            if (m_writer->Submit(std::move(job))) {
+                MI::Log::Info("Exporting preview to " + path);
+            } else {
+                MI::Log::Warn("PreviewExporter: encoder queue full, dropped " + path);
+            }
+        }
+    }
+}
@@ -1,9 +1,50 @@
 ﻿#include "PCH.h"
 #include "ModernInventory/PreviewGraph.h"
 #include "ModernInventory/Player3D.h"
+#include "ModernInventory/PoseBounds.h"
+#include "ModernInventory/REConvert.h"
+
+#include <vector>
 
 namespace MI::PreviewGraph
 {
+    namespace
+    {
+        // CommonLibSSE-NG moved skinInstance behind GetGeometryRuntimeData(); support both layouts.
+        template <class G>
+        RE::NiSkinInstance* GetSkinInstance(G* geo)
+        {
+            if constexpr (requires { geo->GetGeometryRuntimeData().skinInstance; }) {
+                return geo->GetGeometryRuntimeData().skinInstance.get();
+            } else {
+                return geo->skinInstance.get();
+            }
+        }
+
+        // Bone world transforms + bone-space skin bounds of every skinned geometry under root
+        void GatherBones(RE::NiAVObject* root, std::vector<Math::Xform>& boneWorld, std::vector<Math::Sphere>& boneLocal)
+        {
+            boneWorld.clear();
+            boneLocal.clear();
+            RE::BSVisit::TraverseScenegraphGeometries(root, [&](RE::BSGeometry* geo) {
+                auto* skin = geo ? GetSkinInstance(geo) : nullptr;
+                auto* data = skin ? skin->skinData.get() : nullptr;
+                if (!data || !data->boneData || !skin->bones) {
+                    return RE::BSVisit::BSVisitControl::kContinue;
+                }
+                for (std::uint32_t i = 0; i < data->bones; ++i) {
+                    const auto* bone = skin->bones[i];
+                    if (!bone) {
+                        continue;
+                    }
+                    boneWorld.push_back(Convert::ToXform(bone->world));
+                    boneLocal.push_back(Convert::ToSphere(data->boneData[i].bound));
+                }
+                return RE::BSVisit::BSVisitControl::kContinue;
+            });
+        }
+    }
+
     void Sanitize(RE::NiAVObject* root)
     {
         if (!root) {
@@ -28,5 +69,43 @@ namespace MI::PreviewGraph
         Sanitize(cloned);
         return RE::NiPointer<RE::NiAVObject>{ cloned };
     }
-}
 
+    bool ComputePoseBound(RE::NiAVObject* root, RE::NiBound& out)
+    {
+        if (!root) {
+            return false;
+        }
+
+        // Scratch kept across calls so steady-state framing does not allocate.
+        thread_local std::vector<Math::Xform>  boneWorld;
+        thread_local std::vector<Math::Sphere> boneLocal;
+        GatherBones(root, boneWorld, boneLocal);
+
+        Math::Sphere sphere;
+        if (!PoseBounds::Compute(boneWorld, boneLocal, sphere)) {
+            return false;
+        }
+        out = Convert::ToNi(sphere);
+        return true;
+    }
+
+    bool CollectPoseSpheres(RE::NiAVObject* root, std::vector<Math::Sphere>& out)
+    {
+        out.clear();
+        if (!root) {
+            return false;
+        }
+        thread_local std::vector<Math::Xform>  boneWorld;
+        thread_local std::vector<Math::Sphere> boneLocal;
+        GatherBones(root, boneWorld, boneLocal);
+
+        out.reserve(boneWorld.size());
+        for (std::size_t i = 0; i < boneWorld.size(); ++i) {
+            if (boneLocal[i].radius <= 0.0f) {
+                continue;  // bones without skinned vertices
+            }
+            out.push_back({ Math::Apply(boneWorld[i], boneLocal[i].center), boneLocal[i].radius * boneWorld[i].scale });
+        }
+        return !out.empty();
+    }
+}
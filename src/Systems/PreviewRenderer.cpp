@@ -2,10 +2,12 @@
 #include "ModernInventory/PreviewRenderer.h"
 #include "ModernInventory/OffscreenRT.h"
 #include <algorithm>
+#include <cstdio>
 #include "ModernInventory/Player3D.h"
 #include "ModernInventory/PreviewGraph.h"
 #include "ModernInventory/PreviewCamera.h"
 #include "ModernInventory/Config.h"
+#include "ModernInventory/GpuCalls.h"
 #include "ModernInventory/Log.h"
 
 namespace MI {
@@ -33,13 +35,16 @@ void PreviewRenderer::RenderTo(OffscreenRT& rt, ID3D11Texture2D* backBufferTex)
     if (auto* p3d = MI::Player3D::Get()) {
         auto preview = MI::PreviewGraph::BuildFromPlayer();
         if (preview) {
-            const auto& b = preview->worldBound;
+            // Frame the current pose when skin data is available; static bound otherwise.
+            RE::NiBound b = preview->worldBound;
+            MI::PreviewGraph::ComputePoseBound(preview.get(), b);
             const auto& cfg = MI::ConfigSys::Get();
             auto cam = MI::Camera::ComputeFullBody(b, rt.Width(), rt.Height(), cfg.previewFovDeg, cfg.previewFitMargin, cfg.previewYawDeg, cfg.previewPitchDeg);
-            MI::Log::Info(std::string("Preview cam fov=") + std::to_string(cfg.previewFovDeg) +
-                          std::string(" dist=") + std::to_string(cam.distance) +
-                          std::string(" yaw=") + std::to_string(cfg.previewYawDeg) +
-                          std::string(" pitch=") + std::to_string(cfg.previewPitchDeg));
+            // Stack buffer: this runs per frame and must not touch the heap
+            char line[128];
+            std::snprintf(line, sizeof(line), "Preview cam fov=%.2f dist=%.2f yaw=%.2f pitch=%.2f",
+                          cfg.previewFovDeg, cam.distance, cfg.previewYawDeg, cfg.previewPitchDeg);
+            MI::Log::Info(line);
         } else {
             MI::Log::Warn("PreviewGraph clone failed; falling back.");
         }
@@ -66,20 +71,24 @@ void PreviewRenderer::RenderTo(OffscreenRT& rt, ID3D11Texture2D* backBufferTex)
         vp.Height   = static_cast<float>(rt.Height());
         vp.MinDepth = 0.0f;
         vp.MaxDepth = 1.0f;
+        GpuCalls::Count(GpuCall::kRSSetViewports);
         m_ctx->RSSetViewports(1, &vp);
 
         auto* rtv = rt.GetRTV();
         auto* dsv = rt.GetDSV();
+        GpuCalls::Count(GpuCall::kOMSetRenderTargets);
         m_ctx->OMSetRenderTargets(1, &rtv, dsv);
 
         const std::uint32_t rendered = inv3d->Render();
         didEngineRender = (rendered > 0);
 
         // Restore state
+        GpuCalls::Count(GpuCall::kOMSetRenderTargets);
         m_ctx->OMSetRenderTargets(1, &oldRTV, oldDSV);
         if (oldRTV) oldRTV->Release();
         if (oldDSV) oldDSV->Release();
         if (vpCount == 1) {
+            GpuCalls::Count(GpuCall::kRSSetViewports);
             m_ctx->RSSetViewports(1, &oldVP);
         }
     }
@@ -105,6 +114,7 @@ void PreviewRenderer::RenderTo(OffscreenRT& rt, ID3D11Texture2D* backBufferTex)
         ID3D11Resource* dst = nullptr;
         rt.GetRTV()->GetResource(&dst);
         if (dst) {
+            GpuCalls::Count(GpuCall::kCopySubresourceRegion);
             m_ctx->CopySubresourceRegion(dst, 0, 0, 0, 0, backBufferTex, 0, &srcBox);
             dst->Release();
         }
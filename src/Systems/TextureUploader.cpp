@@ -0,0 +1,132 @@
+#include "PCH.h"
+#include "ModernInventory/TextureUploader.h"
+#include "ModernInventory/GpuCalls.h"
+#include "ModernInventory/Log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MI
+{
+    bool TextureUploader::Init(ID3D11Device* device, ID3D11DeviceContext* context, std::uint32_t slots)
+    {
+        m_device = device;
+        m_context = context;
+        m_slotCount = (std::max)(slots, 1u);
+        m_ring.Configure(m_slotCount);
+        return m_device && m_context;
+    }
+
+    void TextureUploader::Shutdown()
+    {
+        m_staging.clear();
+        m_fences.clear();
+        m_ring.Reset();
+        m_w = m_h = 0;
+        m_format = DXGI_FORMAT_UNKNOWN;
+        m_stagingMem.Set(0);
+    }
+
+    bool TextureUploader::EnsureStaging(const D3D11_TEXTURE2D_DESC& dstDesc)
+    {
+        if (dstDesc.Width == m_w && dstDesc.Height == m_h && dstDesc.Format == m_format && !m_staging.empty()) {
+            return true;
+        }
+        // In-flight copies into the old textures finish on their own; start the ring over
+        m_staging.clear();
+        m_fences.clear();
+        m_ring.Reset();
+        m_w = m_h = 0;
+        m_stagingMem.Set(0);
+
+        D3D11_TEXTURE2D_DESC td{};
+        td.Width = dstDesc.Width;
+        td.Height = dstDesc.Height;
+        td.MipLevels = 1;
+        td.ArraySize = 1;
+        td.Format = dstDesc.Format;
+        td.SampleDesc.Count = 1;
+        td.Usage = D3D11_USAGE_STAGING;
+        td.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+        D3D11_QUERY_DESC qd{};
+        qd.Query = D3D11_QUERY_EVENT;
+
+        m_staging.resize(m_slotCount);
+        m_fences.resize(m_slotCount);
+        for (std::uint32_t i = 0; i < m_slotCount; ++i) {
+            GpuCalls::Count(GpuCall::kCreateTexture2D);
+            GpuCalls::Count(GpuCall::kCreateQuery);
+            if (FAILED(m_device->CreateTexture2D(&td, nullptr, &m_staging[i])) ||
+                FAILED(m_device->CreateQuery(&qd, &m_fences[i]))) {
+                MI::Log::Warn("TextureUploader: staging ring creation failed");
+                m_staging.clear();
+                m_fences.clear();
+                return false;
+            }
+        }
+        m_w = dstDesc.Width;
+        m_h = dstDesc.Height;
+        m_format = dstDesc.Format;
+        m_stagingMem.Set(static_cast<std::int64_t>(m_w) * m_h * 4 * m_slotCount);
+        return true;
+    }
+
+    void TextureUploader::Poll()
+    {
+        // Event queries complete in submission order; stop at the first one still pending
+        for (auto slot = m_ring.OldestInFlight(); slot != UploadRing::kNone; slot = m_ring.OldestInFlight()) {
+            if (m_context->GetData(m_fences[slot].Get(), nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK) {
+                break;
+            }
+            m_ring.Complete(m_ring.FenceOf(slot));
+        }
+    }
+
+    bool TextureUploader::Upload(ID3D11Texture2D* dst, const void* pixels, UINT rowPitch, const UploadRing::Rect& region)
+    {
+        if (!m_device || !m_context || !dst || !pixels) {
+            return false;
+        }
+        D3D11_TEXTURE2D_DESC desc{};
+        dst->GetDesc(&desc);
+        if (!EnsureStaging(desc)) {
+            return false;
+        }
+
+        // Clip to the destination; anything outside was never visible
+        UploadRing::Rect r = region;
+        r.w = r.x < m_w ? (std::min)(r.w, m_w - r.x) : 0;
+        r.h = r.y < m_h ? (std::min)(r.h, m_h - r.y) : 0;
+        m_ring.MarkDirty(r);
+
+        Poll();
+        UploadRing::Rect rect;
+        const auto slot = m_ring.Acquire(rect);
+        if (slot == UploadRing::kNone) {
+            return !m_ring.HasDirty();  // true if there was simply nothing to do
+        }
+
+        // The slot's fence has signalled, so this never waits on the GPU
+        D3D11_MAPPED_SUBRESOURCE mapped{};
+        GpuCalls::Count(GpuCall::kMap);
+        if (FAILED(m_context->Map(m_staging[slot].Get(), 0, D3D11_MAP_WRITE, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped))) {
+            m_ring.Abort(slot, rect);
+            return false;
+        }
+        const auto* src = static_cast<const std::uint8_t*>(pixels);
+        auto*       out = static_cast<std::uint8_t*>(mapped.pData);
+        for (UINT y = rect.y; y < rect.y + rect.h; ++y) {
+            std::memcpy(out + static_cast<std::size_t>(y) * mapped.RowPitch + rect.x * 4u,
+                        src + static_cast<std::size_t>(y) * rowPitch + rect.x * 4u, rect.w * 4u);
+        }
+        m_context->Unmap(m_staging[slot].Get(), 0);
+
+        D3D11_BOX box{ rect.x, rect.y, 0, rect.x + rect.w, rect.y + rect.h, 1 };
+        GpuCalls::Count(GpuCall::kCopySubresourceRegion);
+        m_context->CopySubresourceRegion(dst, 0, rect.x, rect.y, 0, m_staging[slot].Get(), 0, &box);
+        m_context->End(m_fences[slot].Get());
+        m_ring.Submit(slot, rect);
+        return true;
+    }
+}
@@ -1,5 +1,11 @@
 #include "PCH.h"
 #include "game/Preview3D.h"
+#include "ModernInventory/Config.h"
+#include "ModernInventory/GpuCalls.h"
+#include "ModernInventory/MemStats.h"
+#include "ModernInventory/PreviewCamera.h"
+#include "ModernInventory/PreviewGraph.h"
+#include "ModernInventory/REConvert.h"
 
 // Choose one of these = 1. Leave the other = 0.
 // Default to UI3D scene manager path.
@@ -34,15 +40,72 @@
 #  endif
 #endif
 #include <cmath>
+#include <cstring>
 
 using Microsoft::WRL::ComPtr;
 
+namespace
+{
+    constexpr float kTwoPi = 6.283185307f;
+
+    // What Preview3D holds, for the MemStats panel / log dump
+    struct PreviewMem
+    {
+        MI::MemCounter& target   = MI::MemStats::Register("Preview3D/target", MI::MemKind::kGpu);
+        MI::MemCounter& atlas    = MI::MemStats::Register("Preview3D/turntableAtlas", MI::MemKind::kGpu);
+        MI::MemCounter& software = MI::MemStats::Register("Preview3D/software", MI::MemKind::kCpu);
+        MI::MemCounter& flat     = MI::MemStats::Register("Preview3D/flatHierarchy", MI::MemKind::kCpu);
+        MI::MemCounter& clone    = MI::MemStats::Register("Preview3D/clone (est.)", MI::MemKind::kEngine);
+        MI::MemCounter& variants = MI::MemStats::Register("Preview3D/hoverVariants (est.)", MI::MemKind::kEngine);
+    };
+
+    PreviewMem& Mem()
+    {
+        static PreviewMem mem;
+        return mem;
+    }
+
+    std::int64_t SoftwareBytes(const MI::SoftRaster::Mesh& mesh, const MI::SoftRaster::Image& image)
+    {
+        return static_cast<std::int64_t>(mesh.positions.capacity() * sizeof(MI::Math::Vec3) +
+                                         mesh.indices.capacity() * sizeof(std::uint32_t) +
+                                         image.rgba.capacity() * sizeof(std::uint32_t) +
+                                         image.depth.capacity() * sizeof(float));
+    }
+
+    // Point a loaded armor model's skin at the variant's bones (matched by name), so it deforms
+    // with the cloned skeleton like the armor the engine attaches on equip
+    void BindSkinTo(RE::NiAVObject* model, RE::NiAVObject* skeleton)
+    {
+        RE::BSVisit::TraverseScenegraphGeometries(model, [&](RE::BSGeometry* geometry) {
+            auto* skin = geometry->GetGeometryRuntimeData().skinInstance.get();
+            if (!skin || !skin->skinData) {
+                return RE::BSVisit::BSVisitControl::kContinue;
+            }
+            for (std::uint32_t i = 0; i < skin->skinData->bones; ++i) {
+                auto* bone = skin->bones[i];
+                if (auto* match = bone ? skeleton->GetObjectByName(bone->name) : nullptr) {
+                    skin->bones[i] = match;
+                    skin->boneWorldTransforms[i] = &match->world;
+                }
+            }
+            skin->rootParent = skeleton;
+            return RE::BSVisit::BSVisitControl::kContinue;
+        });
+    }
+}
+
 void Preview3D::Init(ID3D11Device* device, ID3D11DeviceContext* context)
 {
     if (initialized_) return;
     device_  = device;
     context_ = context;
     initialized_ = (device_ && context_);
+    uploader_.Init(device_, context_);
+    exporter_.Init(device_, context_);
+    if (context_) {
+        context_->QueryInterface(IID_PPV_ARGS(&context1_));  // stays null before Windows 8
+    }
 }
 
 void Preview3D::Shutdown()
@@ -50,7 +113,23 @@ void Preview3D::Shutdown()
     srv_.Reset();
     rtv_.Reset();
     tex_.Reset();
-
+    ReleaseAtlas();
+    turntable_.Configure(0, 0, 0, 0);
+    softRaster_.reset();
+    softMesh_.Clear();
+    uploader_.Shutdown();
+    exporter_.Shutdown();
+    viewList_.clear();
+    views_.SetViews(viewList_);
+    viewImage_ = {};
+    context1_.Reset();
+
+    flat_.Clear();
+    flatNodes_.clear();
+    Mem().target.Set(0);
+    Mem().clone.Set(0);  // the other counters track capacity we still hold
+    ReleaseVariants();
+    variants_.clear();
     cloneRoot_ = nullptr;
     camera_    = nullptr;
     sceneRoot_ = nullptr;
@@ -77,6 +156,7 @@ void Preview3D::CreateTargets()
     srv_.Reset();
     rtv_.Reset();
     tex_.Reset();
+    Mem().target.Set(0);
 
     D3D11_TEXTURE2D_DESC td{};
     td.Width  = width_;
@@ -89,6 +169,7 @@ void Preview3D::CreateTargets()
     td.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
 
     ComPtr<ID3D11Texture2D> tex;
+    MI::GpuCalls::Count(MI::GpuCall::kCreateTexture2D);
     if (FAILED(device_->CreateTexture2D(&td, nullptr, &tex))) {
         return;
     }
@@ -96,6 +177,7 @@ void Preview3D::CreateTargets()
     D3D11_RENDER_TARGET_VIEW_DESC rtvDesc{};
     rtvDesc.Format = td.Format;
     rtvDesc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
+    MI::GpuCalls::Count(MI::GpuCall::kCreateRenderTargetView);
     if (FAILED(device_->CreateRenderTargetView(tex.Get(), &rtvDesc, &rtv_))) {
         return;
     }
@@ -104,11 +186,15 @@ void Preview3D::CreateTargets()
     srvDesc.Format = td.Format;
     srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
     srvDesc.Texture2D.MipLevels = 1;
+    MI::GpuCalls::Count(MI::GpuCall::kCreateShaderResourceView);
     if (FAILED(device_->CreateShaderResourceView(tex.Get(), &srvDesc, &srv_))) {
         return;
     }
 
     tex_ = tex;
+    softDirty_ = true;
+    views_.Invalidate();
+    Mem().target.Set(static_cast<std::int64_t>(width_) * height_ * 4);
 }
 
 void Preview3D::EnsureScene()
@@ -122,50 +208,50 @@ void Preview3D::EnsureScene()
 #if 0
     camera_ = RE::NiCamera::Create();
     if (camera_) {
-        // A simple perspective camera setup—tweak later for framing
-        camera_->frustum.left   = -0.8f;
-        camera_->frustum.right  =  0.8f;
-        camera_->frustum.top    =  1.0f;
-        camera_->frustum.bottom = -1.0f;
-        camera_->frustum.near   =  5.0f;   // push near plane to avoid clipping
-        camera_->frustum.far    = 5000.0f;
-
-        // Position the camera in front of the actor (Z forward in Skyrim is usually "into" screen)
-        camera_->world.translate = RE::NiPoint3{ 0.0f, -150.0f, 10.0f }; // y back, z up
-        camera_->world.rotate = RE::NiMatrix3(); // identity look forward
+        // Frustum and basis come from the orbit state in UpdateCamera
+        needsCameraUpdate_ = true;
     }
 #endif
 
     sceneReady_ = (sceneRoot_ != nullptr);
 }
 
-void Preview3D::BuildFromPlayer()
+void Preview3D::ReleaseClone()
+{
+    ReleaseVariants();
+    if (!cloneRoot_) return;
+    // Detach the clone from our scene
+    if (auto* node = sceneRoot_.get()) {
+        node->DetachChild(cloneRoot_.get());
+    }
+    cloneRoot_ = nullptr;
+    ++cloneGeneration_;  // turntable tiles of the old clone are stale
+    flat_.Clear();
+    flatNodes_.clear();
+    Mem().clone.Set(0);
+}
+
+bool Preview3D::BuildFromPlayer()
 {
     EnsureScene();
-    if (!sceneReady_) return;
+    if (!sceneReady_) return false;
 
     // Clear any previous clone
-    if (cloneRoot_) {
-        // Detach previous clone from our scene
-        if (auto* node = sceneRoot_.get()) {
-            node->DetachChild(cloneRoot_.get());
-        }
-        cloneRoot_ = nullptr;
-    }
+    ReleaseClone();
 
     const auto* pc = RE::PlayerCharacter::GetSingleton();
-    if (!pc) return;
+    if (!pc) return false;
 
     // false => don't compute if not ready; we only need current 3D if present
     auto* player3D = pc->Get3D(false);
     if (!player3D) {
         // Player 3D not ready yet; we'll stay purple this frame
-        return;
+        return false;
     }
 
     // Deep clone the full NiAVObject tree
     auto* clone = player3D->Clone(); // deep copy
-    if (!clone) return;
+    if (!clone) return false;
 
     // Attach clone under our scene root
     if (auto* root = sceneRoot_.get()) {
@@ -173,7 +259,174 @@ void Preview3D::BuildFromPlayer()
     }
 
     cloneRoot_ = RE::NiPointer<RE::NiAVObject>{ clone };
-    needsCameraUpdate_ = true;
+    ++cloneGeneration_;
+
+    // Move the clone's root to the preview origin (it keeps the player's cell placement
+    // otherwise), then mirror it; one linear pass refreshes every world transform.
+    const auto placedWorld = MI::Convert::ToXform(clone->world);
+    clone->local.translate = RE::NiPoint3{};
+    FlattenClone();
+    SyncTransforms();
+
+    // Frame the actual pose (raised weapons, capes, creature races), not the static bound.
+    // The copied worldBound is still at the player's placement: carry it along with the root.
+    RE::NiBound bound = clone->worldBound;
+    if (flat_.Size() > 0) {
+        const auto moved = MI::Math::Compose(flat_.World(0), MI::Math::Inverse(placedWorld));
+        bound.center = MI::Convert::ToNi(MI::Math::Apply(moved, MI::Convert::ToVec3(bound.center)));
+        bound.radius *= moved.scale;
+    }
+    MI::PreviewGraph::ComputePoseBound(clone, bound);
+    const auto& cfg = MI::ConfigSys::Get();
+    const auto cam = MI::Camera::ComputeFullBody(bound, width_, height_, cfg.previewFovDeg,
+                                                 cfg.previewFitMargin, cfg.previewYawDeg, cfg.previewPitchDeg);
+    target_      = bound.center;
+    fitDistance_ = (std::max)(cam.distance, 1.0f);  // SetZoom divides by it
+    fovY_        = cam.fovYRad;
+    ApplyZoom();  // keeps the user's zoom, within the same limits as SetZoom
+
+    // Silhouette for the software fallback: one low-poly sphere per skinned bone bound
+    softMesh_.Clear();
+    thread_local std::vector<MI::Math::Sphere> spheres;
+    if (MI::PreviewGraph::CollectPoseSpheres(clone, spheres)) {
+        for (const auto& s : spheres) {
+            softMesh_.AddSphere(s);
+        }
+    }
+    softDirty_ = true;
+    Mem().software.Set(SoftwareBytes(softMesh_, softImage_));
+    return true;
+}
+
+bool Preview3D::BuildVariant(std::uint32_t slot, RE::TESObjectARMO* armor)
+{
+    if (slot >= variants_.size()) {
+        variants_.resize(slot + 1);
+    }
+    ReleaseVariant(slot);  // the cache evicted whatever was here
+
+    auto* pc = RE::PlayerCharacter::GetSingleton();
+    const auto* race = pc ? pc->GetRace() : nullptr;
+    const auto* npc = pc ? pc->GetActorBase() : nullptr;
+    if (!cloneRoot_ || !sceneRoot_ || !armor || !race || !npc) return false;
+
+    // Copy of the clone: already at the preview origin with synced transforms, so a hover
+    // costs one clone + the item's models instead of a rebuild from the player
+    RE::NiPointer<RE::NiAVObject> variant{ cloneRoot_->Clone() };
+    auto* root = variant ? variant->AsNode() : nullptr;
+    if (!root) return false;
+
+    // Hide what the player wears in the slots the item covers (biped object i is slot bit i)
+    const auto slots = static_cast<std::uint32_t>(armor->GetSlotMask());
+    if (const auto biped = pc->GetBiped(false)) {
+        for (std::uint32_t i = 0; i < 32; ++i) {
+            const auto* part = (slots & (1u << i)) ? biped->objects[i].partClone.get() : nullptr;
+            if (auto* node = part ? root->GetObjectByName(part->name) : nullptr) {
+                node->SetAppCulled(true);
+            }
+        }
+    }
+
+    // Attach the item's models for the player's race and sex (the loaded model is shared with
+    // the model cache, so attach a copy)
+    const auto sex = npc->GetSex() == RE::SEX::kFemale ? 1 : 0;
+    bool attached = false;
+    for (auto* addon : armor->armorAddons) {
+        const char* path = addon && addon->HasRace(race) ? addon->bipedModels[sex].GetModel() : nullptr;
+        RE::NiPointer<RE::NiNode> model;
+        if (!path || !*path || RE::BSModelDB::Demand(path, model, RE::BSModelDB::DBTraits::ArgsType{}) !=
+                                   RE::BSResource::ErrorCode::kNone || !model) {
+            continue;
+        }
+        auto* part = model->Clone();
+        if (!part) continue;
+        BindSkinTo(part, root);
+        root->AttachChild(part, true);
+        attached = true;
+    }
+    if (!attached) return false;
+
+    RE::NiUpdateData update{};
+    root->Update(update);
+    root->SetAppCulled(true);  // until ShowVariant
+    sceneRoot_->AttachChild(root, true);
+    variants_[slot] = variant;
+    const auto built = std::count_if(variants_.begin(), variants_.end(), [](const auto& v) { return v != nullptr; });
+    Mem().variants.Set(static_cast<std::int64_t>(built * flatNodes_.size() * sizeof(RE::NiNode)));
+    return true;
+}
+
+void Preview3D::ShowVariant(std::uint32_t slot)
+{
+    auto* shown = slot < variants_.size() ? variants_[slot].get() : nullptr;  // failed build: the clone
+    const auto next = shown ? slot : kNoVariant;
+    if (next == shownVariant_) return;
+    if (shownVariant_ != kNoVariant) {
+        variants_[shownVariant_]->SetAppCulled(true);
+    }
+    if (cloneRoot_) {
+        cloneRoot_->SetAppCulled(shown != nullptr);
+    }
+    if (shown) {
+        shown->SetAppCulled(false);
+    }
+    shownVariant_ = next;
+    ++variantSerial_;
+}
+
+void Preview3D::ReleaseVariant(std::uint32_t slot)
+{
+    auto& variant = variants_[slot];
+    if (!variant) return;
+    if (slot == shownVariant_) {
+        ShowVariant(kNoVariant);
+    }
+    if (auto* node = sceneRoot_.get()) {
+        node->DetachChild(variant.get());
+    }
+    variant = nullptr;
+}
+
+void Preview3D::ReleaseVariants()
+{
+    for (std::uint32_t i = 0; i < variants_.size(); ++i) {
+        ReleaseVariant(i);
+    }
+    Mem().variants.Set(0);
+}
+
+void Preview3D::FlattenClone()
+{
+    flat_.Clear();
+    flatNodes_.clear();
+    if (!cloneRoot_) return;
+
+    // Breadth-first walk: parents precede children and each depth level stays contiguous.
+    // The clone hangs off sceneRoot_, so the mirror's root carries the scene root's world
+    // transform (NiNode::Update composes it the same way).
+    const auto parentWorld = sceneRoot_ ? MI::Convert::ToXform(sceneRoot_->world) : MI::Math::Xform{};
+    flatNodes_.push_back(cloneRoot_.get());
+    flat_.Add(MI::FlatHierarchy::kNoParent, MI::Math::Compose(parentWorld, MI::Convert::ToXform(cloneRoot_->local)));
+    for (std::uint32_t i = 0; i < flatNodes_.size(); ++i) {
+        auto* node = flatNodes_[i]->AsNode();
+        if (!node) continue;
+        for (auto& child : node->GetChildren()) {
+            if (!child) continue;
+            flatNodes_.push_back(child.get());
+            flat_.Add(i, MI::Convert::ToXform(child->local));
+        }
+    }
+    Mem().flat.Set(static_cast<std::int64_t>(flat_.Bytes() + flatNodes_.capacity() * sizeof(RE::NiAVObject*)));
+    // Clone() copies every node; shared geometry/texture data isn't ours, so count nodes only
+    Mem().clone.Set(static_cast<std::int64_t>(flatNodes_.size() * sizeof(RE::NiNode)));
+}
+
+void Preview3D::SyncTransforms()
+{
+    if (flat_.Update() == 0) return;
+    flat_.ForEachUpdated([&](std::uint32_t i, const MI::Math::Xform& world) {
+        MI::Convert::ToNi(world, flatNodes_[i]->world);
+    });
 }
 
 void Preview3D::ClearToColor(float r, float g, float b, float a)
@@ -183,25 +436,21 @@ void Preview3D::ClearToColor(float r, float g, float b, float a)
     vp.Width  = static_cast<float>(width_);
     vp.Height = static_cast<float>(height_);
     vp.MinDepth = 0.0f; vp.MaxDepth = 1.0f;
+    MI::GpuCalls::Count(MI::GpuCall::kRSSetViewports);
     context_->RSSetViewports(1, &vp);
 
     ID3D11RenderTargetView* rtvs[] = { rtv_.Get() };
+    MI::GpuCalls::Count(MI::GpuCall::kOMSetRenderTargets);
     context_->OMSetRenderTargets(1, rtvs, nullptr);
     const float col[4] = { r, g, b, a };
+    MI::GpuCalls::Count(MI::GpuCall::kClearRenderTargetView);
     context_->ClearRenderTargetView(rtv_.Get(), col);
 }
 
-// Simple yaw(Z) + pitch(X) orbit camera around origin; computes camera position only.
+// Simple yaw(Z) + pitch(X) orbit camera offset from the target; computes camera position only.
 static inline RE::NiPoint3 ComputeOrbitPos(float yaw, float pitch, float distance)
 {
-    const float cp = std::cos(pitch);
-    const float sp = std::sin(pitch);
-    const float sy = std::sin(yaw);
-    const float cy = std::cos(yaw);
-
-    // Forward vector given yaw/pitch (Y-forward convention)
-    const RE::NiPoint3 forward{ sy * cp, cy * cp, sp };
-    return RE::NiPoint3{ -forward.x * distance, -forward.y * distance, -forward.z * distance };
+    return MI::Convert::ToNi(MI::Math::OrbitOffset(yaw, pitch, distance));
 }
 
 void Preview3D::UpdateCamera()
@@ -210,14 +459,17 @@ void Preview3D::UpdateCamera()
         return;
     }
 
-    const RE::NiPoint3 pos = ComputeOrbitPos(yaw_, pitch_, distance_);
-    camera_->world.translate = pos;
-    // Keep identity rotation for now; the engine UI renderer can compute view from camera node
-    // or we will extend this in the next patch to build a full basis.
-    // camera_->world.rotate = RE::NiMatrix3();
+    const float aspect = height_ ? static_cast<float>(width_) / static_cast<float>(height_) : 1.0f;
+    ApplyCamera(MI::Math::OrbitCamera({ MI::Convert::ToVec3(target_), yaw_, pitch_, distance_ }), aspect);
+    needsCameraUpdate_ = false;
+}
 
+// NiCamera looks down its world X column with Y up and Z right, which is what OrbitCamera builds
+void Preview3D::ApplyCamera(const MI::Math::Xform& world, float aspect)
+{
+    MI::Convert::ToNi(world, camera_->world);
+    MI::Convert::ToNi(MI::Math::Perspective(fovY_, aspect, kNearZ, kFarZ), camera_->frustum);
     camera_->UpdateWorldBound();
-    needsCameraUpdate_ = false;
 }
 
 void Preview3D::Render()
@@ -227,11 +479,27 @@ void Preview3D::Render()
     // If we don't have a scene/clone yet, show purple as a fallback
     if (!sceneReady_ || !cloneRoot_) {
         ClearToColor(1.f, 0.f, 1.f, 1.f); // purple fallback
+        views_.Invalidate();
+        return;
+    }
+
+    // Turntable cache: bake tiles while idle; skip the live render when the atlas covers yaw_
+    const bool dragging = yawChanged_;
+    yawChanged_ = false;
+    if (UpdateMultiView()) {
+        return;
+    }
+    // Atlas tiles show the clone, not a hovered variant
+    if (shownVariant_ == kNoVariant && UpdateTurntable(dragging)) {
         return;
     }
 
-    // Try engine/UI path first; if unavailable, fall back to slate clear.
+    // Try engine/UI path first; if unavailable, draw the CPU silhouette, then slate clear.
     if (TryRenderEngineScene()) {
+        softDirty_ = true; // tex_ now holds the engine frame
+        return;
+    }
+    if (RenderSoftware()) {
         return;
     }
     // Placeholder clear to dark slate (indicates scene path is running):
@@ -246,28 +514,221 @@ void Preview3D::Render()
     // For stability, we keep the purple fallback when clone isn't ready.
 }
 
-bool Preview3D::TryRenderEngineScene()
+bool Preview3D::RenderSoftware()
+{
+    if (!MI::ConfigSys::Get().softwareFallback || softMesh_.indices.empty() || !tex_) {
+        return false;
+    }
+    // The silhouette only changes with the clone, camera or size; otherwise tex_ still holds
+    // it, or the last upload is waiting for a free staging slot
+    if (!softDirty_) {
+        if (uploader_.HasPending()) {
+            uploader_.Upload(tex_.Get(), softImage_.rgba.data(), softImage_.stride * 4u, {});
+        }
+        return true;
+    }
+    if (!softRaster_) {
+        softRaster_ = std::make_unique<MI::SoftRaster::Rasterizer>();
+    }
+    if (softImage_.width != width_ || softImage_.height != height_) {
+        softImage_.Resize(width_, height_);
+        Mem().software.Set(SoftwareBytes(softMesh_, softImage_));
+    }
+
+    MI::SoftRaster::View view;
+    view.target  = MI::Convert::ToVec3(target_);
+    view.eye     = MI::Convert::ToVec3(target_ + ComputeOrbitPos(yaw_, pitch_, distance_));
+    view.fovYDeg = MI::ConfigSys::Get().previewFovDeg;
+
+    softImage_.Clear(0); // transparent, like the engine path's pre-clear
+    softRaster_->Draw(softMesh_, view, MI::SoftRaster::Rgba(200, 180, 160), softImage_);
+
+    uploader_.Upload(tex_.Get(), softImage_.rgba.data(), softImage_.stride * 4u, { 0, 0, width_, height_ });
+    softDirty_ = false;
+    return true;
+}
+
+// Side-by-side views of the clone: view i orbits from yaw_ by i/N of a turn. All of them are
+// tiles of tex_ drawn in one pass, and only tiles whose camera or clone changed are redrawn.
+bool Preview3D::UpdateMultiView()
+{
+    const int count = MI::ConfigSys::Get().previewViews;
+    if (count <= 1) {
+        if (views_.Count()) {
+            viewList_.clear();
+            views_.SetViews(viewList_);
+        }
+        return false;
+    }
+
+    viewList_.clear();
+    viewOrbits_.clear();
+    for (int i = 0; i < count; ++i) {
+        viewList_.push_back({ 0, yaw_ + kTwoPi * static_cast<float>(i) / static_cast<float>(count), pitch_, distance_ });
+        viewOrbits_.push_back({ MI::Convert::ToVec3(target_), viewList_.back().yawRad, pitch_, distance_ });
+    }
+    // Every tile's camera in one batch; DrawView picks its own
+    viewCameras_.resize(viewOrbits_.size());
+    MI::Math::OrbitCameras(viewOrbits_, viewCameras_);
+    views_.SetTargetSize(width_, height_);
+    views_.SetVariantGeneration(0, cloneGeneration_ + variantSerial_);
+    views_.SetViews(viewList_);
+    if (uploader_.HasPending()) {
+        uploader_.Upload(tex_.Get(), softImage_.rgba.data(), softImage_.stride * 4u, {});  // software tiles
+    }
+    views_.Render(*this);
+    softDirty_ = true;  // softImage_ holds tiles now, not the single view
+    return true;
+}
+
+bool Preview3D::BeginPass()
+{
+    if (!rtv_) {
+        return false;
+    }
+    ID3D11RenderTargetView* rtvs[] = { rtv_.Get() };
+    MI::GpuCalls::Count(MI::GpuCall::kOMSetRenderTargets);
+    context_->OMSetRenderTargets(1, rtvs, nullptr);
+    return true;
+}
+
+void Preview3D::ClearTarget()
+{
+    const float clear[4] = { 0.f, 0.f, 0.f, 0.f };
+    MI::GpuCalls::Count(MI::GpuCall::kClearRenderTargetView);
+    context_->ClearRenderTargetView(rtv_.Get(), clear);
+}
+
+bool Preview3D::ClearRect(const MI::ViewRect& rect)
+{
+    if (!context1_) {
+        return false;  // the pass clears the whole target instead
+    }
+    const float clear[4] = { 0.f, 0.f, 0.f, 0.f };
+    const D3D11_RECT r{ static_cast<LONG>(rect.x), static_cast<LONG>(rect.y), static_cast<LONG>(rect.x + rect.w),
+                        static_cast<LONG>(rect.y + rect.h) };
+    MI::GpuCalls::Count(MI::GpuCall::kClearRenderTargetView);
+    context1_->ClearView(rtv_.Get(), clear, &r, 1);
+    return true;
+}
+
+bool Preview3D::DrawView(const MI::ViewRect& rect, const MI::PreviewView& view)
+{
+    if (view.variant != 0) {
+        return true;  // only the player's clone exists; the tile stays cleared until a variant does
+    }
+
+    // Render with the view's camera (batched in UpdateMultiView), then restore the interactive one
+    const auto it = std::find(viewList_.begin(), viewList_.end(), view);
+    const auto world = it != viewList_.end() ?
+                           viewCameras_[static_cast<std::size_t>(it - viewList_.begin())] :
+                           MI::Math::OrbitCamera({ MI::Convert::ToVec3(target_), view.yawRad, view.pitchRad, view.distance });
+    if (camera_) {
+        ApplyCamera(world, rect.h ? static_cast<float>(rect.w) / static_cast<float>(rect.h) : 1.0f);
+    }
+    needsCameraUpdate_ = false;
+
+    D3D11_VIEWPORT vp{};
+    vp.TopLeftX = static_cast<float>(rect.x);
+    vp.TopLeftY = static_cast<float>(rect.y);
+    vp.Width    = static_cast<float>(rect.w);
+    vp.Height   = static_cast<float>(rect.h);
+    vp.MinDepth = 0.0f; vp.MaxDepth = 1.0f;
+    MI::GpuCalls::Count(MI::GpuCall::kRSSetViewports);
+    context_->RSSetViewports(1, &vp);
+    const bool ok = DrawScene() || DrawViewSoftware(rect, world.pos);
+
+    needsCameraUpdate_ = true;
+    return ok;
+}
+
+// One tile of the CPU silhouette: rasterized at tile size, copied into softImage_ (the whole
+// target) and uploaded as that region only
+bool Preview3D::DrawViewSoftware(const MI::ViewRect& rect, const MI::Math::Vec3& eye)
+{
+    if (!tex_) {
+        return false;
+    }
+    if (softImage_.width != width_ || softImage_.height != height_) {
+        softImage_.Resize(width_, height_);
+    }
+    if (!RasterizeView(rect.w, rect.h, eye)) {
+        return false;
+    }
+    for (std::uint32_t row = 0; row < rect.h; ++row) {
+        std::memcpy(&softImage_.rgba[(rect.y + row) * softImage_.stride + rect.x], &viewImage_.rgba[row * viewImage_.stride],
+                    rect.w * sizeof(std::uint32_t));
+    }
+    uploader_.Upload(tex_.Get(), softImage_.rgba.data(), softImage_.stride * 4u, { rect.x, rect.y, rect.w, rect.h });
+    return true;
+}
+
+// The CPU silhouette seen from eye, w x h, into viewImage_ (multi-view tiles, turntable frames)
+bool Preview3D::RasterizeView(std::uint32_t w, std::uint32_t h, const MI::Math::Vec3& eye)
 {
-    if (!device_ || !context_ || !rtv_ || !sceneRoot_ || !camera_) {
+    if (!MI::ConfigSys::Get().softwareFallback || softMesh_.indices.empty()) {
         return false;
     }
+    if (!softRaster_) {
+        softRaster_ = std::make_unique<MI::SoftRaster::Rasterizer>();
+    }
+    if (viewImage_.width != w || viewImage_.height != h) {
+        viewImage_.Resize(w, h);
+    }
+    Mem().software.Set(SoftwareBytes(softMesh_, softImage_) +
+                       static_cast<std::int64_t>(viewImage_.rgba.capacity() * sizeof(std::uint32_t) +
+                                                 viewImage_.depth.capacity() * sizeof(float)));
+
+    MI::SoftRaster::View view;
+    view.target  = MI::Convert::ToVec3(target_);
+    view.eye     = eye;
+    view.fovYDeg = MI::ConfigSys::Get().previewFovDeg;
+
+    viewImage_.Clear(0);
+    softRaster_->Draw(softMesh_, view, MI::SoftRaster::Rgba(200, 180, 160), viewImage_);
+    return true;
+}
 
-    // Bind our RTV + viewport for offscreen pass
+bool Preview3D::TryRenderEngineScene()
+{
     D3D11_VIEWPORT vp{};
     vp.TopLeftX = 0.0f; vp.TopLeftY = 0.0f;
     vp.Width    = static_cast<float>(width_);
     vp.Height   = static_cast<float>(height_);
     vp.MinDepth = 0.0f; vp.MaxDepth = 1.0f;
-    ID3D11RenderTargetView* rt = rtv_.Get();
-    context_->OMSetRenderTargets(1, &rt, nullptr);
+    return RenderSceneTo(rtv_.Get(), vp, true);
+}
+
+bool Preview3D::RenderSceneTo(ID3D11RenderTargetView* rtv, const D3D11_VIEWPORT& vp, bool clear)
+{
+    if (!device_ || !context_ || !rtv || !sceneRoot_ || !camera_) {
+        return false;
+    }
+
+    // Bind target + viewport for offscreen pass
+    MI::GpuCalls::Count(MI::GpuCall::kOMSetRenderTargets);
+    context_->OMSetRenderTargets(1, &rtv, nullptr);
+    MI::GpuCalls::Count(MI::GpuCall::kRSSetViewports);
     context_->RSSetViewports(1, &vp);
 
     // Clear to transparent (lets ENB/compositors behave)
-    const float preClear[4] = { 0.f, 0.f, 0.f, 0.f };
-    context_->ClearRenderTargetView(rtv_.Get(), preClear);
+    if (clear) {
+        const float preClear[4] = { 0.f, 0.f, 0.f, 0.f };
+        MI::GpuCalls::Count(MI::GpuCall::kClearRenderTargetView);
+        context_->ClearRenderTargetView(rtv, preClear);
+    }
+    return DrawScene();
+}
 
-    // Ensure transforms are current (skipped: Update requires NiUpdateData variant)
+bool Preview3D::DrawScene()
+{
+    if (!sceneRoot_ || !camera_) {
+        return false;
+    }
+
+    // Ensure transforms are current via the flattened mirror (no NiUpdateData walk);
     // UpdateCamera applies latest orbit state.
+    SyncTransforms();
     UpdateCamera();
 
     // Attach camera temporarily to our scene root (if not already)
@@ -338,3 +799,153 @@ bool Preview3D::TryRenderEngineScene()
 
     return rendered;
 }
+
+bool Preview3D::CreateAtlas()
+{
+    D3D11_TEXTURE2D_DESC td{};
+    td.Width  = turntable_.AtlasWidth();
+    td.Height = turntable_.AtlasHeight();
+    td.MipLevels = 1;
+    td.ArraySize = 1;
+    td.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    td.SampleDesc.Count = 1;
+    td.Usage = D3D11_USAGE_DEFAULT;
+    td.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+
+    // Counted as attempted; a failure part-way releases whatever was created
+    MI::GpuCalls::Count(MI::GpuCall::kCreateTexture2D);
+    MI::GpuCalls::Count(MI::GpuCall::kCreateRenderTargetView);
+    MI::GpuCalls::Count(MI::GpuCall::kCreateShaderResourceView);
+    if (FAILED(device_->CreateTexture2D(&td, nullptr, &atlasTex_)) ||
+        FAILED(device_->CreateRenderTargetView(atlasTex_.Get(), nullptr, &atlasRtv_)) ||
+        FAILED(device_->CreateShaderResourceView(atlasTex_.Get(), nullptr, &atlasSrv_))) {
+        ReleaseAtlas();
+        return false;
+    }
+    Mem().atlas.Set(static_cast<std::int64_t>(td.Width) * td.Height * 4);
+    return true;
+}
+
+void Preview3D::ReleaseAtlas()
+{
+    atlasSrv_.Reset();
+    atlasRtv_.Reset();
+    atlasTex_.Reset();
+    Mem().atlas.Set(0);
+}
+
+bool Preview3D::UpdateTurntable(bool dragging)
+{
+    const auto& cfg = MI::ConfigSys::Get();
+    if (cfg.turntableFrames <= 0) {
+        if (turntable_.Enabled()) {
+            ReleaseAtlas();
+            turntable_.Configure(0, 0, 0, 0);
+        }
+        return false;
+    }
+
+    // (Re)layout the atlas when the frame count or pane size changes
+    const auto frames = static_cast<std::uint32_t>(cfg.turntableFrames);
+    const auto tile = turntable_.TileOf(0);
+    if (!atlasTex_ || turntable_.Frames() != frames || tile.w != width_ || tile.h != height_) {
+        ReleaseAtlas();
+        if (!turntable_.Configure(frames, width_, height_, D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION) || !CreateAtlas()) {
+            turntable_.Configure(0, 0, 0, 0);
+            return false;
+        }
+    }
+
+    // Any change to the outfit or camera settings makes every baked tile stale
+    const MI::TurntableCache::Key key{ cloneGeneration_, width_, height_, cfg.previewFovDeg, pitch_, distance_ };
+    if (turntable_.Validate(key)) {
+        const float clear[4] = { 0.f, 0.f, 0.f, 0.f };
+        MI::GpuCalls::Count(MI::GpuCall::kClearRenderTargetView);
+        context_->ClearRenderTargetView(atlasRtv_.Get(), clear);
+    }
+
+    // Spread baking across idle frames; never while the user is dragging
+    if (!dragging) {
+        for (int i = 0; i < cfg.turntableBakesPerFrame; ++i) {
+            const auto frame = turntable_.NextToBake(yaw_);
+            if (frame == MI::TurntableCache::kNone || !BakeTurntableFrame(frame)) {
+                break;
+            }
+        }
+    }
+
+    return turntable_.Lookup(yaw_, cfg.turntableBlend).frameA != MI::TurntableCache::kNone;
+}
+
+bool Preview3D::BakeTurntableFrame(std::uint32_t frame)
+{
+    const auto tile = turntable_.TileOf(frame);
+    D3D11_VIEWPORT vp{};
+    vp.TopLeftX = static_cast<float>(tile.x);
+    vp.TopLeftY = static_cast<float>(tile.y);
+    vp.Width    = static_cast<float>(tile.w);
+    vp.Height   = static_cast<float>(tile.h);
+    vp.MinDepth = 0.0f; vp.MaxDepth = 1.0f;
+
+    // Render the tile at its own yaw, then restore the interactive camera
+    const float savedYaw = yaw_;
+    yaw_ = turntable_.FrameYaw(frame);
+    needsCameraUpdate_ = true;
+    bool ok = RenderSceneTo(atlasRtv_.Get(), vp, false);
+    yaw_ = savedYaw;
+    needsCameraUpdate_ = true;
+
+    // No engine path (camera creation is still disabled): bake the CPU silhouette instead, so
+    // the atlas fills and rotating stays a tile lookup
+    if (!ok) {
+        const auto eye = MI::Math::OrbitCamera({ MI::Convert::ToVec3(target_), turntable_.FrameYaw(frame), pitch_, distance_ }).pos;
+        if (RasterizeView(tile.w, tile.h, eye)) {
+            const D3D11_BOX box{ tile.x, tile.y, 0, tile.x + tile.w, tile.y + tile.h, 1 };
+            MI::GpuCalls::Count(MI::GpuCall::kUpdateSubresource);
+            context_->UpdateSubresource(atlasTex_.Get(), 0, &box, viewImage_.rgba.data(), viewImage_.stride * 4u, 0);
+            ok = true;
+        }
+    }
+
+    if (ok) {
+        turntable_.MarkBaked(frame);
+    }
+    return ok;
+}
+
+bool Preview3D::GetTurntableView(TurntableView& out) const
+{
+    if (!atlasSrv_ || !turntable_.Enabled() || views_.Count() > 1) {
+        return false;
+    }
+    const auto sample = turntable_.Lookup(yaw_, MI::ConfigSys::Get().turntableBlend);
+    if (sample.frameA == MI::TurntableCache::kNone) {
+        return false;
+    }
+    out.srv = atlasSrv_.Get();
+    out.a = turntable_.UVOf(sample.frameA);
+    out.b = (sample.frameB != MI::TurntableCache::kNone) ? turntable_.UVOf(sample.frameB) : out.a;
+    out.blend = sample.blend;
+    return true;
+}
+
+bool Preview3D::RequestExport(std::string path, MI::ImageFormat format)
+{
+    if (!initialized_) {
+        return false;
+    }
+    // Match the panel: the baked tile nearest the current yaw when the turntable is live
+    if (atlasTex_ && turntable_.Enabled() && views_.Count() <= 1) {
+        const auto sample = turntable_.Lookup(yaw_, false);
+        if (sample.frameA != MI::TurntableCache::kNone) {
+            const auto tile = turntable_.TileOf(sample.frameA);
+            const D3D11_BOX box{ tile.x, tile.y, 0, tile.x + tile.w, tile.y + tile.h, 1 };
+            return exporter_.Capture(atlasTex_.Get(), box, std::move(path), format);
+        }
+    }
+    if (!tex_ || width_ == 0 || height_ == 0) {
+        return false;
+    }
+    const D3D11_BOX box{ 0, 0, 0, width_, height_, 1 };
+    return exporter_.Capture(tex_.Get(), box, std::move(path), format);
+}
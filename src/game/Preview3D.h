@@ -2,10 +2,22 @@
 #include "PCH.h"
 
 #include <d3d11.h>
+#include <d3d11_1.h>
 #include <wrl/client.h>
 #include <algorithm>
-
-class Preview3D {
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "ModernInventory/CameraMath.h"
+#include "ModernInventory/FlatHierarchy.h"
+#include "ModernInventory/MultiView.h"
+#include "ModernInventory/PreviewExporter.h"
+#include "ModernInventory/SoftRaster.h"
+#include "ModernInventory/TextureUploader.h"
+#include "ModernInventory/Turntable.h"
+
+class Preview3D : private MI::IMultiViewBackend {
 public:
     static Preview3D& Get() {
         static Preview3D inst;
@@ -18,8 +30,19 @@ public:
     // Resize the offscreen texture (call every frame with current pane size)
     void EnsureSize(UINT width, UINT height);
 
-    // Build a static "paperdoll" from current player 3D (call on Inventory open, or equip change)
-    void BuildFromPlayer();
+    // Build a static "paperdoll" from current player 3D (call on Inventory open, or equip change);
+    // false if the player has no 3D yet (the previous clone is dropped either way)
+    bool BuildFromPlayer();
+    // Detach and free the clone (unused hotkey prebuild, idle eviction); its variants go too
+    void ReleaseClone();
+
+    // Hover preview: copies of the clone with one armor piece swapped in, kept by slot (the
+    // controller's VariantCache assigns slots). false if the item has no model for the
+    // player's race; the slot then shows the clone. ShowVariant(kNoVariant) shows the clone.
+    static constexpr std::uint32_t kNoVariant = 0xFFFFFFFF;
+    bool BuildVariant(std::uint32_t slot, RE::TESObjectARMO* armor);
+    void ShowVariant(std::uint32_t slot);
+    void ReleaseVariants();
 
     // Render scene into our RTV (safe fallback to purple)
     void Render();
@@ -27,29 +50,84 @@ public:
     // ImGui uses SRV as texture id (DX11 backend)
     ID3D11ShaderResourceView* GetSRV() const { return srv_.Get(); }
 
+    // True once a player clone is in the scene (Render draws it instead of the purple fallback)
+    bool HasClone() const { return sceneReady_ && cloneRoot_; }
+
+    // Turntable atlas tiles covering the current yaw (b/blend used when blending neighbours).
+    struct TurntableView
+    {
+        ID3D11ShaderResourceView*    srv = nullptr;
+        MI::TurntableCache::UVRect   a{};
+        MI::TurntableCache::UVRect   b{};
+        float                        blend = 0.0f;
+    };
+    // True when the panel should draw atlas tiles instead of GetSRV() this frame.
+    bool GetTurntableView(TurntableView& out) const;
+
+    // Save what the panel currently shows (atlas tile or tex_) to path; the readback and
+    // encode happen over the next frames. False if no image yet or the export ring is busy.
+    bool RequestExport(std::string path, MI::ImageFormat format);
+    void PollExports() { exporter_.Poll(); }  // once per frame
+
     // Cleanup
     void Shutdown();
 
     // NEW: call when inventory opens (or right before first frame)
-    void RebuildNow() { BuildFromPlayer(); }
+    bool RebuildNow() { return BuildFromPlayer(); }
 
     // NEW: camera controls (can be bound to hotkeys later)
-    void SetYaw(float radians)   { yaw_ = radians; needsCameraUpdate_ = true; }
-    void SetPitch(float radians) { pitch_ = std::clamp(radians, -1.2f, 1.2f); needsCameraUpdate_ = true; }
-    void SetZoom(float dist)     { distance_ = std::clamp(dist, 60.0f, 220.0f); needsCameraUpdate_ = true; }
+    // Yaw is kept in [-pi, pi]; a non-finite angle (e.g. from a bad mouse delta) is ignored
+    void SetYaw(float radians)
+    {
+        if (!std::isfinite(radians)) return;
+        yaw_ = std::remainder(radians, 6.283185307f);
+        yawChanged_ = true;
+        needsCameraUpdate_ = softDirty_ = true;
+    }
+    float Yaw() const            { return yaw_; }
+    void SetPitch(float radians) { pitch_ = std::clamp(radians, -1.2f, 1.2f); needsCameraUpdate_ = softDirty_ = true; }
+    // Zoom is kept as a factor of the full-body fit, so a rebuild (equip, new pose) reframes
+    // the clone without undoing it; the distance stays within [60, 220]
+    void SetZoom(float dist)
+    {
+        zoom_ = std::clamp(dist, kMinDistance, kMaxDistance) / fitDistance_;
+        ApplyZoom();
+    }
 
 private:
     void CreateTargets();
     void EnsureScene();     // create scene/camera once
     void ClearToColor(float r, float g, float b, float a = 1.0f);
     void UpdateCamera();          // NEW: position/orient camera from yaw/pitch/distance
+    void ApplyZoom() { distance_ = std::clamp(fitDistance_ * zoom_, kMinDistance, kMaxDistance); needsCameraUpdate_ = softDirty_ = true; }
     bool TryRenderEngineScene();  // NEW: attempt engine UI path; returns true if rendered
+    bool RenderSceneTo(ID3D11RenderTargetView* rtv, const D3D11_VIEWPORT& vp, bool clear);
+    void FlattenClone();          // mirror cloneRoot_ into flat_ (breadth-first)
+    void SyncTransforms();        // update flat_ and write back only changed world transforms
+    bool UpdateTurntable(bool dragging); // bake idle tiles; true if the atlas covers yaw_
+    bool BakeTurntableFrame(std::uint32_t frame);
+    bool CreateAtlas();
+    void ReleaseAtlas();
+    bool RenderSoftware();        // CPU silhouette into tex_ when the engine path fails
+    bool DrawScene();             // engine render into the bound target + viewport
+    bool UpdateMultiView();       // Config::previewViews > 1: dirty tiles of tex_; false otherwise
+    bool DrawViewSoftware(const MI::ViewRect& rect, const MI::Math::Vec3& eye);
+    bool RasterizeView(std::uint32_t w, std::uint32_t h, const MI::Math::Vec3& eye);  // CPU silhouette into viewImage_
+    void ApplyCamera(const MI::Math::Xform& world, float aspect);  // camera_ world + frustum
+    void ReleaseVariant(std::uint32_t slot);
+
+    // IMultiViewBackend: one bind of rtv_ per pass, then a viewport per dirty view
+    bool BeginPass() override;
+    void ClearTarget() override;
+    bool ClearRect(const MI::ViewRect& rect) override;
+    bool DrawView(const MI::ViewRect& rect, const MI::PreviewView& view) override;
 
 private:
     // D3D
     bool initialized_ = false;
     ID3D11Device* device_ = nullptr;
     ID3D11DeviceContext* context_ = nullptr;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext1> context1_;  // ClearView for single tiles (D3D 11.1)
 
     UINT width_ = 0, height_ = 0;
     Microsoft::WRL::ComPtr<ID3D11Texture2D> tex_;
@@ -61,11 +139,51 @@ private:
     RE::NiPointer<RE::NiCamera>   camera_;      // preview camera
     RE::NiPointer<RE::NiAVObject> cloneRoot_;   // deep-cloned player tree
 
+    // Flattened SoA transform mirror of cloneRoot_; flatNodes_[i] is the node for flat_ index i
+    MI::FlatHierarchy             flat_;
+    std::vector<RE::NiAVObject*>  flatNodes_;   // raw: kept alive by cloneRoot_
+
     bool sceneReady_ = false;
+    std::uint64_t cloneGeneration_ = 0; // bumped on every rebuild (turntable invalidation)
+
+    // Hover variants, attached under sceneRoot_ and culled unless shown (culls cloneRoot_)
+    std::vector<RE::NiPointer<RE::NiAVObject>> variants_;
+    std::uint32_t shownVariant_ = kNoVariant;
+    std::uint64_t variantSerial_ = 0;  // bumped when what is shown changes (multi-view redraw)
+
+    // Optional turntable cache (Config::turntableFrames > 0)
+    MI::TurntableCache turntable_;
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> atlasTex_;
+    Microsoft::WRL::ComPtr<ID3D11RenderTargetView> atlasRtv_;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> atlasSrv_;
+    bool yawChanged_ = false; // SetYaw called since last Render (user is dragging the preview)
+
+    // Software fallback (Config::softwareFallback): pose-sphere mesh rasterized on the CPU
+    std::unique_ptr<MI::SoftRaster::Rasterizer> softRaster_;  // created on first use
+    MI::SoftRaster::Mesh  softMesh_;
+    MI::SoftRaster::Image softImage_;
+    MI::TextureUploader   uploader_;  // staging ring into tex_ (never stalls the context)
+    MI::PreviewExporter   exporter_;  // readback ring + background encoder for RequestExport
+    bool softDirty_ = true;   // clone, camera or target size changed since the last raster
+
+    // Side-by-side views sharing tex_ (Config::previewViews > 1)
+    MI::MultiViewPass             views_;
+    std::vector<MI::PreviewView>  viewList_;
+    std::vector<MI::Math::Orbit>  viewOrbits_;   // viewList_ as orbits around target_
+    std::vector<MI::Math::Xform>  viewCameras_;  // their camera transforms (OrbitCameras)
+    MI::SoftRaster::Image         viewImage_;  // one software-rendered tile, copied into softImage_
 
     // NEW: simple orbit camera state
     float yaw_   = 0.0f;     // left/right rotate
     float pitch_ = 0.1f;     // up/down tilt
-    float distance_ = 140.0f; // zoom distance from target
+    float distance_ = 140.0f; // zoom distance from target (fitDistance_ * zoom_, clamped)
+    float fitDistance_ = 140.0f; // full-body fit of the current clone (ComputeFullBody)
+    float zoom_ = 1.0f;       // user zoom relative to the fit (SetZoom)
+    RE::NiPoint3 target_{};   // orbit centre (pose bound centre of the clone)
+    float fovY_ = 0.8726646f; // vertical FOV in radians (50 deg until ComputeFullBody sets it)
+    static constexpr float kMinDistance = 60.0f;
+    static constexpr float kMaxDistance = 220.0f;
+    static constexpr float kNearZ = 5.0f;   // push near plane to avoid clipping
+    static constexpr float kFarZ  = 5000.0f;
     bool needsCameraUpdate_ = true;
 };
@@ -3,9 +3,29 @@
 #include "ModernInventory/Config.h"
 #include "ModernInventory/Log.h"
 #include "ModernInventory/D3D11Hook.h"
-#include "game/Preview3D.h"
+#include "ModernInventory/EventLog.h"
+#include "ModernInventory/GameWorld.h"
+#include "ModernInventory/InputBindings.h"
+#include "ModernInventory/OverlayHost.h"
+#include "ModernInventory/PreviewController.h"
+#include "ModernInventory/SinkRegistry.h"
+#include "ModernInventory/Startup.h"
 
-// -------------------- Input sink (detect 'I' key) --------------------
+// -------------------- Event sink state --------------------
+namespace
+{
+    using Action = MI::InputAction;
+
+    MI::InputBindings        g_Bindings;  // scancode -> action, bound from the config
+    MI::SinkRegistry         g_Sinks;
+    MI::SinkRegistry::SinkId g_MenuSinkId{}, g_EquipSinkId{}, g_InputSinkId{};
+
+    constexpr MI::SinkRegistry::Reasons kKeysBound = 1;  // an action usable right now has a key
+}
+
+// -------------------- Input sink (inventory + export keys) --------------------
+// Attached only while a bound key can fire (SyncInput); every event the game produces passes
+// through here, so an unbound key costs one bit test.
 class MI_InputSink final : public RE::BSTEventSink<RE::InputEvent*>
 {
 public:
@@ -15,9 +35,6 @@ public:
         return std::addressof(inst);
     }
 
-    // Keyboard scancode for 'I' (DirectInput)
-    static constexpr std::uint32_t kScan_I = 0x17;
-
     RE::BSEventNotifyControl ProcessEvent(RE::InputEvent* const* a_events,
                                           RE::BSTEventSource<RE::InputEvent*>*) override
     {
@@ -33,19 +50,39 @@ public:
             if (!be || be->GetDevice() != RE::INPUT_DEVICE::kKeyboard) {
                 continue;
             }
+            const auto actions = g_Bindings.Match(be->idCode);
+            if (actions == 0 || !be->IsDown()) {
+                continue;  // fire on press
+            }
 
-            // fire on press
-            if (be->idCode == kScan_I && be->IsDown()) {
-                RE::DebugNotification("ModernInventory: I key detected!");
-                if (auto* con = RE::ConsoleLog::GetSingleton()) {
-                    con->Print("ModernInventory: I key detected!");
-                }
+            if (actions & MI::InputBindings::Bit(Action::kExport)) {
+                MI::GetPreviewController().OnExport();
+            }
+            // Inventory key: start the preview clone while the menu is still opening
+            if (actions & MI::InputBindings::Bit(Action::kPrebuild)) {
+                MI::GetPreviewController().OnHotkey();
             }
         }
         return RE::BSEventNotifyControl::kContinue;
     }
 };
 
+namespace
+{
+    // Held by every g_Bindings writer here, so enabling actions and attaching the input sink
+    // for the result is one step against a concurrent rebind
+    std::mutex g_InputLock;
+
+    // Inventory open: only the export key can do anything; otherwise only the prebuild
+    // hotkey. Menu events (UI thread) and load messages (main thread) both call this.
+    void SyncInput(bool inventoryOpen)
+    {
+        std::lock_guard guard(g_InputLock);
+        g_Bindings.SetEnabled(MI::InputBindings::Bit(inventoryOpen ? Action::kExport : Action::kPrebuild));
+        g_Sinks.Need(g_InputSinkId, kKeysBound, g_Bindings.Any());
+    }
+}
+
 // -------------------- Menu sink (Inventory open/close) --------------------
 class MI_MenuSink final : public RE::BSTEventSink<RE::MenuOpenCloseEvent>
 {
@@ -63,29 +100,12 @@ public:
             return RE::BSEventNotifyControl::kContinue;
         }
 
-            if (a_event->menuName == RE::InventoryMenu::MENU_NAME) {
-                if (a_event->opening) {
-                    RE::DebugNotification("ModernInventory: Inventory opened");
-                    if (auto* con = RE::ConsoleLog::GetSingleton()) {
-                        con->Print("ModernInventory: Inventory opened");
-                    }
-                    MI::SetInventoryOpen(true);
-                    if (auto* inv3d = RE::Inventory3DManager::GetSingleton()) {
-                        inv3d->Clear3D(); // hide vanilla 3D preview under our panel
-                    }
-                    // Kick off our paperdoll build; if player 3D isn't ready yet
-                    // we'll briefly show purple until it becomes available.
-                    Preview3D::Get().BuildFromPlayer();
-                } else {
-                    RE::DebugNotification("ModernInventory: Inventory closed");
-                    if (auto* con = RE::ConsoleLog::GetSingleton()) {
-                        con->Print("ModernInventory: Inventory closed");
-                    }
-                    MI::SetInventoryOpen(false);
-                    // no need to restore Inventory3D; game rebuilds on next open
-                    // TODO(next): hide ImGui right pane
-                }
-            }
+        if (a_event->menuName == RE::InventoryMenu::MENU_NAME) {
+            // Open: show panel, hide vanilla 3D, rebuild paperdoll. Close: hide panel
+            // (no need to restore Inventory3D; game rebuilds on next open).
+            MI::GetPreviewController().OnMenu(a_event->opening);
+            SyncInput(a_event->opening);
+        }
 
         return RE::BSEventNotifyControl::kContinue;
     }
@@ -114,7 +134,7 @@ public:
         }
 
         // Any equip or unequip -> rebuild the paper-doll now
-        Preview3D::Get().RebuildNow();
+        MI::GetPreviewController().OnEquip();
         return RE::BSEventNotifyControl::kContinue;
     }
 };
@@ -122,55 +142,142 @@ public:
 // -------------------- Helpers --------------------
 namespace
 {
-    void RegisterSinks()
+    using Step = MI::StartupStep;
+    using Mode = MI::InitGraph::Mode;
+
+    MI::InitGraph::StepId Id(Step step) { return static_cast<MI::InitGraph::StepId>(step); }
+
+    // Event sources are looked up on every attach: a hook returns false while one is missing
+    template <class Source, class Sink>
+    MI::SinkRegistry::Hooks SinkHooks(Source* (*source)(), Sink* sink)
+    {
+        const auto attach = [source, sink] {
+            auto* s = source();
+            if (s) {
+                s->AddEventSink(sink);
+            }
+            return s != nullptr;
+        };
+        const auto detach = [source, sink] {
+            if (auto* s = source()) {
+                s->RemoveEventSink(sink);
+            }
+        };
+        return { attach, detach };
+    }
+
+    // Idempotent: re-asserts the sinks a fresh world wants (no menu open) and retries any
+    // whose event source was missing before
+    bool SyncSinks()
     {
-        if (auto* inputMgr = RE::BSInputDeviceManager::GetSingleton()) {
-            inputMgr->AddEventSink(MI_InputSink::GetSingleton());
+        const bool menu = g_Sinks.Attach(g_MenuSinkId);
+        const bool equip = g_Sinks.Attach(g_EquipSinkId);
+        SyncInput(false);
+        return menu && equip && RE::BSInputDeviceManager::GetSingleton();
+    }
+
+    // Runs once (kSinks startup step) at kDataLoaded, when every event source exists
+    bool RegisterSinks()
+    {
+        // Config keys are the default bindings; no prebuild timeout, no hotkey to watch
+        const auto& cfg = MI::ConfigSys::Get();
+        {
+            std::lock_guard guard(g_InputLock);
+            g_Bindings.Rebind(Action::kExport, static_cast<std::uint32_t>(cfg.exportKey));
+            g_Bindings.Rebind(Action::kPrebuild, cfg.prebuildTimeoutMs > 0 ? static_cast<std::uint32_t>(cfg.toggleKey) : 0u);
         }
-        if (auto* ui = RE::UI::GetSingleton()) {
-            ui->AddEventSink(MI_MenuSink::GetSingleton());
+
+        g_MenuSinkId = g_Sinks.Add("menu", SinkHooks(&RE::UI::GetSingleton, MI_MenuSink::GetSingleton()));
+        g_EquipSinkId = g_Sinks.Add("equip", SinkHooks(&RE::ScriptEventSourceHolder::GetSingleton, MI_EquipSink::GetSingleton()));
+        g_InputSinkId = g_Sinks.Add("input", SinkHooks(&RE::BSInputDeviceManager::GetSingleton, MI_InputSink::GetSingleton()));
+        return SyncSinks();
+    }
+
+    // Controller settings and the optional capture of the preview event stream (MI_replay)
+    bool SetUpController()
+    {
+        const auto& cfg = MI::ConfigSys::Get();
+        auto& controller = MI::GetPreviewController();
+        controller.SetPrebuildTimeout(static_cast<std::uint64_t>(cfg.prebuildTimeoutMs) * 1000);
+        controller.SetEvictIdle(static_cast<std::uint64_t>(cfg.cacheEvictIdleSec) * 1000000);
+        controller.SetHoverPreview(static_cast<std::uint32_t>(cfg.variantCacheSize),
+                                   static_cast<std::uint32_t>(cfg.hoverPrefetchPerFrame));
+        if (cfg.recordEvents) {
+            static MI::EventRecorder recorder;
+            const auto path = MI::Log::GetFolder() / L"ModernInventory.mievents";
+            if (!recorder.Start(path.string(), MI::LiveGameWorld().NowUs())) {
+                return false;
+            }
+            controller.SetRecorder(&recorder);
+            MI::Log::Info("Recording preview events to " + path.string());
         }
-        if (auto* ev = RE::ScriptEventSourceHolder::GetSingleton()) {
-            ev->AddEventSink(MI_EquipSink::GetSingleton());
+        return true;
+    }
+
+    // Messages other plugins send to us (overlay API requests)
+    void OnPluginMessage(SKSE::MessagingInterface::Message* m)
+    {
+        if (m) {
+            MI::HandleOverlayMessage(m->type, m->data, m->dataLen);
         }
     }
 
     void OnSKSEMessage(SKSE::MessagingInterface::Message* m)
     {
         using M = SKSE::MessagingInterface;
-        switch (m->type) {
-        case M::kDataLoaded:
-        case M::kNewGame:
-        case M::kPostLoadGame:
-            RegisterSinks();
-            break;
-        default:
-            break;
+        if (m->type == M::kNewGame || m->type == M::kPostLoadGame) {
+            if (MI::GetInitGraph().Done(Id(Step::kSinks))) {
+                SyncSinks();
+            }
+            return;
+        }
+        if (m->type != M::kDataLoaded) {
+            return;
+        }
+        MI::RequireStartup(Step::kSinks);
+        // Everything we added to boot, including steps still pending or pulled in lazily
+        MI::Log::Info(MI::GetInitGraph().Report());
+        MI::Log::Info(g_Sinks.Report());
+        MI::Toast("ModernInventory loaded");
+        if (auto* con = RE::ConsoleLog::GetSingleton()) {
+            con->Print("ModernInventory %s loaded", MI::kVersion);
         }
     }
 }
 
+MI::InitGraph& MI::GetInitGraph()
+{
+    static auto* graph = new InitGraph;  // leaked: no thread join during DLL unload
+    return *graph;
+}
+
 // -------------------- SKSE entry --------------------
 extern "C" __declspec(dllexport) bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* skse)
 {
     SKSE::Init(skse);
 
-    if (auto* msg = SKSE::GetMessagingInterface()) {
-        msg->RegisterListener(OnSKSEMessage);
-    }
-
-    // Early sinks (harmless to repeat on DataLoaded)
-    RegisterSinks();
-
-    // Install D3D11 Present hook + Dear ImGui bootstrap
-    MI::InstallD3D11Hook();
-
-        MI::ConfigSys::Load();
-        MI::Log::Init();
-
-        MI::Toast("ModernInventory loaded");
-    if (auto* con = RE::ConsoleLog::GetSingleton()) {
-        con->Print("ModernInventory %s loaded", MI::kVersion);
+    // Only the listeners and the CreateDevice hook have to exist before the loader moves on;
+    // the rest runs on a worker or on first use, and every step is timed for the log.
+    auto& graph = MI::GetInitGraph();
+    const auto messaging = graph.Add("messaging", Mode::kSync, [] {
+        auto* msg = SKSE::GetMessagingInterface();
+        return msg && msg->RegisterListener(OnSKSEMessage) &&
+               msg->RegisterListener(nullptr, OnPluginMessage);  // any sender
+    });
+    const auto hook = graph.Add("present-hook", Mode::kSync, [] { return MI::InstallD3D11Hook(); });
+    const auto log = graph.Add("log", Mode::kBackground, [] { MI::Log::Init(); return true; });
+    const auto config = graph.Add("config", Mode::kLazy, [] { MI::ConfigSys::Load(); return true; });
+    const auto fallback = graph.Add("present-fallback", Mode::kBackground, [] {
+        // Only when the CreateDevice hook couldn't be installed (the device exists already)
+        return MI::GetInitGraph().Require(Id(Step::kPresentHook)) || MI::InstallD3D11HookFallback();
+    }, { hook, log });
+    const auto controller = graph.Add("controller", Mode::kBackground, &SetUpController, { log, config });
+    const auto sinks = graph.Add("sinks", Mode::kLazy, &RegisterSinks, { messaging, controller });
+    if (messaging != Id(Step::kMessaging) || hook != Id(Step::kPresentHook) || log != Id(Step::kLog) ||
+        config != Id(Step::kConfig) || fallback != Id(Step::kHookFallback) || controller != Id(Step::kController) ||
+        sinks != Id(Step::kSinks)) {
+        return false;  // StartupStep out of sync with the graph
     }
+    graph.Run();
     return true;
 }
@@ -0,0 +1,46 @@
+#include "Mannequin.h"
+
+#include <cmath>
+
+namespace MI::Raster
+{
+    namespace
+    {
+        // count spheres from a to b, radius lerped r0 -> r1
+        void Chain(std::vector<Math::Sphere>& out, Math::Vec3 a, Math::Vec3 b, int count, float r0, float r1)
+        {
+            for (int i = 0; i < count; ++i) {
+                const float t = count > 1 ? static_cast<float>(i) / static_cast<float>(count - 1) : 0.0f;
+                out.push_back({ { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t },
+                                r0 + (r1 - r0) * t });
+            }
+        }
+    }
+
+    void BuildMannequin(std::vector<Math::Sphere>& out)
+    {
+        out.clear();
+        out.push_back({ { 0.0f, 0.0f, 120.0f }, 10.0f });                          // head
+        Chain(out, { 0.0f, 0.0f, 109.0f }, { 0.0f, 0.0f, 104.0f }, 2, 5.0f, 6.0f);  // neck
+        Chain(out, { 0.0f, 0.0f, 96.0f }, { 0.0f, 0.0f, 70.0f }, 6, 15.0f, 12.0f); // torso
+        for (float side : { -1.0f, 1.0f }) {
+            out.push_back({ { side * 12.0f, 0.0f, 98.0f }, 7.0f });                                         // shoulder
+            Chain(out, { side * 18.0f, 0.0f, 96.0f }, { side * 24.0f, 2.0f, 56.0f }, 9, 5.0f, 3.5f);         // arm
+            Chain(out, { side * 8.0f, 0.0f, 62.0f }, { side * 10.0f, 0.0f, 6.0f }, 12, 8.0f, 4.5f);          // leg
+            out.push_back({ { side * 10.0f, -5.0f, 3.0f }, 4.0f });                                          // foot
+        }
+    }
+
+    SoftRaster::View MannequinView(float aspect)
+    {
+        // Same fit as Camera::ComputeFullBody for a ~70 unit bound radius at 50 deg fov
+        const float fovY = 50.0f;
+        const float halfTan = std::tan(fovY * 0.5f * 3.14159265f / 180.0f);
+        const float fit = 70.0f * 1.1f / (halfTan * (aspect < 1.0f ? aspect : 1.0f));
+        SoftRaster::View view;
+        view.target = { 0.0f, 0.0f, 64.0f };
+        view.eye = { 0.0f, -fit, 64.0f + 0.1f * fit };
+        view.fovYDeg = fovY;
+        return view;
+    }
+}
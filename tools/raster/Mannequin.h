@@ -0,0 +1,16 @@
+#pragma once
+
+// Reference scene for the software rasterizer: a ~128-unit humanoid built from the same
+// kind of per-bone spheres the plugin feeds in (PreviewGraph::CollectPoseSpheres).
+
+#include <vector>
+
+#include "ModernInventory/SoftRaster.h"
+
+namespace MI::Raster
+{
+    void BuildMannequin(std::vector<Math::Sphere>& out);
+
+    // Framed like the preview: orbit camera at yaw 0 (looking +Y), full body in view.
+    SoftRaster::View MannequinView(float aspect);
+}
@@ -0,0 +1,160 @@
+// MI_raster: render the software-rasterizer reference scene and compare it with a golden image.
+//   MI_raster [--size WxH] [--threads N] [--out image.pgm|.png|.qoi] [--golden golden.pgm]
+//             [--tolerance F] [--repeat N]
+// Goldens are binary PGM (luminance); --out also writes RGBA PNG / QOI through the export
+// encoders. Exit codes: 0 ok, 2 usage / IO, 4 golden mismatch.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Mannequin.h"
+#include "ModernInventory/ImageEncode.h"
+#include "ModernInventory/SoftRaster.h"
+
+namespace
+{
+    constexpr std::uint32_t kBodyColor = MI::SoftRaster::Rgba(200, 180, 160);
+
+    std::uint8_t Luma(std::uint32_t rgba)
+    {
+        const auto r = rgba & 0xFF, g = (rgba >> 8) & 0xFF, b = (rgba >> 16) & 0xFF;
+        return static_cast<std::uint8_t>((r * 77 + g * 150 + b * 29) >> 8);
+    }
+
+    bool WritePgm(const std::string& path, const MI::SoftRaster::Image& img)
+    {
+        std::ofstream f(path, std::ios::binary);
+        if (!f) {
+            return false;
+        }
+        f << "P5\n" << img.width << " " << img.height << "\n255\n";
+        for (std::uint32_t y = 0; y < img.height; ++y) {
+            for (std::uint32_t x = 0; x < img.width; ++x) {
+                f.put(static_cast<char>(Luma(img.At(x, y))));
+            }
+        }
+        return static_cast<bool>(f);
+    }
+
+    bool WriteImage(const std::string& path, const MI::SoftRaster::Image& img)
+    {
+        const auto ext = path.size() >= 4 ? path.substr(path.size() - 4) : std::string{};
+        if (ext != ".png" && ext != ".qoi") {
+            return WritePgm(path, img);
+        }
+        std::vector<std::uint8_t> bytes;
+        MI::ImageEncode::Encode(ext == ".png" ? MI::ImageFormat::kPng : MI::ImageFormat::kQoi,
+                                reinterpret_cast<const std::uint8_t*>(img.rgba.data()), img.width, img.height,
+                                static_cast<std::size_t>(img.stride) * 4, bytes);
+        std::ofstream f(path, std::ios::binary);
+        f.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(f);
+    }
+
+    bool ReadPgm(const std::string& path, std::uint32_t& w, std::uint32_t& h, std::vector<std::uint8_t>& out)
+    {
+        std::ifstream f(path, std::ios::binary);
+        std::string magic;
+        unsigned maxv = 0;
+        if (!(f >> magic >> w >> h >> maxv) || magic != "P5" || maxv != 255) {
+            return false;
+        }
+        f.get();  // single whitespace after the header
+        out.resize(static_cast<std::size_t>(w) * h);
+        return static_cast<bool>(f.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size())));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned width = 128, height = 256;
+    unsigned threads = MI::SoftRaster::Rasterizer::kAuto;
+    unsigned repeat = 1;
+    double tolerance = 0.002;  // fraction of pixels allowed to differ by more than 8 levels
+    std::string outPath, goldenPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--size") == 0 && hasValue && std::sscanf(argv[i + 1], "%ux%u", &width, &height) == 2) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && hasValue) {
+            repeat = (std::max)(1u, static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10)));
+        } else if (std::strcmp(argv[i], "--tolerance") == 0 && hasValue) {
+            tolerance = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--out") == 0 && hasValue) {
+            outPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--golden") == 0 && hasValue) {
+            goldenPath = argv[++i];
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--size WxH] [--threads N] [--out image.pgm|.png|.qoi] [--golden golden.pgm]"
+                      << " [--tolerance F] [--repeat N]\n";
+            return 2;
+        }
+    }
+    if (width == 0 || height == 0) {
+        std::cerr << "invalid --size\n";
+        return 2;
+    }
+
+    std::vector<MI::Math::Sphere> spheres;
+    MI::Raster::BuildMannequin(spheres);
+    MI::SoftRaster::Mesh mesh;
+    for (const auto& s : spheres) {
+        mesh.AddSphere(s);
+    }
+    const auto view = MI::Raster::MannequinView(static_cast<float>(width) / static_cast<float>(height));
+
+    MI::SoftRaster::Rasterizer raster(threads);
+    MI::SoftRaster::Image image;
+    image.Resize(width, height);
+
+    std::size_t tris = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < repeat; ++r) {
+        image.Clear(0);
+        tris = raster.Draw(mesh, view, kBodyColor, image);
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() / repeat;
+    std::cout << width << "x" << height << ": " << mesh.indices.size() / 3 << " triangles (" << tris << " front-facing), "
+              << raster.Workers() + 1 << " threads, " << ms << " ms/frame\n";
+
+    if (!outPath.empty() && !WriteImage(outPath, image)) {
+        std::cerr << "cannot write " << outPath << "\n";
+        return 2;
+    }
+
+    if (!goldenPath.empty()) {
+        std::uint32_t gw = 0, gh = 0;
+        std::vector<std::uint8_t> golden;
+        if (!ReadPgm(goldenPath, gw, gh, golden)) {
+            std::cerr << "cannot read golden " << goldenPath << "\n";
+            return 2;
+        }
+        if (gw != width || gh != height) {
+            std::cerr << "golden is " << gw << "x" << gh << ", rendered " << width << "x" << height << "\n";
+            return 4;
+        }
+        std::size_t differing = 0;
+        for (std::uint32_t y = 0; y < height; ++y) {
+            for (std::uint32_t x = 0; x < width; ++x) {
+                const int d = static_cast<int>(Luma(image.At(x, y))) - static_cast<int>(golden[y * width + x]);
+                differing += (d > 8 || d < -8) ? 1 : 0;
+            }
+        }
+        const double fraction = static_cast<double>(differing) / (static_cast<double>(width) * height);
+        std::cout << "golden: " << differing << " pixels differ (" << fraction * 100.0 << "%, tolerance "
+                  << tolerance * 100.0 << "%)\n";
+        if (fraction > tolerance) {
+            return 4;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "Budget.h"
+
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <string_view>
+
+namespace MI::Replay
+{
+    namespace
+    {
+        std::string trim(std::string_view sv)
+        {
+            size_t b = 0, e = sv.size();
+            while (b < e && isspace(static_cast<unsigned char>(sv[b]))) b++;
+            while (e > b && isspace(static_cast<unsigned char>(sv[e - 1]))) e--;
+            return std::string{ sv.substr(b, e - b) };
+        }
+    }
+
+    bool LoadBudget(const std::string& path, Metrics& limits, std::string& error)
+    {
+        std::ifstream in(path);
+        if (!in) {
+            error = "cannot open " + path;
+            return false;
+        }
+        std::string line;
+        for (int lineNo = 1; std::getline(in, line); ++lineNo) {
+            auto posc = line.find_first_of("#;");
+            if (posc != std::string::npos) line.erase(posc);
+            if (trim(line).empty()) continue;
+
+            const auto eq = line.find('=');
+            const auto k = eq == std::string::npos ? std::string{} : trim(std::string_view{ line }.substr(0, eq));
+            const auto v = eq == std::string::npos ? std::string{} : trim(std::string_view{ line }.substr(eq + 1));
+            try {
+                if (k.empty()) throw std::invalid_argument("key");
+                limits[k] = std::stod(v);
+            } catch (...) {
+                error = path + ":" + std::to_string(lineNo) + ": expected metric=number";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<BudgetViolation> CheckBudget(const Metrics& limits, const Metrics& actual)
+    {
+        std::vector<BudgetViolation> out;
+        for (const auto& [metric, limit] : limits) {
+            const auto it = actual.find(metric);
+            if (it == actual.end()) {
+                out.push_back({ metric, limit, std::numeric_limits<double>::quiet_NaN() });
+            } else if (it->second > limit) {
+                out.push_back({ metric, limit, it->second });
+            }
+        }
+        return out;
+    }
+}
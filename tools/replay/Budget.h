@@ -0,0 +1,29 @@
+#pragma once
+
+// Checked-in regression budgets for MI_replay (tools/replay/budget.ini).
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace MI::Replay
+{
+    // Flat metric name -> value, e.g. "rebuilds_per_trigger", "gpu.creations.max".
+    using Metrics = std::map<std::string, double>;
+
+    struct BudgetViolation
+    {
+        std::string metric;
+        double      limit{};
+        double      actual{};
+    };
+
+    // "metric=max" lines; '#' / ';' start comments. Returns false if the file can't be
+    // read or a line is malformed (error says which).
+    bool LoadBudget(const std::string& path, Metrics& limits, std::string& error);
+
+    // Metrics above their limit. A limit naming an unknown metric is reported as a
+    // violation with actual = NaN so typos in the budget can't pass silently.
+    std::vector<BudgetViolation> CheckBudget(const Metrics& limits, const Metrics& actual);
+}
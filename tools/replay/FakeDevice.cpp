@@ -0,0 +1,383 @@
+#include "FakeDevice.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace MI::Replay
+{
+    class FakeDevice::Texture final : public ID3D11Texture2D
+    {
+    public:
+        Texture(FakeDevice* owner, const D3D11_TEXTURE2D_DESC& desc) : m_owner(owner), m_desc(desc)
+        {
+            if (m_owner) {
+                m_owner->Track(this);
+            }
+        }
+
+        UINT AddRef() override { return ++m_refs; }
+        UINT Release() override
+        {
+            const UINT left = --m_refs;
+            if (left == 0) {
+                if (m_owner) {
+                    m_owner->Untrack(this);
+                }
+                delete this;
+            }
+            return left;
+        }
+        void GetDesc(D3D11_TEXTURE2D_DESC* desc) override { *desc = m_desc; }
+
+        const D3D11_TEXTURE2D_DESC& Desc() const { return m_desc; }
+        UINT                        Pitch() const { return (m_desc.Width * 4u + 255u) & ~255u; }
+
+        // Allocated on first use: most targets are only ever cleared and bound
+        std::uint8_t* Pixels()
+        {
+            if (m_pixels.empty()) {
+                m_pixels.resize(static_cast<std::size_t>(Pitch()) * m_desc.Height);
+            }
+            return m_pixels.data();
+        }
+
+        std::uint64_t writtenAt{ 0 };  // GPU sequence of the last copy / upload into it
+        bool          mapped{ false };
+
+    private:
+        FakeDevice*               m_owner;  // null: the back buffer, owned by the fake swap chain
+        D3D11_TEXTURE2D_DESC      m_desc;
+        UINT                      m_refs{ 1 };
+        std::vector<std::uint8_t> m_pixels;
+    };
+
+    // A view holds a reference on its resource, like the real runtime
+    template <class Interface>
+    class FakeDevice::View final : public Interface
+    {
+    public:
+        View(FakeDevice& owner, ID3D11Resource* resource) : m_owner(owner), m_resource(resource)
+        {
+            m_resource->AddRef();
+            m_owner.Track(this);
+        }
+
+        UINT AddRef() override { return ++m_refs; }
+        UINT Release() override
+        {
+            const UINT left = --m_refs;
+            if (left == 0) {
+                m_owner.Untrack(this);
+                m_resource->Release();
+                delete this;
+            }
+            return left;
+        }
+        void GetResource(ID3D11Resource** resource) override
+        {
+            m_resource->AddRef();
+            *resource = m_resource;
+        }
+
+    private:
+        FakeDevice&     m_owner;
+        ID3D11Resource* m_resource;
+        UINT            m_refs{ 1 };
+    };
+
+    class FakeDevice::Query final : public ID3D11Query
+    {
+    public:
+        explicit Query(FakeDevice& owner) : m_owner(owner) { m_owner.Track(this); }
+
+        UINT AddRef() override { return ++m_refs; }
+        UINT Release() override
+        {
+            const UINT left = --m_refs;
+            if (left == 0) {
+                m_owner.Untrack(this);
+                delete this;
+            }
+            return left;
+        }
+
+        std::uint64_t endedAt{ 0 };  // GPU sequence of the last End (0: never issued)
+
+    private:
+        FakeDevice& m_owner;
+        UINT        m_refs{ 1 };
+    };
+
+    FakeDevice::FakeDevice()
+    {
+        D3D11_TEXTURE2D_DESC desc{};
+        desc.Width = 2560;
+        desc.Height = 1440;
+        desc.MipLevels = 1;
+        desc.ArraySize = 1;
+        desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        desc.SampleDesc.Count = 1;
+        desc.BindFlags = D3D11_BIND_RENDER_TARGET;
+        m_backBuffer = new Texture(nullptr, desc);
+    }
+
+    FakeDevice::~FakeDevice()
+    {
+        m_backBuffer->Release();
+    }
+
+    void FakeDevice::HoldGpu(bool held)
+    {
+        m_held = held;
+        if (!held) {
+            m_retired = m_issued;
+        }
+    }
+
+    std::uint64_t FakeDevice::Issue()
+    {
+        ++m_issued;
+        if (!m_held) {
+            m_retired = m_issued;
+        }
+        return m_issued;
+    }
+
+    void FakeDevice::TakeFrame(GpuCallFrame& out)
+    {
+        out = m_frame;
+        m_frame.fill(0);
+    }
+
+    bool FakeDevice::Check(const void* object)
+    {
+        if (object && (object == m_backBuffer || m_live.count(object))) {
+            return true;
+        }
+        ++m_stats.errors;
+        return false;
+    }
+
+    void FakeDevice::Track(const void* object)
+    {
+        m_live.insert(object);
+        ++m_stats.created;
+    }
+
+    void FakeDevice::Untrack(const void* object)
+    {
+        m_live.erase(object);
+        ++m_stats.destroyed;
+    }
+
+    HRESULT FakeDevice::DeviceImpl::CreateTexture2D(const D3D11_TEXTURE2D_DESC* desc, const void*, ID3D11Texture2D** out)
+    {
+        m_owner.Count(GpuCall::kCreateTexture2D);
+        if (!desc || !out || desc->Width == 0 || desc->Height == 0 || desc->Width > 16384 || desc->Height > 16384) {
+            ++m_owner.m_stats.errors;
+            return E_FAIL;
+        }
+        *out = new Texture(&m_owner, *desc);
+        return S_OK;
+    }
+
+    HRESULT FakeDevice::DeviceImpl::CreateRenderTargetView(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC*,
+                                                           ID3D11RenderTargetView** out)
+    {
+        m_owner.Count(GpuCall::kCreateRenderTargetView);
+        if (!out || !m_owner.Check(resource)) {
+            return E_FAIL;
+        }
+        *out = new View<ID3D11RenderTargetView>(m_owner, resource);
+        return S_OK;
+    }
+
+    HRESULT FakeDevice::DeviceImpl::CreateShaderResourceView(ID3D11Resource* resource, const D3D11_SHADER_RESOURCE_VIEW_DESC*,
+                                                             ID3D11ShaderResourceView** out)
+    {
+        m_owner.Count(GpuCall::kCreateShaderResourceView);
+        if (!out || !m_owner.Check(resource)) {
+            return E_FAIL;
+        }
+        *out = new View<ID3D11ShaderResourceView>(m_owner, resource);
+        return S_OK;
+    }
+
+    HRESULT FakeDevice::DeviceImpl::CreateDepthStencilView(ID3D11Resource* resource, const D3D11_DEPTH_STENCIL_VIEW_DESC*,
+                                                           ID3D11DepthStencilView** out)
+    {
+        m_owner.Count(GpuCall::kCreateDepthStencilView);
+        if (!out || !m_owner.Check(resource)) {
+            return E_FAIL;
+        }
+        *out = new View<ID3D11DepthStencilView>(m_owner, resource);
+        return S_OK;
+    }
+
+    HRESULT FakeDevice::DeviceImpl::CreateQuery(const D3D11_QUERY_DESC* desc, ID3D11Query** out)
+    {
+        m_owner.Count(GpuCall::kCreateQuery);
+        if (!desc || !out || desc->Query != D3D11_QUERY_EVENT) {
+            ++m_owner.m_stats.errors;
+            return E_FAIL;
+        }
+        *out = new Query(m_owner);
+        return S_OK;
+    }
+
+    void FakeDevice::ContextImpl::OMSetRenderTargets(UINT count, ID3D11RenderTargetView* const* rtvs, ID3D11DepthStencilView* dsv)
+    {
+        m_owner.Count(GpuCall::kOMSetRenderTargets);
+        m_boundRtv = count && rtvs ? rtvs[0] : nullptr;
+        m_boundDsv = dsv;
+        // Unbinding (null) is fine; binding a released view is not
+        if (m_boundRtv) {
+            m_owner.Check(m_boundRtv);
+        }
+        if (m_boundDsv) {
+            m_owner.Check(m_boundDsv);
+        }
+    }
+
+    void FakeDevice::ContextImpl::OMGetRenderTargets(UINT count, ID3D11RenderTargetView** rtvs, ID3D11DepthStencilView** dsv)
+    {
+        const bool rtvLive = m_boundRtv && m_owner.m_live.count(m_boundRtv);
+        const bool dsvLive = m_boundDsv && m_owner.m_live.count(m_boundDsv);
+        if (count && rtvs) {
+            rtvs[0] = rtvLive ? m_boundRtv : nullptr;
+            if (rtvs[0]) {
+                rtvs[0]->AddRef();
+            }
+        }
+        if (dsv) {
+            *dsv = dsvLive ? m_boundDsv : nullptr;
+            if (*dsv) {
+                (*dsv)->AddRef();
+            }
+        }
+    }
+
+    void FakeDevice::ContextImpl::RSSetViewports(UINT count, const D3D11_VIEWPORT* viewports)
+    {
+        m_owner.Count(GpuCall::kRSSetViewports);
+        m_viewports = count && viewports ? 1 : 0;
+        if (m_viewports) {
+            m_viewport = viewports[0];
+        }
+    }
+
+    void FakeDevice::ContextImpl::RSGetViewports(UINT* count, D3D11_VIEWPORT* viewports)
+    {
+        if (count) {
+            if (viewports && *count && m_viewports) {
+                viewports[0] = m_viewport;
+            }
+            *count = m_viewports;
+        }
+    }
+
+    void FakeDevice::ContextImpl::ClearRenderTargetView(ID3D11RenderTargetView* rtv, const FLOAT*)
+    {
+        m_owner.Count(GpuCall::kClearRenderTargetView);
+        m_owner.Check(rtv);
+    }
+
+    void FakeDevice::ContextImpl::ClearDepthStencilView(ID3D11DepthStencilView* dsv, UINT, FLOAT, std::uint8_t)
+    {
+        m_owner.Count(GpuCall::kClearDepthStencilView);
+        m_owner.Check(dsv);
+    }
+
+    void FakeDevice::ContextImpl::CopySubresourceRegion(ID3D11Resource* dst, UINT, UINT x, UINT y, UINT, ID3D11Resource* src, UINT,
+                                                        const D3D11_BOX* box)
+    {
+        m_owner.Count(GpuCall::kCopySubresourceRegion);
+        if (!m_owner.Check(dst) || !m_owner.Check(src)) {
+            return;
+        }
+        auto*      to = static_cast<Texture*>(dst);
+        auto*      from = static_cast<Texture*>(src);
+        const auto b = box ? *box : D3D11_BOX{ 0, 0, 0, from->Desc().Width, from->Desc().Height, 1 };
+        if (b.right > from->Desc().Width || b.bottom > from->Desc().Height || b.left >= b.right || b.top >= b.bottom ||
+            x + (b.right - b.left) > to->Desc().Width || y + (b.bottom - b.top) > to->Desc().Height) {
+            ++m_owner.m_stats.errors;  // the runtime drops an out-of-bounds copy
+            return;
+        }
+        for (UINT row = 0; row < b.bottom - b.top; ++row) {
+            std::memcpy(to->Pixels() + static_cast<std::size_t>(y + row) * to->Pitch() + x * 4u,
+                        from->Pixels() + static_cast<std::size_t>(b.top + row) * from->Pitch() + b.left * 4u, (b.right - b.left) * 4u);
+        }
+        to->writtenAt = m_owner.Issue();
+    }
+
+    void FakeDevice::ContextImpl::UpdateSubresource(ID3D11Resource* dst, UINT, const D3D11_BOX* box, const void* data, UINT rowPitch,
+                                                    UINT)
+    {
+        m_owner.Count(GpuCall::kUpdateSubresource);
+        if (!m_owner.Check(dst)) {
+            return;
+        }
+        auto*      to = static_cast<Texture*>(dst);
+        const auto b = box ? *box : D3D11_BOX{ 0, 0, 0, to->Desc().Width, to->Desc().Height, 1 };
+        if (!data || b.right > to->Desc().Width || b.bottom > to->Desc().Height || b.left >= b.right || b.top >= b.bottom) {
+            ++m_owner.m_stats.errors;
+            return;
+        }
+        const auto* in = static_cast<const std::uint8_t*>(data);
+        for (UINT row = 0; row < b.bottom - b.top; ++row) {
+            std::memcpy(to->Pixels() + static_cast<std::size_t>(b.top + row) * to->Pitch() + b.left * 4u,
+                        in + static_cast<std::size_t>(row) * rowPitch, (b.right - b.left) * 4u);
+        }
+        to->writtenAt = m_owner.Issue();
+    }
+
+    HRESULT FakeDevice::ContextImpl::Map(ID3D11Resource* resource, UINT, D3D11_MAP, UINT flags, D3D11_MAPPED_SUBRESOURCE* mapped)
+    {
+        m_owner.Count(GpuCall::kMap);
+        if (!mapped || !m_owner.Check(resource)) {
+            return E_FAIL;
+        }
+        auto* tex = static_cast<Texture*>(resource);
+        if (tex->Desc().Usage != D3D11_USAGE_STAGING || tex->mapped) {
+            ++m_owner.m_stats.errors;
+            return E_FAIL;
+        }
+        if (tex->writtenAt > m_owner.m_retired) {
+            if (flags & D3D11_MAP_FLAG_DO_NOT_WAIT) {
+                return DXGI_ERROR_WAS_STILL_DRAWING;
+            }
+            ++m_owner.m_stats.stalls;  // the real runtime blocks here until the copy lands
+        }
+        tex->mapped = true;
+        *mapped = { tex->Pixels(), tex->Pitch(), tex->Pitch() * tex->Desc().Height };
+        return S_OK;
+    }
+
+    void FakeDevice::ContextImpl::Unmap(ID3D11Resource* resource, UINT)
+    {
+        if (!m_owner.Check(resource) || !std::exchange(static_cast<Texture*>(resource)->mapped, false)) {
+            ++m_owner.m_stats.errors;
+        }
+    }
+
+    void FakeDevice::ContextImpl::End(ID3D11Asynchronous* async)
+    {
+        if (m_owner.Check(async)) {
+            static_cast<Query*>(async)->endedAt = m_owner.Issue();
+        }
+    }
+
+    HRESULT FakeDevice::ContextImpl::GetData(ID3D11Asynchronous* async, void*, UINT, UINT)
+    {
+        if (!m_owner.Check(async)) {
+            return E_FAIL;
+        }
+        const auto endedAt = static_cast<Query*>(async)->endedAt;
+        if (endedAt == 0) {
+            ++m_owner.m_stats.errors;  // polled before it was ever issued
+            return S_FALSE;
+        }
+        return endedAt <= m_owner.m_retired ? S_OK : S_FALSE;
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+// Counting stand-in for the game's D3D11 device and immediate context (off Windows only,
+// against fake/d3d11.h). Every call is counted per GpuCall as the device saw it, so the
+// replay can compare against the GpuCalls::Count at our call sites; textures, views and
+// queries are reference counted and tracked, so a leak or a bind of a released view is
+// reported. Textures keep their pixels (R8G8B8A8, rows padded to 256 bytes like a real
+// staging map), so copies, uploads and readbacks move real data. The GPU retires work as it
+// is issued unless held: then queries stay pending, a DO_NOT_WAIT map of a texture still
+// being written fails with DXGI_ERROR_WAS_STILL_DRAWING, and a map that would have waited
+// is counted as a stall.
+
+#include <cstdint>
+#include <unordered_set>
+
+#include <d3d11.h>
+
+#include "ModernInventory/GpuCalls.h"
+
+namespace MI::Replay
+{
+    class FakeDevice
+    {
+    public:
+        struct Stats
+        {
+            std::uint64_t created{};
+            std::uint64_t destroyed{};
+            std::uint64_t errors{};  // null / released object passed in, bad description
+            std::uint64_t stalls{};  // maps that would have waited for the GPU
+        };
+
+        FakeDevice();
+        ~FakeDevice();
+        FakeDevice(const FakeDevice&) = delete;
+        FakeDevice& operator=(const FakeDevice&) = delete;
+
+        ID3D11Device*        Device() { return &m_device; }
+        ID3D11DeviceContext* Context() { return &m_context; }
+
+        // The swap chain's back buffer (owned by the fake swap chain, not counted as created)
+        ID3D11Texture2D* BackBuffer() { return m_backBuffer; }
+
+        // Held: work issued from now on stays in flight until released
+        void HoldGpu(bool held);
+
+        void  TakeFrame(GpuCallFrame& out);  // calls since the previous take
+        Stats GetStats() const { return m_stats; }
+        std::size_t Live() const { return m_live.size(); }  // textures + views not yet released
+
+    private:
+        class Texture;
+        template <class Interface>
+        class View;
+        class Query;
+
+        class DeviceImpl final : public ID3D11Device
+        {
+        public:
+            explicit DeviceImpl(FakeDevice& owner) : m_owner(owner) {}
+            UINT    AddRef() override { return 1; }
+            UINT    Release() override { return 1; }
+            HRESULT CreateTexture2D(const D3D11_TEXTURE2D_DESC* desc, const void* initialData, ID3D11Texture2D** out) override;
+            HRESULT CreateRenderTargetView(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC* desc,
+                                           ID3D11RenderTargetView** out) override;
+            HRESULT CreateShaderResourceView(ID3D11Resource* resource, const D3D11_SHADER_RESOURCE_VIEW_DESC* desc,
+                                             ID3D11ShaderResourceView** out) override;
+            HRESULT CreateDepthStencilView(ID3D11Resource* resource, const D3D11_DEPTH_STENCIL_VIEW_DESC* desc,
+                                           ID3D11DepthStencilView** out) override;
+            HRESULT CreateQuery(const D3D11_QUERY_DESC* desc, ID3D11Query** out) override;
+
+        private:
+            FakeDevice& m_owner;
+        };
+
+        class ContextImpl final : public ID3D11DeviceContext
+        {
+        public:
+            explicit ContextImpl(FakeDevice& owner) : m_owner(owner) {}
+            UINT AddRef() override { return 1; }
+            UINT Release() override { return 1; }
+            void OMSetRenderTargets(UINT count, ID3D11RenderTargetView* const* rtvs, ID3D11DepthStencilView* dsv) override;
+            void OMGetRenderTargets(UINT count, ID3D11RenderTargetView** rtvs, ID3D11DepthStencilView** dsv) override;
+            void RSSetViewports(UINT count, const D3D11_VIEWPORT* viewports) override;
+            void RSGetViewports(UINT* count, D3D11_VIEWPORT* viewports) override;
+            void ClearRenderTargetView(ID3D11RenderTargetView* rtv, const FLOAT color[4]) override;
+            void ClearDepthStencilView(ID3D11DepthStencilView* dsv, UINT flags, FLOAT depth, std::uint8_t stencil) override;
+            void CopySubresourceRegion(ID3D11Resource* dst, UINT dstSub, UINT x, UINT y, UINT z, ID3D11Resource* src, UINT srcSub,
+                                       const D3D11_BOX* box) override;
+            void UpdateSubresource(ID3D11Resource* dst, UINT dstSub, const D3D11_BOX* box, const void* data, UINT rowPitch,
+                                   UINT depthPitch) override;
+            HRESULT Map(ID3D11Resource* resource, UINT sub, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* mapped) override;
+            void    Unmap(ID3D11Resource* resource, UINT sub) override;
+            void    End(ID3D11Asynchronous* async) override;
+            HRESULT GetData(ID3D11Asynchronous* async, void* data, UINT size, UINT flags) override;
+
+        private:
+            FakeDevice&             m_owner;
+            ID3D11RenderTargetView* m_boundRtv{ nullptr };  // not referenced: only for OMGetRenderTargets
+            ID3D11DepthStencilView* m_boundDsv{ nullptr };
+            D3D11_VIEWPORT          m_viewport{};
+            UINT                    m_viewports{ 0 };
+        };
+
+        void Count(GpuCall call) { ++m_frame[static_cast<std::size_t>(call)]; }
+        bool Check(const void* object);  // live object (counts an error otherwise)
+        void Track(const void* object);
+        void Untrack(const void* object);
+        std::uint64_t Issue();  // one more piece of GPU work; its sequence number
+
+        DeviceImpl                      m_device{ *this };
+        ContextImpl                     m_context{ *this };
+        ID3D11Texture2D*                m_backBuffer{ nullptr };
+        GpuCallFrame                    m_frame{};
+        Stats                           m_stats{};
+        std::unordered_set<const void*> m_live;
+        std::uint64_t                   m_issued{ 0 };
+        std::uint64_t                   m_retired{ 0 };
+        bool                            m_held{ false };
+    };
+}
@@ -0,0 +1,64 @@
+#include "HeadlessGpu.h"
+
+namespace MI::Replay
+{
+    HeadlessGpu::HeadlessGpu()
+    {
+        m_target.Init(m_device.Device(), m_device.Context());
+        GpuCallFrame discard{};
+        GpuCalls::TakeFrame(discard);  // start both counters from zero
+    }
+
+    // Mirrors Preview3D::EnsureSize + the offscreen pass of RenderSceneTo: recreate the target
+    // when the pane size changes, then bind it, set the viewport and clear
+    void HeadlessGpu::RenderPreview(unsigned width, unsigned height)
+    {
+        m_target.Ensure(width, height);
+        if (!m_target.GetRTV()) {
+            return;
+        }
+        m_target.Clear(0.0f, 0.0f, 0.0f, 0.0f);
+        D3D11_VIEWPORT vp{};
+        vp.Width = static_cast<float>(m_target.Width());
+        vp.Height = static_cast<float>(m_target.Height());
+        vp.MaxDepth = 1.0f;
+        GpuCalls::Count(GpuCall::kRSSetViewports);
+        m_device.Context()->RSSetViewports(1, &vp);
+    }
+
+    // Mirrors Present_Hook: CreateRenderTarget on the first frame, then the ImGui back-buffer bind
+    void HeadlessGpu::Present()
+    {
+        if (!m_backBufferRtv) {
+            GpuCalls::Count(GpuCall::kCreateRenderTargetView);
+            m_device.Device()->CreateRenderTargetView(m_device.BackBuffer(), nullptr, &m_backBufferRtv);
+        }
+        if (m_backBufferRtv) {
+            GpuCalls::Count(GpuCall::kOMSetRenderTargets);
+            m_device.Context()->OMSetRenderTargets(1, &m_backBufferRtv, nullptr);
+        }
+    }
+
+    void HeadlessGpu::TakeFrame(GpuCallFrame& out)
+    {
+        GpuCallFrame counted{};
+        GpuCalls::TakeFrame(counted);
+        m_device.TakeFrame(out);
+        m_miscounted += counted != out;
+    }
+
+    void HeadlessGpu::Shutdown()
+    {
+        m_target.Release();
+        if (m_backBufferRtv) {
+            m_backBufferRtv->Release();
+            m_backBufferRtv = nullptr;
+        }
+        m_leaked = m_device.Live();
+    }
+
+    HeadlessGpu::Stats HeadlessGpu::GetStats() const
+    {
+        return Stats{ m_miscounted, m_device.GetStats().errors, m_leaked };
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+// The plugin's per-frame D3D11 work, replayed on FakeDevice (off Windows only): the preview
+// target through the real OffscreenRT (sized with the pane, like Preview3D::CreateTargets),
+// the offscreen pass that binds and clears it, and Present_Hook's tail (back-buffer RTV on
+// the first frame or a swap-chain resize, bound for ImGui every frame). Each frame reports
+// the calls the device saw, and whether our GpuCalls::Count call sites agree with them.
+
+#include <cstdint>
+
+#include "FakeDevice.h"
+#include "ModernInventory/GpuCalls.h"
+#include "ModernInventory/OffscreenRT.h"
+
+namespace MI::Replay
+{
+    class HeadlessGpu
+    {
+    public:
+        struct Stats
+        {
+            std::uint64_t miscountedFrames{};  // call sites and device disagree
+            std::uint64_t deviceErrors{};      // null / released objects passed to the device
+            std::uint64_t leaked{};            // textures + views alive after Shutdown
+        };
+
+        HeadlessGpu();
+
+        void RenderPreview(unsigned width, unsigned height);  // from IGameWorld::RenderPreview
+        void Present();                                       // Present_Hook's tail
+
+        // Calls of the frame just presented, as the device saw them; also compares them with
+        // what the call sites counted (GpuCalls::TakeFrame)
+        void TakeFrame(GpuCallFrame& out);
+
+        void  Shutdown();  // releases everything; anything left alive counts as leaked
+        Stats GetStats() const;
+
+    private:
+        FakeDevice              m_device;
+        OffscreenRT             m_target;
+        ID3D11RenderTargetView* m_backBufferRtv{ nullptr };
+        std::uint64_t           m_miscounted{ 0 };
+        std::uint64_t           m_leaked{ 0 };
+    };
+}
@@ -0,0 +1,88 @@
+#include "HeadlessWorld.h"
+
+#include <cmath>
+
+#include "ModernInventory/PoseBounds.h"
+#include "ModernInventory/PreviewCamera.h"
+
+#if MI_REPLAY_FAKE_D3D11
+#include "HeadlessGpu.h"
+#endif
+
+namespace MI::Replay
+{
+    // Mirrors Preview3D::BuildFromPlayer: flatten a (synthetic) skeleton, place it at the
+    // origin, refresh world transforms and frame the pose bound.
+    bool HeadlessWorld::RebuildPreview()
+    {
+        ++m_seed;
+        m_flat.Clear();
+        m_flat.Reserve(m_bones);
+        for (std::uint32_t i = 0; i < m_bones; ++i) {
+            Math::Xform local;
+            const float a = 0.01f * static_cast<float>((i * 7 + m_seed) % 100);
+            local.rot[0][0] = std::cos(a); local.rot[0][1] = -std::sin(a);
+            local.rot[1][0] = std::sin(a); local.rot[1][1] = std::cos(a);
+            local.pos = { 0.0f, 0.0f, 4.0f };
+            // Breadth-first shape: a spine of short chains fanning out from earlier nodes
+            m_flat.Add(i == 0 ? MI::FlatHierarchy::kNoParent : (i - 1) / 3, local);
+        }
+        m_flat.Update();
+
+        m_boneWorld.resize(m_flat.Size());
+        m_boneLocal.resize(m_flat.Size());
+        for (std::uint32_t i = 0; i < m_flat.Size(); ++i) {
+            m_boneWorld[i] = m_flat.World(i);
+            m_boneLocal[i] = Math::Sphere{ {}, 6.0f };
+        }
+
+        Math::Sphere bound{ {}, 100.0f };
+        PoseBounds::Compute(m_boneWorld, m_boneLocal, bound);
+        m_distance = Camera::ComputeFullBody(bound, m_width, m_height, 50.0f, 1.1f, 180.0f, 0.0f).distance;
+        m_hasClone = true;
+        m_readyAtUs = m_nowUs + m_cloneLatencyUs;
+        return true;
+    }
+
+    bool HeadlessWorld::RenderPreview(unsigned width, unsigned height)
+    {
+        m_width = width;
+        m_height = height;
+        // Per-frame transform sync (nothing dirty in steady state, like the live path)
+        m_flat.Update();
+#if MI_REPLAY_FAKE_D3D11
+        if (m_gpu) {
+            m_gpu->RenderPreview(width, height);
+        }
+#endif
+        return m_hasClone && m_nowUs >= m_readyAtUs;
+    }
+
+    // Synthetic item list: armor, with a potion or book every fifth row (nothing to try on)
+    std::uint32_t HeadlessWorld::ItemForm(std::uint32_t row)
+    {
+        return row < m_rows && row % 5 != 4 ? 0x00012E46 + row : 0;
+    }
+
+    // Mirrors Preview3D::BuildVariant: copy the clone, then the item replaces the nodes of
+    // the slot it covers (a run of bones picked from the form) and their subtree updates.
+    bool HeadlessWorld::BuildVariant(std::uint32_t slot, std::uint32_t formID)
+    {
+        if (!m_hasClone || formID == 0) {
+            return false;
+        }
+        if (slot >= m_variants.size()) {
+            m_variants.resize(slot + 1);
+        }
+        auto& variant = m_variants[slot];
+        variant = m_flat;
+        const auto first = static_cast<std::uint32_t>(formID % (m_flat.Size() ? m_flat.Size() : 1));
+        for (std::uint32_t i = first; i < m_flat.Size() && i < first + 16; ++i) {
+            auto local = variant.Local(i);
+            local.pos.z += 0.5f;
+            variant.SetLocal(i, local);
+        }
+        variant.Update();
+        return true;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+// Headless IGameWorld for MI_replay: stands in for the engine with the same portable
+// kernels the plugin runs (clone mirror, pose bounds, camera fit), so stage costs
+// reflect our own work rather than the game's.
+
+#include <cstdint>
+#include <vector>
+
+#include "ModernInventory/FlatHierarchy.h"
+#include "ModernInventory/GameWorld.h"
+#include "ModernInventory/XformMath.h"
+
+namespace MI::Replay
+{
+    class HeadlessGpu;
+
+    class HeadlessWorld final : public IGameWorld
+    {
+    public:
+        // cloneLatencyUs: how long after a rebuild the clone first renders (player 3D
+        // streaming in, first scene update); 0 = the next frame, like a loaded character.
+        HeadlessWorld(std::uint32_t bones, std::uint64_t cloneLatencyUs) : m_bones(bones), m_cloneLatencyUs(cloneLatencyUs) {}
+
+        void SetTime(std::uint64_t us) { m_nowUs = us; }
+        void ChangeOutfit() { ++m_outfit; }  // recorded equip: the clone inputs changed
+        void SetMemoryPressure(bool pressure) { m_memoryPressure = pressure; }
+        void SetGpu(HeadlessGpu* gpu) { m_gpu = gpu; }  // render the preview on a fake device
+        // Recorded hover: the cursor row and the length of the list it is in
+        void SetHover(std::uint32_t row, std::uint32_t rows)
+        {
+            m_hoverRow = row;
+            m_rows = rows;
+        }
+
+        bool HasPlayer3D() override { return true; }
+        void HideVanillaPreview() override {}
+        void SetPanelVisible(bool) override {}
+        bool RebuildPreview() override;
+        void DiscardPreview() override { m_hasClone = false; }
+        std::uint64_t PreviewFingerprint() override { return m_outfit; }
+        bool UnderMemoryPressure() override { return m_memoryPressure; }
+        bool RenderPreview(unsigned width, unsigned height) override;
+        void Notify(const char*) override {}
+        std::uint64_t NowUs() override { return m_nowUs; }
+        void TakeGpuCalls(GpuCallFrame& out) override { out.fill(0); }  // MI_replay takes them from HeadlessGpu
+        void RequestExport() override {}
+        std::uint32_t HoveredRow() override { return m_hoverRow; }
+        std::uint32_t ItemCount() override { return m_rows; }
+        std::uint32_t ItemForm(std::uint32_t row) override;
+        bool BuildVariant(std::uint32_t slot, std::uint32_t formID) override;
+        void ShowVariant(std::uint32_t slot) override { m_shownVariant = slot; }
+        void DiscardVariants() override { m_shownVariant = kNone; }  // slots keep their storage
+
+    private:
+        std::uint32_t                m_bones;
+        std::uint64_t                m_cloneLatencyUs;
+        std::uint64_t                m_readyAtUs{ 0 };
+        std::uint64_t                m_outfit{ 0 };
+        bool                         m_memoryPressure{ false };
+        std::uint64_t                m_nowUs{ 0 };
+        std::uint64_t                m_seed{ 1 };
+        bool                         m_hasClone{ false };
+        unsigned                     m_width{ 0 }, m_height{ 0 };
+        MI::FlatHierarchy            m_flat;
+        std::vector<Math::Xform>     m_boneWorld;
+        std::vector<Math::Sphere>    m_boneLocal;
+        float                        m_distance{ 0.0f };
+        std::uint32_t                m_hoverRow{ kNone };
+        std::uint32_t                m_rows{ 0 };
+        std::vector<MI::FlatHierarchy> m_variants;  // by slot: copies of m_flat with an item swapped in
+        std::uint32_t                m_shownVariant{ kNone };
+        HeadlessGpu*                 m_gpu{ nullptr };
+    };
+}
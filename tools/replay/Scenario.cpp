@@ -0,0 +1,126 @@
+#include "Scenario.h"
+
+#include <cstdint>
+
+namespace MI::Replay
+{
+    namespace
+    {
+        constexpr std::uint64_t kFrameUs = 16667;  // 60 Hz Present cadence
+
+        struct Script
+        {
+            std::vector<Event>& out;
+            std::uint64_t       now{ 0 };
+
+            void Add(EventType type, std::uint32_t a = 0, std::uint32_t b = 0) { out.push_back({ type, now, a, b }); }
+
+            void Frames(int n)
+            {
+                for (int i = 0; i < n; ++i) {
+                    now += kFrameUs;
+                    Add(EventType::kFrame);
+                }
+            }
+        };
+    }
+
+    bool BuildScenario(const std::string& name, std::vector<Event>& out)
+    {
+        // Same ordering the live controller records: input events land between frames,
+        // a pane size change precedes the frame that uses it.
+        Script s{ out };
+        if (name == "hotkey") {
+            for (int session = 0; session < 2; ++session) {
+                s.Frames(30);
+                s.Add(EventType::kHotkey);
+                s.Frames(6);                            // menu fade-in before the open event
+                s.Add(EventType::kMenuOpen);
+                s.Add(EventType::kPaneSize, 1440, 1404);
+                s.Frames(120);
+                s.Add(EventType::kMenuClose);
+                s.Add(EventType::kPaneSize, 0, 0);
+                if (session == 0) {
+                    s.Frames(30);
+                    s.Add(EventType::kEquip);           // favorites menu: the cached clone is stale
+                    s.Frames(30);
+                    s.Add(EventType::kHotkey);          // pressed in combat: no menu follows
+                    s.Frames(150);                      // past the prebuild timeout
+                }
+            }
+            s.Frames(30);
+            return true;
+        }
+        if (name == "reopen") {
+            const auto session = [&s](int frames) {
+                s.Add(EventType::kMenuOpen);
+                s.Add(EventType::kPaneSize, 1440, 1404);
+                s.Frames(frames);
+                s.Add(EventType::kMenuClose);
+                s.Add(EventType::kPaneSize, 0, 0);
+            };
+            s.Frames(30);
+            session(60);
+            s.Frames(120);
+            session(60);                                // nothing changed: reuse
+            s.Frames(60);
+            s.Add(EventType::kEquip);                   // equipped from the favorites menu
+            s.Frames(60);
+            session(60);                                // stale: rebuild
+            s.Frames(65 * 60);                          // idle past the eviction delay
+            session(60);                                // reuse, or rebuild if evicted
+            s.Frames(30);
+            return true;
+        }
+        if (name == "hover") {
+            constexpr std::uint32_t kRows = 60;
+            const auto hover = [&s](std::uint32_t row) { s.Add(EventType::kHover, row, kRows); };
+            s.Frames(30);
+            s.Add(EventType::kMenuOpen);
+            s.Add(EventType::kPaneSize, 1440, 1404);
+            s.Frames(10);
+            for (std::uint32_t row = 0; row < 25; ++row) {  // reading down the list
+                hover(row);
+                s.Frames(6);
+            }
+            s.Frames(60);                               // lingering on one item
+            for (std::uint32_t row = 25; row < 45; ++row) { // key repeat: a row every frame
+                hover(row);
+                s.Frames(1);
+            }
+            for (std::uint32_t row = 44; row >= 30; --row) { // back up to something seen earlier
+                hover(row);
+                s.Frames(4);
+            }
+            s.Add(EventType::kEquip);                   // tried it on for real: variants are stale
+            s.Frames(10);
+            std::uint32_t row = 7;
+            for (int jump = 0; jump < 12; ++jump) {     // mouse jumps across the list
+                row = (row * 37 + 11) % kRows;
+                hover(row);
+                s.Frames(20);
+            }
+            hover(0xFFFFFFFF);                          // cursor off the list
+            s.Frames(30);
+            s.Add(EventType::kMenuClose);
+            s.Add(EventType::kPaneSize, 0, 0);
+            s.Frames(30);
+            return true;
+        }
+        if (name != "inventory") {
+            return false;
+        }
+        s.Frames(30);                               // gameplay, panel closed
+        s.Add(EventType::kMenuOpen);
+        s.Add(EventType::kPaneSize, 1440, 1404);
+        s.Frames(60);
+        s.Add(EventType::kPaneSize, 1600, 1404);    // window resize / ratio change
+        s.Frames(60);
+        s.Add(EventType::kEquip);
+        s.Frames(1000);                             // idle with the preview up
+        s.Add(EventType::kMenuClose);
+        s.Add(EventType::kPaneSize, 0, 0);
+        s.Frames(30);
+        return true;
+    }
+}
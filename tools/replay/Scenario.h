@@ -0,0 +1,19 @@
+#pragma once
+
+// Built-in scripted sessions for MI_replay, so budgets can be checked without a capture.
+
+#include <string>
+#include <vector>
+
+#include "ModernInventory/EventLog.h"
+
+namespace MI::Replay
+{
+    // Known names: "inventory" (open, resize, equip, idle 1000 frames, close), "hotkey"
+    // (inventory key -> menu open 100 ms later, twice, with an equip and an abandoned press in
+    // between), "reopen" (four short sessions: unchanged, after an equip while closed,
+    // after idling 65 s) and "hover" (browsing a 60-row item list: slow and key-repeat scrolling,
+    // a step back, an equip, mouse jumps).
+    // Returns false for an unknown name.
+    bool BuildScenario(const std::string& name, std::vector<Event>& out);
+}
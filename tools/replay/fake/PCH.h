@@ -0,0 +1,8 @@
+#pragma once
+
+// The plugin's precompiled header pulls in CommonLibSSE. The src/Systems files the host tools
+// compile against the fake <d3d11.h> (PreviewExporter) need none of it.
+
+#include <string_view>
+
+using namespace std::literals;
@@ -0,0 +1,234 @@
+#pragma once
+
+// Just enough of <d3d11.h> for MI_replay and MI_bench off Windows: the types and the
+// ID3D11Device / ID3D11DeviceContext methods our render code calls (OffscreenRT, the preview
+// target, the Present tail, PreviewExporter's readback), as plain abstract classes instead of
+// COM. FakeDevice implements them. Names and signatures follow the Windows SDK so the shared
+// code compiles unchanged. Never on the plugin's include path.
+
+#include <cstdint>
+
+using UINT = unsigned int;
+using HRESULT = std::int32_t;
+using FLOAT = float;
+using LONG = std::int32_t;
+
+constexpr HRESULT S_OK = 0;
+constexpr HRESULT S_FALSE = 1;
+constexpr HRESULT E_FAIL = static_cast<HRESULT>(0x80004005u);
+constexpr HRESULT E_OUTOFMEMORY = static_cast<HRESULT>(0x8007000Eu);
+constexpr HRESULT DXGI_ERROR_WAS_STILL_DRAWING = static_cast<HRESULT>(0x887A000Au);
+
+constexpr bool SUCCEEDED(HRESULT hr) { return hr >= 0; }
+constexpr bool FAILED(HRESULT hr) { return hr < 0; }
+
+enum DXGI_FORMAT : UINT
+{
+    DXGI_FORMAT_UNKNOWN = 0,
+    DXGI_FORMAT_R8G8B8A8_UNORM = 28,
+    DXGI_FORMAT_R8G8B8A8_UNORM_SRGB = 29,
+    DXGI_FORMAT_D24_UNORM_S8_UINT = 45,
+};
+
+struct DXGI_SAMPLE_DESC
+{
+    UINT Count;
+    UINT Quality;
+};
+
+enum D3D11_USAGE : UINT
+{
+    D3D11_USAGE_DEFAULT = 0,
+    D3D11_USAGE_IMMUTABLE = 1,
+    D3D11_USAGE_DYNAMIC = 2,
+    D3D11_USAGE_STAGING = 3,
+};
+
+enum D3D11_BIND_FLAG : UINT
+{
+    D3D11_BIND_SHADER_RESOURCE = 0x8,
+    D3D11_BIND_RENDER_TARGET = 0x20,
+    D3D11_BIND_DEPTH_STENCIL = 0x40,
+};
+
+enum D3D11_CPU_ACCESS_FLAG : UINT
+{
+    D3D11_CPU_ACCESS_WRITE = 0x10000,
+    D3D11_CPU_ACCESS_READ = 0x20000,
+};
+
+enum D3D11_MAP : UINT
+{
+    D3D11_MAP_READ = 1,
+    D3D11_MAP_WRITE = 2,
+    D3D11_MAP_READ_WRITE = 3,
+};
+
+enum D3D11_MAP_FLAG : UINT { D3D11_MAP_FLAG_DO_NOT_WAIT = 0x100000 };
+enum D3D11_ASYNC_GETDATA_FLAG : UINT { D3D11_ASYNC_GETDATA_DONOTFLUSH = 0x1 };
+
+enum D3D11_QUERY : UINT { D3D11_QUERY_EVENT = 0 };
+
+struct D3D11_QUERY_DESC
+{
+    D3D11_QUERY Query;
+    UINT        MiscFlags;
+};
+
+struct D3D11_MAPPED_SUBRESOURCE
+{
+    void* pData;
+    UINT  RowPitch;
+    UINT  DepthPitch;
+};
+
+enum D3D11_CLEAR_FLAG : UINT
+{
+    D3D11_CLEAR_DEPTH = 0x1,
+    D3D11_CLEAR_STENCIL = 0x2,
+};
+
+enum D3D11_RTV_DIMENSION : UINT { D3D11_RTV_DIMENSION_TEXTURE2D = 4 };
+enum D3D11_SRV_DIMENSION : UINT { D3D11_SRV_DIMENSION_TEXTURE2D = 4 };
+enum D3D11_DSV_DIMENSION : UINT { D3D11_DSV_DIMENSION_TEXTURE2D = 3 };
+
+struct D3D11_TEXTURE2D_DESC
+{
+    UINT             Width;
+    UINT             Height;
+    UINT             MipLevels;
+    UINT             ArraySize;
+    DXGI_FORMAT      Format;
+    DXGI_SAMPLE_DESC SampleDesc;
+    D3D11_USAGE      Usage;
+    UINT             BindFlags;
+    UINT             CPUAccessFlags;
+    UINT             MiscFlags;
+};
+
+struct D3D11_TEX2D_VIEW
+{
+    UINT MipSlice;
+};
+
+struct D3D11_TEX2D_SRV
+{
+    UINT MostDetailedMip;
+    UINT MipLevels;
+};
+
+struct D3D11_RENDER_TARGET_VIEW_DESC
+{
+    DXGI_FORMAT         Format;
+    D3D11_RTV_DIMENSION ViewDimension;
+    D3D11_TEX2D_VIEW    Texture2D;
+};
+
+struct D3D11_SHADER_RESOURCE_VIEW_DESC
+{
+    DXGI_FORMAT         Format;
+    D3D11_SRV_DIMENSION ViewDimension;
+    D3D11_TEX2D_SRV     Texture2D;
+};
+
+struct D3D11_DEPTH_STENCIL_VIEW_DESC
+{
+    DXGI_FORMAT         Format;
+    D3D11_DSV_DIMENSION ViewDimension;
+    UINT                Flags;
+    D3D11_TEX2D_VIEW    Texture2D;
+};
+
+struct D3D11_VIEWPORT
+{
+    FLOAT TopLeftX;
+    FLOAT TopLeftY;
+    FLOAT Width;
+    FLOAT Height;
+    FLOAT MinDepth;
+    FLOAT MaxDepth;
+};
+
+struct D3D11_BOX
+{
+    UINT left;
+    UINT top;
+    UINT front;
+    UINT right;
+    UINT bottom;
+    UINT back;
+};
+
+// Reference counted like IUnknown (AddRef / Release); no QueryInterface
+struct IUnknown
+{
+    virtual UINT AddRef() = 0;
+    virtual UINT Release() = 0;
+
+protected:
+    virtual ~IUnknown() = default;
+};
+
+struct ID3D11Resource : IUnknown
+{
+};
+
+struct ID3D11Texture2D : ID3D11Resource
+{
+    virtual void GetDesc(D3D11_TEXTURE2D_DESC* desc) = 0;
+};
+
+struct ID3D11View : IUnknown
+{
+    virtual void GetResource(ID3D11Resource** resource) = 0;  // AddRef'd
+};
+
+struct ID3D11RenderTargetView : ID3D11View
+{
+};
+
+struct ID3D11ShaderResourceView : ID3D11View
+{
+};
+
+struct ID3D11DepthStencilView : ID3D11View
+{
+};
+
+struct ID3D11Asynchronous : IUnknown
+{
+};
+
+struct ID3D11Query : ID3D11Asynchronous
+{
+};
+
+struct ID3D11Device : IUnknown
+{
+    virtual HRESULT CreateTexture2D(const D3D11_TEXTURE2D_DESC* desc, const void* initialData, ID3D11Texture2D** out) = 0;
+    virtual HRESULT CreateRenderTargetView(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC* desc,
+                                           ID3D11RenderTargetView** out) = 0;
+    virtual HRESULT CreateShaderResourceView(ID3D11Resource* resource, const D3D11_SHADER_RESOURCE_VIEW_DESC* desc,
+                                             ID3D11ShaderResourceView** out) = 0;
+    virtual HRESULT CreateDepthStencilView(ID3D11Resource* resource, const D3D11_DEPTH_STENCIL_VIEW_DESC* desc,
+                                           ID3D11DepthStencilView** out) = 0;
+    virtual HRESULT CreateQuery(const D3D11_QUERY_DESC* desc, ID3D11Query** out) = 0;
+};
+
+struct ID3D11DeviceContext : IUnknown
+{
+    virtual void OMSetRenderTargets(UINT count, ID3D11RenderTargetView* const* rtvs, ID3D11DepthStencilView* dsv) = 0;
+    virtual void OMGetRenderTargets(UINT count, ID3D11RenderTargetView** rtvs, ID3D11DepthStencilView** dsv) = 0;
+    virtual void RSSetViewports(UINT count, const D3D11_VIEWPORT* viewports) = 0;
+    virtual void RSGetViewports(UINT* count, D3D11_VIEWPORT* viewports) = 0;
+    virtual void ClearRenderTargetView(ID3D11RenderTargetView* rtv, const FLOAT color[4]) = 0;
+    virtual void ClearDepthStencilView(ID3D11DepthStencilView* dsv, UINT flags, FLOAT depth, std::uint8_t stencil) = 0;
+    virtual void CopySubresourceRegion(ID3D11Resource* dst, UINT dstSub, UINT x, UINT y, UINT z, ID3D11Resource* src,
+                                       UINT srcSub, const D3D11_BOX* box) = 0;
+    virtual void UpdateSubresource(ID3D11Resource* dst, UINT dstSub, const D3D11_BOX* box, const void* data, UINT rowPitch,
+                                   UINT depthPitch) = 0;
+    virtual HRESULT Map(ID3D11Resource* resource, UINT sub, D3D11_MAP type, UINT flags, D3D11_MAPPED_SUBRESOURCE* mapped) = 0;
+    virtual void    Unmap(ID3D11Resource* resource, UINT sub) = 0;
+    virtual void    End(ID3D11Asynchronous* async) = 0;
+    virtual HRESULT GetData(ID3D11Asynchronous* async, void* data, UINT size, UINT flags) = 0;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+// Microsoft::WRL::ComPtr for the fake <d3d11.h>: owns one reference, releases it on Reset or
+// destruction. operator& releases first and hands out the slot, as the real ComPtrRef does
+// when passed to a Create* call.
+
+#include <utility>
+
+namespace Microsoft::WRL
+{
+    template <class T>
+    class ComPtr
+    {
+    public:
+        ComPtr() = default;
+        ComPtr(T* ptr) : m_ptr(ptr)
+        {
+            if (m_ptr) {
+                m_ptr->AddRef();
+            }
+        }
+        ComPtr(const ComPtr& other) : ComPtr(other.m_ptr) {}
+        ComPtr(ComPtr&& other) noexcept : m_ptr(std::exchange(other.m_ptr, nullptr)) {}
+        ~ComPtr() { Reset(); }
+
+        ComPtr& operator=(ComPtr other) noexcept
+        {
+            std::swap(m_ptr, other.m_ptr);
+            return *this;
+        }
+
+        T*   Get() const { return m_ptr; }
+        T*   operator->() const { return m_ptr; }
+        T**  operator&()
+        {
+            Reset();
+            return &m_ptr;
+        }
+        explicit operator bool() const { return m_ptr != nullptr; }
+
+        void Reset()
+        {
+            if (auto* ptr = std::exchange(m_ptr, nullptr)) {
+                ptr->Release();
+            }
+        }
+
+    private:
+        T* m_ptr{ nullptr };
+    };
+}
@@ -0,0 +1,435 @@
+// MI_replay: replay a ModernInventory.mievents capture (or a built-in scripted scenario)
+// headlessly at maximum speed, report rebuild counts, per-stage costs, latency and
+// per-frame D3D11 call distributions as JSON, and optionally fail on a budget.
+//   MI_replay <capture.mievents | --scenario inventory|hotkey|reopen|hover> [--bones N] [--out report.json]
+//             [--budget budget.ini] [--prebuild-timeout-ms N] [--clone-latency-ms N]
+//             [--evict-idle-sec N] [--memory-pressure] [--variant-cache N] [--hover-prefetch N]
+// --clone-latency-ms models how long a fresh clone takes to first render, so the hotkey
+// prebuild shows up in open_to_useful_us; --prebuild-timeout-ms 0 replays without it.
+// --memory-pressure makes the headless world report low memory, so idle clones are evicted.
+// --variant-cache / --hover-prefetch size the hover-preview cache and its builds per frame
+// (0 turns either off); the report's hover_preview section gives the hit rate they reach.
+// Captures recorded in game carry the frame's D3D11 calls; scripted scenarios (and captures
+// without them) run the preview target and Present tail on a counting fake device instead
+// (off Windows), which also checks our call-site counters against what the device saw.
+// With neither, the gpu.* metrics are unknown and a budget naming them fails.
+// Built with -DMI_ALLOC_TRACKING=ON it also counts heap allocations per frame and stage;
+// alloc_budget.ini asserts that steady-state frames (no menu/equip/resize event in the last
+// few frames) allocate nothing.
+// Exit codes: 0 ok, 1 unreadable capture, 2 usage, 3 budget exceeded.
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Budget.h"
+#include "HeadlessWorld.h"
+#include "Scenario.h"
+#include "ModernInventory/AllocTrack.h"
+#include "ModernInventory/EventLog.h"
+#include "ModernInventory/GpuCalls.h"
+#include "ModernInventory/PreviewController.h"
+
+#if MI_REPLAY_FAKE_D3D11
+#include "HeadlessGpu.h"
+#endif
+
+namespace
+{
+    // Per-frame distributions of the recorded D3D11 calls
+    struct GpuFrameStats
+    {
+        MI::LatencyHistogram perCall[MI::kGpuCallCount];
+        MI::LatencyHistogram creations;
+        MI::LatencyHistogram stateChanges;
+
+        void AddFrame(const MI::GpuCallFrame& f)
+        {
+            std::uint64_t created = 0, changed = 0;
+            for (std::size_t i = 0; i < MI::kGpuCallCount; ++i) {
+                perCall[i].Add(f[i]);
+                const auto call = static_cast<MI::GpuCall>(i);
+                created += MI::GpuCalls::IsCreation(call) ? f[i] : 0;
+                changed += MI::GpuCalls::IsStateChange(call) ? f[i] : 0;
+            }
+            creations.Add(created);
+            stateChanges.Add(changed);
+        }
+    };
+
+    // Frames after a menu/equip/resize event may still warm caches; the rest must not allocate
+    constexpr std::uint32_t kAllocWarmupFrames = 2;
+
+    struct AllocStats
+    {
+        MI::LatencyHistogram all;                                  // allocations per frame
+        MI::LatencyHistogram steady;                               // ... steady-state frames only
+        MI::LatencyHistogram steadyStage[MI::AllocTrack::kStageCount];
+        std::uint64_t        steadyBytes{};
+
+        void AddFrame(const MI::AllocTrack::Frame& f, bool isSteady)
+        {
+            const auto total = MI::AllocTrack::TotalAllocs(f);
+            all.Add(total);
+            if (isSteady) {
+                steady.Add(total);
+                for (std::size_t i = 0; i < MI::AllocTrack::kStageCount; ++i) {
+                    steadyStage[i].Add(f[i].allocs);
+                    steadyBytes += f[i].bytes;
+                }
+            }
+        }
+    };
+
+    void AddHistogramMetrics(MI::Replay::Metrics& m, const std::string& prefix, const MI::LatencyHistogram& h)
+    {
+        m[prefix + ".max"] = static_cast<double>(h.Max());
+        m[prefix + ".mean"] = h.Mean();
+        m[prefix + ".p99"] = static_cast<double>(h.Percentile(0.99));
+    }
+
+    double Ratio(std::uint64_t part, std::uint64_t whole)
+    {
+        return whole ? static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+    }
+
+    enum class GpuSource { kNone, kCapture, kFakeDevice };
+
+    const char* SourceName(GpuSource source)
+    {
+        return source == GpuSource::kCapture ? "capture" : source == GpuSource::kFakeDevice ? "fake_device" : "none";
+    }
+
+    // Fake device checks (zero when the calls came from a capture)
+    struct GpuChecks
+    {
+        std::uint64_t miscountedFrames{};
+        std::uint64_t deviceErrors{};
+        std::uint64_t leaked{};
+    };
+
+    MI::Replay::Metrics CollectMetrics(const MI::PreviewController::Stats& stats, const MI::VariantCache::Stats& variants,
+                                       const GpuFrameStats& gpu, GpuSource gpuSource, const GpuChecks& checks,
+                                       const AllocStats& allocs)
+    {
+        MI::Replay::Metrics m;
+        // Prebuilds count as the trigger of the open that reuses them
+        const auto triggers = stats.menuOpens.load() - stats.prebuildHits.load() + stats.prebuilds.load() + stats.equips.load();
+        m["rebuilds"] = static_cast<double>(stats.rebuilds.load());
+        m["rebuilds_per_trigger"] = triggers ? static_cast<double>(stats.rebuilds.load()) / static_cast<double>(triggers) : 0.0;
+        m["resizes"] = static_cast<double>(stats.resizes.load());
+        m["prebuilds_discarded"] = static_cast<double>(stats.prebuildsDiscarded.load());
+        m["clone_evictions"] = static_cast<double>(stats.cloneEvictions.load());
+        m["variant.misses"] = static_cast<double>(variants.misses);
+        m["variant.miss_rate"] = Ratio(variants.misses, variants.lookups);
+        m["variant.prefetch_waste"] = Ratio(variants.prefetchWasted, variants.prefetches);
+        AddHistogramMetrics(m, "latency.open_to_useful_us", stats.openToUsefulUs);
+        AddHistogramMetrics(m, "latency.reopen_to_useful_us", stats.reopenToUsefulUs);
+        // Only known when some device calls were seen, like alloc.* below
+        if (gpuSource != GpuSource::kNone) {
+            AddHistogramMetrics(m, "gpu.creations", gpu.creations);
+            AddHistogramMetrics(m, "gpu.state_changes", gpu.stateChanges);
+            for (std::size_t i = 0; i < MI::kGpuCallCount; ++i) {
+                AddHistogramMetrics(m, std::string("gpu.") + MI::GpuCalls::Name(static_cast<MI::GpuCall>(i)), gpu.perCall[i]);
+            }
+        }
+        if (gpuSource == GpuSource::kFakeDevice) {
+            m["gpu.miscounted_frames"] = static_cast<double>(checks.miscountedFrames);
+            m["gpu.device_errors"] = static_cast<double>(checks.deviceErrors);
+            m["gpu.leaked"] = static_cast<double>(checks.leaked);
+        }
+        // Only known when counted: an alloc.* budget on a non-tracking build fails as unknown
+        if constexpr (MI::AllocTrack::kEnabled) {
+            AddHistogramMetrics(m, "alloc.frame", allocs.all);
+            AddHistogramMetrics(m, "alloc.steady", allocs.steady);
+            m["alloc.steady.frames"] = static_cast<double>(allocs.steady.Count());
+            for (std::size_t i = 1; i < MI::AllocTrack::kStageCount; ++i) {
+                AddHistogramMetrics(m, std::string("alloc.steady.") + MI::AllocTrack::StageName(static_cast<MI::AllocTrack::Stage>(i)),
+                                    allocs.steadyStage[i]);
+            }
+        }
+        return m;
+    }
+
+    void WriteHistogram(std::ostream& out, const char* indent, const std::string& name, const MI::LatencyHistogram& h)
+    {
+        out << indent << "\"" << name << "\": { \"count\": " << h.Count()
+            << ", \"mean\": " << h.Mean()
+            << ", \"min\": " << h.Min()
+            << ", \"p50\": " << h.Percentile(0.50)
+            << ", \"p90\": " << h.Percentile(0.90)
+            << ", \"p99\": " << h.Percentile(0.99)
+            << ", \"max\": " << h.Max() << " }";
+    }
+
+    void WriteReport(std::ostream& out, const std::string& source, const std::vector<MI::Event>& events,
+                     const MI::PreviewController::Stats& stats, const MI::VariantCache::Stats& variants,
+                     const MI::LatencyHistogram& frameIntervalUs,
+                     const GpuFrameStats& gpu, GpuSource gpuSource, const GpuChecks& checks, const AllocStats& allocs, double wallMs,
+                     const std::vector<MI::Replay::BudgetViolation>* violations)
+    {
+        static constexpr const char* kStageNames[] = { "menu", "rebuild", "render", "variant" };
+
+        out << "{\n  \"schema\": 6,\n  \"capture\": \"" << source << "\",\n"
+            << "  \"events\": " << events.size() << ",\n"
+            << "  \"capture_duration_us\": " << (events.empty() ? 0 : events.back().timeUs) << ",\n"
+            << "  \"replay_wall_ms\": " << wallMs << ",\n"
+            << "  \"frames\": " << stats.frames.load() << ",\n"
+            << "  \"rendered_frames\": " << stats.renderedFrames.load() << ",\n"
+            << "  \"rebuilds\": " << stats.rebuilds.load() << ",\n"
+            << "  \"menu_opens\": " << stats.menuOpens.load() << ",\n"
+            << "  \"equips\": " << stats.equips.load() << ",\n"
+            << "  \"resizes\": " << stats.resizes.load() << ",\n"
+            << "  \"prebuild\": { \"started\": " << stats.prebuilds.load() << ", \"reused\": " << stats.prebuildHits.load()
+            << ", \"discarded\": " << stats.prebuildsDiscarded.load() << " },\n"
+            << "  \"clone_cache\": { \"reused\": " << stats.cloneReuses.load() << ", \"evicted\": " << stats.cloneEvictions.load()
+            << " },\n"
+            << "  \"hover_preview\": { \"hovers\": " << stats.hoverChanges.load() << ", \"lookups\": " << variants.lookups
+            << ", \"hits\": " << variants.hits << ", \"prefetch_hits\": " << variants.prefetchHits
+            << ", \"misses\": " << variants.misses << ", \"hit_rate\": " << Ratio(variants.hits, variants.lookups)
+            << ", \"prefetches\": " << variants.prefetches << ", \"prefetch_wasted\": " << variants.prefetchWasted
+            << ", \"evictions\": " << variants.evictions << ", \"failed\": " << stats.variantsFailed.load() << " },\n"
+            << "  \"stages\": {\n";
+        for (std::size_t i = 0; i < MI::PreviewController::kStageCount; ++i) {
+            const auto calls = stats.stageCalls[i].load();
+            const auto ns = stats.stageNs[i].load();
+            out << "    \"" << kStageNames[i] << "\": { \"calls\": " << calls << ", \"total_ns\": " << ns
+                << ", \"mean_ns\": " << (calls ? static_cast<double>(ns) / static_cast<double>(calls) : 0.0) << " }"
+                << (i + 1 < MI::PreviewController::kStageCount ? ",\n" : "\n");
+        }
+        out << "  },\n  \"latency\": {\n";
+        WriteHistogram(out, "    ", "frame_ns", stats.frameNs);
+        out << ",\n";
+        WriteHistogram(out, "    ", "open_to_useful_us", stats.openToUsefulUs);
+        out << ",\n";
+        WriteHistogram(out, "    ", "reopen_to_useful_us", stats.reopenToUsefulUs);
+        out << ",\n";
+        WriteHistogram(out, "    ", "recorded_frame_interval_us", frameIntervalUs);
+        out << "\n  },\n  \"gpu_calls_per_frame\": {\n    \"recorded\": " << (gpuSource != GpuSource::kNone ? "true" : "false")
+            << ",\n    \"source\": \"" << SourceName(gpuSource) << "\",\n";
+        if (gpuSource == GpuSource::kFakeDevice) {
+            out << "    \"miscounted_frames\": " << checks.miscountedFrames << ",\n    \"device_errors\": " << checks.deviceErrors
+                << ",\n    \"leaked\": " << checks.leaked << ",\n";
+        }
+        WriteHistogram(out, "    ", "creations", gpu.creations);
+        out << ",\n";
+        WriteHistogram(out, "    ", "state_changes", gpu.stateChanges);
+        for (std::size_t i = 0; i < MI::kGpuCallCount; ++i) {
+            out << ",\n";
+            WriteHistogram(out, "    ", MI::GpuCalls::Name(static_cast<MI::GpuCall>(i)), gpu.perCall[i]);
+        }
+        out << "\n  },\n  \"allocations_per_frame\": {\n    \"tracking\": " << (MI::AllocTrack::kEnabled ? "true" : "false")
+            << ",\n    \"steady_bytes\": " << allocs.steadyBytes << ",\n";
+        WriteHistogram(out, "    ", "all", allocs.all);
+        out << ",\n";
+        WriteHistogram(out, "    ", "steady", allocs.steady);
+        for (std::size_t i = 1; i < MI::AllocTrack::kStageCount; ++i) {
+            out << ",\n";
+            WriteHistogram(out, "    ", std::string("steady_") + MI::AllocTrack::StageName(static_cast<MI::AllocTrack::Stage>(i)),
+                           allocs.steadyStage[i]);
+        }
+        out << "\n  }";
+        if (violations) {
+            out << ",\n  \"budget\": { \"passed\": " << (violations->empty() ? "true" : "false") << ", \"violations\": [";
+            for (std::size_t i = 0; i < violations->size(); ++i) {
+                const auto& v = (*violations)[i];
+                out << (i ? ", " : " ") << "{ \"metric\": \"" << v.metric << "\", \"limit\": " << v.limit
+                    << ", \"actual\": " << (std::isnan(v.actual) ? std::string("null") : std::to_string(v.actual)) << " }";
+            }
+            out << (violations->empty() ? "] }" : " ] }");
+        }
+        out << "\n}\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string capture;
+    std::string scenario;
+    std::string outPath;
+    std::string budgetPath;
+    std::uint32_t bones = 250;
+    std::uint64_t prebuildTimeoutMs = 1500;  // Config::prebuildTimeoutMs default
+    std::uint64_t cloneLatencyMs = 0;
+    std::uint64_t evictIdleSec = 60;  // Config::cacheEvictIdleSec default
+    bool memoryPressure = false;
+    std::uint32_t variantCache = 8;  // Config::variantCacheSize default
+    std::uint32_t hoverPrefetch = 1;  // Config::hoverPrefetchPerFrame default
+    bool usage = false;
+
+    for (int i = 1; i < argc && !usage; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--bones") == 0 && hasValue) {
+            bones = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--prebuild-timeout-ms") == 0 && hasValue) {
+            prebuildTimeoutMs = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--clone-latency-ms") == 0 && hasValue) {
+            cloneLatencyMs = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--evict-idle-sec") == 0 && hasValue) {
+            evictIdleSec = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--variant-cache") == 0 && hasValue) {
+            variantCache = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--hover-prefetch") == 0 && hasValue) {
+            hoverPrefetch = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--memory-pressure") == 0) {
+            memoryPressure = true;
+        } else if (std::strcmp(argv[i], "--out") == 0 && hasValue) {
+            outPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--budget") == 0 && hasValue) {
+            budgetPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--scenario") == 0 && hasValue) {
+            scenario = argv[++i];
+        } else if (argv[i][0] != '-' && capture.empty()) {
+            capture = argv[i];
+        } else {
+            usage = true;
+        }
+    }
+    if (usage || capture.empty() == scenario.empty()) {
+        std::cerr << "usage: " << argv[0] << " <capture.mievents | --scenario inventory|hotkey|reopen|hover> [--bones N]"
+                  << " [--out report.json] [--budget budget.ini] [--prebuild-timeout-ms N] [--clone-latency-ms N]"
+                  << " [--evict-idle-sec N] [--memory-pressure] [--variant-cache N] [--hover-prefetch N]\n";
+        return 2;
+    }
+
+    std::vector<MI::Event> events;
+    if (!scenario.empty()) {
+        if (!MI::Replay::BuildScenario(scenario, events)) {
+            std::cerr << "unknown scenario '" << scenario << "'\n";
+            return 2;
+        }
+    } else if (!MI::EventLog::ReadFile(capture, events)) {
+        std::cerr << "warning: " << capture << " is missing, malformed or truncated (" << events.size()
+                  << " events decoded)\n";
+        if (events.empty()) {
+            return 1;
+        }
+    }
+
+    MI::Replay::Metrics limits;
+    if (!budgetPath.empty()) {
+        std::string error;
+        if (!MI::Replay::LoadBudget(budgetPath, limits, error)) {
+            std::cerr << error << "\n";
+            return 2;
+        }
+    }
+
+    MI::Replay::HeadlessWorld world(bones, cloneLatencyMs * 1000);
+    MI::PreviewController controller(world);
+    controller.SetPrebuildTimeout(prebuildTimeoutMs * 1000);
+    controller.SetEvictIdle(evictIdleSec * 1000000);
+    controller.SetHoverPreview(variantCache, hoverPrefetch);
+    world.SetMemoryPressure(memoryPressure);
+    MI::LatencyHistogram frameIntervalUs;
+    GpuFrameStats gpu;
+    MI::GpuCallFrame gpuFrame{};
+    GpuSource gpuSource = GpuSource::kNone;
+    for (const auto& e : events) {
+        if (e.type == MI::EventType::kGpuCalls) {
+            gpuSource = GpuSource::kCapture;
+            break;
+        }
+    }
+    GpuChecks gpuChecks;
+#if MI_REPLAY_FAKE_D3D11
+    MI::Replay::HeadlessGpu fakeGpu;
+    if (gpuSource == GpuSource::kNone) {
+        gpuSource = GpuSource::kFakeDevice;
+        world.SetGpu(&fakeGpu);
+    }
+#endif
+    AllocStats allocs;
+    MI::AllocTrack::Frame allocFrame{};
+    std::uint32_t framesSinceChange = 0;
+
+    unsigned paneW = 0, paneH = 0;
+    std::uint64_t lastFrameUs = 0;
+    bool haveFrame = false;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (const auto& e : events) {
+        world.SetTime(e.timeUs);
+        switch (e.type) {
+        case MI::EventType::kMenuOpen:  controller.OnMenu(true); framesSinceChange = 0; break;
+        case MI::EventType::kMenuClose: controller.OnMenu(false); framesSinceChange = 0; break;
+        case MI::EventType::kEquip:
+            world.ChangeOutfit();
+            controller.OnEquip();
+            framesSinceChange = 0;
+            break;
+        case MI::EventType::kHotkey:    controller.OnHotkey(); framesSinceChange = 0; break;
+        case MI::EventType::kHover:     world.SetHover(e.a, e.b); framesSinceChange = 0; break;
+        case MI::EventType::kPaneSize:  paneW = e.a; paneH = e.b; framesSinceChange = 0; break;
+        case MI::EventType::kGpuCalls:
+            // Recorded just before the kFrame that closes the frame they were made in
+            if (e.a < MI::kGpuCallCount) {
+                gpuFrame[e.a] += e.b;
+            }
+            break;
+        case MI::EventType::kFrame:
+            if (haveFrame) {
+                frameIntervalUs.Add(e.timeUs - lastFrameUs);
+            }
+            lastFrameUs = e.timeUs;
+            haveFrame = true;
+            if (gpuSource == GpuSource::kCapture) {
+                gpu.AddFrame(gpuFrame);
+                gpuFrame.fill(0);
+            }
+            {
+                // Present_Hook's share of a frame; the controller opens its own stages
+                const MI::AllocTrack::Scope present(MI::AllocTrack::Stage::kPresent);
+                controller.OnFrame(paneW, paneH);
+#if MI_REPLAY_FAKE_D3D11
+                if (gpuSource == GpuSource::kFakeDevice) {
+                    fakeGpu.Present();
+                }
+#endif
+            }
+#if MI_REPLAY_FAKE_D3D11
+            if (gpuSource == GpuSource::kFakeDevice) {
+                fakeGpu.TakeFrame(gpuFrame);
+                gpu.AddFrame(gpuFrame);
+            }
+#endif
+            MI::AllocTrack::TakeFrame(allocFrame);
+            allocs.AddFrame(allocFrame, framesSinceChange >= kAllocWarmupFrames);
+            ++framesSinceChange;
+            break;
+        }
+    }
+    const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+#if MI_REPLAY_FAKE_D3D11
+    if (gpuSource == GpuSource::kFakeDevice) {
+        fakeGpu.Shutdown();
+        const auto fake = fakeGpu.GetStats();
+        gpuChecks = GpuChecks{ fake.miscountedFrames, fake.deviceErrors, fake.leaked };
+    }
+#endif
+
+    const auto& stats = controller.GetStats();
+    std::vector<MI::Replay::BudgetViolation> violations;
+    if (!budgetPath.empty()) {
+        violations = MI::Replay::CheckBudget(limits, CollectMetrics(stats, controller.GetVariantStats(), gpu, gpuSource, gpuChecks, allocs));
+        for (const auto& v : violations) {
+            std::cerr << "budget exceeded: " << v.metric << " = "
+                      << (std::isnan(v.actual) ? std::string("<unknown metric>") : std::to_string(v.actual))
+                      << " (limit " << v.limit << ")\n";
+        }
+    }
+
+    const auto& source = scenario.empty() ? capture : "scenario:" + scenario;
+    const auto* budget = budgetPath.empty() ? nullptr : &violations;
+    if (outPath.empty()) {
+        WriteReport(std::cout, source, events, stats, controller.GetVariantStats(), frameIntervalUs, gpu, gpuSource, gpuChecks, allocs, wallMs, budget);
+    } else {
+        std::ofstream out(outPath);
+        WriteReport(out, source, events, stats, controller.GetVariantStats(), frameIntervalUs, gpu, gpuSource, gpuChecks, allocs, wallMs, budget);
+    }
+    return violations.empty() ? 0 : 3;
+}